@@ -12,6 +12,11 @@
 #define NROUNDS 24
 #define ROL(a, offset) ((a << offset) ^ (a >> (64-offset)))
 
+#if defined(__x86_64__)
+/* On x86-64, the permutation is the one of the Falcon code, shared in
+ * keccak_x64.h (compile with -mbmi -mbmi2 to get ANDN and RORX). */
+#include "../falcon-lazy/keccak_x64.h"
+#else
 static const uint64_t KeccakF_RoundConstants[NROUNDS] =
 {
     (uint64_t)0x0000000000000001ULL,
@@ -39,6 +44,7 @@ static const uint64_t KeccakF_RoundConstants[NROUNDS] =
     (uint64_t)0x0000000080000001ULL,
     (uint64_t)0x8000000080008008ULL
 };
+#endif
 
 void KeccakF1600_StateExtractBytes(uint64_t *state, unsigned char *data, unsigned int offset, unsigned int length)
 {
@@ -58,6 +64,12 @@ void KeccakF1600_StateXORBytes(uint64_t *state, const unsigned char *data, unsig
     }
 }
 
+#if defined(__x86_64__)
+void KeccakF1600_StatePermute(uint64_t * state)
+{
+    keccak_x64_f1600(state);
+}
+#else
 void KeccakF1600_StatePermute(uint64_t * state)
 {
   int round;
@@ -324,3 +336,4 @@ void KeccakF1600_StatePermute(uint64_t * state)
 
         #undef    round
 }
+#endif
@@ -31,6 +31,205 @@
 
 #include "inner.h"
 
+/*
+ * With FALCON_DISPATCH, this file is also compiled as part of the
+ * kernel copies (kern_avx2.c, kern_avx512.c); only Zf(codec_unpack)()
+ * and Zf(codec_pack)() are then included.
+ *
+ * AVX2 packing and unpacking of fixed-width fields (modq_*() and
+ * trim_*() functions), for widths up to 14 bits. Sixteen fields of
+ * 'bits' bits use exactly 2*bits bytes, so the vector code handles
+ * blocks of 16 values from the start of the data, and the scalar code
+ * finishes the last blocks (and the trailing bits) from a byte
+ * boundary. Results are the same as with the scalar code. The portable
+ * kernels handle no value.
+ */
+
+/* see inner.h */
+TARGET_AVX2
+size_t
+Zk(codec_unpack)(void *x, size_t n, unsigned bits, int kind,
+	const uint8_t *buf, size_t in_len, int *bad)
+{
+#if FALCON_AVX2 // yyyAVX2+1
+	uint8_t ctl[64];
+	uint32_t sh[16];
+	size_t off[4], u, p;
+	unsigned j, i;
+	__m256i c0, c1, s0, s1, mask, lim, sgn, err;
+
+	*bad = 0;
+	if (bits > 14 || n < 16) {
+		return 0;
+	}
+	/*
+	 * Value i of quarter j (each quarter of a block is decoded in
+	 * one 128-bit lane) starts at byte k and bit o (from the top)
+	 * of the 16 bytes loaded from the start of the block plus
+	 * off[j]. Its three bytes go, big-endian, in the top three bytes
+	 * of a 32-bit word, shifted right by 32-o-bits.
+	 */
+	for (j = 0; j < 4; j ++) {
+		off[j] = (4 * j * bits) >> 3;
+		for (i = 0; i < 4; i ++) {
+			unsigned r, k, o;
+
+			r = (4 * j + i) * bits - 8 * (unsigned)off[j];
+			k = r >> 3;
+			o = r & 7;
+			ctl[16 * j + 4 * i] = 0x80;
+			ctl[16 * j + 4 * i + 1] = (uint8_t)(k + 2);
+			ctl[16 * j + 4 * i + 2] = (uint8_t)(k + 1);
+			ctl[16 * j + 4 * i + 3] = (uint8_t)k;
+			sh[4 * j + i] = 32 - o - bits;
+		}
+	}
+	c0 = _mm256_loadu_si256((const __m256i *)ctl);
+	c1 = _mm256_loadu_si256((const __m256i *)(ctl + 32));
+	s0 = _mm256_loadu_si256((const __m256i *)sh);
+	s1 = _mm256_loadu_si256((const __m256i *)(sh + 8));
+	mask = _mm256_set1_epi32((1 << bits) - 1);
+	if (kind == CODEC_MODQ) {
+		lim = _mm256_set1_epi16(12288);
+		sgn = _mm256_setzero_si256();
+	} else {
+		lim = _mm256_set1_epi16((int16_t)(1 << (bits - 1)));
+		sgn = lim;
+	}
+	err = _mm256_setzero_si256();
+
+	for (u = 0, p = 0; u + 16 <= n && p + 2 * bits + 16 <= in_len;
+		u += 16, p += 2 * bits)
+	{
+		__m256i a, b, w;
+
+		a = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			_mm_loadu_si128((const __m128i *)(buf + p + off[0]))),
+			_mm_loadu_si128((const __m128i *)(buf + p + off[1])), 1);
+		b = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			_mm_loadu_si128((const __m128i *)(buf + p + off[2]))),
+			_mm_loadu_si128((const __m128i *)(buf + p + off[3])), 1);
+		a = _mm256_and_si256(_mm256_srlv_epi32(
+			_mm256_shuffle_epi8(a, c0), s0), mask);
+		b = _mm256_and_si256(_mm256_srlv_epi32(
+			_mm256_shuffle_epi8(b, c1), s1), mask);
+		w = _mm256_permute4x64_epi64(
+			_mm256_packus_epi32(a, b), 0xD8);
+
+		if (kind == CODEC_MODQ) {
+			err = _mm256_or_si256(err, _mm256_cmpgt_epi16(w, lim));
+			_mm256_storeu_si256((__m256i *)((uint16_t *)x + u), w);
+			continue;
+		}
+		err = _mm256_or_si256(err, _mm256_cmpeq_epi16(w, lim));
+		w = _mm256_sub_epi16(_mm256_xor_si256(w, sgn), sgn);
+		if (kind == CODEC_I16) {
+			_mm256_storeu_si256((__m256i *)((int16_t *)x + u), w);
+		} else {
+			w = _mm256_permute4x64_epi64(
+				_mm256_packs_epi16(w, w), 0x08);
+			_mm_storeu_si128((__m128i *)((int8_t *)x + u),
+				_mm256_castsi256_si128(w));
+		}
+	}
+	*bad = !_mm256_testz_si256(err, err);
+	return u;
+#else // yyyAVX2+0
+	(void)x;
+	(void)n;
+	(void)bits;
+	(void)kind;
+	(void)buf;
+	(void)in_len;
+	*bad = 0;
+	return 0;
+#endif // yyyAVX2-
+}
+
+/* see inner.h */
+TARGET_AVX2
+size_t
+Zk(codec_pack)(uint8_t *buf, size_t out_len, unsigned bits, int kind,
+	const void *x, size_t n)
+{
+#if FALCON_AVX2 // yyyAVX2+1
+	uint8_t ctl[32];
+	uint64_t sh[4];
+	size_t u, p;
+	unsigned k, h0, h1, e;
+	__m256i mask, m1, cl, c0, c1, s;
+	__m128i cb;
+
+	if (bits > 14 || n < 16) {
+		return 0;
+	}
+	/*
+	 * Pairs of 16-bit fields are merged into 32-bit words (2*bits
+	 * bits), then pairs of those into 64-bit words (4*bits bits).
+	 * The two 64-bit words of a 128-bit lane are aligned so that
+	 * their big-endian bytes, selected by c0 and c1, give the
+	 * 'bits' bytes of eight values. If 4*bits is not a multiple of
+	 * 8, the second word starts in the middle of a byte (e = 4).
+	 */
+	h0 = (4 * bits + 7) >> 3;
+	h1 = (4 * bits) >> 3;
+	e = (4 * bits) & 7;
+	for (k = 0; k < 16; k ++) {
+		ctl[k] = k < h0 ? (uint8_t)(7 - k) : 0x80;
+		ctl[16 + k] = (k >= h1 && k < bits)
+			? (uint8_t)(15 - (k - h1)) : 0x80;
+	}
+	c0 = _mm256_broadcastsi128_si256(
+		_mm_loadu_si128((const __m128i *)ctl));
+	c1 = _mm256_broadcastsi128_si256(
+		_mm_loadu_si128((const __m128i *)(ctl + 16)));
+	sh[0] = sh[2] = 64 - 4 * bits;
+	sh[1] = sh[3] = 64 - 4 * bits - e;
+	s = _mm256_loadu_si256((const __m256i *)sh);
+	mask = _mm256_set1_epi16((int16_t)((1 << bits) - 1));
+	m1 = _mm256_set1_epi32((1 << 16) | (1 << bits));
+	cl = _mm256_set1_epi64x(0xFFFFFFFF);
+	cb = _mm_cvtsi32_si128((int)(2 * bits));
+
+	for (u = 0, p = 0; u + 16 <= n && p + bits + 16 <= out_len;
+		u += 16, p += 2 * bits)
+	{
+		__m256i w;
+
+		if (kind == CODEC_I8) {
+			w = _mm256_cvtepi8_epi16(_mm_loadu_si128(
+				(const __m128i *)((const int8_t *)x + u)));
+		} else {
+			w = _mm256_loadu_si256(
+				(const __m256i *)((const uint16_t *)x + u));
+		}
+		w = _mm256_and_si256(w, mask);
+		w = _mm256_madd_epi16(w, m1);
+		w = _mm256_or_si256(
+			_mm256_sll_epi64(_mm256_and_si256(w, cl), cb),
+			_mm256_srli_epi64(w, 32));
+		w = _mm256_sllv_epi64(w, s);
+		w = _mm256_or_si256(
+			_mm256_shuffle_epi8(w, c0), _mm256_shuffle_epi8(w, c1));
+		_mm_storeu_si128((__m128i *)(buf + p),
+			_mm256_castsi256_si128(w));
+		_mm_storeu_si128((__m128i *)(buf + p + bits),
+			_mm256_extracti128_si256(w, 1));
+	}
+	return u;
+#else // yyyAVX2+0
+	(void)buf;
+	(void)out_len;
+	(void)bits;
+	(void)kind;
+	(void)x;
+	(void)n;
+	return 0;
+#endif // yyyAVX2-
+}
+
+#ifndef FALCON_KERNEL
+
 /* see inner.h */
 size_t
 Zf(modq_encode)(
@@ -56,9 +255,11 @@ Zf(modq_encode)(
 		return 0;
 	}
 	buf = out;
+	u = Zf(codec_pack)(buf, out_len, 14, CODEC_MODQ, x, n);
+	buf += (u * 14) >> 3;
 	acc = 0;
 	acc_len = 0;
-	for (u = 0; u < n; u ++) {
+	for (; u < n; u ++) {
 		acc = (acc << 14) | x[u];
 		acc_len += 14;
 		while (acc_len >= 8) {
@@ -81,7 +282,7 @@ Zf(modq_decode)(
 	size_t n, in_len, u;
 	const uint8_t *buf;
 	uint32_t acc;
-	int acc_len;
+	int acc_len, bad;
 
 	n = (size_t)1 << logn;
 	in_len = ((n * 14) + 7) >> 3;
@@ -89,9 +290,13 @@ Zf(modq_decode)(
 		return 0;
 	}
 	buf = in;
+	u = Zf(codec_unpack)(x, n, 14, CODEC_MODQ, buf, in_len, &bad);
+	if (bad) {
+		return 0;
+	}
+	buf += (u * 14) >> 3;
 	acc = 0;
 	acc_len = 0;
-	u = 0;
 	while (u < n) {
 		acc = (acc << 8) | (*buf ++);
 		acc_len += 8;
@@ -140,10 +345,12 @@ Zf(trim_i16_encode)(
 		return 0;
 	}
 	buf = out;
+	u = Zf(codec_pack)(buf, out_len, bits, CODEC_I16, x, n);
+	buf += (u * bits) >> 3;
 	acc = 0;
 	acc_len = 0;
 	mask = ((uint32_t)1 << bits) - 1;
-	for (u = 0; u < n; u ++) {
+	for (; u < n; u ++) {
 		acc = (acc << bits) | ((uint16_t)x[u] & mask);
 		acc_len += bits;
 		while (acc_len >= 8) {
@@ -168,6 +375,7 @@ Zf(trim_i16_decode)(
 	size_t u;
 	uint32_t acc, mask1, mask2;
 	unsigned acc_len;
+	int bad;
 
 	n = (size_t)1 << logn;
 	in_len = ((n * bits) + 7) >> 3;
@@ -175,7 +383,14 @@ Zf(trim_i16_decode)(
 		return 0;
 	}
 	buf = in;
-	u = 0;
+	u = Zf(codec_unpack)(x, n, bits, CODEC_I16, buf, in_len, &bad);
+	if (bad) {
+		/*
+		 * The -2^(bits-1) value is forbidden.
+		 */
+		return 0;
+	}
+	buf += (u * bits) >> 3;
 	acc = 0;
 	acc_len = 0;
 	mask1 = ((uint32_t)1 << bits) - 1;
@@ -236,10 +451,12 @@ Zf(trim_i8_encode)(
 		return 0;
 	}
 	buf = out;
+	u = Zf(codec_pack)(buf, out_len, bits, CODEC_I8, x, n);
+	buf += (u * bits) >> 3;
 	acc = 0;
 	acc_len = 0;
 	mask = ((uint32_t)1 << bits) - 1;
-	for (u = 0; u < n; u ++) {
+	for (; u < n; u ++) {
 		acc = (acc << bits) | ((uint8_t)x[u] & mask);
 		acc_len += bits;
 		while (acc_len >= 8) {
@@ -264,6 +481,7 @@ Zf(trim_i8_decode)(
 	size_t u;
 	uint32_t acc, mask1, mask2;
 	unsigned acc_len;
+	int bad;
 
 	n = (size_t)1 << logn;
 	in_len = ((n * bits) + 7) >> 3;
@@ -271,7 +489,14 @@ Zf(trim_i8_decode)(
 		return 0;
 	}
 	buf = in;
-	u = 0;
+	u = Zf(codec_unpack)(x, n, bits, CODEC_I8, buf, in_len, &bad);
+	if (bad) {
+		/*
+		 * The -2^(bits-1) value is forbidden.
+		 */
+		return 0;
+	}
+	buf += (u * bits) >> 3;
 	acc = 0;
 	acc_len = 0;
 	mask1 = ((uint32_t)1 << bits) - 1;
@@ -303,6 +528,58 @@ Zf(trim_i8_decode)(
 	return in_len;
 }
 
+/*
+ * The compressed format (comp_encode() and comp_decode()) encodes each
+ * value as a sign bit, the low 7 bits of the absolute value, then the
+ * high bits in unary (as many zeros, then a one). The encoder and the
+ * decoder work on a 64-bit buffer: on the decoder side, the unary part
+ * is read with a count of leading zeros, and the buffer is refilled
+ * with 8 bytes at a time except near the end of the input.
+ *
+ * comp_clz16() returns the number of leading zeros of a 64-bit word
+ * whose top 16 bits are not all zero. It is a single instruction (LZCNT
+ * or BSR on x86, CLZ on ARM) with GCC and Clang; other compilers use a
+ * table for the number of leading zeros of a byte.
+ */
+#if defined __GNUC__ || defined __clang__
+
+#define comp_clz16(x)   ((unsigned)__builtin_clzll(x))
+
+#else
+
+static const uint8_t comp_clz8[] = {
+	8, 7, 6, 6, 5, 5, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+static inline unsigned
+comp_clz16(uint64_t x)
+{
+	unsigned t;
+
+	t = (unsigned)(x >> 56);
+	if (t != 0) {
+		return comp_clz8[t];
+	}
+	return 8 + comp_clz8[(unsigned)(x >> 48) & 0xFF];
+}
+
+#endif
+
 /* see inner.h */
 size_t
 Zf(comp_encode)(
@@ -311,7 +588,7 @@ Zf(comp_encode)(
 {
 	uint8_t *buf;
 	size_t n, u, v;
-	uint32_t acc;
+	uint64_t acc;
 	unsigned acc_len;
 
 	n = (size_t)1 << logn;
@@ -331,70 +608,61 @@ Zf(comp_encode)(
 	v = 0;
 	for (u = 0; u < n; u ++) {
 		int t;
-		unsigned w;
+		unsigned s, w, hi;
 
 		/*
-		 * Get sign and absolute value of next integer; push the
-		 * sign bit.
+		 * Sign bit and low 7 bits of the absolute value, then
+		 * hi zeros and a one. Since the absolute value is at most
+		 * 2047, hi is at most 15, and the code is at most 24 bits.
 		 */
-		acc <<= 1;
 		t = x[u];
-		if (t < 0) {
-			t = -t;
-			acc |= 1;
-		}
-		w = (unsigned)t;
+		s = (unsigned)t >> (sizeof(int) * 8 - 1);
+		w = ((unsigned)t ^ -s) + s;
+		hi = w >> 7;
+		acc = (acc << (hi + 9))
+			| ((uint64_t)((s << 7) | (w & 127u)) << (hi + 1)) | 1;
+		acc_len += hi + 9;
 
 		/*
-		 * Push the low 7 bits of the absolute value.
+		 * Produce 32 bits when available; at most 31 bits are left
+		 * pending, so the accumulator never holds more than 55
+		 * useful bits.
 		 */
-		acc <<= 7;
-		acc |= w & 127u;
-		w >>= 7;
-
-		/*
-		 * We pushed exactly 8 bits.
-		 */
-		acc_len += 8;
-
-		/*
-		 * Push as many zeros as necessary, then a one. Since the
-		 * absolute value is at most 2047, w can only range up to
-		 * 15 at this point, thus we will add at most 16 bits
-		 * here. With the 8 bits above and possibly up to 7 bits
-		 * from previous iterations, we may go up to 31 bits, which
-		 * will fit in the accumulator, which is an uint32_t.
-		 */
-		acc <<= (w + 1);
-		acc |= 1;
-		acc_len += w + 1;
-
-		/*
-		 * Produce all full bytes.
-		 */
-		while (acc_len >= 8) {
-			acc_len -= 8;
+		if (acc_len >= 32) {
+			acc_len -= 32;
 			if (buf != NULL) {
-				if (v >= max_out_len) {
+				uint32_t y;
+
+				if (max_out_len - v < 4) {
 					return 0;
 				}
-				buf[v] = (uint8_t)(acc >> acc_len);
+				y = (uint32_t)(acc >> acc_len);
+				buf[v] = (uint8_t)(y >> 24);
+				buf[v + 1] = (uint8_t)(y >> 16);
+				buf[v + 2] = (uint8_t)(y >> 8);
+				buf[v + 3] = (uint8_t)y;
 			}
-			v ++;
+			v += 4;
 		}
 	}
 
 	/*
-	 * Flush remaining bits (if any).
+	 * Flush remaining bits (if any), padding the last byte with
+	 * zeros.
 	 */
-	if (acc_len > 0) {
+	while (acc_len > 0) {
 		if (buf != NULL) {
 			if (v >= max_out_len) {
 				return 0;
 			}
-			buf[v] = (uint8_t)(acc << (8 - acc_len));
+			if (acc_len >= 8) {
+				buf[v] = (uint8_t)(acc >> (acc_len - 8));
+			} else {
+				buf[v] = (uint8_t)(acc << (8 - acc_len));
+			}
 		}
 		v ++;
+		acc_len = acc_len >= 8 ? acc_len - 8 : 0;
 	}
 
 	return v;
@@ -408,68 +676,94 @@ Zf(comp_decode)(
 {
 	const uint8_t *buf;
 	size_t n, u, v;
-	uint32_t acc;
+	uint64_t acc;
 	unsigned acc_len;
 
 	n = (size_t)1 << logn;
 	buf = in;
+
+	/*
+	 * The acc_len next bits are the top bits of acc, and v bytes have
+	 * been loaded. With the 8-byte refill, the bits after the first
+	 * acc_len ones may already hold the start of the next byte; all
+	 * other bits are zero.
+	 */
 	acc = 0;
 	acc_len = 0;
 	v = 0;
 	for (u = 0; u < n; u ++) {
-		unsigned b, s, m;
+		unsigned b, s, m, z;
+
+		if (max_in_len - v >= 8) {
+			acc |= (((uint64_t)buf[v] << 56)
+				| ((uint64_t)buf[v + 1] << 48)
+				| ((uint64_t)buf[v + 2] << 40)
+				| ((uint64_t)buf[v + 3] << 32)
+				| ((uint64_t)buf[v + 4] << 24)
+				| ((uint64_t)buf[v + 5] << 16)
+				| ((uint64_t)buf[v + 6] << 8)
+				| (uint64_t)buf[v + 7]) >> acc_len;
+			v += (63 - acc_len) >> 3;
+			acc_len |= 56;
+		} else {
+			while (acc_len <= 56 && v < max_in_len) {
+				acc |= (uint64_t)buf[v ++] << (56 - acc_len);
+				acc_len += 8;
+			}
+		}
 
 		/*
 		 * Get next eight bits: sign and low seven bits of the
 		 * absolute value.
 		 */
-		if (v >= max_in_len) {
+		if (acc_len < 8) {
 			return 0;
 		}
-		acc = (acc << 8) | (uint32_t)buf[v ++];
-		b = acc >> acc_len;
+		b = (unsigned)(acc >> 56);
 		s = b & 128;
 		m = b & 127;
+		acc <<= 8;
+		acc_len -= 8;
 
 		/*
-		 * Get next bits until a 1 is reached.
+		 * Get the unary high part: z zeros then a one. There must
+		 * be at most 15 zeros (the absolute value is at most 2047),
+		 * and the one must be within the input.
 		 */
-		for (;;) {
-			if (acc_len == 0) {
-				if (v >= max_in_len) {
-					return 0;
-				}
-				acc = (acc << 8) | (uint32_t)buf[v ++];
-				acc_len = 8;
-			}
-			acc_len --;
-			if (((acc >> acc_len) & 1) != 0) {
-				break;
-			}
-			m += 128;
-			if (m > 2047) {
-				return 0;
-			}
+		if ((acc >> 48) == 0) {
+			return 0;
+		}
+		z = comp_clz16(acc);
+		if (z >= acc_len) {
+			return 0;
 		}
+		m += z << 7;
+		if (m > 2047) {
+			return 0;
+		}
+		acc <<= z + 1;
+		acc_len -= z + 1;
 
 		/*
-		 * "-0" is forbidden.
+		 * "-0" is forbidden. The sign is applied without a branch,
+		 * since it is not predictable.
 		 */
-		if (s && m == 0) {
+		if (m == 0 && s != 0) {
 			return 0;
 		}
-
-		x[u] = (int16_t)(s ? -(int)m : (int)m);
+		s = -(s >> 7);
+		x[u] = (int16_t)((m ^ s) - s);
 	}
 
 	/*
-	 * Unused bits in the last byte must be zero.
+	 * Unused bits in the last byte must be zero. The (acc_len >> 3)
+	 * last loaded bytes were not used.
 	 */
-	if ((acc & ((1u << acc_len) - 1u)) != 0) {
+	if ((acc_len & 7) != 0 && (acc >> (64 - (acc_len & 7))) != 0) {
 		return 0;
 	}
 
-	return v;
+	return v - (acc_len >> 3);
 }
 
 /*
@@ -573,3 +867,5 @@ const uint8_t Zf(max_sig_bits)[] = {
 	12,
 	12
 };
+
+#endif
@@ -66,89 +66,64 @@ Zf(hash_to_point_vartime)(
 	}
 }
 
-/* see inner.h */
-void
-Zf(hash_to_point_ct)(
-	inner_shake256_context *sc,
-	uint16_t *x, unsigned logn, uint8_t *tmp)
+/*
+ * Oversampling in Zf(hash_to_point_ct)(), indexed by logn.
+ */
+static const uint16_t overtab[] = {
+	0, /* unused */
+	65,
+	67,
+	71,
+	77,
+	86,
+	100,
+	122,
+	154,
+	205,
+	287
+};
+
+/*
+ * Reduce the 16-bit sample w modulo q, or set it to 0xFFFF if it is
+ * rejected, and store it as value u (in x[], tt1[] or tt2[], see
+ * Zf(hash_to_point_ct)()). This is constant-time.
+ */
+static inline void
+htp_ct_put(uint16_t *x, uint16_t *tt1, uint16_t *tt2,
+	unsigned n, unsigned u, uint32_t w)
 {
-	/*
-	 * Each 16-bit sample is a value in 0..65535. The value is
-	 * kept if it falls in 0..61444 (because 61445 = 5*12289)
-	 * and rejected otherwise; thus, each sample has probability
-	 * about 0.93758 of being selected.
-	 *
-	 * We want to oversample enough to be sure that we will
-	 * have enough values with probability at least 1 - 2^(-256).
-	 * Depending on degree N, this leads to the following
-	 * required oversampling:
-	 *
-	 *   logn     n  oversampling
-	 *     1      2     65
-	 *     2      4     67
-	 *     3      8     71
-	 *     4     16     77
-	 *     5     32     86
-	 *     6     64    100
-	 *     7    128    122
-	 *     8    256    154
-	 *     9    512    205
-	 *    10   1024    287
-	 *
-	 * If logn >= 7, then the provided temporary buffer is large
-	 * enough. Otherwise, we use a stack buffer of 63 entries
-	 * (i.e. 126 bytes) for the values that do not fit in tmp[].
-	 */
+	uint32_t wr;
 
-	static const uint16_t overtab[] = {
-		0, /* unused */
-		65,
-		67,
-		71,
-		77,
-		86,
-		100,
-		122,
-		154,
-		205,
-		287
-	};
+	wr = w - ((uint32_t)24578 & (((w - 24578) >> 31) - 1));
+	wr = wr - ((uint32_t)24578 & (((wr - 24578) >> 31) - 1));
+	wr = wr - ((uint32_t)12289 & (((wr - 12289) >> 31) - 1));
+	wr |= ((w - 61445) >> 31) - 1;
+	if (u < n) {
+		x[u] = (uint16_t)wr;
+	} else if (u < (n << 1)) {
+		tt1[u - n] = (uint16_t)wr;
+	} else {
+		tt2[u - (n << 1)] = (uint16_t)wr;
+	}
+}
 
+/*
+ * Remove the invalid values from the n + overtab[logn] values in x[],
+ * tt1[] and tt2[] (see Zf(hash_to_point_ct)()); the n first valid
+ * values end up in x[].
+ */
+static void
+htp_ct_squeeze(uint16_t *x, uint16_t *tt1, uint16_t *tt2, unsigned logn)
+{
 	unsigned n, n2, u, m, p, over;
-	uint16_t *tt1, tt2[63];
 
-	/*
-	 * We first generate m 16-bit value. Values 0..n-1 go to x[].
-	 * Values n..2*n-1 go to tt1[]. Values 2*n and later go to tt2[].
-	 * We also reduce modulo q the values; rejected values are set
-	 * to 0xFFFF.
-	 */
 	n = 1U << logn;
 	n2 = n << 1;
 	over = overtab[logn];
 	m = n + over;
-	tt1 = (uint16_t *)tmp;
-	for (u = 0; u < m; u ++) {
-		uint8_t buf[2];
-		uint32_t w, wr;
-
-		inner_shake256_extract(sc, buf, sizeof buf);
-		w = ((uint32_t)buf[0] << 8) | (uint32_t)buf[1];
-		wr = w - ((uint32_t)24578 & (((w - 24578) >> 31) - 1));
-		wr = wr - ((uint32_t)24578 & (((wr - 24578) >> 31) - 1));
-		wr = wr - ((uint32_t)12289 & (((wr - 12289) >> 31) - 1));
-		wr |= ((w - 61445) >> 31) - 1;
-		if (u < n) {
-			x[u] = (uint16_t)wr;
-		} else if (u < n2) {
-			tt1[u - n] = (uint16_t)wr;
-		} else {
-			tt2[u - n2] = (uint16_t)wr;
-		}
-	}
 
 	/*
-	 * Now we must "squeeze out" the invalid values. We do this in
+	 * We must "squeeze out" the invalid values. We do this in
 	 * a logarithmic sequence of passes; each pass computes where a
 	 * value should go, and moves it down by 'p' slots if necessary,
 	 * where 'p' uses an increasing powers-of-two scale. It can be
@@ -233,6 +208,154 @@ Zf(hash_to_point_ct)(
 	}
 }
 
+/* see inner.h */
+void
+Zf(hash_to_point_ct)(
+	inner_shake256_context *sc,
+	uint16_t *x, unsigned logn, uint8_t *tmp)
+{
+	/*
+	 * Each 16-bit sample is a value in 0..65535. The value is
+	 * kept if it falls in 0..61444 (because 61445 = 5*12289)
+	 * and rejected otherwise; thus, each sample has probability
+	 * about 0.93758 of being selected.
+	 *
+	 * We want to oversample enough to be sure that we will
+	 * have enough values with probability at least 1 - 2^(-256).
+	 * Depending on degree N, this leads to the following
+	 * required oversampling:
+	 *
+	 *   logn     n  oversampling
+	 *     1      2     65
+	 *     2      4     67
+	 *     3      8     71
+	 *     4     16     77
+	 *     5     32     86
+	 *     6     64    100
+	 *     7    128    122
+	 *     8    256    154
+	 *     9    512    205
+	 *    10   1024    287
+	 *
+	 * (see overtab[]). If logn >= 7, then the provided temporary
+	 * buffer is large enough. Otherwise, we use a stack buffer of
+	 * 63 entries (i.e. 126 bytes) for the values that do not fit
+	 * in tmp[].
+	 */
+
+	unsigned n, m, u;
+	uint16_t *tt1, tt2[63];
+
+	/*
+	 * We first generate m 16-bit value. Values 0..n-1 go to x[].
+	 * Values n..2*n-1 go to tt1[]. Values 2*n and later go to tt2[].
+	 * We also reduce modulo q the values; rejected values are set
+	 * to 0xFFFF.
+	 */
+	n = 1U << logn;
+	m = n + overtab[logn];
+	tt1 = (uint16_t *)tmp;
+	for (u = 0; u < m; u ++) {
+		uint8_t buf[2];
+
+		inner_shake256_extract(sc, buf, sizeof buf);
+		htp_ct_put(x, tt1, tt2, n, u,
+			((uint32_t)buf[0] << 8) | (uint32_t)buf[1]);
+	}
+	htp_ct_squeeze(x, tt1, tt2, logn);
+}
+
+/* see inner.h */
+void
+Zf(hash_to_point_batch)(inner_shake256_context *const *sc,
+	uint16_t *const *x, size_t num, unsigned logn, int ct, uint8_t *tmp)
+{
+	/*
+	 * The output blocks of all contexts of a group are computed
+	 * together; each block yields 68 samples per context, processed
+	 * as in Zf(hash_to_point_vartime)() or Zf(hash_to_point_ct)().
+	 * The group is done when every context has its m samples (m = n
+	 * valid samples in the variable-time case, m = n + overtab[logn]
+	 * samples in the constant-time case).
+	 */
+	unsigned n, m;
+	size_t i;
+
+	n = 1U << logn;
+	m = ct ? n + overtab[logn] : n;
+	for (i = 0; i < num; i += INNER_SHAKE256_LANES) {
+		inner_shake256_x_context sx;
+		uint16_t tt2[INNER_SHAKE256_LANES][63];
+		unsigned cnt[INNER_SHAKE256_LANES];
+		unsigned k, l, done;
+
+		k = (num - i) < INNER_SHAKE256_LANES
+			? (unsigned)(num - i) : INNER_SHAKE256_LANES;
+		if (!Zf(i_shake256_x_init)(&sx,
+			(const inner_shake256_context *const *)(sc + i), k))
+		{
+			for (l = 0; l < k; l ++) {
+				if (ct) {
+					Zf(hash_to_point_ct)(sc[i + l],
+						x[i + l], logn, tmp);
+				} else {
+					Zf(hash_to_point_vartime)(sc[i + l],
+						x[i + l], logn);
+				}
+			}
+			continue;
+		}
+		for (l = 0; l < k; l ++) {
+			cnt[l] = 0;
+		}
+		done = 0;
+		while (done < k) {
+			Zf(i_shake256_x_next)(&sx);
+			for (l = 0; l < k; l ++) {
+				uint16_t *xl, *tt1;
+				unsigned j;
+
+				if (cnt[l] >= m) {
+					continue;
+				}
+				xl = x[i + l];
+				tt1 = (uint16_t *)tmp + (size_t)n * l;
+				for (j = 0; j < 68 && cnt[l] < m; j ++) {
+					uint64_t z;
+					uint32_t w;
+
+					z = sx.A[(j >> 2) * INNER_SHAKE256_LANES
+						+ l] >> ((j & 3) << 4);
+					w = ((uint32_t)(z & 0xFF) << 8)
+						| (uint32_t)((z >> 8) & 0xFF);
+					if (ct) {
+						htp_ct_put(xl, tt1, tt2[l],
+							n, cnt[l] ++, w);
+					} else if (w < 61445) {
+						/*
+						 * A division by a constant is
+						 * cheaper than the data-dependent
+						 * subtraction loop, which is
+						 * mispredicted most of the time.
+						 */
+						xl[cnt[l] ++] = (uint16_t)(w % 12289);
+					}
+				}
+				if (cnt[l] >= m) {
+					done ++;
+				}
+			}
+		}
+		if (ct) {
+			for (l = 0; l < k; l ++) {
+				htp_ct_squeeze(x[i + l],
+					(uint16_t *)tmp + (size_t)n * l,
+					tt2[l], logn);
+			}
+		}
+	}
+}
+
 /*
  * Acceptance bound for the (squared) l2-norm of the signature depends
  * on the degree. This array is indexed by logn (1 to 10). These bounds
@@ -279,9 +402,15 @@ Zf(is_short)(
 		ng |= s;
 	}
 	s |= -(ng >> 31);
+	return Zf(is_short_sqnorm)(s, logn);
+}
 
+/* see inner.h */
+int
+Zf(is_short_sqnorm)(uint32_t sqn, unsigned logn)
+{
     // TODO!! we had to tweak the verifier's bound :(
-	if (s <= 3*l2bound[logn]) {
+	if (sqn <= 3*l2bound[logn]) {
         return 1;
     } else {
         return 0;
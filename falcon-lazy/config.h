@@ -88,6 +88,26 @@
 #define FALCON_FPEMU   1
  */
 
+/*
+ * Variant of the emulated floating-point code for 64-bit hosts: the
+ * products use the unsigned __int128 type (a single 64x64->128
+ * multiplication, e.g. MUL or MULX on x86-64, MUL/UMULH on ARMv8),
+ * normalization uses __builtin_clzll(), shifts are plain 64-bit
+ * shifts, and the division uses a Newton-Raphson reciprocal instead of
+ * a bit-by-bit loop. Results are the same as with the generic emulated
+ * code. It is constant-time provided that the 64x64->128 multiplication,
+ * the count of leading zeros (LZCNT or BSR on x86, CLZ on ARM) and
+ * 64-bit shifts by a secret count are constant-time, which is the case
+ * on current x86-64 and ARMv8 cores.
+ *
+ * By default, it is used with FALCON_FPEMU when the compiler supports
+ * unsigned __int128 (GCC and Clang on 64-bit targets), unless
+ * FALCON_ASM_CORTEXM4 is enabled. Define it to 0 to use the generic
+ * emulated code.
+ *
+#define FALCON_FPEMU64   1
+ */
+
 /*
  * Enable use of assembly for ARM Cortex-M4 CPU. By default, such
  * support will be used based on some autodection on the compiler
@@ -111,6 +131,18 @@
 #define FALCON_ASM_CORTEXM4   1
  */
 
+/*
+ * Use the Keccak-f[1600] code for x86-64 (keccak_x64.h, shared with the
+ * Dilithium code) for SHAKE256. By default, it is used with GCC and
+ * Clang on x86-64; define this variable to 0 to use the portable code
+ * instead. With FALCON_AVX2 (and in the AVX2 and AVX-512 backends of
+ * FALCON_DISPATCH), the permutation is also compiled for BMI1 and BMI2
+ * (which all x86 CPUs with AVX2 support), and is then about 20% faster
+ * than the portable code.
+ *
+#define FALCON_KECCAK_X64   1
+ */
+
 /*
  * Enable use of AVX2 intrinsics. If enabled, then the code will compile
  * only when targeting x86 with a compiler that supports AVX2 intrinsics
@@ -134,6 +166,48 @@
 #define FALCON_FMA   1
  */
 
+/*
+ * Enable use of AVX-512F/DQ intrinsics. This implies FALCON_AVX2 and
+ * FALCON_FMA: the FFT layers, the polynomial operations in FFT
+ * representation and the ChaCha20-based PRNG then use 512-bit
+ * registers where the data is wide enough, and the AVX2 code
+ * elsewhere. Results are identical to those of the AVX2+FMA build. The
+ * code will run only on systems that offer AVX-512F and AVX-512DQ.
+ *
+#define FALCON_AVX512   1
+ */
+
+/*
+ * Select the SIMD code at runtime instead of compile time. The kernels
+ * that have AVX2 or AVX-512 code (FFT and polynomial operations in FFT
+ * representation, ChaCha20 PRNG refill, Gaussian samplers, mod q NTT,
+ * batch signature verification, fixed-width encoding of keys) are
+ * then compiled once per backend (portable, AVX2+FMA, AVX-512), and
+ * the best one supported by the CPU is chosen when the library is
+ * loaded (see falcon_get_backend() and falcon_set_backend() in
+ * falcon.h).
+ * The rest of the library is compiled as portable code, so that a
+ * single binary runs on any x86 CPU. This setting overrides
+ * FALCON_AVX2, FALCON_FMA and FALCON_AVX512; it requires GCC or Clang
+ * on x86, and native floating-point.
+ *
+#define FALCON_DISPATCH   1
+ */
+
+/*
+ * Do the reduction against the basis in the lazy online phase
+ * (falcon_sign_lazy_online()) in single precision: two FFT, the basis
+ * product and one iFFT then use 8-lane AVX2 registers instead of
+ * 4-lane. The result is checked, and the reduction is redone in double
+ * precision when a value is too close to a rounding boundary, so that
+ * signatures are unchanged (see LAZY_F32 in inner.h). The batched
+ * online phase is not affected. This is a gain only with the AVX2 code
+ * (the portable code is slower in single precision, because of the
+ * conversions); it has no effect with FALCON_FPEMU.
+ *
+#define FALCON_LAZY_F32   1
+ */
+
 /*
  * Assert that the platform uses little-endian encoding. If enabled,
  * then encoding and decoding of aligned multibyte values will be
@@ -0,0 +1,165 @@
+/*
+ * Reentrant signer contexts for the lazy (online/offline) signer.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stdlib.h>
+
+#include "falcon.h"
+#include "inner.h"
+
+struct falcon_lazy_ctx_ {
+	unsigned logn;
+
+	/*
+	 * Lazy expanded key (not owned, read-only).
+	 */
+	const void *expkey;
+
+	/*
+	 * PRNG for the token nonces and the Gaussian samples.
+	 */
+	shake256_context rng;
+
+	/*
+	 * Work buffer: one token (8-byte aligned, so that it is read in
+	 * place), followed by the temporary area for both phases.
+	 */
+	uint8_t *buf;
+	uint8_t *token;
+	uint8_t *tmp;
+	size_t token_len, tmp_len;
+};
+
+/* see falcon.h */
+int
+falcon_lazy_ctx_new(falcon_lazy_ctx **ctx, shake256_context *rng,
+	const void *expanded_key)
+{
+	falcon_lazy_ctx *c;
+	unsigned logn;
+	uint8_t seed[48];
+
+	*ctx = NULL;
+	logn = *(const uint8_t *)expanded_key;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+
+	c = calloc(1, sizeof *c);
+	if (c == NULL) {
+		return FALCON_ERR_INTERNAL;
+	}
+	c->logn = logn;
+	c->expkey = expanded_key;
+	c->token_len = FALCON_LAZY_TOKEN_SIZE(logn);
+	c->tmp_len = FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn);
+	if (c->tmp_len < FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn)) {
+		c->tmp_len = FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn);
+	}
+
+	/*
+	 * malloc() returns memory suitably aligned for any type, and the
+	 * token size is a multiple of 8.
+	 */
+	c->buf = malloc(c->token_len + c->tmp_len);
+	if (c->buf == NULL) {
+		free(c);
+		return FALCON_ERR_INTERNAL;
+	}
+	c->token = c->buf;
+	c->tmp = c->buf + c->token_len;
+
+	shake256_extract(rng, seed, sizeof seed);
+	shake256_init_prng_from_seed(&c->rng, seed, sizeof seed);
+	memset(seed, 0, sizeof seed);
+	*ctx = c;
+	return 0;
+}
+
+/* see falcon.h */
+void
+falcon_lazy_ctx_free(falcon_lazy_ctx *ctx)
+{
+	if (ctx == NULL) {
+		return;
+	}
+	memset(ctx->buf, 0, ctx->token_len + ctx->tmp_len);
+	free(ctx->buf);
+	memset(ctx, 0, sizeof *ctx);
+	free(ctx);
+}
+
+/* see falcon.h */
+unsigned
+falcon_lazy_ctx_get_logn(const falcon_lazy_ctx *ctx)
+{
+	return ctx->logn;
+}
+
+/* see falcon.h */
+int
+falcon_lazy_ctx_offline(falcon_lazy_ctx *ctx, void *token, size_t token_len)
+{
+	return falcon_sign_lazy_offline(&ctx->rng, token, token_len,
+		ctx->expkey, ctx->tmp, ctx->tmp_len);
+}
+
+/* see falcon.h */
+int
+falcon_lazy_ctx_online(falcon_lazy_ctx *ctx,
+	void *sig, size_t *sig_len, int sig_type,
+	void *token, size_t token_len,
+	const void *data, size_t data_len)
+{
+	return falcon_sign_lazy_online(sig, sig_len, sig_type,
+		ctx->expkey, token, token_len, data, data_len,
+		ctx->tmp, ctx->tmp_len);
+}
+
+/*
+ * Token source for falcon_lazy_ctx_sign(): a new token, computed in
+ * the context's own buffer.
+ */
+static int
+ctx_next_token(void *arg, uint8_t **token)
+{
+	falcon_lazy_ctx *ctx;
+
+	ctx = arg;
+	*token = ctx->token;
+	return falcon_lazy_ctx_offline(ctx, ctx->token, ctx->token_len);
+}
+
+/* see falcon.h */
+int
+falcon_lazy_ctx_sign(falcon_lazy_ctx *ctx,
+	void *sig, size_t *sig_len, int sig_type,
+	const void *data, size_t data_len)
+{
+	return Zf(lazy_sign_tokens)(sig, sig_len, sig_type,
+		ctx->expkey, ctx->logn, &ctx_next_token, ctx, ctx->token_len,
+		data, data_len, ctx->tmp, ctx->tmp_len);
+}
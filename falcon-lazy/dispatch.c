@@ -0,0 +1,335 @@
+/*
+ * Runtime selection of the SIMD kernels (FALCON_DISPATCH).
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "falcon.h"
+#include "inner.h"
+
+static const char *const backend_names[] = {
+	"auto", "ref", "avx2", "avx512"
+};
+
+/* see falcon.h */
+const char *
+falcon_backend_name(int backend)
+{
+	if (backend < FALCON_BACKEND_AUTO || backend > FALCON_BACKEND_AVX512) {
+		return NULL;
+	}
+	return backend_names[backend];
+}
+
+#if FALCON_DISPATCH
+
+/*
+ * List of the dispatched kernels: return type, "return" keyword (empty
+ * for void functions), name, parameters, arguments. Each kernel is
+ * defined in fft.c, rng.c, sampler.c, shake.c, vrfy.c or codec.c with
+ * Zk(); the copies are named Zf(name_ref), Zf(name_avx2) and
+ * Zf(name_avx512).
+ */
+#define KERNELS(K) \
+	K(void, , FFT, (fpr *f, unsigned logn), (f, logn)) \
+	K(void, , iFFT, (fpr *f, unsigned logn), (f, logn)) \
+	K(void, , FFT_generic, (fpr *f, unsigned logn), (f, logn)) \
+	K(void, , iFFT_generic, (fpr *f, unsigned logn), (f, logn)) \
+	K(void, , poly_add, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_sub, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_neg, (fpr *a, unsigned logn), (a, logn)) \
+	K(void, , poly_adj_fft, (fpr *a, unsigned logn), (a, logn)) \
+	K(void, , poly_mul_fft, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_muladj_fft, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_mulselfadj_fft, (fpr *a, unsigned logn), (a, logn)) \
+	K(void, , poly_mulconst, (fpr *a, fpr x, unsigned logn), \
+		(a, x, logn)) \
+	K(void, , poly_div_fft, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_invnorm2_fft, (fpr *restrict d, \
+		const fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(d, a, b, logn)) \
+	K(void, , poly_add_muladj_fft, (fpr *restrict d, \
+		const fpr *restrict F, const fpr *restrict G, \
+		const fpr *restrict f, const fpr *restrict g, unsigned logn), \
+		(d, F, G, f, g, logn)) \
+	K(void, , poly_mul_autoadj_fft, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_div_autoadj_fft, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_LDL_fft, (const fpr *restrict g00, \
+		fpr *restrict g01, fpr *restrict g11, unsigned logn), \
+		(g00, g01, g11, logn)) \
+	K(void, , poly_LDLmv_fft, (fpr *restrict d11, fpr *restrict l10, \
+		const fpr *restrict g00, const fpr *restrict g01, \
+		const fpr *restrict g11, unsigned logn), \
+		(d11, l10, g00, g01, g11, logn)) \
+	K(void, , poly_split_fft, (fpr *restrict f0, fpr *restrict f1, \
+		const fpr *restrict f, unsigned logn), \
+		(f0, f1, f, logn)) \
+	K(void, , poly_merge_fft, (fpr *restrict f, \
+		const fpr *restrict f0, const fpr *restrict f1, unsigned logn), \
+		(f, f0, f1, logn)) \
+	K(void, , FFT_x4, (fpr *f, unsigned logn), (f, logn)) \
+	K(void, , iFFT_x4, (fpr *f, unsigned logn), (f, logn)) \
+	K(void, , poly_mul_fft_x4, \
+		(fpr *restrict a, const fpr *restrict b, unsigned logn), \
+		(a, b, logn)) \
+	K(void, , poly_basis_set, (fpr *restrict B, \
+		const fpr *restrict a, int k, unsigned logn), \
+		(B, a, k, logn)) \
+	K(void, , poly_basis_solve_fft, (fpr *restrict y1, \
+		fpr *restrict y2, const fpr *restrict B, unsigned logn), \
+		(y1, y2, B, logn)) \
+	K(void, , poly_basis_mul_fft, (fpr *restrict y1, \
+		fpr *restrict y2, const fpr *restrict B, unsigned logn), \
+		(y1, y2, B, logn)) \
+	K(void, , poly_basis_mul2_fft, (const fpr *restrict y1, \
+		fpr *restrict y2, const fpr *restrict B, unsigned logn), \
+		(y1, y2, B, logn)) \
+	K(void, , poly_basis_mul2_fft_x4, (const fpr *restrict y1, \
+		fpr *restrict y2, const fpr *restrict B, unsigned logn), \
+		(y1, y2, B, logn)) \
+	K(void, , FFT32, (float *f, unsigned logn), (f, logn)) \
+	K(void, , iFFT32, (float *f, unsigned logn), (f, logn)) \
+	K(void, , poly_basis_mul_fft32, (float *restrict y1, \
+		float *restrict y2, const fpr *restrict B, unsigned logn), \
+		(y1, y2, B, logn)) \
+	K(void, , poly_basis_mul2_fft32, (const float *restrict y1, \
+		float *restrict y2, const fpr *restrict B, unsigned logn), \
+		(y1, y2, B, logn)) \
+	K(void, , mq_NTT, (uint16_t *a, unsigned logn), (a, logn)) \
+	K(void, , mq_iNTT, (uint16_t *a, unsigned logn), (a, logn)) \
+	K(void, , mq_poly_montymul_ntt, \
+		(uint16_t *f, const uint16_t *g, unsigned logn), \
+		(f, g, logn)) \
+	K(void, , mq_poly_tomonty, (uint16_t *f, unsigned logn), (f, logn)) \
+	K(void, , verify_raw_batch, (const uint16_t *const *c0, \
+		const int16_t *const *s2, const uint16_t *h, unsigned logn, \
+		int *res, size_t num, uint8_t *tmp), \
+		(c0, s2, h, logn, res, num, tmp)) \
+	K(size_t, return, codec_unpack, (void *x, size_t n, unsigned bits, \
+		int kind, const uint8_t *buf, size_t in_len, int *bad), \
+		(x, n, bits, kind, buf, in_len, bad)) \
+	K(size_t, return, codec_pack, (uint8_t *buf, size_t out_len, \
+		unsigned bits, int kind, const void *x, size_t n), \
+		(buf, out_len, bits, kind, x, n)) \
+	K(void, , prng_refill, (prng *p), (p)) \
+	K(void, , keccak_multi, (uint64_t *A, unsigned num), (A, num)) \
+	K(size_t, return, sample_bern_block, \
+		(int8_t *out, const uint8_t *rnd), (out, rnd)) \
+	K(int, return, gaussian0_sampler, (prng *p), (p)) \
+	K(int, return, sampler, (void *ctx, fpr mu, fpr isigma), \
+		(ctx, mu, isigma)) \
+	KERNELS_KECCAK(K)
+
+/*
+ * The single-state Keccak kernel exists only with the x86-64 code.
+ */
+#if FALCON_KECCAK_X64
+#define KERNELS_KECCAK(K) \
+	K(void, , keccak_f1600, (uint64_t *A), (A))
+#else
+#define KERNELS_KECCAK(K)
+#endif
+
+#define K_FIELD(type, ret, name, params, args) \
+	type (*name) params;
+#define K_DECL(type, ret, name, params, args) \
+	type Zf(name ## _ref) params; \
+	type Zf(name ## _avx2) params; \
+	type Zf(name ## _avx512) params;
+#define K_REF(type, ret, name, params, args)      Zf(name ## _ref),
+#define K_AVX2(type, ret, name, params, args)     Zf(name ## _avx2),
+#define K_AVX512(type, ret, name, params, args)   Zf(name ## _avx512),
+
+typedef struct {
+	int backend;
+	KERNELS(K_FIELD)
+} kernel_table;
+
+KERNELS(K_DECL)
+
+static const kernel_table kernels_ref = {
+	FALCON_BACKEND_REF, KERNELS(K_REF)
+};
+static const kernel_table kernels_avx2 = {
+	FALCON_BACKEND_AVX2, KERNELS(K_AVX2)
+};
+static const kernel_table kernels_avx512 = {
+	FALCON_BACKEND_AVX512, KERNELS(K_AVX512)
+};
+
+/*
+ * Selected table. It starts with the portable kernels, and is set by
+ * select_backend() when the library is loaded. Accesses are atomic so
+ * that falcon_set_backend() may be called at any time; a call already
+ * in progress may then use both backends, which is harmless (all
+ * kernels follow the same conventions, and the PRNG reserve is honoured
+ * by every refill).
+ */
+static const kernel_table *kernels = &kernels_ref;
+
+/*
+ * Get the most capable backend supported by the CPU (and the OS, for
+ * the register state).
+ */
+static int
+cpu_backend(void)
+{
+	__builtin_cpu_init();
+	if (!__builtin_cpu_supports("avx2")
+		|| !__builtin_cpu_supports("fma")
+		|| !__builtin_cpu_supports("bmi")
+		|| !__builtin_cpu_supports("bmi2"))
+	{
+		return FALCON_BACKEND_REF;
+	}
+	if (!__builtin_cpu_supports("avx512f")
+		|| !__builtin_cpu_supports("avx512dq"))
+	{
+		return FALCON_BACKEND_AVX2;
+	}
+	return FALCON_BACKEND_AVX512;
+}
+
+/* see falcon.h */
+int
+falcon_set_backend(int backend)
+{
+	const kernel_table *kt;
+	int max;
+
+	max = cpu_backend();
+	if (backend == FALCON_BACKEND_AUTO) {
+		backend = max;
+	}
+	if (backend < FALCON_BACKEND_REF || backend > max) {
+		return FALCON_ERR_BADARG;
+	}
+	switch (backend) {
+	case FALCON_BACKEND_AVX2:
+		kt = &kernels_avx2;
+		break;
+	case FALCON_BACKEND_AVX512:
+		kt = &kernels_avx512;
+		break;
+	default:
+		kt = &kernels_ref;
+		break;
+	}
+	__atomic_store_n(&kernels, kt, __ATOMIC_RELEASE);
+	return 0;
+}
+
+/* see falcon.h */
+int
+falcon_get_backend(void)
+{
+	return __atomic_load_n(&kernels, __ATOMIC_ACQUIRE)->backend;
+}
+
+/*
+ * Choose the backend when the library is loaded: the most capable one,
+ * unless the FALCON_BACKEND environment variable names another one
+ * (which must be supported).
+ */
+__attribute__((constructor))
+static void
+select_backend(void)
+{
+	const char *env;
+	int b;
+
+	env = getenv("FALCON_BACKEND");
+	if (env != NULL) {
+		for (b = FALCON_BACKEND_REF; b <= FALCON_BACKEND_AVX512; b ++) {
+			if (strcmp(env, backend_names[b]) == 0
+				&& falcon_set_backend(b) == 0)
+			{
+				return;
+			}
+		}
+	}
+	falcon_set_backend(FALCON_BACKEND_AUTO);
+}
+
+/*
+ * Dispatch stubs: the Zf() names declared in inner.h.
+ */
+#define K_STUB(type, ret, name, params, args) \
+	type \
+	Zf(name) params \
+	{ \
+		ret __atomic_load_n(&kernels, __ATOMIC_RELAXED)->name args; \
+	}
+
+KERNELS(K_STUB)
+
+#else
+
+/*
+ * Without runtime dispatch, the only backend is the one selected at
+ * compile time.
+ */
+#if FALCON_AVX512
+#define BUILD_BACKEND   FALCON_BACKEND_AVX512
+#elif FALCON_AVX2
+#define BUILD_BACKEND   FALCON_BACKEND_AVX2
+#else
+#define BUILD_BACKEND   FALCON_BACKEND_REF
+#endif
+
+/* see falcon.h */
+int
+falcon_get_backend(void)
+{
+	return BUILD_BACKEND;
+}
+
+/* see falcon.h */
+int
+falcon_set_backend(int backend)
+{
+	if (backend != FALCON_BACKEND_AUTO && backend != BUILD_BACKEND) {
+		return FALCON_ERR_BADARG;
+	}
+	return 0;
+}
+
+#endif
@@ -517,7 +517,7 @@ falcon_sign_dyn_lazy_finish(shake256_context *rng,
 	uint8_t *atmp;
 	size_t u, v; 
 	size_t n, es_len;
-	unsigned oldcw __attribute__((unused));
+	unsigned oldcw;
 	inner_shake256_context sav_hash_data;
 
 	/// adding some stuff to get rid of warnings
@@ -582,7 +582,8 @@ falcon_sign_dyn_lazy_finish(shake256_context *rng,
 	G = F + n;
 	hm = (uint16_t *)(G + n);
 	sv = (int16_t *)hm;
-	atmp = align_u64(hm + n);
+	h = hm + n;
+	atmp = align_u64(h + n);
 	u = 1;
 	v = Zf(trim_i8_decode)(f, logn, Zf(max_fg_bits)[logn],
 		sk + u, privkey_len - u);
@@ -610,7 +611,6 @@ falcon_sign_dyn_lazy_finish(shake256_context *rng,
 	}
 
 	pk = pubkey;
-	h = (uint16_t *)align_u16(tmp);
 	/*
 	 * Decode public key.
 	 */
@@ -651,7 +651,7 @@ falcon_sign_dyn_lazy_finish(shake256_context *rng,
 
 		Zf(sign_dyn_lazy)(sv, (inner_shake256_context *)rng,
 			f, g, F, G, h, hm, logn, atmp);
-				
+		set_fpu_cw(oldcw);
 		return 0;
 	}
 }
@@ -730,15 +730,599 @@ falcon_expand_privkey(void *expanded_key, size_t expanded_key_len,
 		return FALCON_ERR_FORMAT;
 	}
 
-	/*
-	 * Expand private key.
-	 */
-	*(uint8_t *)expanded_key = logn;
-	expkey = align_fpr((uint8_t *)expanded_key + 1);
-	oldcw = set_fpu_cw(2);
-	Zf(expand_privkey)(expkey, f, g, F, G, logn, atmp);
-	set_fpu_cw(oldcw);
-	return 0;
+	/*
+	 * Expand private key.
+	 */
+	*(uint8_t *)expanded_key = logn;
+	expkey = align_fpr((uint8_t *)expanded_key + 1);
+	oldcw = set_fpu_cw(2);
+	Zf(expand_privkey)(expkey, f, g, F, G, logn, atmp);
+	set_fpu_cw(oldcw);
+	return 0;
+}
+
+/* see falcon.h */
+int
+falcon_lazy_expand_key(void *expanded_key, size_t expanded_key_len,
+	const void *privkey, size_t privkey_len,
+	const void *pubkey, size_t pubkey_len,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+	const uint8_t *sk, *pk;
+	int8_t *f, *g, *F, *G;
+	uint16_t *h;
+	uint8_t *atmp;
+	size_t u, v, n;
+	fpr *expkey;
+	unsigned oldcw;
+
+	/*
+	 * Get degree from private key header byte, and check
+	 * parameters.
+	 */
+	if (privkey_len == 0 || pubkey_len == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	sk = privkey;
+	pk = pubkey;
+	if ((sk[0] & 0xF0) != 0x50 || (pk[0] & 0xF0) != 0x00) {
+		return FALCON_ERR_FORMAT;
+	}
+	logn = sk[0] & 0x0F;
+	if (logn < 1 || logn > 10 || (pk[0] & 0x0F) != logn) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (privkey_len != FALCON_PRIVKEY_SIZE(logn)
+		|| pubkey_len != FALCON_PUBKEY_SIZE(logn))
+	{
+		return FALCON_ERR_FORMAT;
+	}
+	if (expanded_key_len < FALCON_LAZY_EXPANDEDKEY_SIZE(logn)
+		|| tmp_len < FALCON_TMPSIZE_LAZYEXPAND(logn))
+	{
+		return FALCON_ERR_SIZE;
+	}
+
+	/*
+	 * Decode private key elements, and complete private key.
+	 */
+	n = (size_t)1 << logn;
+	h = (uint16_t *)align_u16(tmp);
+	f = (int8_t *)(h + n);
+	g = f + n;
+	F = g + n;
+	G = F + n;
+	atmp = align_u16(G + n);
+	u = 1;
+	v = Zf(trim_i8_decode)(f, logn, Zf(max_fg_bits)[logn],
+		sk + u, privkey_len - u);
+	if (v == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	u += v;
+	v = Zf(trim_i8_decode)(g, logn, Zf(max_fg_bits)[logn],
+		sk + u, privkey_len - u);
+	if (v == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	u += v;
+	v = Zf(trim_i8_decode)(F, logn, Zf(max_FG_bits)[logn],
+		sk + u, privkey_len - u);
+	if (v == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	u += v;
+	if (u != privkey_len) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (!Zf(complete_private)(G, f, g, F, logn, atmp)) {
+		return FALCON_ERR_FORMAT;
+	}
+
+	/*
+	 * Decode public key.
+	 */
+	if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
+		!= pubkey_len - 1)
+	{
+		return FALCON_ERR_FORMAT;
+	}
+
+	/*
+	 * Expand the key pair.
+	 */
+	*(uint8_t *)expanded_key = logn;
+	expkey = align_fpr((uint8_t *)expanded_key + 1);
+	oldcw = set_fpu_cw(2);
+	Zf(lazy_expand_key)(expkey, f, g, F, G, h, logn);
+	set_fpu_cw(oldcw);
+	return 0;
+}
+
+/* see inner.h */
+int
+Zf(lazy_decode_pubkey)(uint16_t *h,
+	const void *pubkey, size_t pubkey_len, unsigned logn)
+{
+	const uint8_t *pk;
+
+	pk = pubkey;
+	if (logn < 1 || logn > 10 || pubkey_len != FALCON_PUBKEY_SIZE(logn)
+		|| pk[0] != logn)
+	{
+		return FALCON_ERR_FORMAT;
+	}
+	if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
+		!= pubkey_len - 1)
+	{
+		return FALCON_ERR_FORMAT;
+	}
+	Zf(to_ntt_monty)(h, logn);
+	return 0;
+}
+
+/* see inner.h */
+const uint16_t *
+Zf(lazy_expkey_h)(const void *expanded_key)
+{
+	unsigned logn;
+
+	/*
+	 * The expanded key holds h in NTT + Montgomery representation
+	 * after the basis (see Zf(lazy_expand_key)()).
+	 */
+	logn = *(const uint8_t *)expanded_key;
+	return (const uint16_t *)((const fpr *)align_fpr(
+		(uint8_t *)expanded_key + 1) + LAZY_EXPKEY_FPR(logn));
+}
+
+/* see inner.h */
+int
+Zf(lazy_check_pubkey)(const void *expanded_key,
+	const void *pubkey, size_t pubkey_len, void *tmp)
+{
+	unsigned logn;
+	uint16_t *h;
+	int r;
+
+	logn = *(const uint8_t *)expanded_key;
+	h = (uint16_t *)align_u16(tmp);
+	r = Zf(lazy_decode_pubkey)(h, pubkey, pubkey_len, logn);
+	if (r != 0) {
+		return r;
+	}
+	return memcmp(h, Zf(lazy_expkey_h)(expanded_key),
+		((size_t)1 << logn) * sizeof *h) == 0 ? 0 : FALCON_ERR_BADARG;
+}
+
+/*
+ * Lazy token layout (falcon_sign_lazy_offline()):
+ *
+ *   offset         size       contents
+ *   0              1          logn (0 once the token is used)
+ *   1              7          padding (zero)
+ *   8              16*n       first Babai step for the token target
+ *                             (2*n fpr values, FFT representation)
+ *   8+16*n         208        SHAKE256 context, nonce injected
+ *   216+16*n       40         nonce
+ *   256+16*n       2*n        sample1, sample2
+ */
+#define LAZY_TK_YT           8
+#define LAZY_TK_HD(logn)     (LAZY_TK_YT + ((size_t)16 << (logn)))
+#define LAZY_TK_NONCE(logn)  (LAZY_TK_HD(logn) + sizeof(shake256_context))
+#define LAZY_TK_SAMPLE(logn) (LAZY_TK_NONCE(logn) + 40)
+
+/* see falcon.h */
+int
+falcon_sign_lazy_offline(shake256_context *rng,
+	void *token, size_t token_len,
+	const void *expanded_key,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+	const fpr *expkey;
+	uint8_t *tk;
+	fpr *yt;
+	int8_t *sample1, *sample2;
+	size_t n;
+	shake256_context hd;
+	unsigned oldcw;
+	int r;
+
+	logn = *(const uint8_t *)expanded_key;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (token_len < FALCON_LAZY_TOKEN_SIZE(logn)
+		|| tmp_len < FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn))
+	{
+		return FALCON_ERR_SIZE;
+	}
+	expkey = (const fpr *)align_fpr((uint8_t *)expanded_key + 1);
+
+	/*
+	 * Everything that does not depend on the message goes in the
+	 * token: the nonce and the hash context where it is injected,
+	 * the Gaussian samples, and the first Babai step for the
+	 * corresponding target. The latter is computed in tmp[] (for
+	 * alignment), then copied.
+	 */
+	tk = token;
+	r = falcon_sign_start(rng, tk + LAZY_TK_NONCE(logn), &hd);
+	if (r != 0) {
+		return r;
+	}
+	memcpy(tk + LAZY_TK_HD(logn), &hd, sizeof hd);
+	memset(&hd, 0, sizeof hd);
+
+	n = (size_t)1 << logn;
+	yt = align_fpr(tmp);
+	sample1 = (int8_t *)(yt + 2 * n);
+	sample2 = sample1 + n;
+	oldcw = set_fpu_cw(2);
+	Zf(sign_lazy_offline)((inner_shake256_context *)rng,
+		expkey, sample1, sample2, yt, logn);
+	set_fpu_cw(oldcw);
+	memcpy(tk + LAZY_TK_YT, yt, 2 * n * sizeof *yt);
+	memcpy(tk + LAZY_TK_SAMPLE(logn), sample1, 2 * n);
+	memset(yt, 0, 2 * n * sizeof *yt + 2 * n);
+	memset(tk + 1, 0, LAZY_TK_YT - 1);
+	tk[0] = logn;
+	return 0;
+}
+
+/* see inner.h */
+int
+Zf(lazy_check_sig)(size_t sig_len, int sig_type, unsigned logn)
+{
+	if (sig_len < 41) {
+		return FALCON_ERR_SIZE;
+	}
+	switch (sig_type) {
+	case FALCON_SIG_COMPRESSED:
+		return 0;
+	case FALCON_SIG_PADDED:
+		if (sig_len < FALCON_SIG_PADDED_SIZE(logn)) {
+			return FALCON_ERR_SIZE;
+		}
+		return 0;
+	case FALCON_SIG_CT:
+		if (sig_len < FALCON_SIG_CT_SIZE(logn)) {
+			return FALCON_ERR_SIZE;
+		}
+		return 0;
+	default:
+		return FALCON_ERR_BADARG;
+	}
+}
+
+/*
+ * Open a token for the online phase: mark it as used, locate the first
+ * Babai step (*yt) and the samples (*sample1, followed by sample2), and
+ * prepare in *hd the hash of the nonce and message (flipped, ready to be
+ * hashed to a point), from the hash context in the token. If token[] has
+ * 8-byte alignment, it is read in place; otherwise, it is copied into
+ * ytbuf[] (2*n fpr) and sbuf[] (2*n bytes).
+ */
+static void
+lazy_open_token(uint8_t *tk, unsigned logn,
+	const void *data, size_t data_len, shake256_context *hd,
+	const fpr **yt, const int8_t **sample1,
+	fpr *ytbuf, int8_t *sbuf)
+{
+	size_t n;
+
+	tk[0] = 0;
+	n = (size_t)1 << logn;
+	if (((uintptr_t)tk & 7) == 0) {
+		*yt = (const fpr *)(tk + LAZY_TK_YT);
+		*sample1 = (const int8_t *)(tk + LAZY_TK_SAMPLE(logn));
+	} else {
+		memcpy(ytbuf, tk + LAZY_TK_YT, 2 * n * sizeof *ytbuf);
+		memcpy(sbuf, tk + LAZY_TK_SAMPLE(logn), 2 * n);
+		*yt = ytbuf;
+		*sample1 = sbuf;
+	}
+
+	/*
+	 * The nonce is already in the hash context.
+	 */
+	memcpy(hd, tk + LAZY_TK_HD(logn), sizeof *hd);
+	shake256_inject(hd, data, data_len);
+	shake256_flip(hd);
+}
+
+/*
+ * Encode a lazy signature (with the nonce from the token), then clear
+ * the token and its copy, if any (see lazy_open_token()).
+ */
+static int
+lazy_finish_sig(void *sig, size_t *sig_len, int sig_type,
+	uint8_t *tk, const int16_t *sv, unsigned logn,
+	fpr *ytbuf, int8_t *sbuf)
+{
+	uint8_t *es;
+	size_t n, u, v, es_len;
+
+	n = (size_t)1 << logn;
+	es = sig;
+	es_len = *sig_len;
+	memcpy(es + 1, tk + LAZY_TK_NONCE(logn), 40);
+	memset(tk + 1, 0, FALCON_LAZY_TOKEN_SIZE(logn) - 1);
+	if (((uintptr_t)tk & 7) != 0) {
+		memset(ytbuf, 0, 2 * n * sizeof *ytbuf);
+		memset(sbuf, 0, 2 * n);
+	}
+	u = 41;
+	switch (sig_type) {
+		size_t tu;
+
+	case FALCON_SIG_COMPRESSED:
+		es[0] = 0x30 + logn;
+		v = Zf(comp_encode)(es + u, es_len - u, sv, logn);
+		if (v == 0) {
+			return FALCON_ERR_SIZE;
+		}
+		break;
+	case FALCON_SIG_PADDED:
+		es[0] = 0x30 + logn;
+		tu = FALCON_SIG_PADDED_SIZE(logn);
+		v = Zf(comp_encode)(es + u, tu - u, sv, logn);
+		if (v == 0) {
+			/*
+			 * Signature does not fit; the token is spent
+			 * anyway, the caller must retry with another.
+			 */
+			return FALCON_ERR_SIZE;
+		}
+		if (u + v < tu) {
+			memset(es + u + v, 0, tu - (u + v));
+			v = tu - u;
+		}
+		break;
+	default:
+		es[0] = 0x50 + logn;
+		v = Zf(trim_i16_encode)(es + u, es_len - u,
+			sv, logn, Zf(max_sig_bits)[logn]);
+		if (v == 0) {
+			return FALCON_ERR_SIZE;
+		}
+		break;
+	}
+	*sig_len = u + v;
+	return 0;
+}
+
+/* see falcon.h */
+int
+falcon_sign_lazy_online(void *sig, size_t *sig_len, int sig_type,
+	const void *expanded_key, void *token, size_t token_len,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+	const fpr *expkey, *yt;
+	fpr *ftmp, *ytbuf;
+	uint8_t *tk;
+	uint16_t *hm;
+	int16_t *sv;
+	const int8_t *sample1;
+	int8_t *sbuf;
+	shake256_context hd;
+	size_t n;
+	unsigned oldcw;
+	int r;
+
+	logn = *(const uint8_t *)expanded_key;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	tk = token;
+	if (token_len < FALCON_LAZY_TOKEN_SIZE(logn) || tk[0] != logn) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (tmp_len < FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+	r = Zf(lazy_check_sig)(*sig_len, sig_type, logn);
+	if (r != 0) {
+		return r;
+	}
+	expkey = (const fpr *)align_fpr((uint8_t *)expanded_key + 1);
+
+	n = (size_t)1 << logn;
+	ftmp = align_fpr(tmp);
+	ytbuf = ftmp + 4 * n;
+	hm = (uint16_t *)(ytbuf + 2 * n);
+	sv = (int16_t *)(hm + n);
+	sbuf = (int8_t *)(sv + n);
+	lazy_open_token(tk, logn, data, data_len, &hd,
+		&yt, &sample1, ytbuf, sbuf);
+	if (sig_type == FALCON_SIG_CT) {
+		Zf(hash_to_point_ct)((inner_shake256_context *)&hd,
+			hm, logn, (uint8_t *)ftmp);
+	} else {
+		Zf(hash_to_point_vartime)((inner_shake256_context *)&hd,
+			hm, logn);
+	}
+	memset(&hd, 0, sizeof hd);
+
+	/*
+	 * Compute and encode signature. The signer-side norm check was
+	 * never enforced here (the verifier checks the norm), so only
+	 * s2 is computed.
+	 */
+	oldcw = set_fpu_cw(2);
+	Zf(sign_lazy_online)(sv, expkey, sample1, sample1 + n, yt,
+		hm, logn, LAZY_NORM_SKIP | (FALCON_LAZY_F32 ? LAZY_F32 : 0),
+		ftmp);
+	set_fpu_cw(oldcw);
+	return lazy_finish_sig(sig, sig_len, sig_type, tk, sv, logn,
+		ytbuf, sbuf);
+}
+
+/* see inner.h */
+int
+Zf(lazy_sign_tokens)(void *sig, size_t *sig_len, int sig_type,
+	const void *expanded_key, unsigned logn,
+	lazy_token_source next_token, void *arg, size_t token_len,
+	const void *data, size_t data_len, void *tmp, size_t tmp_len)
+{
+	unsigned tries;
+	uint8_t *tk;
+	int r;
+
+	r = Zf(lazy_check_sig)(*sig_len, sig_type, logn);
+	if (r != 0) {
+		return r;
+	}
+	for (tries = 0; tries < LAZY_PADDED_MAX_TRIES; tries ++) {
+		r = next_token(arg, &tk);
+		if (r != 0) {
+			return r;
+		}
+		r = falcon_sign_lazy_online(sig, sig_len, sig_type,
+			expanded_key, tk, token_len, data, data_len,
+			tmp, tmp_len);
+		if (r != FALCON_ERR_SIZE || sig_type != FALCON_SIG_PADDED) {
+			return r;
+		}
+
+		/*
+		 * Padded signature does not fit, use another token.
+		 */
+	}
+	return FALCON_ERR_SIZE;
+}
+
+/* see falcon.h */
+int
+falcon_sign_lazy_online_batch(void *const *sig, size_t *sig_len,
+	int sig_type, const void *expanded_key,
+	void *const *token, size_t token_len,
+	const void *const *data, const size_t *data_len,
+	int *results, size_t k, void *tmp, size_t tmp_len)
+{
+	unsigned logn, l, num;
+	const fpr *expkey;
+	fpr *ftmp;
+	size_t n, i, j, idx[LAZY_BATCH];
+	fpr *ytbuf[LAZY_BATCH];
+	int8_t *sbuf[LAZY_BATCH];
+	uint16_t *hm[LAZY_BATCH];
+	const uint16_t *hmp[LAZY_BATCH];
+	int16_t *sv[LAZY_BATCH];
+	const fpr *yt[LAZY_BATCH];
+	const int8_t *sample1[LAZY_BATCH], *sample2[LAZY_BATCH];
+	shake256_context hd[LAZY_BATCH];
+	inner_shake256_context *phd[LAZY_BATCH];
+	unsigned oldcw;
+	int r, ret;
+
+	logn = *(const uint8_t *)expanded_key;
+	if (logn < 1 || logn > 10) {
+		r = FALCON_ERR_FORMAT;
+	} else if (tmp_len < FALCON_TMPSIZE_SIGNLAZY_BATCH(logn)) {
+		r = FALCON_ERR_SIZE;
+	} else {
+		r = 0;
+	}
+	if (r != 0) {
+		for (i = 0; i < k; i ++) {
+			results[i] = r;
+		}
+		return k > 0 ? r : 0;
+	}
+	expkey = (const fpr *)align_fpr((uint8_t *)expanded_key + 1);
+
+	/*
+	 * tmp[] layout: interleaved work area (8*n fpr), then for each
+	 * lane a token copy (2*n fpr), the hashed message, the signature
+	 * and the samples copy.
+	 */
+	n = (size_t)1 << logn;
+	ftmp = align_fpr(tmp);
+	for (l = 0; l < LAZY_BATCH; l ++) {
+		ytbuf[l] = ftmp + 8 * n + 2 * n * l;
+	}
+	for (l = 0; l < LAZY_BATCH; l ++) {
+		hm[l] = (uint16_t *)(ftmp + 16 * n) + 3 * n * l;
+		sv[l] = (int16_t *)(hm[l] + n);
+		sbuf[l] = (int8_t *)(sv[l] + n);
+		phd[l] = (inner_shake256_context *)&hd[l];
+	}
+
+	/*
+	 * Signatures are computed by groups of LAZY_BATCH valid requests;
+	 * an incomplete last group repeats its last request in the
+	 * unused lanes, whose output is discarded.
+	 */
+	ret = 0;
+	i = 0;
+	for (;;) {
+		num = 0;
+		while (num < LAZY_BATCH && i < k) {
+			const uint8_t *tk;
+
+			tk = token[i];
+			if (token_len < FALCON_LAZY_TOKEN_SIZE(logn)
+				|| tk[0] != logn)
+			{
+				r = FALCON_ERR_FORMAT;
+			} else {
+				r = Zf(lazy_check_sig)(sig_len[i], sig_type, logn);
+			}
+			results[i] = r;
+			if (r != 0) {
+				if (ret == 0) {
+					ret = r;
+				}
+			} else {
+				idx[num ++] = i;
+			}
+			i ++;
+		}
+		if (num == 0) {
+			break;
+		}
+		for (l = 0; l < LAZY_BATCH; l ++) {
+			if (l < num) {
+				lazy_open_token(token[idx[l]], logn,
+					data[idx[l]], data_len[idx[l]], &hd[l],
+					&yt[l], &sample1[l], ytbuf[l], sbuf[l]);
+				sample2[l] = sample1[l] + n;
+				hmp[l] = hm[l];
+			} else {
+				yt[l] = yt[num - 1];
+				sample2[l] = sample2[num - 1];
+				hmp[l] = hmp[num - 1];
+			}
+		}
+
+		/*
+		 * The messages of the group are hashed together (the
+		 * constant-time variant uses the work area, which has
+		 * room for 2*n bytes per lane).
+		 */
+		Zf(hash_to_point_batch)(phd, hm, num, logn,
+			sig_type == FALCON_SIG_CT, (uint8_t *)ftmp);
+		memset(hd, 0, sizeof hd);
+		oldcw = set_fpu_cw(2);
+		Zf(sign_lazy_online_batch)(sv, expkey, sample2, yt, hmp,
+			logn, ftmp);
+		set_fpu_cw(oldcw);
+		for (l = 0; l < num; l ++) {
+			j = idx[l];
+			r = lazy_finish_sig(sig[j], &sig_len[j], sig_type,
+				token[j], sv[l], logn, ytbuf[l], sbuf[l]);
+			results[j] = r;
+			if (r != 0 && ret == 0) {
+				ret = r;
+			}
+		}
+	}
+	return ret;
 }
 
 /* see falcon.h */
@@ -950,61 +1534,37 @@ falcon_verify_start(shake256_context *hash_data,
 	return 0;
 }
 
-/* see falcon.h */
-int
-falcon_verify_finish(const void *sig, size_t sig_len, int sig_type,
-	const void *pubkey, size_t pubkey_len,
-	shake256_context *hash_data,
-	void *tmp, size_t tmp_len)
+/*
+ * Check the header of the signature sig[] (of length sig_len bytes, at
+ * least 41) against the degree and the requested type. Returned value
+ * is 1 for a constant-time signature, 0 for a compressed one, or a
+ * negative error code.
+ */
+static int
+verify_sig_type(const uint8_t *es, size_t sig_len, int sig_type,
+	unsigned logn)
 {
-	unsigned logn;
-	uint8_t *atmp;
-	const uint8_t *pk, *es;
-	size_t u, v, n;
-	uint16_t *h, *hm;
-	int16_t *sv;
-	int ct;
-
-	/*
-	 * Get Falcon degree from public key; verify consistency with
-	 * signature value, and check parameters.
-	 */
-	if (sig_len < 41 || pubkey_len == 0) {
-		return FALCON_ERR_FORMAT;
-	}
-	es = sig;
-	pk = pubkey;
-	if ((pk[0] & 0xF0) != 0x00) {
-		return FALCON_ERR_FORMAT;
-	}
-	logn = pk[0] & 0x0F;
-	if (logn < 1 || logn > 10) {
-		return FALCON_ERR_FORMAT;
-	}
 	if ((es[0] & 0x0F) != logn) {
 		return FALCON_ERR_BADSIG;
 	}
-	ct = 0;
 	switch (sig_type) {
 	case 0:
 		switch (es[0] & 0xF0) {
 		case 0x30:
-			break;
+			return 0;
 		case 0x50:
 			if (sig_len != FALCON_SIG_CT_SIZE(logn)) {
 				return FALCON_ERR_FORMAT;
 			}
-			ct = 1;
-			break;
+			return 1;
 		default:
 			return FALCON_ERR_BADSIG;
 		}
-		break;
 	case FALCON_SIG_COMPRESSED:
 		if ((es[0] & 0xF0) != 0x30) {
 			return FALCON_ERR_FORMAT;
 		}
-		break;
+		return 0;
 	case FALCON_SIG_PADDED:
 		if ((es[0] & 0xF0) != 0x30) {
 			return FALCON_ERR_FORMAT;
@@ -1012,7 +1572,7 @@ falcon_verify_finish(const void *sig, size_t sig_len, int sig_type,
 		if (sig_len != FALCON_SIG_PADDED_SIZE(logn)) {
 			return FALCON_ERR_FORMAT;
 		}
-		break;
+		return 0;
 	case FALCON_SIG_CT:
 		if ((es[0] & 0xF0) != 0x50) {
 			return FALCON_ERR_FORMAT;
@@ -1020,36 +1580,22 @@ falcon_verify_finish(const void *sig, size_t sig_len, int sig_type,
 		if (sig_len != FALCON_SIG_CT_SIZE(logn)) {
 			return FALCON_ERR_FORMAT;
 		}
-		ct = 1;
-		break;
+		return 1;
 	default:
 		return FALCON_ERR_BADARG;
 	}
-	if (pubkey_len != FALCON_PUBKEY_SIZE(logn)) {
-		return FALCON_ERR_FORMAT;
-	}
-	if (tmp_len < FALCON_TMPSIZE_VERIFY(logn)) {
-		return FALCON_ERR_SIZE;
-	}
-
-	n = (size_t)1 << logn;
-	h = (uint16_t *)align_u16(tmp);
-	hm = h + n;
-	sv = (int16_t *)(hm + n);
-	atmp = (uint8_t *)(sv + n);
+}
 
-	/*
-	 * Decode public key.
-	 */
-	if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
-		!= pubkey_len - 1)
-	{
-		return FALCON_ERR_FORMAT;
-	}
+/*
+ * Decode the signature value from sig[] (checked with verify_sig_type(),
+ * which returned ct) into sv[].
+ */
+static int
+verify_decode_sv(int16_t *sv, const uint8_t *es, size_t sig_len,
+	int sig_type, unsigned logn, int ct)
+{
+	size_t u, v;
 
-	/*
-	 * Decode signature value.
-	 */
 	u = 41;
 	if (ct) {
 		v = Zf(trim_i16_decode)(sv, logn,
@@ -1078,6 +1624,66 @@ falcon_verify_finish(const void *sig, size_t sig_len, int sig_type,
 			return FALCON_ERR_FORMAT;
 		}
 	}
+	return 0;
+}
+
+/*
+ * Finish a signature verification, once the degree is known. The public
+ * key is either provided encoded (pk[], of length pubkey_len bytes), or
+ * already decoded and in NTT + Montgomery representation (h_ntt[], with
+ * pk == NULL).
+ */
+static int
+verify_finish_inner(const void *sig, size_t sig_len, int sig_type,
+	unsigned logn, const uint8_t *pk, size_t pubkey_len,
+	const uint16_t *h_ntt, shake256_context *hash_data,
+	void *tmp, size_t tmp_len)
+{
+	uint8_t *atmp;
+	const uint8_t *es;
+	size_t n;
+	uint16_t *h, *hm;
+	int16_t *sv;
+	int ct, r;
+
+	es = sig;
+	ct = verify_sig_type(es, sig_len, sig_type, logn);
+	if (ct < 0) {
+		return ct;
+	}
+	if (pk != NULL && pubkey_len != FALCON_PUBKEY_SIZE(logn)) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (tmp_len < FALCON_TMPSIZE_VERIFY(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+
+	n = (size_t)1 << logn;
+	h = (uint16_t *)align_u16(tmp);
+	hm = h + n;
+	sv = (int16_t *)(hm + n);
+	atmp = (uint8_t *)(sv + n);
+
+	/*
+	 * Decode public key.
+	 */
+	if (pk != NULL) {
+		if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
+			!= pubkey_len - 1)
+		{
+			return FALCON_ERR_FORMAT;
+		}
+		Zf(to_ntt_monty)(h, logn);
+		h_ntt = h;
+	}
+
+	/*
+	 * Decode signature value.
+	 */
+	r = verify_decode_sv(sv, es, sig_len, sig_type, logn, ct);
+	if (r != 0) {
+		return r;
+	}
 
 	/*
 	 * Hash message to point.
@@ -1094,13 +1700,41 @@ falcon_verify_finish(const void *sig, size_t sig_len, int sig_type,
 	/*
 	 * Verify signature.
 	 */
-	Zf(to_ntt_monty)(h, logn);
-	if (!Zf(verify_raw)(hm, sv, h, logn, atmp)) {
+	if (!Zf(verify_raw)(hm, sv, h_ntt, logn, atmp)) {
 		return FALCON_ERR_BADSIG;
 	}
 	return 0;
 }
 
+/* see falcon.h */
+int
+falcon_verify_finish(const void *sig, size_t sig_len, int sig_type,
+	const void *pubkey, size_t pubkey_len,
+	shake256_context *hash_data,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+	const uint8_t *pk;
+
+	/*
+	 * Get Falcon degree from public key; verify consistency with
+	 * signature value, and check parameters.
+	 */
+	if (sig_len < 41 || pubkey_len == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	pk = pubkey;
+	if ((pk[0] & 0xF0) != 0x00) {
+		return FALCON_ERR_FORMAT;
+	}
+	logn = pk[0] & 0x0F;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	return verify_finish_inner(sig, sig_len, sig_type, logn,
+		pk, pubkey_len, NULL, hash_data, tmp, tmp_len);
+}
+
 /* see falcon.h */
 int
 falcon_verify(const void *sig, size_t sig_len, int sig_type,
@@ -1119,3 +1753,219 @@ falcon_verify(const void *sig, size_t sig_len, int sig_type,
 	return falcon_verify_finish(sig, sig_len, sig_type,
 		pubkey, pubkey_len, &hd, tmp, tmp_len);
 }
+
+/* see falcon.h */
+int
+falcon_expand_pubkey(void *expanded_pub, size_t expanded_pub_len,
+	const void *pubkey, size_t pubkey_len)
+{
+	unsigned logn;
+	const uint8_t *pk;
+	uint16_t *h;
+
+	if (pubkey_len == 0) {
+		return FALCON_ERR_FORMAT;
+	}
+	pk = pubkey;
+	if ((pk[0] & 0xF0) != 0x00) {
+		return FALCON_ERR_FORMAT;
+	}
+	logn = pk[0] & 0x0F;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (pubkey_len != FALCON_PUBKEY_SIZE(logn)) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (expanded_pub_len < FALCON_EXPANDEDPUB_SIZE(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+
+	/*
+	 * Header byte is the degree; the NTT representation of h follows,
+	 * 8-byte aligned.
+	 */
+	h = (uint16_t *)align_u64((uint8_t *)expanded_pub + 1);
+	if (Zf(modq_decode)(h, logn, pk + 1, pubkey_len - 1)
+		!= pubkey_len - 1)
+	{
+		return FALCON_ERR_FORMAT;
+	}
+	Zf(to_ntt_monty)(h, logn);
+	*(uint8_t *)expanded_pub = logn;
+	return 0;
+}
+
+/* see falcon.h */
+int
+falcon_verify_expanded_finish(const void *sig, size_t sig_len, int sig_type,
+	const void *expanded_pub, shake256_context *hash_data,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+	const uint16_t *h;
+
+	if (sig_len < 41) {
+		return FALCON_ERR_FORMAT;
+	}
+	logn = *(const uint8_t *)expanded_pub;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	h = (const uint16_t *)align_u64((uint8_t *)expanded_pub + 1);
+	return verify_finish_inner(sig, sig_len, sig_type, logn,
+		NULL, 0, h, hash_data, tmp, tmp_len);
+}
+
+/* see falcon.h */
+int
+falcon_verify_expanded(const void *sig, size_t sig_len, int sig_type,
+	const void *expanded_pub,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len)
+{
+	shake256_context hd;
+	int r;
+
+	r = falcon_verify_start(&hd, sig, sig_len);
+	if (r < 0) {
+		return r;
+	}
+	shake256_inject(&hd, data, data_len);
+	return falcon_verify_expanded_finish(sig, sig_len, sig_type,
+		expanded_pub, &hd, tmp, tmp_len);
+}
+
+/*
+ * Number of signatures verified together by falcon_verify_batch().
+ */
+#define VERIFY_BATCH   INNER_VERIFY_LANES
+
+/*
+ * Hash the messages of the lanes whose type is ct, by groups of
+ * INNER_SHAKE256_LANES.
+ */
+static void
+verify_batch_hash(shake256_context *hd, uint16_t *const *hm,
+	const int *lct, unsigned num, int ct, unsigned logn, uint8_t *atmp)
+{
+	inner_shake256_context *psc[INNER_SHAKE256_LANES];
+	uint16_t *px[INNER_SHAKE256_LANES];
+	unsigned l, m;
+
+	m = 0;
+	for (l = 0; l < num; l ++) {
+		if (lct[l] == ct) {
+			psc[m] = (inner_shake256_context *)&hd[l];
+			px[m] = hm[l];
+			if (++ m == INNER_SHAKE256_LANES) {
+				Zf(hash_to_point_batch)(psc, px, m,
+					logn, ct, atmp);
+				m = 0;
+			}
+		}
+	}
+	if (m != 0) {
+		Zf(hash_to_point_batch)(psc, px, m, logn, ct, atmp);
+	}
+}
+
+/* see falcon.h */
+int
+falcon_verify_batch(const void *const *sig, const size_t *sig_len,
+	int sig_type, const void *expanded_pub,
+	const void *const *data, const size_t *data_len,
+	int *results, size_t k, void *tmp, size_t tmp_len)
+{
+	unsigned logn, l, num;
+	const uint16_t *h;
+	uint16_t *hm[VERIFY_BATCH];
+	int16_t *sv[VERIFY_BATCH];
+	uint8_t *atmp;
+	shake256_context hd[VERIFY_BATCH];
+	size_t n, i, idx[VERIFY_BATCH];
+	int lct[VERIFY_BATCH], vr[VERIFY_BATCH];
+	int r, ret;
+
+	logn = *(const uint8_t *)expanded_pub;
+	if (logn < 1 || logn > 10) {
+		r = FALCON_ERR_FORMAT;
+	} else if (tmp_len < FALCON_TMPSIZE_VERIFY_BATCH(logn)) {
+		r = FALCON_ERR_SIZE;
+	} else {
+		r = 0;
+	}
+	if (r != 0) {
+		for (i = 0; i < k; i ++) {
+			results[i] = r;
+		}
+		return k > 0 ? r : 0;
+	}
+	h = (const uint16_t *)align_u64((uint8_t *)expanded_pub + 1);
+
+	/*
+	 * tmp[] layout: for each lane, the hashed message and the decoded
+	 * signature; then the work area for hashing (2*n bytes per hashed
+	 * lane) and verification (2*n bytes per lane).
+	 */
+	n = (size_t)1 << logn;
+	for (l = 0; l < VERIFY_BATCH; l ++) {
+		hm[l] = (uint16_t *)align_u16(tmp) + 2 * n * l;
+		sv[l] = (int16_t *)(hm[l] + n);
+	}
+	atmp = (uint8_t *)(hm[0] + 2 * n * VERIFY_BATCH);
+
+	/*
+	 * Requests are processed by groups of VERIFY_BATCH valid
+	 * signatures; invalid encodings are reported immediately.
+	 */
+	ret = 0;
+	i = 0;
+	for (;;) {
+		num = 0;
+		while (num < VERIFY_BATCH && i < k) {
+			const uint8_t *es;
+
+			es = sig[i];
+			if (sig_len[i] < 41) {
+				r = FALCON_ERR_FORMAT;
+			} else {
+				r = verify_sig_type(es, sig_len[i],
+					sig_type, logn);
+				if (r >= 0) {
+					lct[num] = r;
+					r = verify_decode_sv(sv[num], es,
+						sig_len[i], sig_type, logn, r);
+				}
+			}
+			results[i] = r;
+			if (r != 0) {
+				if (ret == 0) {
+					ret = r;
+				}
+			} else {
+				shake256_init(&hd[num]);
+				shake256_inject(&hd[num], es + 1, 40);
+				shake256_inject(&hd[num], data[i], data_len[i]);
+				shake256_flip(&hd[num]);
+				idx[num ++] = i;
+			}
+			i ++;
+		}
+		if (num == 0) {
+			break;
+		}
+		verify_batch_hash(hd, hm, lct, num, 0, logn, atmp);
+		verify_batch_hash(hd, hm, lct, num, 1, logn, atmp);
+		Zf(verify_raw_batch)((const uint16_t *const *)hm,
+			(const int16_t *const *)sv, h, logn, vr, num, atmp);
+		for (l = 0; l < num; l ++) {
+			r = vr[l] ? 0 : FALCON_ERR_BADSIG;
+			results[idx[l]] = r;
+			if (r != 0 && ret == 0) {
+				ret = r;
+			}
+		}
+	}
+	return ret;
+}
@@ -252,6 +252,13 @@ extern "C" {
  */
 #define FALCON_ERR_INTERNAL   -6
 
+/*
+ * FALCON_ERR_EMPTY is returned when a lazy signature is requested but
+ * no precomputed token is available, and the configured policy forbids
+ * waiting for one or computing one on the spot.
+ */
+#define FALCON_ERR_EMPTY      -7
+
 /* ==================================================================== */
 /*
  * Signature formats.
@@ -380,12 +387,77 @@ extern "C" {
 #define FALCON_EXPANDEDKEY_SIZE(logn) \
 	(((8u * (logn) + 40) << (logn)) + 8)
 
+/*
+ * Size of a lazy expanded key (falcon_lazy_expand_key()).
+ */
+#define FALCON_LAZY_EXPANDEDKEY_SIZE(logn) \
+	((50u << (logn)) + 8)
+
+/*
+ * Size of a lazy signature token (falcon_sign_lazy_offline()).
+ */
+#define FALCON_LAZY_TOKEN_SIZE(logn) \
+	((18u << (logn)) + 256)
+
+/*
+ * Temporary buffer size for computing a lazy expanded key.
+ */
+#define FALCON_TMPSIZE_LAZYEXPAND(logn) \
+	((10u << (logn)) + 7)
+
+/*
+ * Temporary buffer size for the offline phase of a lazy signature.
+ */
+#define FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn) \
+	((18u << (logn)) + 7)
+
+/*
+ * Temporary buffer size for the online phase of a lazy signature.
+ */
+#define FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn) \
+	((54u << (logn)) + 7)
+
+/*
+ * Temporary buffer size for the batched online phase of lazy signatures
+ * (falcon_sign_lazy_online_batch()).
+ */
+#define FALCON_TMPSIZE_SIGNLAZY_BATCH(logn) \
+	((152u << (logn)) + 7)
+
+/*
+ * Temporary buffer size for creating a lazy token store
+ * (falcon_lazy_store_create()).
+ */
+#define FALCON_TMPSIZE_LAZYSTORE(logn) \
+	((36u << (logn)) + 4096)
+
+/*
+ * Temporary buffer size for generating a lazy signature from a
+ * presignature pool (falcon_lazy_sign_from_pool()).
+ */
+#define FALCON_TMPSIZE_SIGNPOOL(logn) \
+	(FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn) \
+	+ FALCON_LAZY_TOKEN_SIZE(logn) + 7)
+
 /*
  * Temporary buffer size for verifying a signature.
  */
 #define FALCON_TMPSIZE_VERIFY(logn) \
 	((8u << (logn)) + 1)
 
+/*
+ * Temporary buffer size for verifying a batch of signatures
+ * (falcon_verify_batch()).
+ */
+#define FALCON_TMPSIZE_VERIFY_BATCH(logn) \
+	((96u << (logn)) + 1)
+
+/*
+ * Size of an expanded public key (falcon_expand_pubkey()).
+ */
+#define FALCON_EXPANDEDPUB_SIZE(logn) \
+	((2u << (logn)) + 8)
+
 /* ==================================================================== */
 /*
  * SHAKE256.
@@ -750,6 +822,432 @@ int falcon_sign_tree_finish(shake256_context *rng,
 	shake256_context *hash_data, const void *nonce,
 	void *tmp, size_t tmp_len);
 
+/* ==================================================================== */
+/*
+ * Lazy signature generation.
+ *
+ * The lazy ("online/offline") signer splits signature generation in
+ * two phases. The offline phase does not depend on the message: it
+ * draws a one-time token made of two small Gaussian polynomials, the
+ * first Babai step for the corresponding target modulo q, the nonce,
+ * and the SHAKE256 context with the nonce already injected. The
+ * online phase only hashes the message, combines it with a token, and
+ * performs the Babai rounding against the private basis.
+ *
+ * Both phases work with a lazy expanded key, which holds the private
+ * basis and the public key in the representations used by the signer,
+ * so that the key pair is decoded and converted only once.
+ */
+
+/*
+ * Expand a key pair for lazy signing. The private key (privkey, of
+ * size privkey_len bytes) and the matching public key (pubkey, of size
+ * pubkey_len bytes) are decoded and expanded into expanded_key[].
+ *
+ * The expanded_key[] buffer has size expanded_key_len, which MUST be at
+ * least FALCON_LAZY_EXPANDEDKEY_SIZE(logn) bytes. Expanded key contents
+ * have an internal, implementation-specific format. Expanded keys may
+ * be moved in RAM only if their 8-byte alignment remains unchanged.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_LAZYEXPAND(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_lazy_expand_key(void *expanded_key, size_t expanded_key_len,
+	const void *privkey, size_t privkey_len,
+	const void *pubkey, size_t pubkey_len,
+	void *tmp, size_t tmp_len);
+
+/*
+ * Offline phase: compute a new token for the lazy expanded key held in
+ * expanded_key[] and write it in token[]. The token size token_len MUST
+ * be at least FALCON_LAZY_TOKEN_SIZE(logn) bytes. Token contents have
+ * an internal format; a token is secret, and MUST NOT be used for more
+ * than one signature. Tokens may be moved in RAM or stored, but are
+ * read in place only if they are 8-byte aligned.
+ *
+ * The source of randomness *rng is used for the signature nonce and to
+ * seed the Gaussian sampler; it must have been already initialized,
+ * seeded, and set to output mode. Concurrent calls must use distinct
+ * rng contexts.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_sign_lazy_offline(shake256_context *rng,
+	void *token, size_t token_len,
+	const void *expanded_key,
+	void *tmp, size_t tmp_len);
+
+/*
+ * Online phase: sign the data provided in buffer data[] (of length
+ * data_len bytes), using the lazy expanded key held in expanded_key[]
+ * and the token held in token[] (of size token_len bytes). The token
+ * is marked as used before being read, and cleared afterwards; a used
+ * token is rejected with FALCON_ERR_FORMAT. If token[] is 8-byte
+ * aligned, it is read in place (no copy). No randomness is needed:
+ * the nonce comes from the token.
+ *
+ * The signature is written in sig[], with the same conventions as in
+ * falcon_sign_dyn() regarding *sig_len and sig_type, except that an
+ * oversized FALCON_SIG_PADDED signature is not retried: the function
+ * returns FALCON_ERR_SIZE, and the caller may try again with another
+ * token. Since lazy signatures are longer than plain Falcon signatures,
+ * this happens often.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_sign_lazy_online(void *sig, size_t *sig_len, int sig_type,
+	const void *expanded_key, void *token, size_t token_len,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len);
+
+/*
+ * Batched online phase: sign k messages at once with the same lazy
+ * expanded key. Signature i is computed over data[i] (of length
+ * data_len[i] bytes) with token[i] (each of size token_len bytes), and
+ * written in sig[i], whose size is in sig_len[i] (updated as in
+ * falcon_sign_lazy_online()). All signatures use the same sig_type.
+ *
+ * The messages are processed by groups of four, with each vector
+ * instruction working on all messages of a group; on x86 with AVX2,
+ * this yields more signatures per second than separate calls. The
+ * resulting signatures are the same as with falcon_sign_lazy_online().
+ *
+ * The status of signature i (0 or a negative error code, with the same
+ * meaning as for falcon_sign_lazy_online()) is written in results[i];
+ * a failed signature does not prevent the others from being computed.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_SIGNLAZY_BATCH(logn) bytes.
+ *
+ * Returned value: 0 if all signatures succeeded, or a negative error
+ * code (one of the values in results[]).
+ */
+int falcon_sign_lazy_online_batch(void *const *sig, size_t *sig_len,
+	int sig_type, const void *expanded_key,
+	void *const *token, size_t token_len,
+	const void *const *data, const size_t *data_len,
+	int *results, size_t k, void *tmp, size_t tmp_len);
+
+/* ==================================================================== */
+/*
+ * Lazy signer contexts.
+ *
+ * A context owns everything that a lazy signer modifies: its own PRNG
+ * (for nonces and Gaussian samples), a token buffer and the temporary
+ * memory for both phases. The lazy expanded key is only read, and can
+ * be shared by any number of contexts. Distinct contexts share no
+ * mutable state; thus, N threads, each with its own context, sign
+ * concurrently without any locking. A given context must not be used
+ * by two threads at the same time. The floating-point rounding mode
+ * (on platforms where it must be set) is set and restored by each
+ * call, on the calling thread only.
+ *
+ * The context functions allocate memory; they are not available on
+ * bare-metal targets.
+ */
+
+/*
+ * Opaque lazy signer context.
+ */
+typedef struct falcon_lazy_ctx_ falcon_lazy_ctx;
+
+/*
+ * Create a lazy signer context for the lazy expanded key held in
+ * expanded_key[] (see falcon_lazy_expand_key()). The context keeps a
+ * reference to expanded_key[], which must remain valid and unmodified
+ * until the context is released.
+ *
+ * The source of randomness *rng is used to seed the context's own
+ * PRNG; it must have been already initialized, seeded, and set to
+ * output mode. It is not used afterwards.
+ *
+ * On success, the new context is written in *ctx and 0 is returned. On
+ * error, *ctx is set to NULL and a negative error code is returned.
+ */
+int falcon_lazy_ctx_new(falcon_lazy_ctx **ctx, shake256_context *rng,
+	const void *expanded_key);
+
+/*
+ * Release a context; its buffers are cleared. If ctx is NULL, this
+ * function does nothing.
+ */
+void falcon_lazy_ctx_free(falcon_lazy_ctx *ctx);
+
+/*
+ * Get the Falcon degree (logarithmic) of the key used by a context.
+ */
+unsigned falcon_lazy_ctx_get_logn(const falcon_lazy_ctx *ctx);
+
+/*
+ * Offline phase with a context: same as falcon_sign_lazy_offline(),
+ * with the context's PRNG and temporary memory.
+ */
+int falcon_lazy_ctx_offline(falcon_lazy_ctx *ctx,
+	void *token, size_t token_len);
+
+/*
+ * Online phase with a context: same as falcon_sign_lazy_online(), with
+ * the context's temporary memory. The token may have been produced by
+ * any context (or by falcon_sign_lazy_offline()) for the same key.
+ */
+int falcon_lazy_ctx_online(falcon_lazy_ctx *ctx,
+	void *sig, size_t *sig_len, int sig_type,
+	void *token, size_t token_len,
+	const void *data, size_t data_len);
+
+/*
+ * Sign the data provided in buffer data[] (of length data_len bytes):
+ * both phases are run, with a token held in the context. Conventions
+ * on sig[], *sig_len and sig_type are as in falcon_sign_dyn(); as with
+ * falcon_lazy_sign_from_pool(), a PADDED signature is retried with a
+ * new token a bounded number of times before FALCON_ERR_SIZE is
+ * returned.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_lazy_ctx_sign(falcon_lazy_ctx *ctx,
+	void *sig, size_t *sig_len, int sig_type,
+	const void *data, size_t data_len);
+
+/* ==================================================================== */
+/*
+ * Lazy signature generation with a presignature pool.
+ *
+ * A pool keeps up to 'capacity' tokens for a given key pair. Tokens
+ * are produced by background threads (if 'nthreads' is not zero) that
+ * keep the pool full, and/or explicitly by the caller through
+ * falcon_lazy_pool_refill(). Each token is used for exactly one
+ * signature and then discarded.
+ *
+ * The pool functions allocate memory and start threads; they are not
+ * available on bare-metal targets.
+ */
+
+/*
+ * Opaque presignature pool.
+ */
+typedef struct falcon_lazy_pool_ falcon_lazy_pool;
+
+/*
+ * Behaviour of falcon_lazy_sign_from_pool() when the pool is empty:
+ *
+ *   FALCON_LAZY_POOL_WAIT   block until a background thread produces
+ *                           a token (requires nthreads > 0)
+ *   FALCON_LAZY_POOL_SYNC   compute a token in the calling thread
+ *   FALCON_LAZY_POOL_FAIL   return FALCON_ERR_EMPTY immediately
+ */
+#define FALCON_LAZY_POOL_WAIT   1
+#define FALCON_LAZY_POOL_SYNC   2
+#define FALCON_LAZY_POOL_FAIL   3
+
+/*
+ * Create a presignature pool for the key pair (privkey, pubkey). The
+ * pool holds its own lazy expanded key, and no reference to the
+ * privkey[] and pubkey[] buffers.
+ *
+ * The source of randomness *rng is used to seed the pool's own PRNG,
+ * which provides the nonces of all tokens; it must have been already
+ * initialized, seeded, and set to output mode.
+ *
+ * The pool is created with one token already available. If nthreads
+ * is not zero, that many background threads are started and keep
+ * refilling the pool up to 'capacity' tokens. 'policy' is one of the
+ * FALCON_LAZY_POOL_* values and selects what happens when a signature
+ * is requested while the pool is empty.
+ *
+ * On success, the new pool is written in *pool and 0 is returned. On
+ * error, *pool is set to NULL and a negative error code is returned.
+ */
+int falcon_lazy_pool_new(falcon_lazy_pool **pool, shake256_context *rng,
+	const void *privkey, size_t privkey_len,
+	const void *pubkey, size_t pubkey_len,
+	size_t capacity, unsigned nthreads, int policy);
+
+/*
+ * Stop the background threads (if any) and release a pool. All unused
+ * tokens and the private basis are cleared. If pool is NULL, this
+ * function does nothing.
+ */
+void falcon_lazy_pool_free(falcon_lazy_pool *pool);
+
+/*
+ * Compute up to 'max' tokens in the calling thread and add them to the
+ * pool, stopping early if the pool becomes full or if a token cannot be
+ * computed. This is meant to use idle time when the pool runs without
+ * background threads. Returned value is the number of tokens added.
+ */
+size_t falcon_lazy_pool_refill(falcon_lazy_pool *pool, size_t max);
+
+/*
+ * Get the number of tokens currently available in the pool. With
+ * background threads running, the value may be stale as soon as it
+ * is returned.
+ */
+size_t falcon_lazy_pool_available(falcon_lazy_pool *pool);
+
+/*
+ * Get the Falcon degree (logarithmic) of the key pair used by a pool.
+ */
+unsigned falcon_lazy_pool_get_logn(const falcon_lazy_pool *pool);
+
+/*
+ * Sign the data provided in buffer data[] (of length data_len bytes)
+ * with the key pair of the provided pool, consuming one token. Only
+ * the online phase of the lazy signer runs here; if the pool is empty,
+ * the pool policy applies (see FALCON_LAZY_POOL_*).
+ *
+ * The signature is written in sig[], with the same conventions as in
+ * falcon_sign_dyn() regarding *sig_len and sig_type. With
+ * FALCON_SIG_PADDED, an oversized signature is discarded and another
+ * token is consumed; since lazy signatures are longer than plain Falcon
+ * signatures, this happens often, and FALCON_ERR_SIZE is returned after
+ * a bounded number of attempts (for logn = 10, PADDED signatures are
+ * usually out of reach).
+ *
+ * This function may be called concurrently from several threads on the
+ * same pool, provided that each caller uses its own sig and tmp.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_SIGNPOOL(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code. If a token
+ * cannot be computed (with FALCON_LAZY_POOL_SYNC, or in a background
+ * thread while the caller waits), the error of
+ * falcon_sign_lazy_offline() is returned; background threads stop on
+ * such an error.
+ */
+int falcon_lazy_sign_from_pool(falcon_lazy_pool *pool,
+	void *sig, size_t *sig_len, int sig_type,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len);
+
+/* ==================================================================== */
+/*
+ * Persistent lazy token store.
+ *
+ * A token store is a file holding a batch of tokens for one key pair,
+ * generated in advance (e.g. on another machine, or during quiet
+ * hours), with a header that records the Falcon degree and a
+ * fingerprint of the public key. The file is memory-mapped, and each
+ * signature consumes the next token in place; a consumption cursor,
+ * stored in the file and advanced atomically, guarantees that a token
+ * is never handed out twice, even across restarts and crashes, and
+ * between several processes that map the same file.
+ *
+ * The file uses the native byte order and is not portable to hosts of
+ * another endianness. These functions use POSIX file mapping; they are
+ * not available on bare-metal targets.
+ */
+
+/*
+ * Opaque token store handle.
+ */
+typedef struct falcon_lazy_store_ falcon_lazy_store;
+
+/*
+ * Flags for falcon_lazy_store_open():
+ *
+ *   FALCON_LAZY_STORE_HUGEPAGES   ask for huge pages on the mapping
+ *                                 (best effort)
+ *   FALCON_LAZY_STORE_POPULATE    prefault the whole mapping when
+ *                                 opening the file
+ *   FALCON_LAZY_STORE_NOSYNC      do not flush the cursor to disk before
+ *                                 each signature; a process crash is
+ *                                 still safe, but a system crash may
+ *                                 lose cursor updates and let tokens
+ *                                 be used twice
+ */
+#define FALCON_LAZY_STORE_HUGEPAGES   0x01
+#define FALCON_LAZY_STORE_POPULATE    0x02
+#define FALCON_LAZY_STORE_NOSYNC      0x04
+
+/*
+ * Create a token store file at 'path' with 'count' fresh tokens for
+ * the lazy expanded key held in expanded_key[]; pubkey[] (of size
+ * pubkey_len bytes) MUST be the matching public key (FALCON_ERR_BADARG
+ * otherwise), and is used for the key fingerprint. The file is first
+ * written under the name 'path' followed by ".tmp", then renamed; an
+ * existing file at 'path' is replaced. The file and its directory are
+ * synced to disk before the function returns.
+ *
+ * The source of randomness *rng is used for the token nonces; it must
+ * have been already initialized, seeded, and set to output mode.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_LAZYSTORE(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code
+ * (FALCON_ERR_INTERNAL on I/O errors). On error, the temporary file
+ * is removed and 'path' is left unchanged, except when only the final
+ * sync of the directory failed: the new store is then in place, but
+ * might not survive a crash.
+ */
+int falcon_lazy_store_create(shake256_context *rng,
+	const char *path, size_t count, const void *expanded_key,
+	const void *pubkey, size_t pubkey_len,
+	void *tmp, size_t tmp_len);
+
+/*
+ * Open and map the token store file at 'path'. The store header is
+ * checked, and its key fingerprint is compared with the provided
+ * public key (FALCON_ERR_BADARG on mismatch). 'flags' is a combination
+ * of FALCON_LAZY_STORE_* values.
+ *
+ * On success, the new handle is written in *store and 0 is returned.
+ * On error, *store is set to NULL and a negative error code is
+ * returned.
+ */
+int falcon_lazy_store_open(falcon_lazy_store **store, const char *path,
+	const void *pubkey, size_t pubkey_len, int flags);
+
+/*
+ * Unmap and release a token store handle. If store is NULL, this
+ * function does nothing.
+ */
+void falcon_lazy_store_close(falcon_lazy_store *store);
+
+/*
+ * Get the number of unused tokens in a store.
+ */
+size_t falcon_lazy_store_remaining(const falcon_lazy_store *store);
+
+/*
+ * Get the Falcon degree (logarithmic) of the key pair of a store.
+ */
+unsigned falcon_lazy_store_get_logn(const falcon_lazy_store *store);
+
+/*
+ * Sign the data provided in buffer data[] (of length data_len bytes)
+ * with the next token of the store, read directly from the mapped
+ * file. The lazy expanded key in expanded_key[] MUST correspond to the
+ * public key used to open the store; otherwise, FALCON_ERR_BADARG is
+ * returned and no token is consumed. FALCON_ERR_EMPTY is returned when
+ * all tokens have been used.
+ *
+ * The sig[], *sig_len and sig_type parameters are as in
+ * falcon_sign_lazy_online(); with FALCON_SIG_PADDED, an oversized
+ * signature is discarded and another token is consumed, up to a
+ * bounded number of attempts.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_lazy_store_sign(falcon_lazy_store *store,
+	void *sig, size_t *sig_len, int sig_type,
+	const void *expanded_key,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len);
+
 /* ==================================================================== */
 /*
  * Signature verification.
@@ -817,6 +1315,126 @@ int falcon_verify_finish(const void *sig, size_t sig_len, int sig_type,
 	shake256_context *hash_data,
 	void *tmp, size_t tmp_len);
 
+/*
+ * Expand a public key. The provided Falcon public key (pubkey, of size
+ * pubkey_len bytes) is decoded and converted to the NTT representation
+ * used by the verification, into expanded_pub[]. Verifying many
+ * signatures against the same key with falcon_verify_expanded() then
+ * saves the decoding and the NTT of the key on each call.
+ *
+ * The expanded_pub[] buffer has size expanded_pub_len, which MUST be at
+ * least FALCON_EXPANDEDPUB_SIZE(logn) bytes (where 'logn' qualifies the
+ * Falcon degree encoded in the public key and can be obtained with
+ * falcon_get_logn()). Expanded key contents have an internal,
+ * implementation-specific format. Expanded keys may be moved in RAM
+ * only if their 8-byte alignment remains unchanged. An expanded key is
+ * not modified by the verification functions, and may be used by
+ * several threads concurrently.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_expand_pubkey(void *expanded_pub, size_t expanded_pub_len,
+	const void *pubkey, size_t pubkey_len);
+
+/*
+ * Verify the signature sig[] (of length sig_len bytes) with regards to
+ * the expanded public key expanded_pub[] (as generated by
+ * falcon_expand_pubkey()) and the message data[] (of length data_len
+ * bytes). This is equivalent to falcon_verify() with the original
+ * public key; sig_type and tmp[] have the same meaning, and tmp_len
+ * MUST be at least FALCON_TMPSIZE_VERIFY(logn) bytes.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_verify_expanded(const void *sig, size_t sig_len, int sig_type,
+	const void *expanded_pub,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len);
+
+/*
+ * Finish a streamed signature verification (see falcon_verify_start()
+ * and falcon_verify_finish()) with an expanded public key.
+ *
+ * Returned value: 0 on success, or a negative error code.
+ */
+int falcon_verify_expanded_finish(const void *sig, size_t sig_len,
+	int sig_type, const void *expanded_pub,
+	shake256_context *hash_data,
+	void *tmp, size_t tmp_len);
+
+/*
+ * Verify k signatures against the same expanded public key
+ * expanded_pub[] (see falcon_expand_pubkey()). Signature i is sig[i]
+ * (of length sig_len[i] bytes), for the message data[i] (of length
+ * data_len[i] bytes); sig_type has the same meaning as for
+ * falcon_verify(). The status of signature i (0 if valid, or the
+ * negative error code that falcon_verify_expanded() would return) is
+ * written in results[i].
+ *
+ * Signatures are processed by groups of up to sixteen. The messages
+ * are hashed to points together, with a multi-buffer SHAKE256 (AVX2 or
+ * AVX-512 when available), and with AVX2 the signatures of a group are
+ * verified together, with the public key shared by all of them.
+ *
+ * The tmp[] buffer is used to hold temporary values. Its size tmp_len
+ * MUST be at least FALCON_TMPSIZE_VERIFY_BATCH(logn) bytes.
+ *
+ * Returned value: 0 if all signatures are valid, or a negative error
+ * code (one of the values in results[]).
+ */
+int falcon_verify_batch(const void *const *sig, const size_t *sig_len,
+	int sig_type, const void *expanded_pub,
+	const void *const *data, const size_t *data_len,
+	int *results, size_t k, void *tmp, size_t tmp_len);
+
+/* ==================================================================== */
+/*
+ * SIMD backend selection.
+ *
+ * When the library is compiled with FALCON_DISPATCH (see config.h), the
+ * FFT, PRNG, sampler, Keccak, mod q NTT, batch verification and
+ * fixed-width codec kernels exist in several versions, and the most
+ * capable one supported by the CPU is selected when the library is
+ * loaded. The FALCON_BACKEND
+ * environment variable ("ref", "avx2" or "avx512") may name another
+ * supported backend to use instead, and falcon_set_backend() changes
+ * the selection at runtime (e.g. for benchmarks). Without
+ * FALCON_DISPATCH, the only backend is the one chosen at compile time
+ * (FALCON_AVX2, FALCON_AVX512).
+ *
+ * All backends produce valid and interoperable keys and signatures; the
+ * PRNG output and the sampled values are identical, while the use of
+ * FMA may change the last bits of floating-point values (and thus,
+ * very rarely, a signature).
+ */
+
+#define FALCON_BACKEND_AUTO     0
+#define FALCON_BACKEND_REF      1
+#define FALCON_BACKEND_AVX2     2
+#define FALCON_BACKEND_AVX512   3
+
+/*
+ * Get the backend currently in use (FALCON_BACKEND_REF,
+ * FALCON_BACKEND_AVX2 or FALCON_BACKEND_AVX512).
+ */
+int falcon_get_backend(void);
+
+/*
+ * Get the name of a backend ("auto", "ref", "avx2" or "avx512"), or
+ * NULL if the value is not a FALCON_BACKEND_* constant.
+ */
+const char *falcon_backend_name(int backend);
+
+/*
+ * Select the backend. FALCON_BACKEND_AUTO selects the most capable one
+ * supported by the CPU. This function may be called at any time, also
+ * while other threads use the library.
+ *
+ * Returned value: 0 on success, or FALCON_ERR_BADARG if the backend is
+ * unknown, not compiled in, or not supported by the CPU.
+ */
+int falcon_set_backend(int backend);
+
 /* ==================================================================== */
 
 #ifdef __cplusplus
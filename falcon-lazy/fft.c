@@ -166,10 +166,24 @@
  * (Note that rev(j) is even for j < N/2.)
  */
 
-/* see inner.h */
+/*
+ * The specialized transforms for logn = 9 and 10 are obtained by
+ * inlining the generic layer code with a constant logn; we force the
+ * inlining since these functions are large.
+ */
+#if defined __GNUC__ || defined __clang__
+#define FFT_INLINE   static inline __attribute__((always_inline))
+#else
+#define FFT_INLINE   static inline
+#endif
+
+/*
+ * Apply the FFT layers ustart to ulim-1 (all layers if ustart = 1 and
+ * ulim = logn), one pass over the array per layer.
+ */
 TARGET_AVX2
-void
-Zf(FFT)(fpr *f, unsigned logn)
+FFT_INLINE void
+fft_layers(fpr *f, unsigned logn, unsigned ustart, unsigned ulim)
 {
 	/*
 	 * FFT algorithm in bit-reversal order uses the following
@@ -216,8 +230,8 @@ Zf(FFT)(fpr *f, unsigned logn)
 	 */
 	n = (size_t)1 << logn;
 	hn = n >> 1;
-	t = hn;
-	for (u = 1, m = 2; u < logn; u ++, m <<= 1) {
+	t = hn >> (ustart - 1);
+	for (u = ustart, m = (size_t)1 << ustart; u < ulim; u ++, m <<= 1) {
 		size_t ht, hm, i1, j1;
 
 		ht = t >> 1;
@@ -234,7 +248,39 @@ Zf(FFT)(fpr *f, unsigned logn)
 					fpr_gm_tab[((m + i1) << 1) + 0].v);
 				s_im = _mm256_set1_pd(
 					fpr_gm_tab[((m + i1) << 1) + 1].v);
-				for (j = j1; j < j2; j += 4) {
+				j = j1;
+#if FALCON_AVX512
+				if (ht >= 8) {
+					__m512d s_re8, s_im8;
+
+					s_re8 = _mm512_set1_pd(
+						fpr_gm_tab[((m + i1) << 1) + 0].v);
+					s_im8 = _mm512_set1_pd(
+						fpr_gm_tab[((m + i1) << 1) + 1].v);
+					for (; j < j2; j += 8) {
+						__m512d x_re, x_im, y_re, y_im;
+						__m512d z_re, z_im;
+
+						x_re = _mm512_loadu_pd(&f[j].v);
+						x_im = _mm512_loadu_pd(&f[j + hn].v);
+						z_re = _mm512_loadu_pd(&f[j+ht].v);
+						z_im = _mm512_loadu_pd(&f[j+ht + hn].v);
+						y_re = FMSUB512(z_re, s_re8,
+							_mm512_mul_pd(z_im, s_im8));
+						y_im = FMADD512(z_re, s_im8,
+							_mm512_mul_pd(z_im, s_re8));
+						_mm512_storeu_pd(&f[j].v,
+							_mm512_add_pd(x_re, y_re));
+						_mm512_storeu_pd(&f[j + hn].v,
+							_mm512_add_pd(x_im, y_im));
+						_mm512_storeu_pd(&f[j + ht].v,
+							_mm512_sub_pd(x_re, y_re));
+						_mm512_storeu_pd(&f[j + ht + hn].v,
+							_mm512_sub_pd(x_im, y_im));
+					}
+				}
+#endif
+				for (; j < j2; j += 4) {
 					__m256d x_re, x_im, y_re, y_im;
 					__m256d z_re, z_im;
 
@@ -299,10 +345,389 @@ Zf(FFT)(fpr *f, unsigned logn)
 	}
 }
 
+/*
+ * Apply the FFT layers u and u+1 in a single pass (radix-4 butterflies):
+ * each group of t slots is processed as four quarters, which are read
+ * and written once for both layers. The operations are the same as in
+ * fft_layers(), hence the results are identical. In AVX2 builds, this
+ * is used only with q >= 4 (both layers vectorized).
+ */
+TARGET_AVX2
+FFT_INLINE void
+fft_layers2(fpr *f, unsigned logn, unsigned u)
+{
+	size_t hn, t, q, m, hm, i1, j1;
+
+	hn = (size_t)1 << (logn - 1);
+	t = hn >> (u - 1);
+	q = t >> 2;
+	m = (size_t)1 << u;
+	hm = m >> 1;
+	for (i1 = 0, j1 = 0; i1 < hm; i1 ++, j1 += t) {
+		const fpr *s, *sa, *sb;
+		size_t j, j2;
+
+		s = &fpr_gm_tab[(m + i1) << 1];
+		sa = &fpr_gm_tab[((m + i1) << 2)];
+		sb = &fpr_gm_tab[((m + i1) << 2) + 2];
+		j2 = j1 + q;
+#if FALCON_AVX2 // yyyAVX2+1
+		if (q >= 4) {
+			__m256d s_re, s_im, sa_re, sa_im, sb_re, sb_im;
+
+			s_re = _mm256_set1_pd(s[0].v);
+			s_im = _mm256_set1_pd(s[1].v);
+			sa_re = _mm256_set1_pd(sa[0].v);
+			sa_im = _mm256_set1_pd(sa[1].v);
+			sb_re = _mm256_set1_pd(sb[0].v);
+			sb_im = _mm256_set1_pd(sb[1].v);
+			j = j1;
+#if FALCON_AVX512
+			if (q >= 8) {
+				__m512d s_re8, s_im8, sa_re8, sa_im8;
+				__m512d sb_re8, sb_im8;
+
+				s_re8 = _mm512_set1_pd(s[0].v);
+				s_im8 = _mm512_set1_pd(s[1].v);
+				sa_re8 = _mm512_set1_pd(sa[0].v);
+				sa_im8 = _mm512_set1_pd(sa[1].v);
+				sb_re8 = _mm512_set1_pd(sb[0].v);
+				sb_im8 = _mm512_set1_pd(sb[1].v);
+				for (; j < j2; j += 8) {
+					__m512d x0_re, x0_im, x1_re, x1_im;
+					__m512d x2_re, x2_im, x3_re, x3_im;
+					__m512d y_re, y_im;
+
+					x0_re = _mm512_loadu_pd(&f[j].v);
+					x0_im = _mm512_loadu_pd(&f[j + hn].v);
+					x1_re = _mm512_loadu_pd(&f[j + q].v);
+					x1_im = _mm512_loadu_pd(&f[j + q + hn].v);
+					x2_re = _mm512_loadu_pd(&f[j + 2 * q].v);
+					x2_im = _mm512_loadu_pd(
+						&f[j + 2 * q + hn].v);
+					x3_re = _mm512_loadu_pd(&f[j + 3 * q].v);
+					x3_im = _mm512_loadu_pd(
+						&f[j + 3 * q + hn].v);
+
+					y_re = FMSUB512(x2_re, s_re8,
+						_mm512_mul_pd(x2_im, s_im8));
+					y_im = FMADD512(x2_re, s_im8,
+						_mm512_mul_pd(x2_im, s_re8));
+					x2_re = _mm512_sub_pd(x0_re, y_re);
+					x2_im = _mm512_sub_pd(x0_im, y_im);
+					x0_re = _mm512_add_pd(x0_re, y_re);
+					x0_im = _mm512_add_pd(x0_im, y_im);
+					y_re = FMSUB512(x3_re, s_re8,
+						_mm512_mul_pd(x3_im, s_im8));
+					y_im = FMADD512(x3_re, s_im8,
+						_mm512_mul_pd(x3_im, s_re8));
+					x3_re = _mm512_sub_pd(x1_re, y_re);
+					x3_im = _mm512_sub_pd(x1_im, y_im);
+					x1_re = _mm512_add_pd(x1_re, y_re);
+					x1_im = _mm512_add_pd(x1_im, y_im);
+
+					y_re = FMSUB512(x1_re, sa_re8,
+						_mm512_mul_pd(x1_im, sa_im8));
+					y_im = FMADD512(x1_re, sa_im8,
+						_mm512_mul_pd(x1_im, sa_re8));
+					_mm512_storeu_pd(&f[j].v,
+						_mm512_add_pd(x0_re, y_re));
+					_mm512_storeu_pd(&f[j + hn].v,
+						_mm512_add_pd(x0_im, y_im));
+					_mm512_storeu_pd(&f[j + q].v,
+						_mm512_sub_pd(x0_re, y_re));
+					_mm512_storeu_pd(&f[j + q + hn].v,
+						_mm512_sub_pd(x0_im, y_im));
+					y_re = FMSUB512(x3_re, sb_re8,
+						_mm512_mul_pd(x3_im, sb_im8));
+					y_im = FMADD512(x3_re, sb_im8,
+						_mm512_mul_pd(x3_im, sb_re8));
+					_mm512_storeu_pd(&f[j + 2 * q].v,
+						_mm512_add_pd(x2_re, y_re));
+					_mm512_storeu_pd(&f[j + 2 * q + hn].v,
+						_mm512_add_pd(x2_im, y_im));
+					_mm512_storeu_pd(&f[j + 3 * q].v,
+						_mm512_sub_pd(x2_re, y_re));
+					_mm512_storeu_pd(&f[j + 3 * q + hn].v,
+						_mm512_sub_pd(x2_im, y_im));
+				}
+			}
+#endif
+			for (; j < j2; j += 4) {
+				__m256d x0_re, x0_im, x1_re, x1_im;
+				__m256d x2_re, x2_im, x3_re, x3_im;
+				__m256d y_re, y_im;
+
+				x0_re = _mm256_loadu_pd(&f[j].v);
+				x0_im = _mm256_loadu_pd(&f[j + hn].v);
+				x1_re = _mm256_loadu_pd(&f[j + q].v);
+				x1_im = _mm256_loadu_pd(&f[j + q + hn].v);
+				x2_re = _mm256_loadu_pd(&f[j + 2 * q].v);
+				x2_im = _mm256_loadu_pd(&f[j + 2 * q + hn].v);
+				x3_re = _mm256_loadu_pd(&f[j + 3 * q].v);
+				x3_im = _mm256_loadu_pd(&f[j + 3 * q + hn].v);
+
+				y_re = FMSUB(x2_re, s_re,
+					_mm256_mul_pd(x2_im, s_im));
+				y_im = FMADD(x2_re, s_im,
+					_mm256_mul_pd(x2_im, s_re));
+				x2_re = _mm256_sub_pd(x0_re, y_re);
+				x2_im = _mm256_sub_pd(x0_im, y_im);
+				x0_re = _mm256_add_pd(x0_re, y_re);
+				x0_im = _mm256_add_pd(x0_im, y_im);
+				y_re = FMSUB(x3_re, s_re,
+					_mm256_mul_pd(x3_im, s_im));
+				y_im = FMADD(x3_re, s_im,
+					_mm256_mul_pd(x3_im, s_re));
+				x3_re = _mm256_sub_pd(x1_re, y_re);
+				x3_im = _mm256_sub_pd(x1_im, y_im);
+				x1_re = _mm256_add_pd(x1_re, y_re);
+				x1_im = _mm256_add_pd(x1_im, y_im);
+
+				y_re = FMSUB(x1_re, sa_re,
+					_mm256_mul_pd(x1_im, sa_im));
+				y_im = FMADD(x1_re, sa_im,
+					_mm256_mul_pd(x1_im, sa_re));
+				_mm256_storeu_pd(&f[j].v,
+					_mm256_add_pd(x0_re, y_re));
+				_mm256_storeu_pd(&f[j + hn].v,
+					_mm256_add_pd(x0_im, y_im));
+				_mm256_storeu_pd(&f[j + q].v,
+					_mm256_sub_pd(x0_re, y_re));
+				_mm256_storeu_pd(&f[j + q + hn].v,
+					_mm256_sub_pd(x0_im, y_im));
+				y_re = FMSUB(x3_re, sb_re,
+					_mm256_mul_pd(x3_im, sb_im));
+				y_im = FMADD(x3_re, sb_im,
+					_mm256_mul_pd(x3_im, sb_re));
+				_mm256_storeu_pd(&f[j + 2 * q].v,
+					_mm256_add_pd(x2_re, y_re));
+				_mm256_storeu_pd(&f[j + 2 * q + hn].v,
+					_mm256_add_pd(x2_im, y_im));
+				_mm256_storeu_pd(&f[j + 3 * q].v,
+					_mm256_sub_pd(x2_re, y_re));
+				_mm256_storeu_pd(&f[j + 3 * q + hn].v,
+					_mm256_sub_pd(x2_im, y_im));
+			}
+			continue;
+		}
+#endif // yyyAVX2-
+		for (j = j1; j < j2; j ++) {
+			fpr x_re[4], x_im[4], y_re, y_im;
+			int k;
+
+			for (k = 0; k < 4; k ++) {
+				x_re[k] = f[j + k * q];
+				x_im[k] = f[j + k * q + hn];
+			}
+			for (k = 0; k < 2; k ++) {
+				FPC_MUL(y_re, y_im, x_re[k + 2], x_im[k + 2],
+					s[0], s[1]);
+				FPC_SUB(x_re[k + 2], x_im[k + 2],
+					x_re[k], x_im[k], y_re, y_im);
+				FPC_ADD(x_re[k], x_im[k],
+					x_re[k], x_im[k], y_re, y_im);
+			}
+			FPC_MUL(y_re, y_im, x_re[1], x_im[1], sa[0], sa[1]);
+			FPC_ADD(f[j], f[j + hn], x_re[0], x_im[0], y_re, y_im);
+			FPC_SUB(f[j + q], f[j + q + hn],
+				x_re[0], x_im[0], y_re, y_im);
+			FPC_MUL(y_re, y_im, x_re[3], x_im[3], sb[0], sb[1]);
+			FPC_ADD(f[j + 2 * q], f[j + 2 * q + hn],
+				x_re[2], x_im[2], y_re, y_im);
+			FPC_SUB(f[j + 3 * q], f[j + 3 * q + hn],
+				x_re[2], x_im[2], y_re, y_im);
+		}
+	}
+}
+
+/*
+ * Apply the last FFT layers for logn = 9 or 10 in a single pass: the
+ * layers with 4, 2 and 1 elements per half-group over blocks of 8 slots
+ * (AVX2), or the layers with 2 and 1 elements per half-group over
+ * blocks of 4 slots (scalar).
+ */
+TARGET_AVX2
+FFT_INLINE void
+fft_tail(fpr *f, unsigned logn)
+{
+#if FALCON_AVX2 // yyyAVX2+1
+	const fpr *tw;
+	size_t hn, j;
+
+	hn = (size_t)1 << (logn - 1);
+	tw = (logn == 9) ? fpr_gm_tail9 : fpr_gm_tail10;
+	for (j = 0; j < hn; j += 8, tw += 16) {
+		__m256d a_re, a_im, b_re, b_im, x_re, x_im, y_re, y_im;
+		__m256d z_re, z_im, s_re, s_im;
+
+		x_re = _mm256_loadu_pd(&f[j].v);
+		y_re = _mm256_loadu_pd(&f[j + 4].v);
+		x_im = _mm256_loadu_pd(&f[j + hn].v);
+		y_im = _mm256_loadu_pd(&f[j + hn + 4].v);
+
+		/*
+		 * ht = 4: x = (f0, f1, f2, f3), y = (f4, f5, f6, f7).
+		 */
+		s_re = _mm256_set1_pd(fpr_gm_tab[(hn >> 1) + (j >> 2)].v);
+		s_im = _mm256_set1_pd(fpr_gm_tab[(hn >> 1) + (j >> 2) + 1].v);
+		z_re = FMSUB(y_re, s_re, _mm256_mul_pd(y_im, s_im));
+		z_im = FMADD(y_re, s_im, _mm256_mul_pd(y_im, s_re));
+		a_re = _mm256_add_pd(x_re, z_re);
+		a_im = _mm256_add_pd(x_im, z_im);
+		b_re = _mm256_sub_pd(x_re, z_re);
+		b_im = _mm256_sub_pd(x_im, z_im);
+
+		/*
+		 * ht = 2: x = (f0, f1, f4, f5), y = (f2, f3, f6, f7).
+		 * Products are not fused, to match the scalar layers
+		 * of the generic code.
+		 */
+		x_re = _mm256_permute2f128_pd(a_re, b_re, 0x20);
+		y_re = _mm256_permute2f128_pd(a_re, b_re, 0x31);
+		x_im = _mm256_permute2f128_pd(a_im, b_im, 0x20);
+		y_im = _mm256_permute2f128_pd(a_im, b_im, 0x31);
+		s_re = _mm256_loadu_pd(&tw[0].v);
+		s_im = _mm256_loadu_pd(&tw[4].v);
+		z_re = _mm256_sub_pd(
+			_mm256_mul_pd(y_re, s_re), _mm256_mul_pd(y_im, s_im));
+		z_im = _mm256_add_pd(
+			_mm256_mul_pd(y_re, s_im), _mm256_mul_pd(y_im, s_re));
+		a_re = _mm256_add_pd(x_re, z_re);
+		a_im = _mm256_add_pd(x_im, z_im);
+		b_re = _mm256_sub_pd(x_re, z_re);
+		b_im = _mm256_sub_pd(x_im, z_im);
+
+		/*
+		 * ht = 1: x = (f0, f2, f4, f6), y = (f1, f3, f5, f7).
+		 */
+		x_re = _mm256_unpacklo_pd(a_re, b_re);
+		y_re = _mm256_unpackhi_pd(a_re, b_re);
+		x_im = _mm256_unpacklo_pd(a_im, b_im);
+		y_im = _mm256_unpackhi_pd(a_im, b_im);
+		s_re = _mm256_loadu_pd(&tw[8].v);
+		s_im = _mm256_loadu_pd(&tw[12].v);
+		z_re = _mm256_sub_pd(
+			_mm256_mul_pd(y_re, s_re), _mm256_mul_pd(y_im, s_im));
+		z_im = _mm256_add_pd(
+			_mm256_mul_pd(y_re, s_im), _mm256_mul_pd(y_im, s_re));
+		a_re = _mm256_add_pd(x_re, z_re);
+		a_im = _mm256_add_pd(x_im, z_im);
+		b_re = _mm256_sub_pd(x_re, z_re);
+		b_im = _mm256_sub_pd(x_im, z_im);
+
+		/*
+		 * Back to the natural order.
+		 */
+		x_re = _mm256_unpacklo_pd(a_re, b_re);
+		y_re = _mm256_unpackhi_pd(a_re, b_re);
+		x_im = _mm256_unpacklo_pd(a_im, b_im);
+		y_im = _mm256_unpackhi_pd(a_im, b_im);
+		_mm256_storeu_pd(&f[j].v,
+			_mm256_permute2f128_pd(x_re, y_re, 0x20));
+		_mm256_storeu_pd(&f[j + 4].v,
+			_mm256_permute2f128_pd(x_re, y_re, 0x31));
+		_mm256_storeu_pd(&f[j + hn].v,
+			_mm256_permute2f128_pd(x_im, y_im, 0x20));
+		_mm256_storeu_pd(&f[j + hn + 4].v,
+			_mm256_permute2f128_pd(x_im, y_im, 0x31));
+	}
+#else // yyyAVX2+0
+	const fpr *gm2, *gm1;
+	size_t hn, j;
+
+	hn = (size_t)1 << (logn - 1);
+	gm2 = &fpr_gm_tab[hn];
+	gm1 = &fpr_gm_tab[hn << 1];
+	for (j = 0; j < hn; j += 4, gm2 += 2, gm1 += 4) {
+		fpr x_re[4], x_im[4], y_re, y_im;
+		int k;
+
+		for (k = 0; k < 4; k ++) {
+			x_re[k] = f[j + k];
+			x_im[k] = f[j + k + hn];
+		}
+		for (k = 0; k < 2; k ++) {
+			FPC_MUL(y_re, y_im, x_re[k + 2], x_im[k + 2],
+				gm2[0], gm2[1]);
+			FPC_SUB(x_re[k + 2], x_im[k + 2],
+				x_re[k], x_im[k], y_re, y_im);
+			FPC_ADD(x_re[k], x_im[k],
+				x_re[k], x_im[k], y_re, y_im);
+		}
+		for (k = 0; k < 4; k += 2) {
+			FPC_MUL(y_re, y_im, x_re[k + 1], x_im[k + 1],
+				gm1[k], gm1[k + 1]);
+			FPC_ADD(f[j + k], f[j + k + hn],
+				x_re[k], x_im[k], y_re, y_im);
+			FPC_SUB(f[j + k + 1], f[j + k + 1 + hn],
+				x_re[k], x_im[k], y_re, y_im);
+		}
+	}
+#endif // yyyAVX2-
+}
+
+/*
+ * FFT specialized for a constant logn (9 or 10). Layers are merged by
+ * pairs, so that the array is read and written 4 or 5 times instead of
+ * logn - 1.
+ */
+TARGET_AVX2
+FFT_INLINE void
+fft_fixed(fpr *f, unsigned logn)
+{
+	unsigned u, ulim;
+
+#if FALCON_AVX2 // yyyAVX2+1
+	ulim = logn - 3;
+#else // yyyAVX2+0
+	ulim = logn - 2;
+#endif // yyyAVX2-
+	u = 1;
+	if (((ulim - u) & 1) != 0) {
+		fft_layers(f, logn, u, u + 1);
+		u ++;
+	}
+	for (; u < ulim; u += 2) {
+		fft_layers2(f, logn, u);
+	}
+	fft_tail(f, logn);
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(FFT_generic)(fpr *f, unsigned logn)
+{
+	fft_layers(f, logn, 1, logn);
+}
+
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(iFFT)(fpr *f, unsigned logn)
+Zk(FFT)(fpr *f, unsigned logn)
+{
+	switch (logn) {
+	case 9:
+		fft_fixed(f, 9);
+		break;
+	case 10:
+		fft_fixed(f, 10);
+		break;
+	default:
+		Zk(FFT_generic)(f, logn);
+		break;
+	}
+}
+
+/*
+ * Apply the iFFT layers ustart down to ulim+1 (all layers if
+ * ustart = logn and ulim = 1), one pass over the array per layer. The
+ * final division is done separately, by ifft_scale().
+ */
+TARGET_AVX2
+FFT_INLINE void
+ifft_layers(fpr *f, unsigned logn, unsigned ustart, unsigned ulim)
 {
 	/*
 	 * Inverse FFT algorithm in bit-reversal order uses the following
@@ -349,10 +774,10 @@ Zf(iFFT)(fpr *f, unsigned logn)
 	size_t u, n, hn, t, m;
 
 	n = (size_t)1 << logn;
-	t = 1;
-	m = n;
+	t = (size_t)1 << (logn - ustart);
+	m = n >> (logn - ustart);
 	hn = n >> 1;
-	for (u = logn; u > 1; u --) {
+	for (u = ustart; u > ulim; u --) {
 		size_t hm, dt, i1, j1;
 
 		hm = m >> 1;
@@ -369,7 +794,39 @@ Zf(iFFT)(fpr *f, unsigned logn)
 					fpr_gm_tab[((hm + i1) << 1) + 0].v);
 				s_im = _mm256_set1_pd(
 					fpr_gm_tab[((hm + i1) << 1) + 1].v);
-				for (j = j1; j < j2; j += 4) {
+				j = j1;
+#if FALCON_AVX512
+				if (t >= 8) {
+					__m512d s_re8, s_im8;
+
+					s_re8 = _mm512_set1_pd(
+						fpr_gm_tab[((hm + i1) << 1) + 0].v);
+					s_im8 = _mm512_set1_pd(
+						fpr_gm_tab[((hm + i1) << 1) + 1].v);
+					for (; j < j2; j += 8) {
+						__m512d x_re, x_im, y_re, y_im;
+						__m512d z_re, z_im;
+
+						x_re = _mm512_loadu_pd(&f[j].v);
+						x_im = _mm512_loadu_pd(&f[j + hn].v);
+						y_re = _mm512_loadu_pd(&f[j+t].v);
+						y_im = _mm512_loadu_pd(&f[j+t + hn].v);
+						_mm512_storeu_pd(&f[j].v,
+							_mm512_add_pd(x_re, y_re));
+						_mm512_storeu_pd(&f[j + hn].v,
+							_mm512_add_pd(x_im, y_im));
+						x_re = _mm512_sub_pd(y_re, x_re);
+						x_im = _mm512_sub_pd(x_im, y_im);
+						z_re = FMSUB512(x_im, s_im8,
+							_mm512_mul_pd(x_re, s_re8));
+						z_im = FMADD512(x_re, s_im8,
+							_mm512_mul_pd(x_im, s_re8));
+						_mm512_storeu_pd(&f[j+t].v, z_re);
+						_mm512_storeu_pd(&f[j+t + hn].v, z_im);
+					}
+				}
+#endif
+				for (; j < j2; j += 4) {
 					__m256d x_re, x_im, y_re, y_im;
 					__m256d z_re, z_im;
 
@@ -433,11 +890,22 @@ Zf(iFFT)(fpr *f, unsigned logn)
 		t = dt;
 		m = hm;
 	}
+}
+
+/*
+ * Final division of the iFFT.
+ */
+TARGET_AVX2
+FFT_INLINE void
+ifft_scale(fpr *f, unsigned logn)
+{
+	size_t u, n;
 
 	/*
 	 * Last iteration is a no-op, provided that we divide by N/2
 	 * instead of N. We need to make a special case for logn = 0.
 	 */
+	n = (size_t)1 << logn;
 	if (logn > 0) {
 		fpr ni;
 
@@ -448,10 +916,418 @@ Zf(iFFT)(fpr *f, unsigned logn)
 	}
 }
 
+/*
+ * Apply the iFFT layers u and u-1 in a single pass (radix-4 butterflies);
+ * if 'scale' is non-zero, the final division is also applied to the
+ * output values. The operations are the same as in ifft_layers() and
+ * ifft_scale(), hence the results are identical. In AVX2 builds, this
+ * is used only with t >= 4 (both layers vectorized).
+ */
+TARGET_AVX2
+FFT_INLINE void
+ifft_layers2(fpr *f, unsigned logn, unsigned u, int scale)
+{
+	size_t hn, t, h2, i1, j1;
+	fpr ni;
+
+	hn = (size_t)1 << (logn - 1);
+	t = (size_t)1 << (logn - u);
+	h2 = hn >> (logn - u + 1);
+	ni = fpr_p2_tab[logn];
+	for (i1 = 0, j1 = 0; j1 < hn; i1 ++, j1 += t << 2) {
+		const fpr *s0, *s1, *s2;
+		size_t j, j2;
+
+		s0 = &fpr_gm_tab[(h2 + i1) << 2];
+		s1 = &fpr_gm_tab[((h2 + i1) << 2) + 2];
+		s2 = &fpr_gm_tab[(h2 + i1) << 1];
+		j2 = j1 + t;
+#if FALCON_AVX2 // yyyAVX2+1
+		if (t >= 4) {
+			__m256d s0_re, s0_im, s1_re, s1_im, s2_re, s2_im, n4;
+
+			s0_re = _mm256_set1_pd(s0[0].v);
+			s0_im = _mm256_set1_pd(s0[1].v);
+			s1_re = _mm256_set1_pd(s1[0].v);
+			s1_im = _mm256_set1_pd(s1[1].v);
+			s2_re = _mm256_set1_pd(s2[0].v);
+			s2_im = _mm256_set1_pd(s2[1].v);
+			n4 = _mm256_set1_pd(ni.v);
+			j = j1;
+#if FALCON_AVX512
+			if (t >= 8) {
+				__m512d s0_re8, s0_im8, s1_re8, s1_im8;
+				__m512d s2_re8, s2_im8, n8;
+
+				s0_re8 = _mm512_set1_pd(s0[0].v);
+				s0_im8 = _mm512_set1_pd(s0[1].v);
+				s1_re8 = _mm512_set1_pd(s1[0].v);
+				s1_im8 = _mm512_set1_pd(s1[1].v);
+				s2_re8 = _mm512_set1_pd(s2[0].v);
+				s2_im8 = _mm512_set1_pd(s2[1].v);
+				n8 = _mm512_set1_pd(ni.v);
+				for (; j < j2; j += 8) {
+					__m512d x0_re, x0_im, x1_re, x1_im;
+					__m512d x2_re, x2_im, x3_re, x3_im;
+					__m512d y_re, y_im;
+
+					x0_re = _mm512_loadu_pd(&f[j].v);
+					x0_im = _mm512_loadu_pd(&f[j + hn].v);
+					x1_re = _mm512_loadu_pd(&f[j + t].v);
+					x1_im = _mm512_loadu_pd(&f[j + t + hn].v);
+					x2_re = _mm512_loadu_pd(&f[j + 2 * t].v);
+					x2_im = _mm512_loadu_pd(
+						&f[j + 2 * t + hn].v);
+					x3_re = _mm512_loadu_pd(&f[j + 3 * t].v);
+					x3_im = _mm512_loadu_pd(
+						&f[j + 3 * t + hn].v);
+
+					y_re = _mm512_sub_pd(x1_re, x0_re);
+					y_im = _mm512_sub_pd(x0_im, x1_im);
+					x0_re = _mm512_add_pd(x0_re, x1_re);
+					x0_im = _mm512_add_pd(x0_im, x1_im);
+					x1_re = FMSUB512(y_im, s0_im8,
+						_mm512_mul_pd(y_re, s0_re8));
+					x1_im = FMADD512(y_re, s0_im8,
+						_mm512_mul_pd(y_im, s0_re8));
+					y_re = _mm512_sub_pd(x3_re, x2_re);
+					y_im = _mm512_sub_pd(x2_im, x3_im);
+					x2_re = _mm512_add_pd(x2_re, x3_re);
+					x2_im = _mm512_add_pd(x2_im, x3_im);
+					x3_re = FMSUB512(y_im, s1_im8,
+						_mm512_mul_pd(y_re, s1_re8));
+					x3_im = FMADD512(y_re, s1_im8,
+						_mm512_mul_pd(y_im, s1_re8));
+
+					y_re = _mm512_sub_pd(x2_re, x0_re);
+					y_im = _mm512_sub_pd(x0_im, x2_im);
+					x0_re = _mm512_add_pd(x0_re, x2_re);
+					x0_im = _mm512_add_pd(x0_im, x2_im);
+					x2_re = FMSUB512(y_im, s2_im8,
+						_mm512_mul_pd(y_re, s2_re8));
+					x2_im = FMADD512(y_re, s2_im8,
+						_mm512_mul_pd(y_im, s2_re8));
+					y_re = _mm512_sub_pd(x3_re, x1_re);
+					y_im = _mm512_sub_pd(x1_im, x3_im);
+					x1_re = _mm512_add_pd(x1_re, x3_re);
+					x1_im = _mm512_add_pd(x1_im, x3_im);
+					x3_re = FMSUB512(y_im, s2_im8,
+						_mm512_mul_pd(y_re, s2_re8));
+					x3_im = FMADD512(y_re, s2_im8,
+						_mm512_mul_pd(y_im, s2_re8));
+
+					if (scale) {
+						x0_re = _mm512_mul_pd(x0_re, n8);
+						x0_im = _mm512_mul_pd(x0_im, n8);
+						x1_re = _mm512_mul_pd(x1_re, n8);
+						x1_im = _mm512_mul_pd(x1_im, n8);
+						x2_re = _mm512_mul_pd(x2_re, n8);
+						x2_im = _mm512_mul_pd(x2_im, n8);
+						x3_re = _mm512_mul_pd(x3_re, n8);
+						x3_im = _mm512_mul_pd(x3_im, n8);
+					}
+					_mm512_storeu_pd(&f[j].v, x0_re);
+					_mm512_storeu_pd(&f[j + hn].v, x0_im);
+					_mm512_storeu_pd(&f[j + t].v, x1_re);
+					_mm512_storeu_pd(
+						&f[j + t + hn].v, x1_im);
+					_mm512_storeu_pd(
+						&f[j + 2 * t].v, x2_re);
+					_mm512_storeu_pd(
+						&f[j + 2 * t + hn].v, x2_im);
+					_mm512_storeu_pd(
+						&f[j + 3 * t].v, x3_re);
+					_mm512_storeu_pd(
+						&f[j + 3 * t + hn].v, x3_im);
+				}
+			}
+#endif
+			for (; j < j2; j += 4) {
+				__m256d x0_re, x0_im, x1_re, x1_im;
+				__m256d x2_re, x2_im, x3_re, x3_im;
+				__m256d y_re, y_im;
+
+				x0_re = _mm256_loadu_pd(&f[j].v);
+				x0_im = _mm256_loadu_pd(&f[j + hn].v);
+				x1_re = _mm256_loadu_pd(&f[j + t].v);
+				x1_im = _mm256_loadu_pd(&f[j + t + hn].v);
+				x2_re = _mm256_loadu_pd(&f[j + 2 * t].v);
+				x2_im = _mm256_loadu_pd(&f[j + 2 * t + hn].v);
+				x3_re = _mm256_loadu_pd(&f[j + 3 * t].v);
+				x3_im = _mm256_loadu_pd(&f[j + 3 * t + hn].v);
+
+				y_re = _mm256_sub_pd(x1_re, x0_re);
+				y_im = _mm256_sub_pd(x0_im, x1_im);
+				x0_re = _mm256_add_pd(x0_re, x1_re);
+				x0_im = _mm256_add_pd(x0_im, x1_im);
+				x1_re = FMSUB(y_im, s0_im,
+					_mm256_mul_pd(y_re, s0_re));
+				x1_im = FMADD(y_re, s0_im,
+					_mm256_mul_pd(y_im, s0_re));
+				y_re = _mm256_sub_pd(x3_re, x2_re);
+				y_im = _mm256_sub_pd(x2_im, x3_im);
+				x2_re = _mm256_add_pd(x2_re, x3_re);
+				x2_im = _mm256_add_pd(x2_im, x3_im);
+				x3_re = FMSUB(y_im, s1_im,
+					_mm256_mul_pd(y_re, s1_re));
+				x3_im = FMADD(y_re, s1_im,
+					_mm256_mul_pd(y_im, s1_re));
+
+				y_re = _mm256_sub_pd(x2_re, x0_re);
+				y_im = _mm256_sub_pd(x0_im, x2_im);
+				x0_re = _mm256_add_pd(x0_re, x2_re);
+				x0_im = _mm256_add_pd(x0_im, x2_im);
+				x2_re = FMSUB(y_im, s2_im,
+					_mm256_mul_pd(y_re, s2_re));
+				x2_im = FMADD(y_re, s2_im,
+					_mm256_mul_pd(y_im, s2_re));
+				y_re = _mm256_sub_pd(x3_re, x1_re);
+				y_im = _mm256_sub_pd(x1_im, x3_im);
+				x1_re = _mm256_add_pd(x1_re, x3_re);
+				x1_im = _mm256_add_pd(x1_im, x3_im);
+				x3_re = FMSUB(y_im, s2_im,
+					_mm256_mul_pd(y_re, s2_re));
+				x3_im = FMADD(y_re, s2_im,
+					_mm256_mul_pd(y_im, s2_re));
+
+				if (scale) {
+					x0_re = _mm256_mul_pd(x0_re, n4);
+					x0_im = _mm256_mul_pd(x0_im, n4);
+					x1_re = _mm256_mul_pd(x1_re, n4);
+					x1_im = _mm256_mul_pd(x1_im, n4);
+					x2_re = _mm256_mul_pd(x2_re, n4);
+					x2_im = _mm256_mul_pd(x2_im, n4);
+					x3_re = _mm256_mul_pd(x3_re, n4);
+					x3_im = _mm256_mul_pd(x3_im, n4);
+				}
+				_mm256_storeu_pd(&f[j].v, x0_re);
+				_mm256_storeu_pd(&f[j + hn].v, x0_im);
+				_mm256_storeu_pd(&f[j + t].v, x1_re);
+				_mm256_storeu_pd(&f[j + t + hn].v, x1_im);
+				_mm256_storeu_pd(&f[j + 2 * t].v, x2_re);
+				_mm256_storeu_pd(&f[j + 2 * t + hn].v, x2_im);
+				_mm256_storeu_pd(&f[j + 3 * t].v, x3_re);
+				_mm256_storeu_pd(&f[j + 3 * t + hn].v, x3_im);
+			}
+			continue;
+		}
+#endif // yyyAVX2-
+		for (j = j1; j < j2; j ++) {
+			fpr x_re[4], x_im[4], y_re, y_im;
+			int k;
+
+			for (k = 0; k < 4; k ++) {
+				x_re[k] = f[j + k * t];
+				x_im[k] = f[j + k * t + hn];
+			}
+			for (k = 0; k < 4; k += 2) {
+				const fpr *s;
+
+				s = (k == 0) ? s0 : s1;
+				FPC_SUB(y_re, y_im, x_re[k], x_im[k],
+					x_re[k + 1], x_im[k + 1]);
+				FPC_ADD(x_re[k], x_im[k], x_re[k], x_im[k],
+					x_re[k + 1], x_im[k + 1]);
+				FPC_MUL(x_re[k + 1], x_im[k + 1], y_re, y_im,
+					s[0], fpr_neg(s[1]));
+			}
+			for (k = 0; k < 2; k ++) {
+				FPC_SUB(y_re, y_im, x_re[k], x_im[k],
+					x_re[k + 2], x_im[k + 2]);
+				FPC_ADD(x_re[k], x_im[k], x_re[k], x_im[k],
+					x_re[k + 2], x_im[k + 2]);
+				FPC_MUL(x_re[k + 2], x_im[k + 2], y_re, y_im,
+					s2[0], fpr_neg(s2[1]));
+			}
+			for (k = 0; k < 4; k ++) {
+				if (scale) {
+					x_re[k] = fpr_mul(x_re[k], ni);
+					x_im[k] = fpr_mul(x_im[k], ni);
+				}
+				f[j + k * t] = x_re[k];
+				f[j + k * t + hn] = x_im[k];
+			}
+		}
+	}
+}
+
+/*
+ * Apply the first iFFT layers for logn = 9 or 10 in a single pass (three
+ * layers with AVX2, two otherwise); this mirrors fft_tail().
+ */
+TARGET_AVX2
+FFT_INLINE void
+ifft_head(fpr *f, unsigned logn)
+{
+#if FALCON_AVX2 // yyyAVX2+1
+	const fpr *tw;
+	size_t hn, j;
+	__m256d neg;
+
+	hn = (size_t)1 << (logn - 1);
+	tw = (logn == 9) ? fpr_gm_tail9 : fpr_gm_tail10;
+	neg = _mm256_set1_pd(-0.0);
+	for (j = 0; j < hn; j += 8, tw += 16) {
+		__m256d a_re, a_im, b_re, b_im, x_re, x_im, y_re, y_im;
+		__m256d s_re, s_im;
+
+		a_re = _mm256_loadu_pd(&f[j].v);
+		b_re = _mm256_loadu_pd(&f[j + 4].v);
+		a_im = _mm256_loadu_pd(&f[j + hn].v);
+		b_im = _mm256_loadu_pd(&f[j + hn + 4].v);
+		x_re = _mm256_permute2f128_pd(a_re, b_re, 0x20);
+		y_re = _mm256_permute2f128_pd(a_re, b_re, 0x31);
+		x_im = _mm256_permute2f128_pd(a_im, b_im, 0x20);
+		y_im = _mm256_permute2f128_pd(a_im, b_im, 0x31);
+
+		/*
+		 * t = 1: x = (f0, f2, f4, f6), y = (f1, f3, f5, f7).
+		 * We multiply by the conjugate of the twiddle factor,
+		 * with the same (non-fused) operations as the scalar
+		 * layers of the generic code.
+		 */
+		a_re = _mm256_unpacklo_pd(x_re, y_re);
+		b_re = _mm256_unpackhi_pd(x_re, y_re);
+		a_im = _mm256_unpacklo_pd(x_im, y_im);
+		b_im = _mm256_unpackhi_pd(x_im, y_im);
+		x_re = _mm256_add_pd(a_re, b_re);
+		x_im = _mm256_add_pd(a_im, b_im);
+		a_re = _mm256_sub_pd(a_re, b_re);
+		a_im = _mm256_sub_pd(a_im, b_im);
+		s_re = _mm256_loadu_pd(&tw[8].v);
+		s_im = _mm256_xor_pd(_mm256_loadu_pd(&tw[12].v), neg);
+		y_re = _mm256_sub_pd(
+			_mm256_mul_pd(a_re, s_re), _mm256_mul_pd(a_im, s_im));
+		y_im = _mm256_add_pd(
+			_mm256_mul_pd(a_re, s_im), _mm256_mul_pd(a_im, s_re));
+
+		/*
+		 * t = 2: x = (f0, f1, f4, f5), y = (f2, f3, f6, f7).
+		 */
+		a_re = _mm256_unpacklo_pd(x_re, y_re);
+		b_re = _mm256_unpackhi_pd(x_re, y_re);
+		a_im = _mm256_unpacklo_pd(x_im, y_im);
+		b_im = _mm256_unpackhi_pd(x_im, y_im);
+		x_re = _mm256_add_pd(a_re, b_re);
+		x_im = _mm256_add_pd(a_im, b_im);
+		a_re = _mm256_sub_pd(a_re, b_re);
+		a_im = _mm256_sub_pd(a_im, b_im);
+		s_re = _mm256_loadu_pd(&tw[0].v);
+		s_im = _mm256_xor_pd(_mm256_loadu_pd(&tw[4].v), neg);
+		y_re = _mm256_sub_pd(
+			_mm256_mul_pd(a_re, s_re), _mm256_mul_pd(a_im, s_im));
+		y_im = _mm256_add_pd(
+			_mm256_mul_pd(a_re, s_im), _mm256_mul_pd(a_im, s_re));
+
+		/*
+		 * t = 4: x = (f0, f1, f2, f3), y = (f4, f5, f6, f7).
+		 */
+		a_re = _mm256_permute2f128_pd(x_re, y_re, 0x20);
+		b_re = _mm256_permute2f128_pd(x_re, y_re, 0x31);
+		a_im = _mm256_permute2f128_pd(x_im, y_im, 0x20);
+		b_im = _mm256_permute2f128_pd(x_im, y_im, 0x31);
+		_mm256_storeu_pd(&f[j].v, _mm256_add_pd(a_re, b_re));
+		_mm256_storeu_pd(&f[j + hn].v, _mm256_add_pd(a_im, b_im));
+		a_re = _mm256_sub_pd(b_re, a_re);
+		a_im = _mm256_sub_pd(a_im, b_im);
+		s_re = _mm256_set1_pd(fpr_gm_tab[(hn >> 1) + (j >> 2)].v);
+		s_im = _mm256_set1_pd(fpr_gm_tab[(hn >> 1) + (j >> 2) + 1].v);
+		_mm256_storeu_pd(&f[j + 4].v,
+			FMSUB(a_im, s_im, _mm256_mul_pd(a_re, s_re)));
+		_mm256_storeu_pd(&f[j + hn + 4].v,
+			FMADD(a_re, s_im, _mm256_mul_pd(a_im, s_re)));
+	}
+#else // yyyAVX2+0
+	const fpr *gm2, *gm1;
+	size_t hn, j;
+
+	hn = (size_t)1 << (logn - 1);
+	gm2 = &fpr_gm_tab[hn];
+	gm1 = &fpr_gm_tab[hn << 1];
+	for (j = 0; j < hn; j += 4, gm2 += 2, gm1 += 4) {
+		fpr x_re[4], x_im[4], y_re, y_im;
+		int k;
+
+		for (k = 0; k < 4; k += 2) {
+			fpr a_re, a_im, b_re, b_im;
+
+			a_re = f[j + k];
+			a_im = f[j + k + hn];
+			b_re = f[j + k + 1];
+			b_im = f[j + k + 1 + hn];
+			FPC_ADD(x_re[k], x_im[k], a_re, a_im, b_re, b_im);
+			FPC_SUB(y_re, y_im, a_re, a_im, b_re, b_im);
+			FPC_MUL(x_re[k + 1], x_im[k + 1], y_re, y_im,
+				gm1[k], fpr_neg(gm1[k + 1]));
+		}
+		for (k = 0; k < 2; k ++) {
+			FPC_ADD(f[j + k], f[j + k + hn],
+				x_re[k], x_im[k], x_re[k + 2], x_im[k + 2]);
+			FPC_SUB(y_re, y_im,
+				x_re[k], x_im[k], x_re[k + 2], x_im[k + 2]);
+			FPC_MUL(f[j + k + 2], f[j + k + 2 + hn], y_re, y_im,
+				gm2[0], fpr_neg(gm2[1]));
+		}
+	}
+#endif // yyyAVX2-
+}
+
+/*
+ * iFFT specialized for a constant logn (9 or 10). Layers are merged by
+ * pairs, and the final division is done in the last pass.
+ */
+TARGET_AVX2
+FFT_INLINE void
+ifft_fixed(fpr *f, unsigned logn)
+{
+	unsigned u;
+
+	ifft_head(f, logn);
+#if FALCON_AVX2 // yyyAVX2+1
+	u = logn - 3;
+#else // yyyAVX2+0
+	u = logn - 2;
+#endif // yyyAVX2-
+	if (((u - 1) & 1) != 0) {
+		ifft_layers(f, logn, u, u - 1);
+		u --;
+	}
+	for (; u > 1; u -= 2) {
+		ifft_layers2(f, logn, u, u == 3);
+	}
+}
+
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_add)(
+Zk(iFFT_generic)(fpr *f, unsigned logn)
+{
+	ifft_layers(f, logn, logn, 1);
+	ifft_scale(f, logn);
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(iFFT)(fpr *f, unsigned logn)
+{
+	switch (logn) {
+	case 9:
+		ifft_fixed(f, 9);
+		break;
+	case 10:
+		ifft_fixed(f, 10);
+		break;
+	default:
+		Zk(iFFT_generic)(f, logn);
+		break;
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_add)(
 	fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, u;
@@ -459,7 +1335,18 @@ Zf(poly_add)(
 	n = (size_t)1 << logn;
 #if FALCON_AVX2 // yyyAVX2+1
 	if (n >= 4) {
-		for (u = 0; u < n; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (n >= 8) {
+			for (; u < n; u += 8) {
+				_mm512_storeu_pd(&a[u].v,
+					_mm512_add_pd(
+						_mm512_loadu_pd(&a[u].v),
+						_mm512_loadu_pd(&b[u].v)));
+			}
+		}
+#endif
+		for (; u < n; u += 4) {
 			_mm256_storeu_pd(&a[u].v,
 				_mm256_add_pd(
 					_mm256_loadu_pd(&a[u].v),
@@ -480,7 +1367,7 @@ Zf(poly_add)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_sub)(
+Zk(poly_sub)(
 	fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, u;
@@ -488,7 +1375,18 @@ Zf(poly_sub)(
 	n = (size_t)1 << logn;
 #if FALCON_AVX2 // yyyAVX2+1
 	if (n >= 4) {
-		for (u = 0; u < n; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (n >= 8) {
+			for (; u < n; u += 8) {
+				_mm512_storeu_pd(&a[u].v,
+					_mm512_sub_pd(
+						_mm512_loadu_pd(&a[u].v),
+						_mm512_loadu_pd(&b[u].v)));
+			}
+		}
+#endif
+		for (; u < n; u += 4) {
 			_mm256_storeu_pd(&a[u].v,
 				_mm256_sub_pd(
 					_mm256_loadu_pd(&a[u].v),
@@ -509,7 +1407,7 @@ Zf(poly_sub)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_neg)(fpr *a, unsigned logn)
+Zk(poly_neg)(fpr *a, unsigned logn)
 {
 	size_t n, u;
 
@@ -519,7 +1417,19 @@ Zf(poly_neg)(fpr *a, unsigned logn)
 		__m256d s;
 
 		s = _mm256_set1_pd(-0.0);
-		for (u = 0; u < n; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (n >= 8) {
+			__m512d s8;
+
+			s8 = _mm512_set1_pd(-0.0);
+			for (; u < n; u += 8) {
+				_mm512_storeu_pd(&a[u].v, _mm512_xor_pd(
+					_mm512_loadu_pd(&a[u].v), s8));
+			}
+		}
+#endif
+		for (; u < n; u += 4) {
 			_mm256_storeu_pd(&a[u].v,
 				_mm256_xor_pd(_mm256_loadu_pd(&a[u].v), s));
 		}
@@ -538,7 +1448,7 @@ Zf(poly_neg)(fpr *a, unsigned logn)
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_adj_fft)(fpr *a, unsigned logn)
+Zk(poly_adj_fft)(fpr *a, unsigned logn)
 {
 	size_t n, u;
 
@@ -548,7 +1458,19 @@ Zf(poly_adj_fft)(fpr *a, unsigned logn)
 		__m256d s;
 
 		s = _mm256_set1_pd(-0.0);
-		for (u = (n >> 1); u < n; u += 4) {
+		u = (n >> 1);
+#if FALCON_AVX512
+		if (n >= 16) {
+			__m512d s8;
+
+			s8 = _mm512_set1_pd(-0.0);
+			for (; u < n; u += 8) {
+				_mm512_storeu_pd(&a[u].v, _mm512_xor_pd(
+					_mm512_loadu_pd(&a[u].v), s8));
+			}
+		}
+#endif
+		for (; u < n; u += 4) {
 			_mm256_storeu_pd(&a[u].v,
 				_mm256_xor_pd(_mm256_loadu_pd(&a[u].v), s));
 		}
@@ -567,7 +1489,7 @@ Zf(poly_adj_fft)(fpr *a, unsigned logn)
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_mul_fft)(
+Zk(poly_mul_fft)(
 	fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, hn, u;
@@ -576,7 +1498,26 @@ Zf(poly_mul_fft)(
 	hn = n >> 1;
 #if FALCON_AVX2 // yyyAVX2+1
 	if (n >= 8) {
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			for (; u < hn; u += 8) {
+				__m512d a_re, a_im, b_re, b_im, c_re, c_im;
+
+				a_re = _mm512_loadu_pd(&a[u].v);
+				a_im = _mm512_loadu_pd(&a[u + hn].v);
+				b_re = _mm512_loadu_pd(&b[u].v);
+				b_im = _mm512_loadu_pd(&b[u + hn].v);
+				c_re = FMSUB512(
+					a_re, b_re, _mm512_mul_pd(a_im, b_im));
+				c_im = FMADD512(
+					a_re, b_im, _mm512_mul_pd(a_im, b_re));
+				_mm512_storeu_pd(&a[u].v, c_re);
+				_mm512_storeu_pd(&a[u + hn].v, c_im);
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d a_re, a_im, b_re, b_im, c_re, c_im;
 
 			a_re = _mm256_loadu_pd(&a[u].v);
@@ -617,7 +1558,7 @@ Zf(poly_mul_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_muladj_fft)(
+Zk(poly_muladj_fft)(
 	fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, hn, u;
@@ -626,7 +1567,26 @@ Zf(poly_muladj_fft)(
 	hn = n >> 1;
 #if FALCON_AVX2 // yyyAVX2+1
 	if (n >= 8) {
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			for (; u < hn; u += 8) {
+				__m512d a_re, a_im, b_re, b_im, c_re, c_im;
+
+				a_re = _mm512_loadu_pd(&a[u].v);
+				a_im = _mm512_loadu_pd(&a[u + hn].v);
+				b_re = _mm512_loadu_pd(&b[u].v);
+				b_im = _mm512_loadu_pd(&b[u + hn].v);
+				c_re = FMADD512(
+					a_re, b_re, _mm512_mul_pd(a_im, b_im));
+				c_im = FMSUB512(
+					a_im, b_re, _mm512_mul_pd(a_re, b_im));
+				_mm512_storeu_pd(&a[u].v, c_re);
+				_mm512_storeu_pd(&a[u + hn].v, c_im);
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d a_re, a_im, b_re, b_im, c_re, c_im;
 
 			a_re = _mm256_loadu_pd(&a[u].v);
@@ -667,7 +1627,7 @@ Zf(poly_muladj_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_mulselfadj_fft)(fpr *a, unsigned logn)
+Zk(poly_mulselfadj_fft)(fpr *a, unsigned logn)
 {
 	/*
 	 * Since each coefficient is multiplied with its own conjugate,
@@ -682,7 +1642,25 @@ Zf(poly_mulselfadj_fft)(fpr *a, unsigned logn)
 		__m256d zero;
 
 		zero = _mm256_setzero_pd();
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			__m512d zero8;
+
+			zero8 = _mm512_setzero_pd();
+			for (; u < hn; u += 8) {
+				__m512d a_re, a_im;
+
+				a_re = _mm512_loadu_pd(&a[u].v);
+				a_im = _mm512_loadu_pd(&a[u + hn].v);
+				_mm512_storeu_pd(&a[u].v,
+					FMADD512(a_re, a_re,
+						_mm512_mul_pd(a_im, a_im)));
+				_mm512_storeu_pd(&a[u + hn].v, zero8);
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d a_re, a_im;
 
 			a_re = _mm256_loadu_pd(&a[u].v);
@@ -717,7 +1695,7 @@ Zf(poly_mulselfadj_fft)(fpr *a, unsigned logn)
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_mulconst)(fpr *a, fpr x, unsigned logn)
+Zk(poly_mulconst)(fpr *a, fpr x, unsigned logn)
 {
 	size_t n, u;
 
@@ -727,7 +1705,20 @@ Zf(poly_mulconst)(fpr *a, fpr x, unsigned logn)
 		__m256d x4;
 
 		x4 = _mm256_set1_pd(x.v);
-		for (u = 0; u < n; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (n >= 8) {
+			__m512d x8;
+
+			x8 = _mm512_set1_pd(x.v);
+			for (; u < n; u += 8) {
+				_mm512_storeu_pd(&a[u].v,
+					_mm512_mul_pd(x8,
+						_mm512_loadu_pd(&a[u].v)));
+			}
+		}
+#endif
+		for (; u < n; u += 4) {
 			_mm256_storeu_pd(&a[u].v,
 				_mm256_mul_pd(x4, _mm256_loadu_pd(&a[u].v)));
 		}
@@ -746,7 +1737,7 @@ Zf(poly_mulconst)(fpr *a, fpr x, unsigned logn)
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_div_fft)(
+Zk(poly_div_fft)(
 	fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, hn, u;
@@ -758,7 +1749,34 @@ Zf(poly_div_fft)(
 		__m256d one;
 
 		one = _mm256_set1_pd(1.0);
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			__m512d one8;
+
+			one8 = _mm512_set1_pd(1.0);
+			for (; u < hn; u += 8) {
+				__m512d a_re, a_im, b_re, b_im, c_re, c_im, t;
+
+				a_re = _mm512_loadu_pd(&a[u].v);
+				a_im = _mm512_loadu_pd(&a[u + hn].v);
+				b_re = _mm512_loadu_pd(&b[u].v);
+				b_im = _mm512_loadu_pd(&b[u + hn].v);
+				t = _mm512_div_pd(one8,
+					FMADD512(b_re, b_re,
+						_mm512_mul_pd(b_im, b_im)));
+				b_re = _mm512_mul_pd(b_re, t);
+				b_im = _mm512_mul_pd(b_im, t);
+				c_re = FMADD512(
+					a_re, b_re, _mm512_mul_pd(a_im, b_im));
+				c_im = FMSUB512(
+					a_im, b_re, _mm512_mul_pd(a_re, b_im));
+				_mm512_storeu_pd(&a[u].v, c_re);
+				_mm512_storeu_pd(&a[u + hn].v, c_im);
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d a_re, a_im, b_re, b_im, c_re, c_im, t;
 
 			a_re = _mm256_loadu_pd(&a[u].v);
@@ -804,7 +1822,7 @@ Zf(poly_div_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_invnorm2_fft)(fpr *restrict d,
+Zk(poly_invnorm2_fft)(fpr *restrict d,
 	const fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, hn, u;
@@ -816,7 +1834,30 @@ Zf(poly_invnorm2_fft)(fpr *restrict d,
 		__m256d one;
 
 		one = _mm256_set1_pd(1.0);
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			__m512d one8;
+
+			one8 = _mm512_set1_pd(1.0);
+			for (; u < hn; u += 8) {
+				__m512d a_re, a_im, b_re, b_im, dv;
+
+				a_re = _mm512_loadu_pd(&a[u].v);
+				a_im = _mm512_loadu_pd(&a[u + hn].v);
+				b_re = _mm512_loadu_pd(&b[u].v);
+				b_im = _mm512_loadu_pd(&b[u + hn].v);
+				dv = _mm512_div_pd(one8,
+					_mm512_add_pd(
+						FMADD512(a_re, a_re,
+							_mm512_mul_pd(a_im, a_im)),
+						FMADD512(b_re, b_re,
+							_mm512_mul_pd(b_im, b_im))));
+				_mm512_storeu_pd(&d[u].v, dv);
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d a_re, a_im, b_re, b_im, dv;
 
 			a_re = _mm256_loadu_pd(&a[u].v);
@@ -864,7 +1905,7 @@ Zf(poly_invnorm2_fft)(fpr *restrict d,
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_add_muladj_fft)(fpr *restrict d,
+Zk(poly_add_muladj_fft)(fpr *restrict d,
 	const fpr *restrict F, const fpr *restrict G,
 	const fpr *restrict f, const fpr *restrict g, unsigned logn)
 {
@@ -874,7 +1915,39 @@ Zf(poly_add_muladj_fft)(fpr *restrict d,
 	hn = n >> 1;
 #if FALCON_AVX2 // yyyAVX2+1
 	if (n >= 8) {
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			for (; u < hn; u += 8) {
+				__m512d F_re, F_im, G_re, G_im;
+				__m512d f_re, f_im, g_re, g_im;
+				__m512d a_re, a_im, b_re, b_im;
+
+				F_re = _mm512_loadu_pd(&F[u].v);
+				F_im = _mm512_loadu_pd(&F[u + hn].v);
+				G_re = _mm512_loadu_pd(&G[u].v);
+				G_im = _mm512_loadu_pd(&G[u + hn].v);
+				f_re = _mm512_loadu_pd(&f[u].v);
+				f_im = _mm512_loadu_pd(&f[u + hn].v);
+				g_re = _mm512_loadu_pd(&g[u].v);
+				g_im = _mm512_loadu_pd(&g[u + hn].v);
+
+				a_re = FMADD512(F_re, f_re,
+					_mm512_mul_pd(F_im, f_im));
+				a_im = FMSUB512(F_im, f_re,
+					_mm512_mul_pd(F_re, f_im));
+				b_re = FMADD512(G_re, g_re,
+					_mm512_mul_pd(G_im, g_im));
+				b_im = FMSUB512(G_im, g_re,
+					_mm512_mul_pd(G_re, g_im));
+				_mm512_storeu_pd(&d[u].v,
+					_mm512_add_pd(a_re, b_re));
+				_mm512_storeu_pd(&d[u + hn].v,
+					_mm512_add_pd(a_im, b_im));
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d F_re, F_im, G_re, G_im;
 			__m256d f_re, f_im, g_re, g_im;
 			__m256d a_re, a_im, b_re, b_im;
@@ -948,7 +2021,7 @@ Zf(poly_add_muladj_fft)(fpr *restrict d,
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_mul_autoadj_fft)(
+Zk(poly_mul_autoadj_fft)(
 	fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, hn, u;
@@ -957,7 +2030,23 @@ Zf(poly_mul_autoadj_fft)(
 	hn = n >> 1;
 #if FALCON_AVX2 // yyyAVX2+1
 	if (n >= 8) {
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			for (; u < hn; u += 8) {
+				__m512d a_re, a_im, bv;
+
+				a_re = _mm512_loadu_pd(&a[u].v);
+				a_im = _mm512_loadu_pd(&a[u + hn].v);
+				bv = _mm512_loadu_pd(&b[u].v);
+				_mm512_storeu_pd(&a[u].v,
+					_mm512_mul_pd(a_re, bv));
+				_mm512_storeu_pd(&a[u + hn].v,
+					_mm512_mul_pd(a_im, bv));
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d a_re, a_im, bv;
 
 			a_re = _mm256_loadu_pd(&a[u].v);
@@ -985,7 +2074,7 @@ Zf(poly_mul_autoadj_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_div_autoadj_fft)(
+Zk(poly_div_autoadj_fft)(
 	fpr *restrict a, const fpr *restrict b, unsigned logn)
 {
 	size_t n, hn, u;
@@ -997,7 +2086,27 @@ Zf(poly_div_autoadj_fft)(
 		__m256d one;
 
 		one = _mm256_set1_pd(1.0);
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			__m512d one8;
+
+			one8 = _mm512_set1_pd(1.0);
+			for (; u < hn; u += 8) {
+				__m512d ib, a_re, a_im;
+
+				ib = _mm512_div_pd(one8,
+					_mm512_loadu_pd(&b[u].v));
+				a_re = _mm512_loadu_pd(&a[u].v);
+				a_im = _mm512_loadu_pd(&a[u + hn].v);
+				_mm512_storeu_pd(&a[u].v,
+					_mm512_mul_pd(a_re, ib));
+				_mm512_storeu_pd(&a[u + hn].v,
+					_mm512_mul_pd(a_im, ib));
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d ib, a_re, a_im;
 
 			ib = _mm256_div_pd(one, _mm256_loadu_pd(&b[u].v));
@@ -1029,7 +2138,7 @@ Zf(poly_div_autoadj_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_LDL_fft)(
+Zk(poly_LDL_fft)(
 	const fpr *restrict g00,
 	fpr *restrict g01, fpr *restrict g11, unsigned logn)
 {
@@ -1042,7 +2151,47 @@ Zf(poly_LDL_fft)(
 		__m256d one;
 
 		one = _mm256_set1_pd(1.0);
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			__m512d one8;
+
+			one8 = _mm512_set1_pd(1.0);
+			for (; u < hn; u += 8) {
+				__m512d g00_re, g00_im, g01_re, g01_im;
+				__m512d g11_re, g11_im;
+				__m512d t, mu_re, mu_im, xi_re, xi_im;
+
+				g00_re = _mm512_loadu_pd(&g00[u].v);
+				g00_im = _mm512_loadu_pd(&g00[u + hn].v);
+				g01_re = _mm512_loadu_pd(&g01[u].v);
+				g01_im = _mm512_loadu_pd(&g01[u + hn].v);
+				g11_re = _mm512_loadu_pd(&g11[u].v);
+				g11_im = _mm512_loadu_pd(&g11[u + hn].v);
+
+				t = _mm512_div_pd(one8,
+					FMADD512(g00_re, g00_re,
+						_mm512_mul_pd(g00_im, g00_im)));
+				g00_re = _mm512_mul_pd(g00_re, t);
+				g00_im = _mm512_mul_pd(g00_im, t);
+				mu_re = FMADD512(g01_re, g00_re,
+					_mm512_mul_pd(g01_im, g00_im));
+				mu_im = FMSUB512(g01_re, g00_im,
+					_mm512_mul_pd(g01_im, g00_re));
+				xi_re = FMSUB512(mu_re, g01_re,
+					_mm512_mul_pd(mu_im, g01_im));
+				xi_im = FMADD512(mu_im, g01_re,
+					_mm512_mul_pd(mu_re, g01_im));
+				_mm512_storeu_pd(&g11[u].v,
+					_mm512_sub_pd(g11_re, xi_re));
+				_mm512_storeu_pd(&g11[u + hn].v,
+					_mm512_add_pd(g11_im, xi_im));
+				_mm512_storeu_pd(&g01[u].v, mu_re);
+				_mm512_storeu_pd(&g01[u + hn].v, mu_im);
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d g00_re, g00_im, g01_re, g01_im, g11_re, g11_im;
 			__m256d t, mu_re, mu_im, xi_re, xi_im;
 
@@ -1116,7 +2265,7 @@ Zf(poly_LDL_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_LDLmv_fft)(
+Zk(poly_LDLmv_fft)(
 	fpr *restrict d11, fpr *restrict l10,
 	const fpr *restrict g00, const fpr *restrict g01,
 	const fpr *restrict g11, unsigned logn)
@@ -1130,7 +2279,47 @@ Zf(poly_LDLmv_fft)(
 		__m256d one;
 
 		one = _mm256_set1_pd(1.0);
-		for (u = 0; u < hn; u += 4) {
+		u = 0;
+#if FALCON_AVX512
+		if (hn >= 8) {
+			__m512d one8;
+
+			one8 = _mm512_set1_pd(1.0);
+			for (; u < hn; u += 8) {
+				__m512d g00_re, g00_im, g01_re, g01_im;
+				__m512d g11_re, g11_im;
+				__m512d t, mu_re, mu_im, xi_re, xi_im;
+
+				g00_re = _mm512_loadu_pd(&g00[u].v);
+				g00_im = _mm512_loadu_pd(&g00[u + hn].v);
+				g01_re = _mm512_loadu_pd(&g01[u].v);
+				g01_im = _mm512_loadu_pd(&g01[u + hn].v);
+				g11_re = _mm512_loadu_pd(&g11[u].v);
+				g11_im = _mm512_loadu_pd(&g11[u + hn].v);
+
+				t = _mm512_div_pd(one8,
+					FMADD512(g00_re, g00_re,
+						_mm512_mul_pd(g00_im, g00_im)));
+				g00_re = _mm512_mul_pd(g00_re, t);
+				g00_im = _mm512_mul_pd(g00_im, t);
+				mu_re = FMADD512(g01_re, g00_re,
+					_mm512_mul_pd(g01_im, g00_im));
+				mu_im = FMSUB512(g01_re, g00_im,
+					_mm512_mul_pd(g01_im, g00_re));
+				xi_re = FMSUB512(mu_re, g01_re,
+					_mm512_mul_pd(mu_im, g01_im));
+				xi_im = FMADD512(mu_im, g01_re,
+					_mm512_mul_pd(mu_re, g01_im));
+				_mm512_storeu_pd(&d11[u].v,
+					_mm512_sub_pd(g11_re, xi_re));
+				_mm512_storeu_pd(&d11[u + hn].v,
+					_mm512_add_pd(g11_im, xi_im));
+				_mm512_storeu_pd(&l10[u].v, mu_re);
+				_mm512_storeu_pd(&l10[u + hn].v, mu_im);
+			}
+		}
+#endif
+		for (; u < hn; u += 4) {
 			__m256d g00_re, g00_im, g01_re, g01_im, g11_re, g11_im;
 			__m256d t, mu_re, mu_im, xi_re, xi_im;
 
@@ -1204,7 +2393,7 @@ Zf(poly_LDLmv_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_split_fft)(
+Zk(poly_split_fft)(
 	fpr *restrict f0, fpr *restrict f1,
 	const fpr *restrict f, unsigned logn)
 {
@@ -1311,7 +2500,7 @@ Zf(poly_split_fft)(
 /* see inner.h */
 TARGET_AVX2
 void
-Zf(poly_merge_fft)(
+Zk(poly_merge_fft)(
 	fpr *restrict f,
 	const fpr *restrict f0, const fpr *restrict f1, unsigned logn)
 {
@@ -1410,3 +2599,1198 @@ Zf(poly_merge_fft)(
 	}
 #endif // yyyAVX2-
 }
+
+/* ==================================================================== */
+/*
+ * Interleaved variants, for batched lazy signing: four polynomials are
+ * processed at once, element j of polynomial l being stored in slot
+ * 4*j+l. All four polynomials use the same twiddle factors, so that
+ * every butterfly fills an AVX2 register, including in the inner
+ * layers where the plain FFT falls back to scalar code. Results are
+ * bit-for-bit identical to those of the one-polynomial functions: the
+ * same layers use fused multiply-add (with FALCON_FMA) as in Zf(FFT)
+ * and Zf(iFFT).
+ */
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(FFT_x4)(fpr *f, unsigned logn)
+{
+	unsigned u;
+	size_t t, n, hn, m;
+
+	n = (size_t)1 << logn;
+	hn = n >> 1;
+	t = hn;
+	for (u = 1, m = 2; u < logn; u ++, m <<= 1) {
+		size_t ht, hm, i1, j1;
+
+		ht = t >> 1;
+		hm = m >> 1;
+		for (i1 = 0, j1 = 0; i1 < hm; i1 ++, j1 += t) {
+			size_t j, j2;
+#if FALCON_AVX2 // yyyAVX2+1
+			__m256d s_re, s_im;
+#else // yyyAVX2+0
+			fpr s_re, s_im;
+#endif // yyyAVX2-
+
+			j2 = j1 + ht;
+#if FALCON_AVX2 // yyyAVX2+1
+			s_re = _mm256_set1_pd(
+				fpr_gm_tab[((m + i1) << 1) + 0].v);
+			s_im = _mm256_set1_pd(
+				fpr_gm_tab[((m + i1) << 1) + 1].v);
+			for (j = j1; j < j2; j ++) {
+				__m256d x_re, x_im, y_re, y_im;
+				__m256d z_re, z_im;
+
+				x_re = _mm256_loadu_pd(&f[j << 2].v);
+				x_im = _mm256_loadu_pd(&f[(j + hn) << 2].v);
+				z_re = _mm256_loadu_pd(&f[(j + ht) << 2].v);
+				z_im = _mm256_loadu_pd(
+					&f[(j + ht + hn) << 2].v);
+				if (ht >= 4) {
+					y_re = FMSUB(z_re, s_re,
+						_mm256_mul_pd(z_im, s_im));
+					y_im = FMADD(z_re, s_im,
+						_mm256_mul_pd(z_im, s_re));
+				} else {
+					y_re = _mm256_sub_pd(
+						_mm256_mul_pd(z_re, s_re),
+						_mm256_mul_pd(z_im, s_im));
+					y_im = _mm256_add_pd(
+						_mm256_mul_pd(z_re, s_im),
+						_mm256_mul_pd(z_im, s_re));
+				}
+				_mm256_storeu_pd(&f[j << 2].v,
+					_mm256_add_pd(x_re, y_re));
+				_mm256_storeu_pd(&f[(j + hn) << 2].v,
+					_mm256_add_pd(x_im, y_im));
+				_mm256_storeu_pd(&f[(j + ht) << 2].v,
+					_mm256_sub_pd(x_re, y_re));
+				_mm256_storeu_pd(&f[(j + ht + hn) << 2].v,
+					_mm256_sub_pd(x_im, y_im));
+			}
+#else // yyyAVX2+0
+			s_re = fpr_gm_tab[((m + i1) << 1) + 0];
+			s_im = fpr_gm_tab[((m + i1) << 1) + 1];
+			for (j = j1 << 2; j < (j2 << 2); j ++) {
+				fpr x_re, x_im, y_re, y_im;
+				size_t k1, k2;
+
+				k1 = j + (hn << 2);
+				k2 = j + (ht << 2);
+				x_re = f[j];
+				x_im = f[k1];
+				y_re = f[k2];
+				y_im = f[k2 + (hn << 2)];
+				FPC_MUL(y_re, y_im, y_re, y_im, s_re, s_im);
+				FPC_ADD(f[j], f[k1],
+					x_re, x_im, y_re, y_im);
+				FPC_SUB(f[k2], f[k2 + (hn << 2)],
+					x_re, x_im, y_re, y_im);
+			}
+#endif // yyyAVX2-
+		}
+		t = ht;
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(iFFT_x4)(fpr *f, unsigned logn)
+{
+	size_t u, n, hn, t, m;
+
+	n = (size_t)1 << logn;
+	t = 1;
+	m = n;
+	hn = n >> 1;
+	for (u = logn; u > 1; u --) {
+		size_t hm, dt, i1, j1;
+
+		hm = m >> 1;
+		dt = t << 1;
+		for (i1 = 0, j1 = 0; j1 < hn; i1 ++, j1 += dt) {
+			size_t j, j2;
+#if FALCON_AVX2 // yyyAVX2+1
+			__m256d s_re, s_im, ms_im;
+#else // yyyAVX2+0
+			fpr s_re, s_im;
+#endif // yyyAVX2-
+
+			j2 = j1 + t;
+#if FALCON_AVX2 // yyyAVX2+1
+			s_re = _mm256_set1_pd(
+				fpr_gm_tab[((hm + i1) << 1) + 0].v);
+			s_im = _mm256_set1_pd(
+				fpr_gm_tab[((hm + i1) << 1) + 1].v);
+			ms_im = _mm256_set1_pd(
+				fpr_neg(fpr_gm_tab[((hm + i1) << 1) + 1]).v);
+			for (j = j1; j < j2; j ++) {
+				__m256d x_re, x_im, y_re, y_im;
+				__m256d z_re, z_im;
+
+				x_re = _mm256_loadu_pd(&f[j << 2].v);
+				x_im = _mm256_loadu_pd(&f[(j + hn) << 2].v);
+				y_re = _mm256_loadu_pd(&f[(j + t) << 2].v);
+				y_im = _mm256_loadu_pd(
+					&f[(j + t + hn) << 2].v);
+				_mm256_storeu_pd(&f[j << 2].v,
+					_mm256_add_pd(x_re, y_re));
+				_mm256_storeu_pd(&f[(j + hn) << 2].v,
+					_mm256_add_pd(x_im, y_im));
+				if (t >= 4) {
+					x_re = _mm256_sub_pd(y_re, x_re);
+					x_im = _mm256_sub_pd(x_im, y_im);
+					z_re = FMSUB(x_im, s_im,
+						_mm256_mul_pd(x_re, s_re));
+					z_im = FMADD(x_re, s_im,
+						_mm256_mul_pd(x_im, s_re));
+				} else {
+					x_re = _mm256_sub_pd(x_re, y_re);
+					x_im = _mm256_sub_pd(x_im, y_im);
+					z_re = _mm256_sub_pd(
+						_mm256_mul_pd(x_re, s_re),
+						_mm256_mul_pd(x_im, ms_im));
+					z_im = _mm256_add_pd(
+						_mm256_mul_pd(x_re, ms_im),
+						_mm256_mul_pd(x_im, s_re));
+				}
+				_mm256_storeu_pd(&f[(j + t) << 2].v, z_re);
+				_mm256_storeu_pd(&f[(j + t + hn) << 2].v, z_im);
+			}
+#else // yyyAVX2+0
+			s_re = fpr_gm_tab[((hm + i1) << 1) + 0];
+			s_im = fpr_neg(fpr_gm_tab[((hm + i1) << 1) + 1]);
+			for (j = j1 << 2; j < (j2 << 2); j ++) {
+				fpr x_re, x_im, y_re, y_im;
+				size_t k1, k2;
+
+				k1 = j + (hn << 2);
+				k2 = j + (t << 2);
+				x_re = f[j];
+				x_im = f[k1];
+				y_re = f[k2];
+				y_im = f[k2 + (hn << 2)];
+				FPC_ADD(f[j], f[k1],
+					x_re, x_im, y_re, y_im);
+				FPC_SUB(x_re, x_im, x_re, x_im, y_re, y_im);
+				FPC_MUL(f[k2], f[k2 + (hn << 2)],
+					x_re, x_im, s_re, s_im);
+			}
+#endif // yyyAVX2-
+		}
+		t = dt;
+		m = hm;
+	}
+
+	/*
+	 * Last iteration is a no-op, provided that we divide by N/2
+	 * instead of N (see Zf(iFFT)).
+	 */
+	if (logn > 0) {
+		Zk(poly_mulconst)(f, fpr_p2_tab[logn], logn + 2);
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_mul_fft_x4)(
+	fpr *restrict a, const fpr *restrict b, unsigned logn)
+{
+	size_t n, hn, u;
+
+	n = (size_t)1 << logn;
+	hn = n >> 1;
+#if FALCON_AVX2 // yyyAVX2+1
+	for (u = 0; u < hn; u ++) {
+		__m256d a_re, a_im, b_re, b_im, c_re, c_im;
+
+		a_re = _mm256_loadu_pd(&a[u << 2].v);
+		a_im = _mm256_loadu_pd(&a[(u + hn) << 2].v);
+		b_re = _mm256_set1_pd(b[u].v);
+		b_im = _mm256_set1_pd(b[u + hn].v);
+		if (n >= 8) {
+			c_re = FMSUB(a_re, b_re, _mm256_mul_pd(a_im, b_im));
+			c_im = FMADD(a_re, b_im, _mm256_mul_pd(a_im, b_re));
+		} else {
+			c_re = _mm256_sub_pd(_mm256_mul_pd(a_re, b_re),
+				_mm256_mul_pd(a_im, b_im));
+			c_im = _mm256_add_pd(_mm256_mul_pd(a_re, b_im),
+				_mm256_mul_pd(a_im, b_re));
+		}
+		_mm256_storeu_pd(&a[u << 2].v, c_re);
+		_mm256_storeu_pd(&a[(u + hn) << 2].v, c_im);
+	}
+#else // yyyAVX2+0
+	for (u = 0; u < (hn << 2); u ++) {
+		fpr a_re, a_im, b_re, b_im;
+
+		a_re = a[u];
+		a_im = a[u + (hn << 2)];
+		b_re = b[u >> 2];
+		b_im = b[(u >> 2) + hn];
+		FPC_MUL(a[u], a[u + (hn << 2)], a_re, a_im, b_re, b_im);
+	}
+#endif // yyyAVX2-
+}
+
+/*
+ * Offset of frequency slot u in an interleaved basis, for groups of w
+ * slots (see inner.h); component k, real part, is at offset + 2*k*w,
+ * and the imaginary part at offset + (2*k+1)*w.
+ */
+static inline size_t
+basis_off(size_t u, size_t w)
+{
+	return ((u - (u % w)) << 3) + (u % w);
+}
+
+/* see inner.h */
+void
+Zk(poly_basis_set)(fpr *restrict B, const fpr *restrict a,
+	int k, unsigned logn)
+{
+	size_t hn, w, u;
+
+	hn = (size_t)1 << (logn - 1);
+	w = hn < 4 ? hn : 4;
+	for (u = 0; u < hn; u ++) {
+		fpr *b;
+
+		b = B + basis_off(u, w) + ((size_t)k << 1) * w;
+		b[0] = a[u];
+		b[w] = a[u + hn];
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_basis_solve_fft)(fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t hn, w, u;
+
+	hn = (size_t)1 << (logn - 1);
+#if FALCON_AVX2 // yyyAVX2+1
+	if (hn >= 4) {
+		__m256d iq, miq;
+
+		iq = _mm256_set1_pd(fpr_inverse_of_q.v);
+		miq = _mm256_set1_pd(-fpr_inverse_of_q.v);
+		for (u = 0; u < hn; u += 4) {
+			const fpr *b;
+			__m256d t_re, t_im, f_re, f_im, F_re, F_im;
+			__m256d c_re, c_im;
+
+			b = B + (u << 3);
+			t_re = _mm256_loadu_pd(&y1[u].v);
+			t_im = _mm256_loadu_pd(&y1[u + hn].v);
+			f_re = _mm256_loadu_pd(&b[0].v);
+			f_im = _mm256_loadu_pd(&b[4].v);
+			F_re = _mm256_loadu_pd(&b[16].v);
+			F_im = _mm256_loadu_pd(&b[20].v);
+			c_re = FMSUB(t_re, f_re, _mm256_mul_pd(t_im, f_im));
+			c_im = FMADD(t_re, f_im, _mm256_mul_pd(t_im, f_re));
+			_mm256_storeu_pd(&y2[u].v, _mm256_mul_pd(iq, c_re));
+			_mm256_storeu_pd(&y2[u + hn].v, _mm256_mul_pd(iq, c_im));
+			c_re = FMSUB(t_re, F_re, _mm256_mul_pd(t_im, F_im));
+			c_im = FMADD(t_re, F_im, _mm256_mul_pd(t_im, F_re));
+			_mm256_storeu_pd(&y1[u].v, _mm256_mul_pd(miq, c_re));
+			_mm256_storeu_pd(&y1[u + hn].v, _mm256_mul_pd(miq, c_im));
+		}
+		return;
+	}
+#endif // yyyAVX2-
+	w = hn < 4 ? hn : 4;
+	for (u = 0; u < hn; u ++) {
+		const fpr *b;
+		fpr t_re, t_im, c_re, c_im;
+
+		b = B + basis_off(u, w);
+		t_re = y1[u];
+		t_im = y1[u + hn];
+		FPC_MUL(c_re, c_im, t_re, t_im, b[0], b[w]);
+		y2[u] = fpr_mul(c_re, fpr_inverse_of_q);
+		y2[u + hn] = fpr_mul(c_im, fpr_inverse_of_q);
+		FPC_MUL(c_re, c_im, t_re, t_im, b[4 * w], b[5 * w]);
+		y1[u] = fpr_mul(c_re, fpr_neg(fpr_inverse_of_q));
+		y1[u + hn] = fpr_mul(c_im, fpr_neg(fpr_inverse_of_q));
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_basis_mul_fft)(fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t hn, w, u;
+
+	hn = (size_t)1 << (logn - 1);
+#if FALCON_AVX2 // yyyAVX2+1
+	if (hn >= 4) {
+		for (u = 0; u < hn; u += 4) {
+			const fpr *b;
+			__m256d a_re, a_im, c_re, c_im;
+			__m256d b_re, b_im, d_re, d_im;
+
+			b = B + (u << 3);
+			a_re = _mm256_loadu_pd(&y1[u].v);
+			a_im = _mm256_loadu_pd(&y1[u + hn].v);
+			c_re = _mm256_loadu_pd(&y2[u].v);
+			c_im = _mm256_loadu_pd(&y2[u + hn].v);
+
+			/*
+			 * y1 <- g*y1 + G*y2
+			 */
+			b_re = _mm256_loadu_pd(&b[8].v);
+			b_im = _mm256_loadu_pd(&b[12].v);
+			d_re = FMSUB(a_re, b_re, _mm256_mul_pd(a_im, b_im));
+			d_im = FMADD(a_re, b_im, _mm256_mul_pd(a_im, b_re));
+			b_re = _mm256_loadu_pd(&b[24].v);
+			b_im = _mm256_loadu_pd(&b[28].v);
+			_mm256_storeu_pd(&y1[u].v, _mm256_add_pd(d_re,
+				FMSUB(c_re, b_re, _mm256_mul_pd(c_im, b_im))));
+			_mm256_storeu_pd(&y1[u + hn].v, _mm256_add_pd(d_im,
+				FMADD(c_re, b_im, _mm256_mul_pd(c_im, b_re))));
+
+			/*
+			 * y2 <- F*y2 + f*y1
+			 */
+			b_re = _mm256_loadu_pd(&b[16].v);
+			b_im = _mm256_loadu_pd(&b[20].v);
+			d_re = FMSUB(c_re, b_re, _mm256_mul_pd(c_im, b_im));
+			d_im = FMADD(c_re, b_im, _mm256_mul_pd(c_im, b_re));
+			b_re = _mm256_loadu_pd(&b[0].v);
+			b_im = _mm256_loadu_pd(&b[4].v);
+			_mm256_storeu_pd(&y2[u].v, _mm256_add_pd(d_re,
+				FMSUB(a_re, b_re, _mm256_mul_pd(a_im, b_im))));
+			_mm256_storeu_pd(&y2[u + hn].v, _mm256_add_pd(d_im,
+				FMADD(a_re, b_im, _mm256_mul_pd(a_im, b_re))));
+		}
+		return;
+	}
+#endif // yyyAVX2-
+	w = hn < 4 ? hn : 4;
+	for (u = 0; u < hn; u ++) {
+		const fpr *b;
+		fpr a_re, a_im, c_re, c_im, d_re, d_im, e_re, e_im;
+
+		b = B + basis_off(u, w);
+		a_re = y1[u];
+		a_im = y1[u + hn];
+		c_re = y2[u];
+		c_im = y2[u + hn];
+		FPC_MUL(d_re, d_im, a_re, a_im, b[2 * w], b[3 * w]);
+		FPC_MUL(e_re, e_im, c_re, c_im, b[6 * w], b[7 * w]);
+		FPC_ADD(y1[u], y1[u + hn], d_re, d_im, e_re, e_im);
+		FPC_MUL(d_re, d_im, c_re, c_im, b[4 * w], b[5 * w]);
+		FPC_MUL(e_re, e_im, a_re, a_im, b[0], b[w]);
+		FPC_ADD(y2[u], y2[u + hn], d_re, d_im, e_re, e_im);
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_basis_mul2_fft)(const fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t hn, w, u;
+
+	hn = (size_t)1 << (logn - 1);
+#if FALCON_AVX2 // yyyAVX2+1
+	if (hn >= 4) {
+		for (u = 0; u < hn; u += 4) {
+			const fpr *b;
+			__m256d a_re, a_im, c_re, c_im;
+			__m256d b_re, b_im, d_re, d_im;
+
+			b = B + (u << 3);
+			a_re = _mm256_loadu_pd(&y1[u].v);
+			a_im = _mm256_loadu_pd(&y1[u + hn].v);
+			c_re = _mm256_loadu_pd(&y2[u].v);
+			c_im = _mm256_loadu_pd(&y2[u + hn].v);
+			b_re = _mm256_loadu_pd(&b[16].v);
+			b_im = _mm256_loadu_pd(&b[20].v);
+			d_re = FMSUB(c_re, b_re, _mm256_mul_pd(c_im, b_im));
+			d_im = FMADD(c_re, b_im, _mm256_mul_pd(c_im, b_re));
+			b_re = _mm256_loadu_pd(&b[0].v);
+			b_im = _mm256_loadu_pd(&b[4].v);
+			_mm256_storeu_pd(&y2[u].v, _mm256_add_pd(d_re,
+				FMSUB(a_re, b_re, _mm256_mul_pd(a_im, b_im))));
+			_mm256_storeu_pd(&y2[u + hn].v, _mm256_add_pd(d_im,
+				FMADD(a_re, b_im, _mm256_mul_pd(a_im, b_re))));
+		}
+		return;
+	}
+#endif // yyyAVX2-
+	w = hn < 4 ? hn : 4;
+	for (u = 0; u < hn; u ++) {
+		const fpr *b;
+		fpr d_re, d_im, e_re, e_im;
+
+		b = B + basis_off(u, w);
+		FPC_MUL(d_re, d_im, y2[u], y2[u + hn], b[4 * w], b[5 * w]);
+		FPC_MUL(e_re, e_im, y1[u], y1[u + hn], b[0], b[w]);
+		FPC_ADD(y2[u], y2[u + hn], d_re, d_im, e_re, e_im);
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_basis_mul2_fft_x4)(const fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t hn, w, u;
+
+	hn = (size_t)1 << (logn - 1);
+	w = hn < 4 ? hn : 4;
+#if FALCON_AVX2 // yyyAVX2+1
+	for (u = 0; u < hn; u ++) {
+		const fpr *b;
+		__m256d a_re, a_im, c_re, c_im;
+		__m256d b_re, b_im, d_re, d_im, e_re, e_im;
+
+		b = B + basis_off(u, w);
+		a_re = _mm256_loadu_pd(&y1[u << 2].v);
+		a_im = _mm256_loadu_pd(&y1[(u + hn) << 2].v);
+		c_re = _mm256_loadu_pd(&y2[u << 2].v);
+		c_im = _mm256_loadu_pd(&y2[(u + hn) << 2].v);
+		b_re = _mm256_set1_pd(b[4 * w].v);
+		b_im = _mm256_set1_pd(b[5 * w].v);
+		if (hn >= 4) {
+			d_re = FMSUB(c_re, b_re, _mm256_mul_pd(c_im, b_im));
+			d_im = FMADD(c_re, b_im, _mm256_mul_pd(c_im, b_re));
+		} else {
+			d_re = _mm256_sub_pd(_mm256_mul_pd(c_re, b_re),
+				_mm256_mul_pd(c_im, b_im));
+			d_im = _mm256_add_pd(_mm256_mul_pd(c_re, b_im),
+				_mm256_mul_pd(c_im, b_re));
+		}
+		b_re = _mm256_set1_pd(b[0].v);
+		b_im = _mm256_set1_pd(b[w].v);
+		if (hn >= 4) {
+			e_re = FMSUB(a_re, b_re, _mm256_mul_pd(a_im, b_im));
+			e_im = FMADD(a_re, b_im, _mm256_mul_pd(a_im, b_re));
+		} else {
+			e_re = _mm256_sub_pd(_mm256_mul_pd(a_re, b_re),
+				_mm256_mul_pd(a_im, b_im));
+			e_im = _mm256_add_pd(_mm256_mul_pd(a_re, b_im),
+				_mm256_mul_pd(a_im, b_re));
+		}
+		_mm256_storeu_pd(&y2[u << 2].v, _mm256_add_pd(d_re, e_re));
+		_mm256_storeu_pd(&y2[(u + hn) << 2].v,
+			_mm256_add_pd(d_im, e_im));
+	}
+#else // yyyAVX2+0
+	for (u = 0; u < (hn << 2); u ++) {
+		const fpr *b;
+		fpr d_re, d_im, e_re, e_im;
+
+		b = B + basis_off(u >> 2, w);
+		FPC_MUL(d_re, d_im, y2[u], y2[u + (hn << 2)],
+			b[4 * w], b[5 * w]);
+		FPC_MUL(e_re, e_im, y1[u], y1[u + (hn << 2)], b[0], b[w]);
+		FPC_ADD(y2[u], y2[u + (hn << 2)], d_re, d_im, e_re, e_im);
+	}
+#endif // yyyAVX2-
+}
+
+#if FALCON_FPNATIVE
+/* ==================================================================== */
+/*
+ * Single-precision variants, for the reduction against the basis in
+ * the lazy online phase (LAZY_F32). The layout and the order of the
+ * layers are those of Zf(FFT)() and Zf(iFFT)(); with AVX2, a register
+ * holds 8 values instead of 4, so that the layers with 8 elements or
+ * more per half-group are fully vectorized, and the last three layers
+ * are done in registers for logn = 9 and 10 (twiddle factors from
+ * fpr_gm32_tail9[] and fpr_gm32_tail10[]). The values are not
+ * reproducible across backends (FMA contractions differ); the caller
+ * checks that they are close enough to the double-precision ones.
+ */
+
+#if FALCON_AVX2 // yyyAVX2+1
+/*
+ * Last three FFT layers for logn = 9 or 10, over blocks of 16 slots.
+ * Two registers hold the 16 real (or imaginary) parts of a block; they
+ * are shuffled so that each layer pairs lanes of the same index.
+ */
+TARGET_AVX2
+static void
+fft32_tail(float *f, unsigned logn)
+{
+	const float *tw;
+	size_t hn, j;
+
+	hn = (size_t)1 << (logn - 1);
+	tw = (logn == 9) ? fpr_gm32_tail9 : fpr_gm32_tail10;
+	for (j = 0; j < hn; j += 16, tw += 48) {
+		__m256 a_re, a_im, b_re, b_im, x_re, x_im, y_re, y_im;
+		__m256 s_re, s_im, z_re, z_im;
+
+		a_re = _mm256_loadu_ps(&f[j]);
+		b_re = _mm256_loadu_ps(&f[j + 8]);
+		a_im = _mm256_loadu_ps(&f[j + hn]);
+		b_im = _mm256_loadu_ps(&f[j + hn + 8]);
+
+		/*
+		 * 4 elements per half-group: x = (0..3, 8..11),
+		 * y = (4..7, 12..15).
+		 */
+		x_re = _mm256_permute2f128_ps(a_re, b_re, 0x20);
+		y_re = _mm256_permute2f128_ps(a_re, b_re, 0x31);
+		x_im = _mm256_permute2f128_ps(a_im, b_im, 0x20);
+		y_im = _mm256_permute2f128_ps(a_im, b_im, 0x31);
+		s_re = _mm256_loadu_ps(&tw[0]);
+		s_im = _mm256_loadu_ps(&tw[8]);
+		z_re = FMSUB_PS(y_re, s_re, _mm256_mul_ps(y_im, s_im));
+		z_im = FMADD_PS(y_re, s_im, _mm256_mul_ps(y_im, s_re));
+		a_re = _mm256_add_ps(x_re, z_re);
+		a_im = _mm256_add_ps(x_im, z_im);
+		b_re = _mm256_sub_ps(x_re, z_re);
+		b_im = _mm256_sub_ps(x_im, z_im);
+
+		/*
+		 * 2 elements per half-group: x = (0, 1, 4, 5, 8, 9, 12, 13),
+		 * y = (2, 3, 6, 7, 10, 11, 14, 15).
+		 */
+		x_re = _mm256_shuffle_ps(a_re, b_re, 0x44);
+		y_re = _mm256_shuffle_ps(a_re, b_re, 0xEE);
+		x_im = _mm256_shuffle_ps(a_im, b_im, 0x44);
+		y_im = _mm256_shuffle_ps(a_im, b_im, 0xEE);
+		s_re = _mm256_loadu_ps(&tw[16]);
+		s_im = _mm256_loadu_ps(&tw[24]);
+		z_re = FMSUB_PS(y_re, s_re, _mm256_mul_ps(y_im, s_im));
+		z_im = FMADD_PS(y_re, s_im, _mm256_mul_ps(y_im, s_re));
+		a_re = _mm256_add_ps(x_re, z_re);
+		a_im = _mm256_add_ps(x_im, z_im);
+		b_re = _mm256_sub_ps(x_re, z_re);
+		b_im = _mm256_sub_ps(x_im, z_im);
+
+		/*
+		 * 1 element per half-group: x = (0, 4, 2, 6, 8, 12, 10, 14),
+		 * y = (1, 5, 3, 7, 9, 13, 11, 15).
+		 */
+		x_re = _mm256_shuffle_ps(a_re, b_re, 0x88);
+		y_re = _mm256_shuffle_ps(a_re, b_re, 0xDD);
+		x_im = _mm256_shuffle_ps(a_im, b_im, 0x88);
+		y_im = _mm256_shuffle_ps(a_im, b_im, 0xDD);
+		s_re = _mm256_loadu_ps(&tw[32]);
+		s_im = _mm256_loadu_ps(&tw[40]);
+		z_re = FMSUB_PS(y_re, s_re, _mm256_mul_ps(y_im, s_im));
+		z_im = FMADD_PS(y_re, s_im, _mm256_mul_ps(y_im, s_re));
+		a_re = _mm256_add_ps(x_re, z_re);
+		a_im = _mm256_add_ps(x_im, z_im);
+		b_re = _mm256_sub_ps(x_re, z_re);
+		b_im = _mm256_sub_ps(x_im, z_im);
+
+		/*
+		 * Back to the natural order.
+		 */
+		x_re = _mm256_unpacklo_ps(a_re, b_re);
+		y_re = _mm256_unpackhi_ps(a_re, b_re);
+		x_im = _mm256_unpacklo_ps(a_im, b_im);
+		y_im = _mm256_unpackhi_ps(a_im, b_im);
+		a_re = _mm256_shuffle_ps(x_re, y_re, 0x44);
+		b_re = _mm256_shuffle_ps(x_re, y_re, 0xEE);
+		a_im = _mm256_shuffle_ps(x_im, y_im, 0x44);
+		b_im = _mm256_shuffle_ps(x_im, y_im, 0xEE);
+		_mm256_storeu_ps(&f[j], _mm256_permute2f128_ps(a_re, b_re, 0x20));
+		_mm256_storeu_ps(&f[j + 8],
+			_mm256_permute2f128_ps(a_re, b_re, 0x31));
+		_mm256_storeu_ps(&f[j + hn],
+			_mm256_permute2f128_ps(a_im, b_im, 0x20));
+		_mm256_storeu_ps(&f[j + hn + 8],
+			_mm256_permute2f128_ps(a_im, b_im, 0x31));
+	}
+}
+
+/*
+ * First three iFFT layers for logn = 9 or 10 (inverse of fft32_tail()).
+ */
+TARGET_AVX2
+static void
+ifft32_head(float *f, unsigned logn)
+{
+	const float *tw;
+	size_t hn, j;
+
+	hn = (size_t)1 << (logn - 1);
+	tw = (logn == 9) ? fpr_gm32_tail9 : fpr_gm32_tail10;
+	for (j = 0; j < hn; j += 16, tw += 48) {
+		__m256 a_re, a_im, b_re, b_im, x_re, x_im, y_re, y_im;
+		__m256 s_re, s_im;
+
+		a_re = _mm256_loadu_ps(&f[j]);
+		b_re = _mm256_loadu_ps(&f[j + 8]);
+		a_im = _mm256_loadu_ps(&f[j + hn]);
+		b_im = _mm256_loadu_ps(&f[j + hn + 8]);
+		x_re = _mm256_permute2f128_ps(a_re, b_re, 0x20);
+		y_re = _mm256_permute2f128_ps(a_re, b_re, 0x31);
+		x_im = _mm256_permute2f128_ps(a_im, b_im, 0x20);
+		y_im = _mm256_permute2f128_ps(a_im, b_im, 0x31);
+		a_re = _mm256_shuffle_ps(x_re, y_re, 0x44);
+		b_re = _mm256_shuffle_ps(x_re, y_re, 0xEE);
+		a_im = _mm256_shuffle_ps(x_im, y_im, 0x44);
+		b_im = _mm256_shuffle_ps(x_im, y_im, 0xEE);
+
+		/*
+		 * 1 element per half-group (same lane order as in
+		 * fft32_tail()); the twiddle factors are conjugated.
+		 */
+		x_re = _mm256_shuffle_ps(a_re, b_re, 0x88);
+		y_re = _mm256_shuffle_ps(a_re, b_re, 0xDD);
+		x_im = _mm256_shuffle_ps(a_im, b_im, 0x88);
+		y_im = _mm256_shuffle_ps(a_im, b_im, 0xDD);
+		s_re = _mm256_loadu_ps(&tw[32]);
+		s_im = _mm256_loadu_ps(&tw[40]);
+		a_re = _mm256_add_ps(x_re, y_re);
+		a_im = _mm256_add_ps(x_im, y_im);
+		x_re = _mm256_sub_ps(x_re, y_re);
+		x_im = _mm256_sub_ps(x_im, y_im);
+		b_re = FMADD_PS(x_re, s_re, _mm256_mul_ps(x_im, s_im));
+		b_im = FMSUB_PS(x_im, s_re, _mm256_mul_ps(x_re, s_im));
+
+		/*
+		 * 2 elements per half-group.
+		 */
+		x_re = _mm256_unpacklo_ps(a_re, b_re);
+		y_re = _mm256_unpackhi_ps(a_re, b_re);
+		x_im = _mm256_unpacklo_ps(a_im, b_im);
+		y_im = _mm256_unpackhi_ps(a_im, b_im);
+		s_re = _mm256_loadu_ps(&tw[16]);
+		s_im = _mm256_loadu_ps(&tw[24]);
+		a_re = _mm256_add_ps(x_re, y_re);
+		a_im = _mm256_add_ps(x_im, y_im);
+		x_re = _mm256_sub_ps(x_re, y_re);
+		x_im = _mm256_sub_ps(x_im, y_im);
+		b_re = FMADD_PS(x_re, s_re, _mm256_mul_ps(x_im, s_im));
+		b_im = FMSUB_PS(x_im, s_re, _mm256_mul_ps(x_re, s_im));
+
+		/*
+		 * 4 elements per half-group.
+		 */
+		x_re = _mm256_shuffle_ps(a_re, b_re, 0x44);
+		y_re = _mm256_shuffle_ps(a_re, b_re, 0xEE);
+		x_im = _mm256_shuffle_ps(a_im, b_im, 0x44);
+		y_im = _mm256_shuffle_ps(a_im, b_im, 0xEE);
+		s_re = _mm256_loadu_ps(&tw[0]);
+		s_im = _mm256_loadu_ps(&tw[8]);
+		a_re = _mm256_add_ps(x_re, y_re);
+		a_im = _mm256_add_ps(x_im, y_im);
+		x_re = _mm256_sub_ps(x_re, y_re);
+		x_im = _mm256_sub_ps(x_im, y_im);
+		b_re = FMADD_PS(x_re, s_re, _mm256_mul_ps(x_im, s_im));
+		b_im = FMSUB_PS(x_im, s_re, _mm256_mul_ps(x_re, s_im));
+		_mm256_storeu_ps(&f[j], _mm256_permute2f128_ps(a_re, b_re, 0x20));
+		_mm256_storeu_ps(&f[j + 8],
+			_mm256_permute2f128_ps(a_re, b_re, 0x31));
+		_mm256_storeu_ps(&f[j + hn],
+			_mm256_permute2f128_ps(a_im, b_im, 0x20));
+		_mm256_storeu_ps(&f[j + hn + 8],
+			_mm256_permute2f128_ps(a_im, b_im, 0x31));
+	}
+}
+
+/*
+ * Load 8 consecutive slots of an interleaved basis component (two
+ * groups of 4 slots, 32 fpr apart), rounded to float.
+ */
+TARGET_AVX2
+static inline __m256
+basis_load32(const fpr *b)
+{
+	return _mm256_insertf128_ps(
+		_mm256_castps128_ps256(_mm256_cvtpd_ps(
+			_mm256_loadu_pd(&b[0].v))),
+		_mm256_cvtpd_ps(_mm256_loadu_pd(&b[32].v)), 1);
+}
+#endif // yyyAVX2-
+
+/*
+ * Apply FFT layer u (as in fft_layers()) to single-precision values.
+ */
+TARGET_AVX2
+static void
+fft32_layer(float *f, unsigned logn, unsigned u)
+{
+	size_t hn, t, ht, m, hm, i1, j1;
+
+	hn = (size_t)1 << (logn - 1);
+	t = hn >> (u - 1);
+	ht = t >> 1;
+	m = (size_t)1 << u;
+	hm = m >> 1;
+	for (i1 = 0, j1 = 0; i1 < hm; i1 ++, j1 += t) {
+		size_t j, j2;
+		float s_re, s_im;
+
+		j2 = j1 + ht;
+		s_re = (float)fpr_gm_tab[((m + i1) << 1) + 0].v;
+		s_im = (float)fpr_gm_tab[((m + i1) << 1) + 1].v;
+#if FALCON_AVX2 // yyyAVX2+1
+		if (ht >= 8) {
+			__m256 s8_re, s8_im;
+
+			s8_re = _mm256_set1_ps(s_re);
+			s8_im = _mm256_set1_ps(s_im);
+			for (j = j1; j < j2; j += 8) {
+				__m256 x_re, x_im, y_re, y_im, z_re, z_im;
+
+				x_re = _mm256_loadu_ps(&f[j]);
+				x_im = _mm256_loadu_ps(&f[j + hn]);
+				z_re = _mm256_loadu_ps(&f[j + ht]);
+				z_im = _mm256_loadu_ps(&f[j + ht + hn]);
+				y_re = FMSUB_PS(z_re, s8_re,
+					_mm256_mul_ps(z_im, s8_im));
+				y_im = FMADD_PS(z_re, s8_im,
+					_mm256_mul_ps(z_im, s8_re));
+				_mm256_storeu_ps(&f[j], _mm256_add_ps(x_re, y_re));
+				_mm256_storeu_ps(&f[j + hn],
+					_mm256_add_ps(x_im, y_im));
+				_mm256_storeu_ps(&f[j + ht],
+					_mm256_sub_ps(x_re, y_re));
+				_mm256_storeu_ps(&f[j + ht + hn],
+					_mm256_sub_ps(x_im, y_im));
+			}
+			continue;
+		}
+#endif // yyyAVX2-
+		for (j = j1; j < j2; j ++) {
+			float x_re, x_im, y_re, y_im;
+
+			x_re = f[j];
+			x_im = f[j + hn];
+			y_re = f[j + ht] * s_re - f[j + ht + hn] * s_im;
+			y_im = f[j + ht] * s_im + f[j + ht + hn] * s_re;
+			f[j] = x_re + y_re;
+			f[j + hn] = x_im + y_im;
+			f[j + ht] = x_re - y_re;
+			f[j + ht + hn] = x_im - y_im;
+		}
+	}
+}
+
+/*
+ * Apply iFFT layer u (as in ifft_layers()) to single-precision values.
+ */
+TARGET_AVX2
+static void
+ifft32_layer(float *f, unsigned logn, unsigned u)
+{
+	size_t hn, t, hm, i1, j1;
+
+	hn = (size_t)1 << (logn - 1);
+	t = (size_t)1 << (logn - u);
+	hm = (size_t)1 << (u - 1);
+	for (i1 = 0, j1 = 0; j1 < hn; i1 ++, j1 += t << 1) {
+		size_t j, j2;
+		float s_re, s_im;
+
+		j2 = j1 + t;
+		s_re = (float)fpr_gm_tab[((hm + i1) << 1) + 0].v;
+		s_im = -(float)fpr_gm_tab[((hm + i1) << 1) + 1].v;
+#if FALCON_AVX2 // yyyAVX2+1
+		if (t >= 8) {
+			__m256 s8_re, s8_im;
+
+			s8_re = _mm256_set1_ps(s_re);
+			s8_im = _mm256_set1_ps(s_im);
+			for (j = j1; j < j2; j += 8) {
+				__m256 x_re, x_im, y_re, y_im;
+
+				x_re = _mm256_loadu_ps(&f[j]);
+				x_im = _mm256_loadu_ps(&f[j + hn]);
+				y_re = _mm256_loadu_ps(&f[j + t]);
+				y_im = _mm256_loadu_ps(&f[j + t + hn]);
+				_mm256_storeu_ps(&f[j], _mm256_add_ps(x_re, y_re));
+				_mm256_storeu_ps(&f[j + hn],
+					_mm256_add_ps(x_im, y_im));
+				x_re = _mm256_sub_ps(x_re, y_re);
+				x_im = _mm256_sub_ps(x_im, y_im);
+				_mm256_storeu_ps(&f[j + t], FMSUB_PS(x_re, s8_re,
+					_mm256_mul_ps(x_im, s8_im)));
+				_mm256_storeu_ps(&f[j + t + hn], FMADD_PS(x_re, s8_im,
+					_mm256_mul_ps(x_im, s8_re)));
+			}
+			continue;
+		}
+#endif // yyyAVX2-
+		for (j = j1; j < j2; j ++) {
+			float x_re, x_im, y_re, y_im;
+
+			x_re = f[j];
+			x_im = f[j + hn];
+			y_re = f[j + t];
+			y_im = f[j + t + hn];
+			f[j] = x_re + y_re;
+			f[j + hn] = x_im + y_im;
+			x_re -= y_re;
+			x_im -= y_im;
+			f[j + t] = x_re * s_re - x_im * s_im;
+			f[j + t + hn] = x_re * s_im + x_im * s_re;
+		}
+	}
+}
+
+#if FALCON_AVX2 // yyyAVX2+1
+/*
+ * Apply FFT layers u and u+1 in a single pass (as fft_layers2()), for
+ * quarters of at least 8 slots.
+ */
+TARGET_AVX2
+static void
+fft32_layers2(float *f, unsigned logn, unsigned u)
+{
+	size_t hn, t, q, m, hm, i1, j1;
+
+	hn = (size_t)1 << (logn - 1);
+	t = hn >> (u - 1);
+	q = t >> 2;
+	m = (size_t)1 << u;
+	hm = m >> 1;
+	for (i1 = 0, j1 = 0; i1 < hm; i1 ++, j1 += t) {
+		const fpr *s, *sa, *sb;
+		__m256 s_re, s_im, sa_re, sa_im, sb_re, sb_im;
+		size_t j;
+
+		s = &fpr_gm_tab[(m + i1) << 1];
+		sa = &fpr_gm_tab[((m + i1) << 2)];
+		sb = &fpr_gm_tab[((m + i1) << 2) + 2];
+		s_re = _mm256_set1_ps((float)s[0].v);
+		s_im = _mm256_set1_ps((float)s[1].v);
+		sa_re = _mm256_set1_ps((float)sa[0].v);
+		sa_im = _mm256_set1_ps((float)sa[1].v);
+		sb_re = _mm256_set1_ps((float)sb[0].v);
+		sb_im = _mm256_set1_ps((float)sb[1].v);
+		for (j = j1; j < j1 + q; j += 8) {
+			__m256 x0_re, x0_im, x1_re, x1_im;
+			__m256 x2_re, x2_im, x3_re, x3_im;
+			__m256 y_re, y_im;
+
+			x0_re = _mm256_loadu_ps(&f[j]);
+			x0_im = _mm256_loadu_ps(&f[j + hn]);
+			x1_re = _mm256_loadu_ps(&f[j + q]);
+			x1_im = _mm256_loadu_ps(&f[j + q + hn]);
+			x2_re = _mm256_loadu_ps(&f[j + 2 * q]);
+			x2_im = _mm256_loadu_ps(&f[j + 2 * q + hn]);
+			x3_re = _mm256_loadu_ps(&f[j + 3 * q]);
+			x3_im = _mm256_loadu_ps(&f[j + 3 * q + hn]);
+
+			y_re = FMSUB_PS(x2_re, s_re, _mm256_mul_ps(x2_im, s_im));
+			y_im = FMADD_PS(x2_re, s_im, _mm256_mul_ps(x2_im, s_re));
+			x2_re = _mm256_sub_ps(x0_re, y_re);
+			x2_im = _mm256_sub_ps(x0_im, y_im);
+			x0_re = _mm256_add_ps(x0_re, y_re);
+			x0_im = _mm256_add_ps(x0_im, y_im);
+			y_re = FMSUB_PS(x3_re, s_re, _mm256_mul_ps(x3_im, s_im));
+			y_im = FMADD_PS(x3_re, s_im, _mm256_mul_ps(x3_im, s_re));
+			x3_re = _mm256_sub_ps(x1_re, y_re);
+			x3_im = _mm256_sub_ps(x1_im, y_im);
+			x1_re = _mm256_add_ps(x1_re, y_re);
+			x1_im = _mm256_add_ps(x1_im, y_im);
+
+			y_re = FMSUB_PS(x1_re, sa_re, _mm256_mul_ps(x1_im, sa_im));
+			y_im = FMADD_PS(x1_re, sa_im, _mm256_mul_ps(x1_im, sa_re));
+			_mm256_storeu_ps(&f[j], _mm256_add_ps(x0_re, y_re));
+			_mm256_storeu_ps(&f[j + hn], _mm256_add_ps(x0_im, y_im));
+			_mm256_storeu_ps(&f[j + q], _mm256_sub_ps(x0_re, y_re));
+			_mm256_storeu_ps(&f[j + q + hn],
+				_mm256_sub_ps(x0_im, y_im));
+			y_re = FMSUB_PS(x3_re, sb_re, _mm256_mul_ps(x3_im, sb_im));
+			y_im = FMADD_PS(x3_re, sb_im, _mm256_mul_ps(x3_im, sb_re));
+			_mm256_storeu_ps(&f[j + 2 * q], _mm256_add_ps(x2_re, y_re));
+			_mm256_storeu_ps(&f[j + 2 * q + hn],
+				_mm256_add_ps(x2_im, y_im));
+			_mm256_storeu_ps(&f[j + 3 * q], _mm256_sub_ps(x2_re, y_re));
+			_mm256_storeu_ps(&f[j + 3 * q + hn],
+				_mm256_sub_ps(x2_im, y_im));
+		}
+	}
+}
+
+/*
+ * Apply iFFT layers u and u-1 in a single pass (as ifft_layers2(),
+ * without the scaling), for quarters of at least 8 slots.
+ */
+TARGET_AVX2
+static void
+ifft32_layers2(float *f, unsigned logn, unsigned u)
+{
+	size_t hn, t, h2, i1, j1;
+
+	hn = (size_t)1 << (logn - 1);
+	t = (size_t)1 << (logn - u);
+	h2 = hn >> (logn - u + 1);
+	for (i1 = 0, j1 = 0; j1 < hn; i1 ++, j1 += t << 2) {
+		const fpr *s0, *s1, *s2;
+		__m256 s0_re, s0_im, s1_re, s1_im, s2_re, s2_im;
+		size_t j;
+
+		s0 = &fpr_gm_tab[(h2 + i1) << 2];
+		s1 = &fpr_gm_tab[((h2 + i1) << 2) + 2];
+		s2 = &fpr_gm_tab[(h2 + i1) << 1];
+		s0_re = _mm256_set1_ps((float)s0[0].v);
+		s0_im = _mm256_set1_ps((float)s0[1].v);
+		s1_re = _mm256_set1_ps((float)s1[0].v);
+		s1_im = _mm256_set1_ps((float)s1[1].v);
+		s2_re = _mm256_set1_ps((float)s2[0].v);
+		s2_im = _mm256_set1_ps((float)s2[1].v);
+		for (j = j1; j < j1 + t; j += 8) {
+			__m256 x0_re, x0_im, x1_re, x1_im;
+			__m256 x2_re, x2_im, x3_re, x3_im;
+			__m256 y_re, y_im;
+
+			x0_re = _mm256_loadu_ps(&f[j]);
+			x0_im = _mm256_loadu_ps(&f[j + hn]);
+			x1_re = _mm256_loadu_ps(&f[j + t]);
+			x1_im = _mm256_loadu_ps(&f[j + t + hn]);
+			x2_re = _mm256_loadu_ps(&f[j + 2 * t]);
+			x2_im = _mm256_loadu_ps(&f[j + 2 * t + hn]);
+			x3_re = _mm256_loadu_ps(&f[j + 3 * t]);
+			x3_im = _mm256_loadu_ps(&f[j + 3 * t + hn]);
+
+			y_re = _mm256_sub_ps(x1_re, x0_re);
+			y_im = _mm256_sub_ps(x0_im, x1_im);
+			x0_re = _mm256_add_ps(x0_re, x1_re);
+			x0_im = _mm256_add_ps(x0_im, x1_im);
+			x1_re = FMSUB_PS(y_im, s0_im, _mm256_mul_ps(y_re, s0_re));
+			x1_im = FMADD_PS(y_re, s0_im, _mm256_mul_ps(y_im, s0_re));
+			y_re = _mm256_sub_ps(x3_re, x2_re);
+			y_im = _mm256_sub_ps(x2_im, x3_im);
+			x2_re = _mm256_add_ps(x2_re, x3_re);
+			x2_im = _mm256_add_ps(x2_im, x3_im);
+			x3_re = FMSUB_PS(y_im, s1_im, _mm256_mul_ps(y_re, s1_re));
+			x3_im = FMADD_PS(y_re, s1_im, _mm256_mul_ps(y_im, s1_re));
+
+			y_re = _mm256_sub_ps(x2_re, x0_re);
+			y_im = _mm256_sub_ps(x0_im, x2_im);
+			_mm256_storeu_ps(&f[j], _mm256_add_ps(x0_re, x2_re));
+			_mm256_storeu_ps(&f[j + hn], _mm256_add_ps(x0_im, x2_im));
+			_mm256_storeu_ps(&f[j + 2 * t],
+				FMSUB_PS(y_im, s2_im, _mm256_mul_ps(y_re, s2_re)));
+			_mm256_storeu_ps(&f[j + 2 * t + hn],
+				FMADD_PS(y_re, s2_im, _mm256_mul_ps(y_im, s2_re)));
+			y_re = _mm256_sub_ps(x3_re, x1_re);
+			y_im = _mm256_sub_ps(x1_im, x3_im);
+			_mm256_storeu_ps(&f[j + t], _mm256_add_ps(x1_re, x3_re));
+			_mm256_storeu_ps(&f[j + t + hn],
+				_mm256_add_ps(x1_im, x3_im));
+			_mm256_storeu_ps(&f[j + 3 * t],
+				FMSUB_PS(y_im, s2_im, _mm256_mul_ps(y_re, s2_re)));
+			_mm256_storeu_ps(&f[j + 3 * t + hn],
+				FMADD_PS(y_re, s2_im, _mm256_mul_ps(y_im, s2_re)));
+		}
+	}
+}
+#endif // yyyAVX2-
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(FFT32)(float *f, unsigned logn)
+{
+	unsigned u;
+
+	u = 1;
+#if FALCON_AVX2 // yyyAVX2+1
+	if (logn == 9 || logn == 10) {
+		/*
+		 * Layers 1 to logn-4 (with an odd layer first if needed),
+		 * then the last three layers.
+		 */
+		if (((logn - 4) & 1) != 0) {
+			fft32_layer(f, logn, 1);
+			u = 2;
+		}
+		for (; u < logn - 3; u += 2) {
+			fft32_layers2(f, logn, u);
+		}
+		fft32_tail(f, logn);
+		return;
+	}
+#endif // yyyAVX2-
+	for (; u < logn; u ++) {
+		fft32_layer(f, logn, u);
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(iFFT32)(float *f, unsigned logn)
+{
+	size_t n, v;
+	unsigned u;
+	float ni;
+
+	u = logn;
+#if FALCON_AVX2 // yyyAVX2+1
+	if (logn == 9 || logn == 10) {
+		ifft32_head(f, logn);
+		u = logn - 3;
+		if (((u - 1) & 1) != 0) {
+			ifft32_layer(f, logn, u);
+			u --;
+		}
+		for (; u > 1; u -= 2) {
+			ifft32_layers2(f, logn, u);
+		}
+	}
+#endif // yyyAVX2-
+	for (; u > 1; u --) {
+		ifft32_layer(f, logn, u);
+	}
+
+	/*
+	 * Last iteration is a no-op, provided that we divide by N/2
+	 * instead of N (see Zf(iFFT)).
+	 */
+	if (logn > 0) {
+		n = (size_t)1 << logn;
+		ni = (float)fpr_p2_tab[logn].v;
+		for (v = 0; v < n; v ++) {
+			f[v] *= ni;
+		}
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_basis_mul_fft32)(float *restrict y1, float *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t hn, w, u;
+
+	hn = (size_t)1 << (logn - 1);
+#if FALCON_AVX2 // yyyAVX2+1
+	if (hn >= 8) {
+		for (u = 0; u < hn; u += 8) {
+			const fpr *b;
+			__m256 a_re, a_im, c_re, c_im;
+			__m256 b_re, b_im, d_re, d_im;
+
+			b = B + (u << 3);
+			a_re = _mm256_loadu_ps(&y1[u]);
+			a_im = _mm256_loadu_ps(&y1[u + hn]);
+			c_re = _mm256_loadu_ps(&y2[u]);
+			c_im = _mm256_loadu_ps(&y2[u + hn]);
+
+			/*
+			 * y1 <- g*y1 + G*y2
+			 */
+			b_re = basis_load32(b + 8);
+			b_im = basis_load32(b + 12);
+			d_re = FMSUB_PS(a_re, b_re, _mm256_mul_ps(a_im, b_im));
+			d_im = FMADD_PS(a_re, b_im, _mm256_mul_ps(a_im, b_re));
+			b_re = basis_load32(b + 24);
+			b_im = basis_load32(b + 28);
+			_mm256_storeu_ps(&y1[u], _mm256_add_ps(d_re, FMSUB_PS(
+				c_re, b_re, _mm256_mul_ps(c_im, b_im))));
+			_mm256_storeu_ps(&y1[u + hn], _mm256_add_ps(d_im, FMADD_PS(
+				c_re, b_im, _mm256_mul_ps(c_im, b_re))));
+
+			/*
+			 * y2 <- F*y2 + f*y1
+			 */
+			b_re = basis_load32(b + 16);
+			b_im = basis_load32(b + 20);
+			d_re = FMSUB_PS(c_re, b_re, _mm256_mul_ps(c_im, b_im));
+			d_im = FMADD_PS(c_re, b_im, _mm256_mul_ps(c_im, b_re));
+			b_re = basis_load32(b + 0);
+			b_im = basis_load32(b + 4);
+			_mm256_storeu_ps(&y2[u], _mm256_add_ps(d_re, FMSUB_PS(
+				a_re, b_re, _mm256_mul_ps(a_im, b_im))));
+			_mm256_storeu_ps(&y2[u + hn], _mm256_add_ps(d_im, FMADD_PS(
+				a_re, b_im, _mm256_mul_ps(a_im, b_re))));
+		}
+		return;
+	}
+#endif // yyyAVX2-
+	w = hn < 4 ? hn : 4;
+	for (u = 0; u < hn; u ++) {
+		const fpr *b;
+		float a_re, a_im, c_re, c_im;
+
+		b = B + basis_off(u, w);
+		a_re = y1[u];
+		a_im = y1[u + hn];
+		c_re = y2[u];
+		c_im = y2[u + hn];
+		y1[u] = a_re * (float)b[2 * w].v - a_im * (float)b[3 * w].v
+			+ c_re * (float)b[6 * w].v - c_im * (float)b[7 * w].v;
+		y1[u + hn] = a_re * (float)b[3 * w].v
+			+ a_im * (float)b[2 * w].v
+			+ c_re * (float)b[7 * w].v + c_im * (float)b[6 * w].v;
+		y2[u] = c_re * (float)b[4 * w].v - c_im * (float)b[5 * w].v
+			+ a_re * (float)b[0].v - a_im * (float)b[w].v;
+		y2[u + hn] = c_re * (float)b[5 * w].v
+			+ c_im * (float)b[4 * w].v
+			+ a_re * (float)b[w].v + a_im * (float)b[0].v;
+	}
+}
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(poly_basis_mul2_fft32)(const float *restrict y1, float *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t hn, w, u;
+
+	hn = (size_t)1 << (logn - 1);
+#if FALCON_AVX2 // yyyAVX2+1
+	if (hn >= 8) {
+		for (u = 0; u < hn; u += 8) {
+			const fpr *b;
+			__m256 a_re, a_im, c_re, c_im;
+			__m256 b_re, b_im, d_re, d_im;
+
+			b = B + (u << 3);
+			a_re = _mm256_loadu_ps(&y1[u]);
+			a_im = _mm256_loadu_ps(&y1[u + hn]);
+			c_re = _mm256_loadu_ps(&y2[u]);
+			c_im = _mm256_loadu_ps(&y2[u + hn]);
+			b_re = basis_load32(b + 16);
+			b_im = basis_load32(b + 20);
+			d_re = FMSUB_PS(c_re, b_re, _mm256_mul_ps(c_im, b_im));
+			d_im = FMADD_PS(c_re, b_im, _mm256_mul_ps(c_im, b_re));
+			b_re = basis_load32(b + 0);
+			b_im = basis_load32(b + 4);
+			_mm256_storeu_ps(&y2[u], _mm256_add_ps(d_re, FMSUB_PS(
+				a_re, b_re, _mm256_mul_ps(a_im, b_im))));
+			_mm256_storeu_ps(&y2[u + hn], _mm256_add_ps(d_im, FMADD_PS(
+				a_re, b_im, _mm256_mul_ps(a_im, b_re))));
+		}
+		return;
+	}
+#endif // yyyAVX2-
+	w = hn < 4 ? hn : 4;
+	for (u = 0; u < hn; u ++) {
+		const fpr *b;
+		float a_re, a_im, c_re, c_im;
+
+		b = B + basis_off(u, w);
+		a_re = y1[u];
+		a_im = y1[u + hn];
+		c_re = y2[u];
+		c_im = y2[u + hn];
+		y2[u] = c_re * (float)b[4 * w].v - c_im * (float)b[5 * w].v
+			+ a_re * (float)b[0].v - a_im * (float)b[w].v;
+		y2[u + hn] = c_re * (float)b[5 * w].v
+			+ c_im * (float)b[4 * w].v
+			+ a_re * (float)b[w].v + a_im * (float)b[0].v;
+	}
+}
+#endif
@@ -36,6 +36,26 @@
 
 #if FALCON_FPEMU // yyyFPEMU+1
 
+#if FALCON_FPEMU64 // yyyFPEMU64+1
+
+/*
+ * Normalize a provided unsigned integer to the 2^63..2^64-1 range by
+ * left-shifting it if necessary. The exponent e is adjusted accordingly
+ * (i.e. if the value was left-shifted by n bits, then n is subtracted
+ * from e). If source m is 0, then it remains 0, but e is altered (by
+ * -63, as in the generic code). Both m and e must be simple variables
+ * (no expressions allowed).
+ */
+#define FPR_NORM64(m, e)   do { \
+		int nz; \
+ \
+		nz = __builtin_clzll((m) | 1); \
+		(m) <<= nz; \
+		(e) -= nz; \
+	} while (0)
+
+#else // yyyFPEMU64+0
+
 /*
  * Normalize a provided unsigned integer to the 2^63..2^64-1 range by
  * left-shifting it if necessary. The exponent e is adjusted accordingly
@@ -78,6 +98,8 @@
 		(e) += (int)(nt); \
 	} while (0)
 
+#endif // yyyFPEMU64-
+
 #if FALCON_ASM_CORTEXM4 // yyyASM_CORTEXM4+1
 
 __attribute__((naked))
@@ -706,7 +728,11 @@ fpr
 fpr_mul(fpr x, fpr y)
 {
 	uint64_t xu, yu, w, zu, zv;
+#if FALCON_FPEMU64 // yyyFPEMU64+1
+	unsigned __int128 z;
+#else // yyyFPEMU64+0
 	uint32_t x0, x1, y0, y1, z0, z1, z2;
+#endif // yyyFPEMU64-
 	int ex, ey, d, e, s;
 
 	/*
@@ -716,6 +742,18 @@ fpr_mul(fpr x, fpr y)
 	xu = (x & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
 	yu = (y & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
 
+#if FALCON_FPEMU64 // yyyFPEMU64+1
+	/*
+	 * Since xu and yu are both in the 2^52..2^53-1 range, the
+	 * product is in the 2^104..2^106-1 range. We keep its top bits
+	 * in the 2^54..2^56-1 range; the 50 dropped bits only matter
+	 * for the "sticky" bottom bit.
+	 */
+	z = (unsigned __int128)xu * (unsigned __int128)yu;
+	zu = (uint64_t)(z >> 50);
+	w = (uint64_t)z & (((uint64_t)1 << 50) - 1);
+	zu |= (w + (((uint64_t)1 << 50) - 1)) >> 50;
+#else // yyyFPEMU64+0
 	/*
 	 * We have two 53-bit integers to multiply; we need to split
 	 * each into a lower half and a upper half. Moreover, we
@@ -750,6 +788,7 @@ fpr_mul(fpr x, fpr y)
 	 * (This is the reason why we chose 25-bit limbs above.)
 	 */
 	zu |= ((z0 | z1) + 0x01FFFFFF) >> 25;
+#endif // yyyFPEMU64-
 
 	/*
 	 * We normalize zu to the 2^54..s^55-1 range: it could be one
@@ -941,6 +980,9 @@ fpr
 fpr_div(fpr x, fpr y)
 {
 	uint64_t xu, yu, q, q2, w;
+#if FALCON_FPEMU64 // yyyFPEMU64+1
+	uint64_t D, r, rem;
+#endif // yyyFPEMU64-
 	int i, ex, ey, e, d, s;
 
 	/*
@@ -949,6 +991,43 @@ fpr_div(fpr x, fpr y)
 	xu = (x & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
 	yu = (y & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52);
 
+#if FALCON_FPEMU64 // yyyFPEMU64+1
+	/*
+	 * We compute the same value as the bit-by-bit loop of the
+	 * generic code: q = 2*floor(xu*2^54/yu), with the bottom bit set
+	 * if the remainder is not zero.
+	 *
+	 * First, r ~ 2^126/D with D = yu*2^11 (2^63 <= D < 2^64), hence
+	 * 2^62 < r <= 2^63: we start from the linear approximation
+	 * 48/17 - 32/17*(D/2^64) (relative error below 1/17), and apply
+	 * four Newton-Raphson iterations r <- r*(2 - r*D/2^126), which
+	 * bring the relative error down to a few units of 2^-62. The
+	 * quotient estimate xu*r/2^61 is then off by at most one (we
+	 * allow one unit too high and two too low), and the remainder
+	 * (lower than 2^56 in absolute value, so it fits in a 64-bit
+	 * word) is used to fix it, without any branch.
+	 */
+	D = yu << 11;
+	r = (uint64_t)13021231110853801984u
+		- (uint64_t)(((unsigned __int128)D
+		* (uint64_t)8680820740569200640u) >> 64);
+	for (i = 0; i < 4; i ++) {
+		w = ((uint64_t)1 << 63)
+			- (uint64_t)(((unsigned __int128)D * r) >> 64);
+		r = (uint64_t)(((unsigned __int128)r * w) >> 62);
+	}
+	q = (uint64_t)(((unsigned __int128)xu * r) >> 61);
+	rem = (xu << 54) - q * yu;
+	w = -(rem >> 63);
+	q += w;
+	rem += w & yu;
+	for (i = 0; i < 2; i ++) {
+		w = ((rem - yu) >> 63) - 1;
+		q -= w;
+		rem -= w & yu;
+	}
+	q = (q << 1) | ((rem | -rem) >> 63);
+#else // yyyFPEMU64+0
 	/*
 	 * Perform bit-by-bit division of xu by yu. We run it for 55 bits.
 	 */
@@ -974,6 +1053,7 @@ fpr_div(fpr x, fpr y)
 	 * only if the remainder (xu) is non-zero.
 	 */
 	q |= (xu | -xu) >> 63;
+#endif // yyyFPEMU64-
 
 	/*
 	 * Quotient is at most 2^56-1. Its top bit may be zero, but in
@@ -3453,6 +3533,1379 @@ const fpr fpr_p2_tab[] = {
 	{ 0.00195312500 }
 };
 
+/*
+ * Twiddle factors for the last two FFT layers (and the first two iFFT
+ * layers) of the specialized transforms for logn = 9 and 10, in the
+ * order in which the AVX2 code reads them: for each block of 8
+ * coefficients, 4 real parts and 4 imaginary parts for the layer with
+ * 2 coefficients per half-group (each value repeated twice), then 4
+ * real parts and 4 imaginary parts for the last layer. Values are
+ * copied from fpr_gm_tab[].
+ */
+const fpr fpr_gm_tail9[] = {
+	{ 0.999924701839144540921646491}, { 0.999924701839144540921646491},
+	{-0.012271538285719926079408262}, {-0.012271538285719926079408262},
+	{ 0.012271538285719926079408262}, { 0.012271538285719926079408262},
+	{ 0.999924701839144540921646491}, { 0.999924701839144540921646491},
+	{ 0.999981175282601142656990438}, {-0.006135884649154475359640235},
+	{ 0.702754744457225302452914421}, {-0.711432195745216441522130290},
+	{ 0.006135884649154475359640235}, { 0.999981175282601142656990438},
+	{ 0.711432195745216441522130290}, { 0.702754744457225302452914421},
+	{ 0.698376249408972853554813503}, { 0.698376249408972853554813503},
+	{-0.715730825283818654125532623}, {-0.715730825283818654125532623},
+	{ 0.715730825283818654125532623}, { 0.715730825283818654125532623},
+	{ 0.698376249408972853554813503}, { 0.698376249408972853554813503},
+	{ 0.921514039342041943465396332}, {-0.388345046698826291624993541},
+	{ 0.377007410216418256726567823}, {-0.926210242138311341974793388},
+	{ 0.388345046698826291624993541}, { 0.921514039342041943465396332},
+	{ 0.926210242138311341974793388}, { 0.377007410216418256726567823},
+	{ 0.919113851690057743908477789}, { 0.919113851690057743908477789},
+	{-0.393992040061048108596188661}, {-0.393992040061048108596188661},
+	{ 0.393992040061048108596188661}, { 0.393992040061048108596188661},
+	{ 0.919113851690057743908477789}, { 0.919113851690057743908477789},
+	{ 0.979569765685440534439326110}, {-0.201104634842091911558443546},
+	{ 0.550457972936604802977289893}, {-0.834862874986380056304401383},
+	{ 0.201104634842091911558443546}, { 0.979569765685440534439326110},
+	{ 0.834862874986380056304401383}, { 0.550457972936604802977289893},
+	{ 0.371317193951837543411934967}, { 0.371317193951837543411934967},
+	{-0.928506080473215565937167396}, {-0.928506080473215565937167396},
+	{ 0.928506080473215565937167396}, { 0.928506080473215565937167396},
+	{ 0.371317193951837543411934967}, { 0.371317193951837543411934967},
+	{ 0.828045045257755752067527592}, {-0.560661576197336023839710223},
+	{ 0.189068664149806212754997837}, {-0.981963869109555264072848154},
+	{ 0.560661576197336023839710223}, { 0.828045045257755752067527592},
+	{ 0.981963869109555264072848154}, { 0.189068664149806212754997837},
+	{ 0.978317370719627633106240097}, { 0.978317370719627633106240097},
+	{-0.207111376192218549708116020}, {-0.207111376192218549708116020},
+	{ 0.207111376192218549708116020}, { 0.207111376192218549708116020},
+	{ 0.978317370719627633106240097}, { 0.978317370719627633106240097},
+	{ 0.994564570734255452119106243}, {-0.104121633872054579120943880},
+	{ 0.629638238914927025372981341}, {-0.776888465673232450040827983},
+	{ 0.104121633872054579120943880}, { 0.994564570734255452119106243},
+	{ 0.776888465673232450040827983}, { 0.629638238914927025372981341},
+	{ 0.545324988422046422313987347}, { 0.545324988422046422313987347},
+	{-0.838224705554838043186996856}, {-0.838224705554838043186996856},
+	{ 0.838224705554838043186996856}, { 0.838224705554838043186996856},
+	{ 0.545324988422046422313987347}, { 0.545324988422046422313987347},
+	{ 0.879012226428633477831323711}, {-0.476799230063322133342158117},
+	{ 0.284407537211271843618310615}, {-0.958703474895871555374645792},
+	{ 0.476799230063322133342158117}, { 0.879012226428633477831323711},
+	{ 0.958703474895871555374645792}, { 0.284407537211271843618310615},
+	{ 0.824589302785025264474803737}, { 0.824589302785025264474803737},
+	{-0.565731810783613197389765011}, {-0.565731810783613197389765011},
+	{ 0.565731810783613197389765011}, { 0.565731810783613197389765011},
+	{ 0.824589302785025264474803737}, { 0.824589302785025264474803737},
+	{ 0.955141168305770721498157712}, {-0.296150888243623824121786128},
+	{ 0.465976495767966177902756065}, {-0.884797098430937780104007041},
+	{ 0.296150888243623824121786128}, { 0.955141168305770721498157712},
+	{ 0.884797098430937780104007041}, { 0.465976495767966177902756065},
+	{ 0.183039887955140958516532578}, { 0.183039887955140958516532578},
+	{-0.983105487431216327180301155}, {-0.983105487431216327180301155},
+	{ 0.983105487431216327180301155}, { 0.983105487431216327180301155},
+	{ 0.183039887955140958516532578}, { 0.183039887955140958516532578},
+	{ 0.769103337645579639346626069}, {-0.639124444863775743801488193},
+	{ 0.091908956497132728624990979}, {-0.995767414467659793982495643},
+	{ 0.639124444863775743801488193}, { 0.769103337645579639346626069},
+	{ 0.995767414467659793982495643}, { 0.091908956497132728624990979},
+	{ 0.993906970002356041546922813}, { 0.993906970002356041546922813},
+	{-0.110222207293883058807899140}, {-0.110222207293883058807899140},
+	{ 0.110222207293883058807899140}, { 0.110222207293883058807899140},
+	{ 0.993906970002356041546922813}, { 0.993906970002356041546922813},
+	{ 0.998475580573294752208559038}, {-0.055195244349689939809447526},
+	{ 0.666999922303637506650154222}, {-0.745057785441465962407907310},
+	{ 0.055195244349689939809447526}, { 0.998475580573294752208559038},
+	{ 0.745057785441465962407907310}, { 0.666999922303637506650154222},
+	{ 0.624859488142386377084072816}, { 0.624859488142386377084072816},
+	{-0.780737228572094478301588484}, {-0.780737228572094478301588484},
+	{ 0.780737228572094478301588484}, { 0.780737228572094478301588484},
+	{ 0.624859488142386377084072816}, { 0.624859488142386377084072816},
+	{ 0.901348847046022014570746093}, {-0.433093818853151968484222638},
+	{ 0.331106305759876401737190737}, {-0.943593458161960361495301445},
+	{ 0.433093818853151968484222638}, { 0.901348847046022014570746093},
+	{ 0.943593458161960361495301445}, { 0.331106305759876401737190737},
+	{ 0.876070094195406607095844268}, { 0.876070094195406607095844268},
+	{-0.482183772079122748517344481}, {-0.482183772079122748517344481},
+	{ 0.482183772079122748517344481}, { 0.482183772079122748517344481},
+	{ 0.876070094195406607095844268}, { 0.876070094195406607095844268},
+	{ 0.968522094274417316221088329}, {-0.248927605745720168110682816},
+	{ 0.508830142543107036931749324}, {-0.860866938637767279344583877},
+	{ 0.248927605745720168110682816}, { 0.968522094274417316221088329},
+	{ 0.860866938637767279344583877}, { 0.508830142543107036931749324},
+	{ 0.278519689385053105207848526}, { 0.278519689385053105207848526},
+	{-0.960430519415565811199035138}, {-0.960430519415565811199035138},
+	{ 0.960430519415565811199035138}, { 0.960430519415565811199035138},
+	{ 0.278519689385053105207848526}, { 0.278519689385053105207848526},
+	{ 0.799537269107905033500246232}, {-0.600616479383868926653875896},
+	{ 0.140658239332849230714788846}, {-0.990058210262297105505906464},
+	{ 0.600616479383868926653875896}, { 0.799537269107905033500246232},
+	{ 0.990058210262297105505906464}, { 0.140658239332849230714788846},
+	{ 0.953306040354193836916740383}, { 0.953306040354193836916740383},
+	{-0.302005949319228067003463232}, {-0.302005949319228067003463232},
+	{ 0.302005949319228067003463232}, { 0.302005949319228067003463232},
+	{ 0.953306040354193836916740383}, { 0.953306040354193836916740383},
+	{ 0.988257567730749491404792538}, {-0.152797185258443427720336613},
+	{ 0.590759701858874228423887908}, {-0.806847553543799272206514313},
+	{ 0.152797185258443427720336613}, { 0.988257567730749491404792538},
+	{ 0.806847553543799272206514313}, { 0.590759701858874228423887908},
+	{ 0.460538710958240023633181487}, { 0.460538710958240023633181487},
+	{-0.887639620402853947760181617}, {-0.887639620402853947760181617},
+	{ 0.887639620402853947760181617}, { 0.887639620402853947760181617},
+	{ 0.460538710958240023633181487}, { 0.460538710958240023633181487},
+	{ 0.854557988365400520767862276}, {-0.519355990165589587361829932},
+	{ 0.237023605994367206867735915}, {-0.971503890986251775537099622},
+	{ 0.519355990165589587361829932}, { 0.854557988365400520767862276},
+	{ 0.971503890986251775537099622}, { 0.237023605994367206867735915},
+	{ 0.765167265622458925888815999}, { 0.765167265622458925888815999},
+	{-0.643831542889791465068086063}, {-0.643831542889791465068086063},
+	{ 0.643831542889791465068086063}, { 0.643831542889791465068086063},
+	{ 0.765167265622458925888815999}, { 0.765167265622458925888815999},
+	{ 0.939459223602189911962669246}, {-0.342660717311994397592781983},
+	{ 0.422000270799799685941287941}, {-0.906595704514915365332960588},
+	{ 0.342660717311994397592781983}, { 0.939459223602189911962669246},
+	{ 0.906595704514915365332960588}, { 0.422000270799799685941287941},
+	{ 0.085797312344439890461556332}, { 0.085797312344439890461556332},
+	{-0.996312612182778012627226190}, {-0.996312612182778012627226190},
+	{ 0.996312612182778012627226190}, { 0.996312612182778012627226190},
+	{ 0.085797312344439890461556332}, { 0.085797312344439890461556332},
+	{ 0.736816568877369875090132520}, {-0.676092703575315960360419228},
+	{ 0.042938256934940823077124540}, {-0.999077727752645382888781997},
+	{ 0.676092703575315960360419228}, { 0.736816568877369875090132520},
+	{ 0.999077727752645382888781997}, { 0.042938256934940823077124540},
+	{ 0.998118112900149207125155861}, { 0.998118112900149207125155861},
+	{-0.061320736302208577782614593}, {-0.061320736302208577782614593},
+	{ 0.061320736302208577782614593}, { 0.061320736302208577782614593},
+	{ 0.998118112900149207125155861}, { 0.998118112900149207125155861},
+	{ 0.999529417501093163079703322}, {-0.030674803176636625934021028},
+	{ 0.685083667772700381362052545}, {-0.728464390448225196492035438},
+	{ 0.030674803176636625934021028}, { 0.999529417501093163079703322},
+	{ 0.728464390448225196492035438}, { 0.685083667772700381362052545},
+	{ 0.662415777590171761113069817}, { 0.662415777590171761113069817},
+	{-0.749136394523459325469203257}, {-0.749136394523459325469203257},
+	{ 0.749136394523459325469203257}, { 0.749136394523459325469203257},
+	{ 0.662415777590171761113069817}, { 0.662415777590171761113069817},
+	{ 0.911706032005429851404397325}, {-0.410843171057903942183466675},
+	{ 0.354163525420490382357395796}, {-0.935183509938947577642207480},
+	{ 0.410843171057903942183466675}, { 0.911706032005429851404397325},
+	{ 0.935183509938947577642207480}, { 0.354163525420490382357395796},
+	{ 0.898674465693953843041976744}, { 0.898674465693953843041976744},
+	{-0.438616238538527637647025738}, {-0.438616238538527637647025738},
+	{ 0.438616238538527637647025738}, { 0.438616238538527637647025738},
+	{ 0.898674465693953843041976744}, { 0.898674465693953843041976744},
+	{ 0.974339382785575860518721668}, {-0.225083911359792835991642120},
+	{ 0.529803624686294668216054671}, {-0.848120344803297251279133563},
+	{ 0.225083911359792835991642120}, { 0.974339382785575860518721668},
+	{ 0.848120344803297251279133563}, { 0.529803624686294668216054671},
+	{ 0.325310292162262934135954708}, { 0.325310292162262934135954708},
+	{-0.945607325380521325730945387}, {-0.945607325380521325730945387},
+	{ 0.945607325380521325730945387}, { 0.945607325380521325730945387},
+	{ 0.325310292162262934135954708}, { 0.325310292162262934135954708},
+	{ 0.814036329705948361654516690}, {-0.580813958095764545075595272},
+	{ 0.164913120489969921418189113}, {-0.986308097244598647863297524},
+	{ 0.580813958095764545075595272}, { 0.814036329705948361654516690},
+	{ 0.986308097244598647863297524}, { 0.164913120489969921418189113},
+	{ 0.966976471044852109087220226}, { 0.966976471044852109087220226},
+	{-0.254865659604514571553980779}, {-0.254865659604514571553980779},
+	{ 0.254865659604514571553980779}, { 0.254865659604514571553980779},
+	{ 0.966976471044852109087220226}, { 0.966976471044852109087220226},
+	{ 0.991709753669099522860049931}, {-0.128498110793793172624415589},
+	{ 0.610382806276309452716352152}, {-0.792106577300212351782342879},
+	{ 0.128498110793793172624415589}, { 0.991709753669099522860049931},
+	{ 0.792106577300212351782342879}, { 0.610382806276309452716352152},
+	{ 0.503538383725717558691867071}, { 0.503538383725717558691867071},
+	{-0.863972856121586737918147054}, {-0.863972856121586737918147054},
+	{ 0.863972856121586737918147054}, { 0.863972856121586737918147054},
+	{ 0.503538383725717558691867071}, { 0.503538383725717558691867071},
+	{ 0.867046245515692651480195629}, {-0.498227666972781852410983869},
+	{ 0.260794117915275518280186509}, {-0.965394441697689374550843858},
+	{ 0.498227666972781852410983869}, { 0.867046245515692651480195629},
+	{ 0.965394441697689374550843858}, { 0.260794117915275518280186509},
+	{ 0.795836904608883536262791915}, { 0.795836904608883536262791915},
+	{-0.605511041404325513920626941}, {-0.605511041404325513920626941},
+	{ 0.605511041404325513920626941}, { 0.605511041404325513920626941},
+	{ 0.795836904608883536262791915}, { 0.795836904608883536262791915},
+	{ 0.947585591017741134653387321}, {-0.319502030816015677901518272},
+	{ 0.444122144570429231642069418}, {-0.895966249756185155914560282},
+	{ 0.319502030816015677901518272}, { 0.947585591017741134653387321},
+	{ 0.895966249756185155914560282}, { 0.444122144570429231642069418},
+	{ 0.134580708507126186316358409}, { 0.134580708507126186316358409},
+	{-0.990902635427780025108237011}, {-0.990902635427780025108237011},
+	{ 0.990902635427780025108237011}, { 0.990902635427780025108237011},
+	{ 0.134580708507126186316358409}, { 0.134580708507126186316358409},
+	{ 0.753186799043612482483430486}, {-0.657806693297078656931182264},
+	{ 0.067443919563664057897972422}, {-0.997723066644191609848546728},
+	{ 0.657806693297078656931182264}, { 0.753186799043612482483430486},
+	{ 0.997723066644191609848546728}, { 0.067443919563664057897972422},
+	{ 0.987301418157858382399815802}, { 0.987301418157858382399815802},
+	{-0.158858143333861441684385360}, {-0.158858143333861441684385360},
+	{ 0.158858143333861441684385360}, { 0.158858143333861441684385360},
+	{ 0.987301418157858382399815802}, { 0.987301418157858382399815802},
+	{ 0.996820299291165714972629398}, {-0.079682437971430121147120656},
+	{ 0.648514401022112445084560551}, {-0.761202385484261814029709836},
+	{ 0.079682437971430121147120656}, { 0.996820299291165714972629398},
+	{ 0.761202385484261814029709836}, { 0.648514401022112445084560551},
+	{ 0.585797857456438860328080838}, { 0.585797857456438860328080838},
+	{-0.810457198252594791726703434}, {-0.810457198252594791726703434},
+	{ 0.810457198252594791726703434}, { 0.810457198252594791726703434},
+	{ 0.585797857456438860328080838}, { 0.585797857456438860328080838},
+	{ 0.890448723244757889952150560}, {-0.455083587126343823535869268},
+	{ 0.307849640041534893682063646}, {-0.951435020969008369549175569},
+	{ 0.455083587126343823535869268}, { 0.890448723244757889952150560},
+	{ 0.951435020969008369549175569}, { 0.307849640041534893682063646},
+	{ 0.851355193105265142261290312}, { 0.851355193105265142261290312},
+	{-0.524589682678468906215098464}, {-0.524589682678468906215098464},
+	{ 0.524589682678468906215098464}, { 0.524589682678468906215098464},
+	{ 0.851355193105265142261290312}, { 0.851355193105265142261290312},
+	{ 0.962121404269041595429604316}, {-0.272621355449948984493347477},
+	{ 0.487550160148435954641485027}, {-0.873094978418290098636085973},
+	{ 0.272621355449948984493347477}, { 0.962121404269041595429604316},
+	{ 0.873094978418290098636085973}, { 0.487550160148435954641485027},
+	{ 0.231058108280671119643236018}, { 0.231058108280671119643236018},
+	{-0.972939952205560145467720114}, {-0.972939952205560145467720114},
+	{ 0.972939952205560145467720114}, { 0.972939952205560145467720114},
+	{ 0.231058108280671119643236018}, { 0.231058108280671119643236018},
+	{ 0.784556597155575233023892575}, {-0.620057211763289178646268191},
+	{ 0.116318630911904767252544319}, {-0.993211949234794533104601012},
+	{ 0.620057211763289178646268191}, { 0.784556597155575233023892575},
+	{ 0.993211949234794533104601012}, { 0.116318630911904767252544319},
+	{ 0.937339011912574923201899593}, { 0.937339011912574923201899593},
+	{-0.348418680249434568419308588}, {-0.348418680249434568419308588},
+	{ 0.348418680249434568419308588}, { 0.348418680249434568419308588},
+	{ 0.937339011912574923201899593}, { 0.937339011912574923201899593},
+	{ 0.984210092386929073193874387}, {-0.177004220412148756196839844},
+	{ 0.570780745886967280232652864}, {-0.821102514991104679060430820},
+	{ 0.177004220412148756196839844}, { 0.984210092386929073193874387},
+	{ 0.821102514991104679060430820}, { 0.570780745886967280232652864},
+	{ 0.416429560097637182562598911}, { 0.416429560097637182562598911},
+	{-0.909167983090522376563884788}, {-0.909167983090522376563884788},
+	{ 0.909167983090522376563884788}, { 0.909167983090522376563884788},
+	{ 0.416429560097637182562598911}, { 0.416429560097637182562598911},
+	{ 0.841554977436898409603499520}, {-0.540171472729892881297845480},
+	{ 0.213110319916091373967757518}, {-0.977028142657754351485866211},
+	{ 0.540171472729892881297845480}, { 0.841554977436898409603499520},
+	{ 0.977028142657754351485866211}, { 0.213110319916091373967757518},
+	{ 0.732654271672412834615546649}, { 0.732654271672412834615546649},
+	{-0.680600997795453050594430464}, {-0.680600997795453050594430464},
+	{ 0.680600997795453050594430464}, { 0.680600997795453050594430464},
+	{ 0.732654271672412834615546649}, { 0.732654271672412834615546649},
+	{ 0.930766961078983731944872340}, {-0.365612997804773870011745909},
+	{ 0.399624199845646828544117031}, {-0.916679059921042663116457013},
+	{ 0.365612997804773870011745909}, { 0.930766961078983731944872340},
+	{ 0.916679059921042663116457013}, { 0.399624199845646828544117031},
+	{ 0.036807222941358832324332691}, { 0.036807222941358832324332691},
+	{-0.999322384588349500896221011}, {-0.999322384588349500896221011},
+	{ 0.999322384588349500896221011}, { 0.999322384588349500896221011},
+	{ 0.036807222941358832324332691}, { 0.036807222941358832324332691},
+	{ 0.720002507961381629076682999}, {-0.693971460889654009003734389},
+	{ 0.018406729905804820927366313}, {-0.999830581795823422015722275},
+	{ 0.693971460889654009003734389}, { 0.720002507961381629076682999},
+	{ 0.999830581795823422015722275}, { 0.018406729905804820927366313}
+};
+
+const fpr fpr_gm_tail10[] = {
+	{ 0.999981175282601142656990438}, { 0.999981175282601142656990438},
+	{-0.006135884649154475359640235}, {-0.006135884649154475359640235},
+	{ 0.006135884649154475359640235}, { 0.006135884649154475359640235},
+	{ 0.999981175282601142656990438}, { 0.999981175282601142656990438},
+	{ 0.999995293809576171511580126}, {-0.003067956762965976270145365},
+	{ 0.704934080375904908852523758}, {-0.709272826438865651316533772},
+	{ 0.003067956762965976270145365}, { 0.999995293809576171511580126},
+	{ 0.709272826438865651316533772}, { 0.704934080375904908852523758},
+	{ 0.702754744457225302452914421}, { 0.702754744457225302452914421},
+	{-0.711432195745216441522130290}, {-0.711432195745216441522130290},
+	{ 0.711432195745216441522130290}, { 0.711432195745216441522130290},
+	{ 0.702754744457225302452914421}, { 0.702754744457225302452914421},
+	{ 0.922701128333878570437264227}, {-0.385516053843918864075607949},
+	{ 0.379847208924051170576281147}, {-0.925049240782677590302371869},
+	{ 0.385516053843918864075607949}, { 0.922701128333878570437264227},
+	{ 0.925049240782677590302371869}, { 0.379847208924051170576281147},
+	{ 0.921514039342041943465396332}, { 0.921514039342041943465396332},
+	{-0.388345046698826291624993541}, {-0.388345046698826291624993541},
+	{ 0.388345046698826291624993541}, { 0.388345046698826291624993541},
+	{ 0.921514039342041943465396332}, { 0.921514039342041943465396332},
+	{ 0.980182135968117392690210009}, {-0.198098410717953586179324918},
+	{ 0.553016705580027531764226988}, {-0.833170164701913186439915922},
+	{ 0.198098410717953586179324918}, { 0.980182135968117392690210009},
+	{ 0.833170164701913186439915922}, { 0.553016705580027531764226988},
+	{ 0.377007410216418256726567823}, { 0.377007410216418256726567823},
+	{-0.926210242138311341974793388}, {-0.926210242138311341974793388},
+	{ 0.926210242138311341974793388}, { 0.926210242138311341974793388},
+	{ 0.377007410216418256726567823}, { 0.377007410216418256726567823},
+	{ 0.829761233794523042469023765}, {-0.558118531220556115693702964},
+	{ 0.192080397049892441679288205}, {-0.981379193313754574318224190},
+	{ 0.558118531220556115693702964}, { 0.829761233794523042469023765},
+	{ 0.981379193313754574318224190}, { 0.192080397049892441679288205},
+	{ 0.979569765685440534439326110}, { 0.979569765685440534439326110},
+	{-0.201104634842091911558443546}, {-0.201104634842091911558443546},
+	{ 0.201104634842091911558443546}, { 0.201104634842091911558443546},
+	{ 0.979569765685440534439326110}, { 0.979569765685440534439326110},
+	{ 0.994879330794805620591166107}, {-0.101069862754827824987887585},
+	{ 0.632018735939809021909403706}, {-0.774953106594873878359129282},
+	{ 0.101069862754827824987887585}, { 0.994879330794805620591166107},
+	{ 0.774953106594873878359129282}, { 0.632018735939809021909403706},
+	{ 0.550457972936604802977289893}, { 0.550457972936604802977289893},
+	{-0.834862874986380056304401383}, {-0.834862874986380056304401383},
+	{ 0.834862874986380056304401383}, { 0.834862874986380056304401383},
+	{ 0.550457972936604802977289893}, { 0.550457972936604802977289893},
+	{ 0.880470889052160770806542929}, {-0.474100214650550014398580015},
+	{ 0.287347459544729526477331841}, {-0.957826413027532890321037029},
+	{ 0.474100214650550014398580015}, { 0.880470889052160770806542929},
+	{ 0.957826413027532890321037029}, { 0.287347459544729526477331841},
+	{ 0.828045045257755752067527592}, { 0.828045045257755752067527592},
+	{-0.560661576197336023839710223}, {-0.560661576197336023839710223},
+	{ 0.560661576197336023839710223}, { 0.560661576197336023839710223},
+	{ 0.828045045257755752067527592}, { 0.828045045257755752067527592},
+	{ 0.956045251349996443270479823}, {-0.293219162694258650606608599},
+	{ 0.468688822035827933697617870}, {-0.883363338665731594736308015},
+	{ 0.293219162694258650606608599}, { 0.956045251349996443270479823},
+	{ 0.883363338665731594736308015}, { 0.468688822035827933697617870},
+	{ 0.189068664149806212754997837}, { 0.189068664149806212754997837},
+	{-0.981963869109555264072848154}, {-0.981963869109555264072848154},
+	{ 0.981963869109555264072848154}, { 0.981963869109555264072848154},
+	{ 0.189068664149806212754997837}, { 0.189068664149806212754997837},
+	{ 0.771060524261813773200605759}, {-0.636761861236284230413943435},
+	{ 0.094963495329638998938034312}, {-0.995480755491926941769171600},
+	{ 0.636761861236284230413943435}, { 0.771060524261813773200605759},
+	{ 0.995480755491926941769171600}, { 0.094963495329638998938034312},
+	{ 0.994564570734255452119106243}, { 0.994564570734255452119106243},
+	{-0.104121633872054579120943880}, {-0.104121633872054579120943880},
+	{ 0.104121633872054579120943880}, { 0.104121633872054579120943880},
+	{ 0.994564570734255452119106243}, { 0.994564570734255452119106243},
+	{ 0.998640218180265222418199049}, {-0.052131704680283321236358216},
+	{ 0.669282588346636065720696366}, {-0.743007952135121693517362293},
+	{ 0.052131704680283321236358216}, { 0.998640218180265222418199049},
+	{ 0.743007952135121693517362293}, { 0.669282588346636065720696366},
+	{ 0.629638238914927025372981341}, { 0.629638238914927025372981341},
+	{-0.776888465673232450040827983}, {-0.776888465673232450040827983},
+	{ 0.776888465673232450040827983}, { 0.776888465673232450040827983},
+	{ 0.629638238914927025372981341}, { 0.629638238914927025372981341},
+	{ 0.902673318237258806751502391}, {-0.430326481340082633908199031},
+	{ 0.333999651442009404650865481}, {-0.942573197601446879280758735},
+	{ 0.430326481340082633908199031}, { 0.902673318237258806751502391},
+	{ 0.942573197601446879280758735}, { 0.333999651442009404650865481},
+	{ 0.879012226428633477831323711}, { 0.879012226428633477831323711},
+	{-0.476799230063322133342158117}, {-0.476799230063322133342158117},
+	{ 0.476799230063322133342158117}, { 0.476799230063322133342158117},
+	{ 0.879012226428633477831323711}, { 0.879012226428633477831323711},
+	{ 0.969281235356548486048290738}, {-0.245955050335794611599924709},
+	{ 0.511468850437970399504391001}, {-0.859301818357008404783582139},
+	{ 0.245955050335794611599924709}, { 0.969281235356548486048290738},
+	{ 0.859301818357008404783582139}, { 0.511468850437970399504391001},
+	{ 0.284407537211271843618310615}, { 0.284407537211271843618310615},
+	{-0.958703474895871555374645792}, {-0.958703474895871555374645792},
+	{ 0.958703474895871555374645792}, { 0.958703474895871555374645792},
+	{ 0.284407537211271843618310615}, { 0.284407537211271843618310615},
+	{ 0.801376171723140219430247777}, {-0.598160706996342311724958652},
+	{ 0.143695033150294454819773349}, {-0.989622017463200834623694454},
+	{ 0.598160706996342311724958652}, { 0.801376171723140219430247777},
+	{ 0.989622017463200834623694454}, { 0.143695033150294454819773349},
+	{ 0.955141168305770721498157712}, { 0.955141168305770721498157712},
+	{-0.296150888243623824121786128}, {-0.296150888243623824121786128},
+	{ 0.296150888243623824121786128}, { 0.296150888243623824121786128},
+	{ 0.955141168305770721498157712}, { 0.955141168305770721498157712},
+	{ 0.988721691960323767604516485}, {-0.149764534677321517229695737},
+	{ 0.593232295039799808047809426}, {-0.805031331142963597922659282},
+	{ 0.149764534677321517229695737}, { 0.988721691960323767604516485},
+	{ 0.805031331142963597922659282}, { 0.593232295039799808047809426},
+	{ 0.465976495767966177902756065}, { 0.465976495767966177902756065},
+	{-0.884797098430937780104007041}, {-0.884797098430937780104007041},
+	{ 0.884797098430937780104007041}, { 0.884797098430937780104007041},
+	{ 0.465976495767966177902756065}, { 0.465976495767966177902756065},
+	{ 0.856147328375194481019630732}, {-0.516731799017649881508753876},
+	{ 0.240003022448741486568922365}, {-0.970772140728950302138169611},
+	{ 0.516731799017649881508753876}, { 0.856147328375194481019630732},
+	{ 0.970772140728950302138169611}, { 0.240003022448741486568922365},
+	{ 0.769103337645579639346626069}, { 0.769103337645579639346626069},
+	{-0.639124444863775743801488193}, {-0.639124444863775743801488193},
+	{ 0.639124444863775743801488193}, { 0.639124444863775743801488193},
+	{ 0.769103337645579639346626069}, { 0.769103337645579639346626069},
+	{ 0.940506070593268323787291309}, {-0.339776884406826857828825803},
+	{ 0.424779681209108833357226189}, {-0.905296759318118774354048329},
+	{ 0.339776884406826857828825803}, { 0.940506070593268323787291309},
+	{ 0.905296759318118774354048329}, { 0.424779681209108833357226189},
+	{ 0.091908956497132728624990979}, { 0.091908956497132728624990979},
+	{-0.995767414467659793982495643}, {-0.995767414467659793982495643},
+	{ 0.995767414467659793982495643}, { 0.995767414467659793982495643},
+	{ 0.091908956497132728624990979}, { 0.091908956497132728624990979},
+	{ 0.738887324460615147933116508}, {-0.673829000378756060917568372},
+	{ 0.046003182130914628814301788}, {-0.998941293186856850633930266},
+	{ 0.673829000378756060917568372}, { 0.738887324460615147933116508},
+	{ 0.998941293186856850633930266}, { 0.046003182130914628814301788},
+	{ 0.998475580573294752208559038}, { 0.998475580573294752208559038},
+	{-0.055195244349689939809447526}, {-0.055195244349689939809447526},
+	{ 0.055195244349689939809447526}, { 0.055195244349689939809447526},
+	{ 0.998475580573294752208559038}, { 0.998475580573294752208559038},
+	{ 0.999618822495178597116830637}, {-0.027608145778965741612354872},
+	{ 0.687315340891759108199186948}, {-0.726359155084345976817494315},
+	{ 0.027608145778965741612354872}, { 0.999618822495178597116830637},
+	{ 0.726359155084345976817494315}, { 0.687315340891759108199186948},
+	{ 0.666999922303637506650154222}, { 0.666999922303637506650154222},
+	{-0.745057785441465962407907310}, {-0.745057785441465962407907310},
+	{ 0.745057785441465962407907310}, { 0.745057785441465962407907310},
+	{ 0.666999922303637506650154222}, { 0.666999922303637506650154222},
+	{ 0.912962190428398164628018233}, {-0.408044162864978680820747499},
+	{ 0.357030961233430032614954036}, {-0.934092550404258914729877883},
+	{ 0.408044162864978680820747499}, { 0.912962190428398164628018233},
+	{ 0.934092550404258914729877883}, { 0.357030961233430032614954036},
+	{ 0.901348847046022014570746093}, { 0.901348847046022014570746093},
+	{-0.433093818853151968484222638}, {-0.433093818853151968484222638},
+	{ 0.433093818853151968484222638}, { 0.433093818853151968484222638},
+	{ 0.901348847046022014570746093}, { 0.901348847046022014570746093},
+	{ 0.975025345066994146844913468}, {-0.222093620973203534094094721},
+	{ 0.532403127877197971442805218}, {-0.846490938774052078300544488},
+	{ 0.222093620973203534094094721}, { 0.975025345066994146844913468},
+	{ 0.846490938774052078300544488}, { 0.532403127877197971442805218},
+	{ 0.331106305759876401737190737}, { 0.331106305759876401737190737},
+	{-0.943593458161960361495301445}, {-0.943593458161960361495301445},
+	{ 0.943593458161960361495301445}, { 0.943593458161960361495301445},
+	{ 0.331106305759876401737190737}, { 0.331106305759876401737190737},
+	{ 0.815814410806733789010772660}, {-0.578313796411655563342245019},
+	{ 0.167938294974731178054745536}, {-0.985797509167567424700995000},
+	{ 0.578313796411655563342245019}, { 0.815814410806733789010772660},
+	{ 0.985797509167567424700995000}, { 0.167938294974731178054745536},
+	{ 0.968522094274417316221088329}, { 0.968522094274417316221088329},
+	{-0.248927605745720168110682816}, {-0.248927605745720168110682816},
+	{ 0.248927605745720168110682816}, { 0.248927605745720168110682816},
+	{ 0.968522094274417316221088329}, { 0.968522094274417316221088329},
+	{ 0.992099313142191757112085445}, {-0.125454983411546238542336453},
+	{ 0.612810082429409703935211936}, {-0.790230221437310055030217152},
+	{ 0.125454983411546238542336453}, { 0.992099313142191757112085445},
+	{ 0.790230221437310055030217152}, { 0.612810082429409703935211936},
+	{ 0.508830142543107036931749324}, { 0.508830142543107036931749324},
+	{-0.860866938637767279344583877}, {-0.860866938637767279344583877},
+	{ 0.860866938637767279344583877}, { 0.860866938637767279344583877},
+	{ 0.508830142543107036931749324}, { 0.508830142543107036931749324},
+	{ 0.868570705971340895340449876}, {-0.495565261825772531150266670},
+	{ 0.263754678974831383611349322}, {-0.964589793289812723836432159},
+	{ 0.495565261825772531150266670}, { 0.868570705971340895340449876},
+	{ 0.964589793289812723836432159}, { 0.263754678974831383611349322},
+	{ 0.799537269107905033500246232}, { 0.799537269107905033500246232},
+	{-0.600616479383868926653875896}, {-0.600616479383868926653875896},
+	{ 0.600616479383868926653875896}, { 0.600616479383868926653875896},
+	{ 0.799537269107905033500246232}, { 0.799537269107905033500246232},
+	{ 0.948561349915730288158494826}, {-0.316593375556165867243047035},
+	{ 0.446868840162374195353044389}, {-0.894599485631382678433072126},
+	{ 0.316593375556165867243047035}, { 0.948561349915730288158494826},
+	{ 0.894599485631382678433072126}, { 0.446868840162374195353044389},
+	{ 0.140658239332849230714788846}, { 0.140658239332849230714788846},
+	{-0.990058210262297105505906464}, {-0.990058210262297105505906464},
+	{ 0.990058210262297105505906464}, { 0.990058210262297105505906464},
+	{ 0.140658239332849230714788846}, { 0.140658239332849230714788846},
+	{ 0.755201376896536527598710756}, {-0.655492852999615385312679701},
+	{ 0.070504573389613863027351471}, {-0.997511456140303459699448390},
+	{ 0.655492852999615385312679701}, { 0.755201376896536527598710756},
+	{ 0.997511456140303459699448390}, { 0.070504573389613863027351471},
+	{ 0.988257567730749491404792538}, { 0.988257567730749491404792538},
+	{-0.152797185258443427720336613}, {-0.152797185258443427720336613},
+	{ 0.152797185258443427720336613}, { 0.152797185258443427720336613},
+	{ 0.988257567730749491404792538}, { 0.988257567730749491404792538},
+	{ 0.997060070339482978987989949}, {-0.076623861392031492278332463},
+	{ 0.650846684996380915068975573}, {-0.759209188978388033485525443},
+	{ 0.076623861392031492278332463}, { 0.997060070339482978987989949},
+	{ 0.759209188978388033485525443}, { 0.650846684996380915068975573},
+	{ 0.590759701858874228423887908}, { 0.590759701858874228423887908},
+	{-0.806847553543799272206514313}, {-0.806847553543799272206514313},
+	{ 0.806847553543799272206514313}, { 0.806847553543799272206514313},
+	{ 0.590759701858874228423887908}, { 0.590759701858874228423887908},
+	{ 0.891840709392342727796478697}, {-0.452349587233770874133026703},
+	{ 0.310767152749611495835997250}, {-0.950486073949481721759926101},
+	{ 0.452349587233770874133026703}, { 0.891840709392342727796478697},
+	{ 0.950486073949481721759926101}, { 0.310767152749611495835997250},
+	{ 0.854557988365400520767862276}, { 0.854557988365400520767862276},
+	{-0.519355990165589587361829932}, {-0.519355990165589587361829932},
+	{ 0.519355990165589587361829932}, { 0.519355990165589587361829932},
+	{ 0.854557988365400520767862276}, { 0.854557988365400520767862276},
+	{ 0.962953266873683886347921481}, {-0.269668325572915106525464462},
+	{ 0.490226483288291154229598449}, {-0.871595086655951034842481435},
+	{ 0.269668325572915106525464462}, { 0.962953266873683886347921481},
+	{ 0.871595086655951034842481435}, { 0.490226483288291154229598449},
+	{ 0.237023605994367206867735915}, { 0.237023605994367206867735915},
+	{-0.971503890986251775537099622}, {-0.971503890986251775537099622},
+	{ 0.971503890986251775537099622}, { 0.971503890986251775537099622},
+	{ 0.237023605994367206867735915}, { 0.237023605994367206867735915},
+	{ 0.786455213599085757522319464}, {-0.617647307937803932403979402},
+	{ 0.119365214810991364593637790}, {-0.992850414459865090793563344},
+	{ 0.617647307937803932403979402}, { 0.786455213599085757522319464},
+	{ 0.992850414459865090793563344}, { 0.119365214810991364593637790},
+	{ 0.939459223602189911962669246}, { 0.939459223602189911962669246},
+	{-0.342660717311994397592781983}, {-0.342660717311994397592781983},
+	{ 0.342660717311994397592781983}, { 0.342660717311994397592781983},
+	{ 0.939459223602189911962669246}, { 0.939459223602189911962669246},
+	{ 0.984748501801904218556553176}, {-0.173983873387463827950700807},
+	{ 0.573297166698042212820171239}, {-0.819347520076796960824689637},
+	{ 0.173983873387463827950700807}, { 0.984748501801904218556553176},
+	{ 0.819347520076796960824689637}, { 0.573297166698042212820171239},
+	{ 0.422000270799799685941287941}, { 0.422000270799799685941287941},
+	{-0.906595704514915365332960588}, {-0.906595704514915365332960588},
+	{ 0.906595704514915365332960588}, { 0.906595704514915365332960588},
+	{ 0.422000270799799685941287941}, { 0.422000270799799685941287941},
+	{ 0.843208239641845437161743865}, {-0.537587076295645482502214932},
+	{ 0.216106797076219509948385131}, {-0.976369731330021149312732194},
+	{ 0.537587076295645482502214932}, { 0.843208239641845437161743865},
+	{ 0.976369731330021149312732194}, { 0.216106797076219509948385131},
+	{ 0.736816568877369875090132520}, { 0.736816568877369875090132520},
+	{-0.676092703575315960360419228}, {-0.676092703575315960360419228},
+	{ 0.676092703575315960360419228}, { 0.676092703575315960360419228},
+	{ 0.736816568877369875090132520}, { 0.736816568877369875090132520},
+	{ 0.931884265581668106718557199}, {-0.362755724367397216204854462},
+	{ 0.402434650859418441082533934}, {-0.915448716088267819566431292},
+	{ 0.362755724367397216204854462}, { 0.931884265581668106718557199},
+	{ 0.915448716088267819566431292}, { 0.402434650859418441082533934},
+	{ 0.042938256934940823077124540}, { 0.042938256934940823077124540},
+	{-0.999077727752645382888781997}, {-0.999077727752645382888781997},
+	{ 0.999077727752645382888781997}, { 0.999077727752645382888781997},
+	{ 0.042938256934940823077124540}, { 0.042938256934940823077124540},
+	{ 0.722128193929215321243607198}, {-0.691759258364157774906734132},
+	{ 0.021474080275469507418374898}, {-0.999769405351215321657617036},
+	{ 0.691759258364157774906734132}, { 0.722128193929215321243607198},
+	{ 0.999769405351215321657617036}, { 0.021474080275469507418374898},
+	{ 0.999529417501093163079703322}, { 0.999529417501093163079703322},
+	{-0.030674803176636625934021028}, {-0.030674803176636625934021028},
+	{ 0.030674803176636625934021028}, { 0.030674803176636625934021028},
+	{ 0.999529417501093163079703322}, { 0.999529417501093163079703322},
+	{ 0.999882347454212525633049627}, {-0.015339206284988101044151868},
+	{ 0.696177131491462944788582591}, {-0.717870045055731736211325329},
+	{ 0.015339206284988101044151868}, { 0.999882347454212525633049627},
+	{ 0.717870045055731736211325329}, { 0.696177131491462944788582591},
+	{ 0.685083667772700381362052545}, { 0.685083667772700381362052545},
+	{-0.728464390448225196492035438}, {-0.728464390448225196492035438},
+	{ 0.728464390448225196492035438}, { 0.728464390448225196492035438},
+	{ 0.685083667772700381362052545}, { 0.685083667772700381362052545},
+	{ 0.917900775621390457642276297}, {-0.396809987416710328595290911},
+	{ 0.368466829953372331712746222}, {-0.929640895843181265457918066},
+	{ 0.396809987416710328595290911}, { 0.917900775621390457642276297},
+	{ 0.929640895843181265457918066}, { 0.368466829953372331712746222},
+	{ 0.911706032005429851404397325}, { 0.911706032005429851404397325},
+	{-0.410843171057903942183466675}, {-0.410843171057903942183466675},
+	{ 0.410843171057903942183466675}, { 0.410843171057903942183466675},
+	{ 0.911706032005429851404397325}, { 0.911706032005429851404397325},
+	{ 0.977677357824509979943404762}, {-0.210111836880469621717489972},
+	{ 0.542750784864515906586768661}, {-0.839893794195999504583383987},
+	{ 0.210111836880469621717489972}, { 0.977677357824509979943404762},
+	{ 0.839893794195999504583383987}, { 0.542750784864515906586768661},
+	{ 0.354163525420490382357395796}, { 0.354163525420490382357395796},
+	{-0.935183509938947577642207480}, {-0.935183509938947577642207480},
+	{ 0.935183509938947577642207480}, { 0.935183509938947577642207480},
+	{ 0.354163525420490382357395796}, { 0.354163525420490382357395796},
+	{ 0.822849781375826332046780034}, {-0.568258952670131549790548489},
+	{ 0.180022901405699522679906590}, {-0.983662419211730274396237776},
+	{ 0.568258952670131549790548489}, { 0.822849781375826332046780034},
+	{ 0.983662419211730274396237776}, { 0.180022901405699522679906590},
+	{ 0.974339382785575860518721668}, { 0.974339382785575860518721668},
+	{-0.225083911359792835991642120}, {-0.225083911359792835991642120},
+	{ 0.225083911359792835991642120}, { 0.225083911359792835991642120},
+	{ 0.974339382785575860518721668}, { 0.974339382785575860518721668},
+	{ 0.993564135520595333782021697}, {-0.113270952177564349018228733},
+	{ 0.622461279374149972519166721}, {-0.782650596166575738458949301},
+	{ 0.113270952177564349018228733}, { 0.993564135520595333782021697},
+	{ 0.782650596166575738458949301}, { 0.622461279374149972519166721},
+	{ 0.529803624686294668216054671}, { 0.529803624686294668216054671},
+	{-0.848120344803297251279133563}, {-0.848120344803297251279133563},
+	{ 0.848120344803297251279133563}, { 0.848120344803297251279133563},
+	{ 0.529803624686294668216054671}, { 0.529803624686294668216054671},
+	{ 0.874586652278176112634431897}, {-0.484869248000791101822951699},
+	{ 0.275571819310958163076425168}, {-0.961280485811320641748659653},
+	{ 0.484869248000791101822951699}, { 0.874586652278176112634431897},
+	{ 0.961280485811320641748659653}, { 0.275571819310958163076425168},
+	{ 0.814036329705948361654516690}, { 0.814036329705948361654516690},
+	{-0.580813958095764545075595272}, {-0.580813958095764545075595272},
+	{ 0.580813958095764545075595272}, { 0.580813958095764545075595272},
+	{ 0.814036329705948361654516690}, { 0.814036329705948361654516690},
+	{ 0.952375012719765858529893608}, {-0.304929229735402406490728633},
+	{ 0.457813303598877221904961155}, {-0.889048355854664562540777729},
+	{ 0.304929229735402406490728633}, { 0.952375012719765858529893608},
+	{ 0.889048355854664562540777729}, { 0.457813303598877221904961155},
+	{ 0.164913120489969921418189113}, { 0.164913120489969921418189113},
+	{-0.986308097244598647863297524}, {-0.986308097244598647863297524},
+	{ 0.986308097244598647863297524}, { 0.986308097244598647863297524},
+	{ 0.164913120489969921418189113}, { 0.164913120489969921418189113},
+	{ 0.763188417263381271704838297}, {-0.646176012983316364832802220},
+	{ 0.082740264549375693111987083}, {-0.996571145790554847093566910},
+	{ 0.646176012983316364832802220}, { 0.763188417263381271704838297},
+	{ 0.996571145790554847093566910}, { 0.082740264549375693111987083},
+	{ 0.991709753669099522860049931}, { 0.991709753669099522860049931},
+	{-0.128498110793793172624415589}, {-0.128498110793793172624415589},
+	{ 0.128498110793793172624415589}, { 0.128498110793793172624415589},
+	{ 0.991709753669099522860049931}, { 0.991709753669099522860049931},
+	{ 0.997925286198596012623025462}, {-0.064382630929857460819324537},
+	{ 0.660114342067420478559490747}, {-0.751165131909686411205819422},
+	{ 0.064382630929857460819324537}, { 0.997925286198596012623025462},
+	{ 0.751165131909686411205819422}, { 0.660114342067420478559490747},
+	{ 0.610382806276309452716352152}, { 0.610382806276309452716352152},
+	{-0.792106577300212351782342879}, {-0.792106577300212351782342879},
+	{ 0.792106577300212351782342879}, { 0.792106577300212351782342879},
+	{ 0.610382806276309452716352152}, { 0.610382806276309452716352152},
+	{ 0.897324580705418281231391836}, {-0.441371268731716692879988968},
+	{ 0.322407678801069848384807478}, {-0.946600913083283570044599823},
+	{ 0.441371268731716692879988968}, { 0.897324580705418281231391836},
+	{ 0.946600913083283570044599823}, { 0.322407678801069848384807478},
+	{ 0.867046245515692651480195629}, { 0.867046245515692651480195629},
+	{-0.498227666972781852410983869}, {-0.498227666972781852410983869},
+	{ 0.498227666972781852410983869}, { 0.498227666972781852410983869},
+	{ 0.867046245515692651480195629}, { 0.867046245515692651480195629},
+	{ 0.966190003445412555433832961}, {-0.257831102162159005614471295},
+	{ 0.500885382611240786241285004}, {-0.865513624090569082825488358},
+	{ 0.257831102162159005614471295}, { 0.966190003445412555433832961},
+	{ 0.865513624090569082825488358}, { 0.500885382611240786241285004},
+	{ 0.260794117915275518280186509}, { 0.260794117915275518280186509},
+	{-0.965394441697689374550843858}, {-0.965394441697689374550843858},
+	{ 0.965394441697689374550843858}, { 0.965394441697689374550843858},
+	{ 0.260794117915275518280186509}, { 0.260794117915275518280186509},
+	{ 0.793975477554337164895083757}, {-0.607949784967773667243642671},
+	{ 0.131540028702883111103387493}, {-0.991310859846115418957349799},
+	{ 0.607949784967773667243642671}, { 0.793975477554337164895083757},
+	{ 0.991310859846115418957349799}, { 0.131540028702883111103387493},
+	{ 0.947585591017741134653387321}, { 0.947585591017741134653387321},
+	{-0.319502030816015677901518272}, {-0.319502030816015677901518272},
+	{ 0.319502030816015677901518272}, { 0.319502030816015677901518272},
+	{ 0.947585591017741134653387321}, { 0.947585591017741134653387321},
+	{ 0.986809401814185476970235952}, {-0.161886393780111837641387995},
+	{ 0.583308652937698294392830961}, {-0.812250586585203913049744181},
+	{ 0.161886393780111837641387995}, { 0.986809401814185476970235952},
+	{ 0.812250586585203913049744181}, { 0.583308652937698294392830961},
+	{ 0.444122144570429231642069418}, { 0.444122144570429231642069418},
+	{-0.895966249756185155914560282}, {-0.895966249756185155914560282},
+	{ 0.895966249756185155914560282}, { 0.895966249756185155914560282},
+	{ 0.444122144570429231642069418}, { 0.444122144570429231642069418},
+	{ 0.849741768000852489471268395}, {-0.527199134781901348464274575},
+	{ 0.228072083170885739254457379}, {-0.973644249650811925318383912},
+	{ 0.527199134781901348464274575}, { 0.849741768000852489471268395},
+	{ 0.973644249650811925318383912}, { 0.228072083170885739254457379},
+	{ 0.753186799043612482483430486}, { 0.753186799043612482483430486},
+	{-0.657806693297078656931182264}, {-0.657806693297078656931182264},
+	{ 0.657806693297078656931182264}, { 0.657806693297078656931182264},
+	{ 0.753186799043612482483430486}, { 0.753186799043612482483430486},
+	{ 0.936265667170278246576310996}, {-0.351292756085567125601307623},
+	{ 0.413638312238434547471944324}, {-0.910441292258067196934095369},
+	{ 0.351292756085567125601307623}, { 0.936265667170278246576310996},
+	{ 0.910441292258067196934095369}, { 0.413638312238434547471944324},
+	{ 0.067443919563664057897972422}, { 0.067443919563664057897972422},
+	{-0.997723066644191609848546728}, {-0.997723066644191609848546728},
+	{ 0.997723066644191609848546728}, { 0.997723066644191609848546728},
+	{ 0.067443919563664057897972422}, { 0.067443919563664057897972422},
+	{ 0.730562769227827561177758850}, {-0.682845546385248068164596123},
+	{ 0.033741171851377584833716112}, {-0.999430604555461772019008327},
+	{ 0.682845546385248068164596123}, { 0.730562769227827561177758850},
+	{ 0.999430604555461772019008327}, { 0.033741171851377584833716112},
+	{ 0.996820299291165714972629398}, { 0.996820299291165714972629398},
+	{-0.079682437971430121147120656}, {-0.079682437971430121147120656},
+	{ 0.079682437971430121147120656}, { 0.079682437971430121147120656},
+	{ 0.996820299291165714972629398}, { 0.996820299291165714972629398},
+	{ 0.999204758618363895492950001}, {-0.039872927587739811128578738},
+	{ 0.678350043129861486873655042}, {-0.734738878095963464563223604},
+	{ 0.039872927587739811128578738}, { 0.999204758618363895492950001},
+	{ 0.734738878095963464563223604}, { 0.678350043129861486873655042},
+	{ 0.648514401022112445084560551}, { 0.648514401022112445084560551},
+	{-0.761202385484261814029709836}, {-0.761202385484261814029709836},
+	{ 0.761202385484261814029709836}, { 0.761202385484261814029709836},
+	{ 0.648514401022112445084560551}, { 0.648514401022112445084560551},
+	{ 0.907886116487666212038681480}, {-0.419216888363223956433010020},
+	{ 0.345541324963989065539191723}, {-0.938403534063108112192420774},
+	{ 0.419216888363223956433010020}, { 0.907886116487666212038681480},
+	{ 0.938403534063108112192420774}, { 0.345541324963989065539191723},
+	{ 0.890448723244757889952150560}, { 0.890448723244757889952150560},
+	{-0.455083587126343823535869268}, {-0.455083587126343823535869268},
+	{ 0.455083587126343823535869268}, { 0.455083587126343823535869268},
+	{ 0.890448723244757889952150560}, { 0.890448723244757889952150560},
+	{ 0.972226497078936305708321144}, {-0.234041958583543423191242045},
+	{ 0.521975292937154342694258318}, {-0.852960604930363657746588082},
+	{ 0.234041958583543423191242045}, { 0.972226497078936305708321144},
+	{ 0.852960604930363657746588082}, { 0.521975292937154342694258318},
+	{ 0.307849640041534893682063646}, { 0.307849640041534893682063646},
+	{-0.951435020969008369549175569}, {-0.951435020969008369549175569},
+	{ 0.951435020969008369549175569}, { 0.951435020969008369549175569},
+	{ 0.307849640041534893682063646}, { 0.307849640041534893682063646},
+	{ 0.808656181588174991946968128}, {-0.588281548222645304786439813},
+	{ 0.155828397654265235743101486}, {-0.987784141644572154230969032},
+	{ 0.588281548222645304786439813}, { 0.808656181588174991946968128},
+	{ 0.987784141644572154230969032}, { 0.155828397654265235743101486},
+	{ 0.962121404269041595429604316}, { 0.962121404269041595429604316},
+	{-0.272621355449948984493347477}, {-0.272621355449948984493347477},
+	{ 0.272621355449948984493347477}, { 0.272621355449948984493347477},
+	{ 0.962121404269041595429604316}, { 0.962121404269041595429604316},
+	{ 0.990485084256457037998682243}, {-0.137620121586486044948441663},
+	{ 0.603066598540348201693430617}, {-0.797690840943391108362662755},
+	{ 0.137620121586486044948441663}, { 0.990485084256457037998682243},
+	{ 0.797690840943391108362662755}, { 0.603066598540348201693430617},
+	{ 0.487550160148435954641485027}, { 0.487550160148435954641485027},
+	{-0.873094978418290098636085973}, {-0.873094978418290098636085973},
+	{ 0.873094978418290098636085973}, { 0.873094978418290098636085973},
+	{ 0.487550160148435954641485027}, { 0.487550160148435954641485027},
+	{ 0.862423956111040538690933878}, {-0.506186645345155291048942344},
+	{ 0.251897818154216950498106628}, {-0.967753837093475465243391912},
+	{ 0.506186645345155291048942344}, { 0.862423956111040538690933878},
+	{ 0.967753837093475465243391912}, { 0.251897818154216950498106628},
+	{ 0.784556597155575233023892575}, { 0.784556597155575233023892575},
+	{-0.620057211763289178646268191}, {-0.620057211763289178646268191},
+	{ 0.620057211763289178646268191}, { 0.620057211763289178646268191},
+	{ 0.784556597155575233023892575}, { 0.784556597155575233023892575},
+	{ 0.944604837261480265659265493}, {-0.328209843579092526107916817},
+	{ 0.435857079922255491032544080}, {-0.900015892016160228714535267},
+	{ 0.328209843579092526107916817}, { 0.944604837261480265659265493},
+	{ 0.900015892016160228714535267}, { 0.435857079922255491032544080},
+	{ 0.116318630911904767252544319}, { 0.116318630911904767252544319},
+	{-0.993211949234794533104601012}, {-0.993211949234794533104601012},
+	{ 0.993211949234794533104601012}, { 0.993211949234794533104601012},
+	{ 0.116318630911904767252544319}, { 0.116318630911904767252544319},
+	{ 0.747100605980180144323078847}, {-0.664710978203344868130324985},
+	{ 0.058258264500435759613979782}, {-0.998301544933892840738782163},
+	{ 0.664710978203344868130324985}, { 0.747100605980180144323078847},
+	{ 0.998301544933892840738782163}, { 0.058258264500435759613979782},
+	{ 0.984210092386929073193874387}, { 0.984210092386929073193874387},
+	{-0.177004220412148756196839844}, {-0.177004220412148756196839844},
+	{ 0.177004220412148756196839844}, { 0.177004220412148756196839844},
+	{ 0.984210092386929073193874387}, { 0.984210092386929073193874387},
+	{ 0.996044700901251989887944810}, {-0.088853552582524596561586535},
+	{ 0.641481012808583151988739898}, {-0.767138911935820381181694573},
+	{ 0.088853552582524596561586535}, { 0.996044700901251989887944810},
+	{ 0.767138911935820381181694573}, { 0.641481012808583151988739898},
+	{ 0.570780745886967280232652864}, { 0.570780745886967280232652864},
+	{-0.821102514991104679060430820}, {-0.821102514991104679060430820},
+	{ 0.821102514991104679060430820}, { 0.821102514991104679060430820},
+	{ 0.570780745886967280232652864}, { 0.570780745886967280232652864},
+	{ 0.886222530148880631647990821}, {-0.463259783551860197390719637},
+	{ 0.299079826308040476750336973}, {-0.954228095109105629780430732},
+	{ 0.463259783551860197390719637}, { 0.886222530148880631647990821},
+	{ 0.954228095109105629780430732}, { 0.299079826308040476750336973},
+	{ 0.841554977436898409603499520}, { 0.841554977436898409603499520},
+	{-0.540171472729892881297845480}, {-0.540171472729892881297845480},
+	{ 0.540171472729892881297845480}, { 0.540171472729892881297845480},
+	{ 0.841554977436898409603499520}, { 0.841554977436898409603499520},
+	{ 0.959571513081984528335528181}, {-0.281464937925757984095231007},
+	{ 0.479493757660153026679839798}, {-0.877545290207261291668470750},
+	{ 0.281464937925757984095231007}, { 0.959571513081984528335528181},
+	{ 0.877545290207261291668470750}, { 0.479493757660153026679839798},
+	{ 0.213110319916091373967757518}, { 0.213110319916091373967757518},
+	{-0.977028142657754351485866211}, {-0.977028142657754351485866211},
+	{ 0.977028142657754351485866211}, { 0.977028142657754351485866211},
+	{ 0.213110319916091373967757518}, { 0.213110319916091373967757518},
+	{ 0.778816512381475953374724325}, {-0.627251815495144113509622565},
+	{ 0.107172424956808849175529148}, {-0.994240449453187946358413442},
+	{ 0.627251815495144113509622565}, { 0.778816512381475953374724325},
+	{ 0.994240449453187946358413442}, { 0.107172424956808849175529148},
+	{ 0.930766961078983731944872340}, { 0.930766961078983731944872340},
+	{-0.365612997804773870011745909}, {-0.365612997804773870011745909},
+	{ 0.365612997804773870011745909}, { 0.365612997804773870011745909},
+	{ 0.930766961078983731944872340}, { 0.930766961078983731944872340},
+	{ 0.982539302287441255907040396}, {-0.186055151663446648105438304},
+	{ 0.563199344013834115007363772}, {-0.826321062845663480311195452},
+	{ 0.186055151663446648105438304}, { 0.982539302287441255907040396},
+	{ 0.826321062845663480311195452}, { 0.563199344013834115007363772},
+	{ 0.399624199845646828544117031}, { 0.399624199845646828544117031},
+	{-0.916679059921042663116457013}, {-0.916679059921042663116457013},
+	{ 0.916679059921042663116457013}, { 0.916679059921042663116457013},
+	{ 0.399624199845646828544117031}, { 0.399624199845646828544117031},
+	{ 0.836547727223511984524285790}, {-0.547894059173100165608820571},
+	{ 0.204108966092816874181696950}, {-0.978948175319062194715480124},
+	{ 0.547894059173100165608820571}, { 0.836547727223511984524285790},
+	{ 0.978948175319062194715480124}, { 0.204108966092816874181696950},
+	{ 0.720002507961381629076682999}, { 0.720002507961381629076682999},
+	{-0.693971460889654009003734389}, {-0.693971460889654009003734389},
+	{ 0.693971460889654009003734389}, { 0.693971460889654009003734389},
+	{ 0.720002507961381629076682999}, { 0.720002507961381629076682999},
+	{ 0.927362525650401087274536959}, {-0.374164062971457997104393020},
+	{ 0.391170384302253888687512949}, {-0.920318276709110566440076541},
+	{ 0.374164062971457997104393020}, { 0.927362525650401087274536959},
+	{ 0.920318276709110566440076541}, { 0.391170384302253888687512949},
+	{ 0.018406729905804820927366313}, { 0.018406729905804820927366313},
+	{-0.999830581795823422015722275}, {-0.999830581795823422015722275},
+	{ 0.999830581795823422015722275}, { 0.999830581795823422015722275},
+	{ 0.018406729905804820927366313}, { 0.018406729905804820927366313},
+	{ 0.713584868780793592903125099}, {-0.700568793943248366792866380},
+	{ 0.009203754782059819315102378}, {-0.999957644551963866333120920},
+	{ 0.700568793943248366792866380}, { 0.713584868780793592903125099},
+	{ 0.999957644551963866333120920}, { 0.009203754782059819315102378}
+};
+
+/*
+ * Single-precision twiddle factors for the last three FFT layers (and
+ * the first three iFFT layers) of Zf(FFT32)() and Zf(iFFT32)() for
+ * logn = 9 and 10, in the order in which the AVX2 code reads them: for
+ * each block of 16 coefficients, 8 real parts and 8 imaginary parts
+ * for each of the layers with 4, 2 and 1 elements per half-group. The
+ * values are those of fpr_gm_tab[], rounded to float.
+ */
+const float fpr_gm32_tail9[] = {
+	 0.999698818f,  0.999698818f,  0.999698818f,  0.999698818f,
+	-0.024541229f, -0.024541229f, -0.024541229f, -0.024541229f,
+	 0.024541229f,  0.024541229f,  0.024541229f,  0.024541229f,
+	 0.999698818f,  0.999698818f,  0.999698818f,  0.999698818f,
+	 0.999924719f,  0.999924719f, -0.0122715384f, -0.0122715384f,
+	 0.698376238f,  0.698376238f, -0.715730846f, -0.715730846f,
+	 0.0122715384f,  0.0122715384f,  0.999924719f,  0.999924719f,
+	 0.715730846f,  0.715730846f,  0.698376238f,  0.698376238f,
+	 0.999981165f,  0.702754736f, -0.00613588467f, -0.711432219f,
+	 0.921514034f,  0.377007425f, -0.388345033f, -0.926210225f,
+	 0.00613588467f,  0.711432219f,  0.999981165f,  0.702754736f,
+	 0.388345033f,  0.926210225f,  0.921514034f,  0.377007425f,
+	 0.689540565f,  0.689540565f,  0.689540565f,  0.689540565f,
+	-0.724247098f, -0.724247098f, -0.724247098f, -0.724247098f,
+	 0.724247098f,  0.724247098f,  0.724247098f,  0.724247098f,
+	 0.689540565f,  0.689540565f,  0.689540565f,  0.689540565f,
+	 0.919113874f,  0.919113874f, -0.393992037f, -0.393992037f,
+	 0.371317208f,  0.371317208f, -0.928506076f, -0.928506076f,
+	 0.393992037f,  0.393992037f,  0.919113874f,  0.919113874f,
+	 0.928506076f,  0.928506076f,  0.371317208f,  0.371317208f,
+	 0.979569793f,  0.550457954f, -0.201104641f, -0.834862888f,
+	 0.82804507f,  0.18906866f, -0.560661554f, -0.981963873f,
+	 0.201104641f,  0.834862888f,  0.979569793f,  0.550457954f,
+	 0.560661554f,  0.981963873f,  0.82804507f,  0.18906866f,
+	 0.914209783f,  0.914209783f,  0.914209783f,  0.914209783f,
+	-0.405241311f, -0.405241311f, -0.405241311f, -0.405241311f,
+	 0.405241311f,  0.405241311f,  0.405241311f,  0.405241311f,
+	 0.914209783f,  0.914209783f,  0.914209783f,  0.914209783f,
+	 0.97831738f,  0.97831738f, -0.207111374f, -0.207111374f,
+	 0.545324981f,  0.545324981f, -0.838224709f, -0.838224709f,
+	 0.207111374f,  0.207111374f,  0.97831738f,  0.97831738f,
+	 0.838224709f,  0.838224709f,  0.545324981f,  0.545324981f,
+	 0.994564593f,  0.629638255f, -0.104121633f, -0.77688849f,
+	 0.879012227f,  0.284407526f, -0.47679922f, -0.958703458f,
+	 0.104121633f,  0.77688849f,  0.994564593f,  0.629638255f,
+	 0.47679922f,  0.958703458f,  0.879012227f,  0.284407526f,
+	 0.359895051f,  0.359895051f,  0.359895051f,  0.359895051f,
+	-0.932992816f, -0.932992816f, -0.932992816f, -0.932992816f,
+	 0.932992816f,  0.932992816f,  0.932992816f,  0.932992816f,
+	 0.359895051f,  0.359895051f,  0.359895051f,  0.359895051f,
+	 0.824589312f,  0.824589312f, -0.565731823f, -0.565731823f,
+	 0.183039889f,  0.183039889f, -0.983105481f, -0.983105481f,
+	 0.565731823f,  0.565731823f,  0.824589312f,  0.824589312f,
+	 0.983105481f,  0.983105481f,  0.183039889f,  0.183039889f,
+	 0.955141187f,  0.465976506f, -0.296150893f, -0.884797096f,
+	 0.769103348f,  0.0919089541f, -0.639124453f, -0.995767415f,
+	 0.296150893f,  0.884797096f,  0.955141187f,  0.465976506f,
+	 0.639124453f,  0.995767415f,  0.769103348f,  0.0919089541f,
+	 0.975702107f,  0.975702107f,  0.975702107f,  0.975702107f,
+	-0.219101235f, -0.219101235f, -0.219101235f, -0.219101235f,
+	 0.219101235f,  0.219101235f,  0.219101235f,  0.219101235f,
+	 0.975702107f,  0.975702107f,  0.975702107f,  0.975702107f,
+	 0.993906975f,  0.993906975f, -0.110222206f, -0.110222206f,
+	 0.624859512f,  0.624859512f, -0.780737221f, -0.780737221f,
+	 0.110222206f,  0.110222206f,  0.993906975f,  0.993906975f,
+	 0.780737221f,  0.780737221f,  0.624859512f,  0.624859512f,
+	 0.998475552f,  0.666999936f, -0.0551952459f, -0.745057762f,
+	 0.901348829f,  0.331106305f, -0.433093816f, -0.943593442f,
+	 0.0551952459f,  0.745057762f,  0.998475552f,  0.666999936f,
+	 0.433093816f,  0.943593442f,  0.901348829f,  0.331106305f,
+	 0.534997642f,  0.534997642f,  0.534997642f,  0.534997642f,
+	-0.84485358f, -0.84485358f, -0.84485358f, -0.84485358f,
+	 0.84485358f,  0.84485358f,  0.84485358f,  0.84485358f,
+	 0.534997642f,  0.534997642f,  0.534997642f,  0.534997642f,
+	 0.876070082f,  0.876070082f, -0.482183784f, -0.482183784f,
+	 0.27851969f,  0.27851969f, -0.960430503f, -0.960430503f,
+	 0.482183784f,  0.482183784f,  0.876070082f,  0.876070082f,
+	 0.960430503f,  0.960430503f,  0.27851969f,  0.27851969f,
+	 0.968522072f,  0.50883013f, -0.248927608f, -0.860866964f,
+	 0.799537241f,  0.140658244f, -0.600616455f, -0.990058184f,
+	 0.248927608f,  0.860866964f,  0.968522072f,  0.50883013f,
+	 0.600616455f,  0.990058184f,  0.799537241f,  0.140658244f,
+	 0.817584813f,  0.817584813f,  0.817584813f,  0.817584813f,
+	-0.575808167f, -0.575808167f, -0.575808167f, -0.575808167f,
+	 0.575808167f,  0.575808167f,  0.575808167f,  0.575808167f,
+	 0.817584813f,  0.817584813f,  0.817584813f,  0.817584813f,
+	 0.953306019f,  0.953306019f, -0.302005947f, -0.302005947f,
+	 0.460538715f,  0.460538715f, -0.887639642f, -0.887639642f,
+	 0.302005947f,  0.302005947f,  0.953306019f,  0.953306019f,
+	 0.887639642f,  0.887639642f,  0.460538715f,  0.460538715f,
+	 0.988257587f,  0.590759695f, -0.152797192f, -0.806847572f,
+	 0.854557991f,  0.237023607f, -0.519356012f, -0.971503913f,
+	 0.152797192f,  0.806847572f,  0.988257587f,  0.590759695f,
+	 0.519356012f,  0.971503913f,  0.854557991f,  0.237023607f,
+	 0.170961887f,  0.170961887f,  0.170961887f,  0.170961887f,
+	-0.985277653f, -0.985277653f, -0.985277653f, -0.985277653f,
+	 0.985277653f,  0.985277653f,  0.985277653f,  0.985277653f,
+	 0.170961887f,  0.170961887f,  0.170961887f,  0.170961887f,
+	 0.765167236f,  0.765167236f, -0.643831551f, -0.643831551f,
+	 0.0857973099f,  0.0857973099f, -0.996312618f, -0.996312618f,
+	 0.643831551f,  0.643831551f,  0.765167236f,  0.765167236f,
+	 0.996312618f,  0.996312618f,  0.0857973099f,  0.0857973099f,
+	 0.939459205f,  0.422000259f, -0.342660725f, -0.906595707f,
+	 0.736816585f,  0.0429382585f, -0.676092684f, -0.999077737f,
+	 0.342660725f,  0.906595707f,  0.939459205f,  0.422000259f,
+	 0.676092684f,  0.999077737f,  0.736816585f,  0.0429382585f,
+	 0.992479563f,  0.992479563f,  0.992479563f,  0.992479563f,
+	-0.122410677f, -0.122410677f, -0.122410677f, -0.122410677f,
+	 0.122410677f,  0.122410677f,  0.122410677f,  0.122410677f,
+	 0.992479563f,  0.992479563f,  0.992479563f,  0.992479563f,
+	 0.998118103f,  0.998118103f, -0.061320737f, -0.061320737f,
+	 0.662415802f,  0.662415802f, -0.749136388f, -0.749136388f,
+	 0.061320737f,  0.061320737f,  0.998118103f,  0.998118103f,
+	 0.749136388f,  0.749136388f,  0.662415802f,  0.662415802f,
+	 0.999529421f,  0.685083687f, -0.030674804f, -0.728464365f,
+	 0.91170603f,  0.354163527f, -0.410843164f, -0.935183525f,
+	 0.030674804f,  0.728464365f,  0.999529421f,  0.685083687f,
+	 0.410843164f,  0.935183525f,  0.91170603f,  0.354163527f,
+	 0.615231574f,  0.615231574f,  0.615231574f,  0.615231574f,
+	-0.78834641f, -0.78834641f, -0.78834641f, -0.78834641f,
+	 0.78834641f,  0.78834641f,  0.78834641f,  0.78834641f,
+	 0.615231574f,  0.615231574f,  0.615231574f,  0.615231574f,
+	 0.898674488f,  0.898674488f, -0.438616246f, -0.438616246f,
+	 0.32531029f,  0.32531029f, -0.945607305f, -0.945607305f,
+	 0.438616246f,  0.438616246f,  0.898674488f,  0.898674488f,
+	 0.945607305f,  0.945607305f,  0.32531029f,  0.32531029f,
+	 0.974339366f,  0.529803634f, -0.225083917f, -0.848120332f,
+	 0.81403631f,  0.164913118f, -0.580813944f, -0.986308098f,
+	 0.225083917f,  0.848120332f,  0.974339366f,  0.529803634f,
+	 0.580813944f,  0.986308098f,  0.81403631f,  0.164913118f,
+	 0.870086968f,  0.870086968f,  0.870086968f,  0.870086968f,
+	-0.492898196f, -0.492898196f, -0.492898196f, -0.492898196f,
+	 0.492898196f,  0.492898196f,  0.492898196f,  0.492898196f,
+	 0.870086968f,  0.870086968f,  0.870086968f,  0.870086968f,
+	 0.966976464f,  0.966976464f, -0.254865646f, -0.254865646f,
+	 0.50353837f,  0.50353837f, -0.863972843f, -0.863972843f,
+	 0.254865646f,  0.254865646f,  0.966976464f,  0.966976464f,
+	 0.863972843f,  0.863972843f,  0.50353837f,  0.50353837f,
+	 0.991709769f,  0.610382795f, -0.128498107f, -0.792106569f,
+	 0.867046237f,  0.260794103f, -0.498227656f, -0.965394437f,
+	 0.128498107f,  0.792106569f,  0.991709769f,  0.610382795f,
+	 0.498227656f,  0.965394437f,  0.867046237f,  0.260794103f,
+	 0.266712755f,  0.266712755f,  0.266712755f,  0.266712755f,
+	-0.963776052f, -0.963776052f, -0.963776052f, -0.963776052f,
+	 0.963776052f,  0.963776052f,  0.963776052f,  0.963776052f,
+	 0.266712755f,  0.266712755f,  0.266712755f,  0.266712755f,
+	 0.795836926f,  0.795836926f, -0.605511069f, -0.605511069f,
+	 0.134580702f,  0.134580702f, -0.990902662f, -0.990902662f,
+	 0.605511069f,  0.605511069f,  0.795836926f,  0.795836926f,
+	 0.990902662f,  0.990902662f,  0.134580702f,  0.134580702f,
+	 0.947585583f,  0.444122136f, -0.319502026f, -0.895966232f,
+	 0.753186822f,  0.0674439222f, -0.657806695f, -0.997723043f,
+	 0.319502026f,  0.895966232f,  0.947585583f,  0.444122136f,
+	 0.657806695f,  0.997723043f,  0.753186822f,  0.0674439222f,
+	 0.949528158f,  0.949528158f,  0.949528158f,  0.949528158f,
+	-0.313681751f, -0.313681751f, -0.313681751f, -0.313681751f,
+	 0.313681751f,  0.313681751f,  0.313681751f,  0.313681751f,
+	 0.949528158f,  0.949528158f,  0.949528158f,  0.949528158f,
+	 0.987301409f,  0.987301409f, -0.15885815f, -0.15885815f,
+	 0.585797846f,  0.585797846f, -0.81045717f, -0.81045717f,
+	 0.15885815f,  0.15885815f,  0.987301409f,  0.987301409f,
+	 0.81045717f,  0.81045717f,  0.585797846f,  0.585797846f,
+	 0.996820271f,  0.64851439f, -0.0796824396f, -0.761202395f,
+	 0.890448749f,  0.307849646f, -0.455083579f, -0.95143503f,
+	 0.0796824396f,  0.761202395f,  0.996820271f,  0.64851439f,
+	 0.455083579f,  0.95143503f,  0.890448749f,  0.307849646f,
+	 0.449611336f,  0.449611336f,  0.449611336f,  0.449611336f,
+	-0.893224299f, -0.893224299f, -0.893224299f, -0.893224299f,
+	 0.893224299f,  0.893224299f,  0.893224299f,  0.893224299f,
+	 0.449611336f,  0.449611336f,  0.449611336f,  0.449611336f,
+	 0.851355195f,  0.851355195f, -0.524589658f, -0.524589658f,
+	 0.231058106f,  0.231058106f, -0.972939968f, -0.972939968f,
+	 0.524589658f,  0.524589658f,  0.851355195f,  0.851355195f,
+	 0.972939968f,  0.972939968f,  0.231058106f,  0.231058106f,
+	 0.962121427f,  0.487550169f, -0.272621363f, -0.873094976f,
+	 0.784556568f,  0.116318628f, -0.620057225f, -0.993211925f,
+	 0.272621363f,  0.873094976f,  0.962121427f,  0.487550169f,
+	 0.620057225f,  0.993211925f,  0.784556568f,  0.116318628f,
+	 0.757208824f,  0.757208824f,  0.757208824f,  0.757208824f,
+	-0.653172851f, -0.653172851f, -0.653172851f, -0.653172851f,
+	 0.653172851f,  0.653172851f,  0.653172851f,  0.653172851f,
+	 0.757208824f,  0.757208824f,  0.757208824f,  0.757208824f,
+	 0.937339008f,  0.937339008f, -0.348418683f, -0.348418683f,
+	 0.416429549f,  0.416429549f, -0.909168005f, -0.909168005f,
+	 0.348418683f,  0.348418683f,  0.937339008f,  0.937339008f,
+	 0.909168005f,  0.909168005f,  0.416429549f,  0.416429549f,
+	 0.984210074f,  0.570780754f, -0.177004218f, -0.8211025f,
+	 0.841554999f,  0.213110313f, -0.540171444f, -0.977028131f,
+	 0.177004218f,  0.8211025f,  0.984210074f,  0.570780754f,
+	 0.540171444f,  0.977028131f,  0.841554999f,  0.213110313f,
+	 0.0735645667f,  0.0735645667f,  0.0735645667f,  0.0735645667f,
+	-0.997290432f, -0.997290432f, -0.997290432f, -0.997290432f,
+	 0.997290432f,  0.997290432f,  0.997290432f,  0.997290432f,
+	 0.0735645667f,  0.0735645667f,  0.0735645667f,  0.0735645667f,
+	 0.732654274f,  0.732654274f, -0.680601001f, -0.680601001f,
+	 0.0368072242f,  0.0368072242f, -0.999322355f, -0.999322355f,
+	 0.680601001f,  0.680601001f,  0.732654274f,  0.732654274f,
+	 0.999322355f,  0.999322355f,  0.0368072242f,  0.0368072242f,
+	 0.93076694f,  0.399624199f, -0.365612984f, -0.916679084f,
+	 0.720002532f,  0.0184067301f, -0.693971455f, -0.999830604f,
+	 0.365612984f,  0.916679084f,  0.93076694f,  0.399624199f,
+	 0.693971455f,  0.999830604f,  0.720002532f,  0.0184067301f
+};
+
+const float fpr_gm32_tail10[] = {
+	 0.999924719f,  0.999924719f,  0.999924719f,  0.999924719f,
+	-0.0122715384f, -0.0122715384f, -0.0122715384f, -0.0122715384f,
+	 0.0122715384f,  0.0122715384f,  0.0122715384f,  0.0122715384f,
+	 0.999924719f,  0.999924719f,  0.999924719f,  0.999924719f,
+	 0.999981165f,  0.999981165f, -0.00613588467f, -0.00613588467f,
+	 0.702754736f,  0.702754736f, -0.711432219f, -0.711432219f,
+	 0.00613588467f,  0.00613588467f,  0.999981165f,  0.999981165f,
+	 0.711432219f,  0.711432219f,  0.702754736f,  0.702754736f,
+	 0.999995291f,  0.704934061f, -0.00306795677f, -0.709272802f,
+	 0.92270112f,  0.379847199f, -0.385516047f, -0.925049245f,
+	 0.00306795677f,  0.709272802f,  0.999995291f,  0.704934061f,
+	 0.385516047f,  0.925049245f,  0.92270112f,  0.379847199f,
+	 0.698376238f,  0.698376238f,  0.698376238f,  0.698376238f,
+	-0.715730846f, -0.715730846f, -0.715730846f, -0.715730846f,
+	 0.715730846f,  0.715730846f,  0.715730846f,  0.715730846f,
+	 0.698376238f,  0.698376238f,  0.698376238f,  0.698376238f,
+	 0.921514034f,  0.921514034f, -0.388345033f, -0.388345033f,
+	 0.377007425f,  0.377007425f, -0.926210225f, -0.926210225f,
+	 0.388345033f,  0.388345033f,  0.921514034f,  0.921514034f,
+	 0.926210225f,  0.926210225f,  0.377007425f,  0.377007425f,
+	 0.980182111f,  0.553016722f, -0.198098406f, -0.833170176f,
+	 0.829761207f,  0.192080393f, -0.558118522f, -0.981379211f,
+	 0.198098406f,  0.833170176f,  0.980182111f,  0.553016722f,
+	 0.558118522f,  0.981379211f,  0.829761207f,  0.192080393f,
+	 0.919113874f,  0.919113874f,  0.919113874f,  0.919113874f,
+	-0.393992037f, -0.393992037f, -0.393992037f, -0.393992037f,
+	 0.393992037f,  0.393992037f,  0.393992037f,  0.393992037f,
+	 0.919113874f,  0.919113874f,  0.919113874f,  0.919113874f,
+	 0.979569793f,  0.979569793f, -0.201104641f, -0.201104641f,
+	 0.550457954f,  0.550457954f, -0.834862888f, -0.834862888f,
+	 0.201104641f,  0.201104641f,  0.979569793f,  0.979569793f,
+	 0.834862888f,  0.834862888f,  0.550457954f,  0.550457954f,
+	 0.994879305f,  0.632018745f, -0.10106986f, -0.774953127f,
+	 0.880470872f,  0.287347466f, -0.474100202f, -0.957826436f,
+	 0.10106986f,  0.774953127f,  0.994879305f,  0.632018745f,
+	 0.474100202f,  0.957826436f,  0.880470872f,  0.287347466f,
+	 0.371317208f,  0.371317208f,  0.371317208f,  0.371317208f,
+	-0.928506076f, -0.928506076f, -0.928506076f, -0.928506076f,
+	 0.928506076f,  0.928506076f,  0.928506076f,  0.928506076f,
+	 0.371317208f,  0.371317208f,  0.371317208f,  0.371317208f,
+	 0.82804507f,  0.82804507f, -0.560661554f, -0.560661554f,
+	 0.18906866f,  0.18906866f, -0.981963873f, -0.981963873f,
+	 0.560661554f,  0.560661554f,  0.82804507f,  0.82804507f,
+	 0.981963873f,  0.981963873f,  0.18906866f,  0.18906866f,
+	 0.95604527f,  0.468688816f, -0.293219149f, -0.883363366f,
+	 0.771060526f,  0.0949634984f, -0.636761844f, -0.995480776f,
+	 0.293219149f,  0.883363366f,  0.95604527f,  0.468688816f,
+	 0.636761844f,  0.995480776f,  0.771060526f,  0.0949634984f,
+	 0.97831738f,  0.97831738f,  0.97831738f,  0.97831738f,
+	-0.207111374f, -0.207111374f, -0.207111374f, -0.207111374f,
+	 0.207111374f,  0.207111374f,  0.207111374f,  0.207111374f,
+	 0.97831738f,  0.97831738f,  0.97831738f,  0.97831738f,
+	 0.994564593f,  0.994564593f, -0.104121633f, -0.104121633f,
+	 0.629638255f,  0.629638255f, -0.77688849f, -0.77688849f,
+	 0.104121633f,  0.104121633f,  0.994564593f,  0.994564593f,
+	 0.77688849f,  0.77688849f,  0.629638255f,  0.629638255f,
+	 0.998640239f,  0.669282615f, -0.052131705f, -0.743007958f,
+	 0.902673304f,  0.333999664f, -0.430326492f, -0.94257319f,
+	 0.052131705f,  0.743007958f,  0.998640239f,  0.669282615f,
+	 0.430326492f,  0.94257319f,  0.902673304f,  0.333999664f,
+	 0.545324981f,  0.545324981f,  0.545324981f,  0.545324981f,
+	-0.838224709f, -0.838224709f, -0.838224709f, -0.838224709f,
+	 0.838224709f,  0.838224709f,  0.838224709f,  0.838224709f,
+	 0.545324981f,  0.545324981f,  0.545324981f,  0.545324981f,
+	 0.879012227f,  0.879012227f, -0.47679922f, -0.47679922f,
+	 0.284407526f,  0.284407526f, -0.958703458f, -0.958703458f,
+	 0.47679922f,  0.47679922f,  0.879012227f,  0.879012227f,
+	 0.958703458f,  0.958703458f,  0.284407526f,  0.284407526f,
+	 0.969281256f,  0.511468828f, -0.24595505f, -0.859301805f,
+	 0.801376164f,  0.143695027f, -0.598160684f, -0.989621997f,
+	 0.24595505f,  0.859301805f,  0.969281256f,  0.511468828f,
+	 0.598160684f,  0.989621997f,  0.801376164f,  0.143695027f,
+	 0.824589312f,  0.824589312f,  0.824589312f,  0.824589312f,
+	-0.565731823f, -0.565731823f, -0.565731823f, -0.565731823f,
+	 0.565731823f,  0.565731823f,  0.565731823f,  0.565731823f,
+	 0.824589312f,  0.824589312f,  0.824589312f,  0.824589312f,
+	 0.955141187f,  0.955141187f, -0.296150893f, -0.296150893f,
+	 0.465976506f,  0.465976506f, -0.884797096f, -0.884797096f,
+	 0.296150893f,  0.296150893f,  0.955141187f,  0.955141187f,
+	 0.884797096f,  0.884797096f,  0.465976506f,  0.465976506f,
+	 0.988721669f,  0.593232274f, -0.149764538f, -0.805031359f,
+	 0.856147349f,  0.24000302f, -0.516731799f, -0.970772147f,
+	 0.149764538f,  0.805031359f,  0.988721669f,  0.593232274f,
+	 0.516731799f,  0.970772147f,  0.856147349f,  0.24000302f,
+	 0.183039889f,  0.183039889f,  0.183039889f,  0.183039889f,
+	-0.983105481f, -0.983105481f, -0.983105481f, -0.983105481f,
+	 0.983105481f,  0.983105481f,  0.983105481f,  0.983105481f,
+	 0.183039889f,  0.183039889f,  0.183039889f,  0.183039889f,
+	 0.769103348f,  0.769103348f, -0.639124453f, -0.639124453f,
+	 0.0919089541f,  0.0919089541f, -0.995767415f, -0.995767415f,
+	 0.639124453f,  0.639124453f,  0.769103348f,  0.769103348f,
+	 0.995767415f,  0.995767415f,  0.0919089541f,  0.0919089541f,
+	 0.940506041f,  0.424779683f, -0.339776874f, -0.905296743f,
+	 0.73888731f,  0.0460031815f, -0.673829019f, -0.998941302f,
+	 0.339776874f,  0.905296743f,  0.940506041f,  0.424779683f,
+	 0.673829019f,  0.998941302f,  0.73888731f,  0.0460031815f,
+	 0.993906975f,  0.993906975f,  0.993906975f,  0.993906975f,
+	-0.110222206f, -0.110222206f, -0.110222206f, -0.110222206f,
+	 0.110222206f,  0.110222206f,  0.110222206f,  0.110222206f,
+	 0.993906975f,  0.993906975f,  0.993906975f,  0.993906975f,
+	 0.998475552f,  0.998475552f, -0.0551952459f, -0.0551952459f,
+	 0.666999936f,  0.666999936f, -0.745057762f, -0.745057762f,
+	 0.0551952459f,  0.0551952459f,  0.998475552f,  0.998475552f,
+	 0.745057762f,  0.745057762f,  0.666999936f,  0.666999936f,
+	 0.999618828f,  0.687315345f, -0.027608145f, -0.726359129f,
+	 0.912962198f,  0.357030958f, -0.408044159f, -0.934092522f,
+	 0.027608145f,  0.726359129f,  0.999618828f,  0.687315345f,
+	 0.408044159f,  0.934092522f,  0.912962198f,  0.357030958f,
+	 0.624859512f,  0.624859512f,  0.624859512f,  0.624859512f,
+	-0.780737221f, -0.780737221f, -0.780737221f, -0.780737221f,
+	 0.780737221f,  0.780737221f,  0.780737221f,  0.780737221f,
+	 0.624859512f,  0.624859512f,  0.624859512f,  0.624859512f,
+	 0.901348829f,  0.901348829f, -0.433093816f, -0.433093816f,
+	 0.331106305f,  0.331106305f, -0.943593442f, -0.943593442f,
+	 0.433093816f,  0.433093816f,  0.901348829f,  0.901348829f,
+	 0.943593442f,  0.943593442f,  0.331106305f,  0.331106305f,
+	 0.975025356f,  0.532403111f, -0.222093627f, -0.84649092f,
+	 0.815814435f,  0.167938292f, -0.578313768f, -0.985797524f,
+	 0.222093627f,  0.84649092f,  0.975025356f,  0.532403111f,
+	 0.578313768f,  0.985797524f,  0.815814435f,  0.167938292f,
+	 0.876070082f,  0.876070082f,  0.876070082f,  0.876070082f,
+	-0.482183784f, -0.482183784f, -0.482183784f, -0.482183784f,
+	 0.482183784f,  0.482183784f,  0.482183784f,  0.482183784f,
+	 0.876070082f,  0.876070082f,  0.876070082f,  0.876070082f,
+	 0.968522072f,  0.968522072f, -0.248927608f, -0.248927608f,
+	 0.50883013f,  0.50883013f, -0.860866964f, -0.860866964f,
+	 0.248927608f,  0.248927608f,  0.968522072f,  0.968522072f,
+	 0.860866964f,  0.860866964f,  0.50883013f,  0.50883013f,
+	 0.992099285f,  0.612810075f, -0.125454977f, -0.790230215f,
+	 0.868570685f,  0.263754666f, -0.495565265f, -0.964589775f,
+	 0.125454977f,  0.790230215f,  0.992099285f,  0.612810075f,
+	 0.495565265f,  0.964589775f,  0.868570685f,  0.263754666f,
+	 0.27851969f,  0.27851969f,  0.27851969f,  0.27851969f,
+	-0.960430503f, -0.960430503f, -0.960430503f, -0.960430503f,
+	 0.960430503f,  0.960430503f,  0.960430503f,  0.960430503f,
+	 0.27851969f,  0.27851969f,  0.27851969f,  0.27851969f,
+	 0.799537241f,  0.799537241f, -0.600616455f, -0.600616455f,
+	 0.140658244f,  0.140658244f, -0.990058184f, -0.990058184f,
+	 0.600616455f,  0.600616455f,  0.799537241f,  0.799537241f,
+	 0.990058184f,  0.990058184f,  0.140658244f,  0.140658244f,
+	 0.94856137f,  0.446868837f, -0.316593379f, -0.894599497f,
+	 0.755201399f,  0.070504576f, -0.655492842f, -0.997511446f,
+	 0.316593379f,  0.894599497f,  0.94856137f,  0.446868837f,
+	 0.655492842f,  0.997511446f,  0.755201399f,  0.070504576f,
+	 0.953306019f,  0.953306019f,  0.953306019f,  0.953306019f,
+	-0.302005947f, -0.302005947f, -0.302005947f, -0.302005947f,
+	 0.302005947f,  0.302005947f,  0.302005947f,  0.302005947f,
+	 0.953306019f,  0.953306019f,  0.953306019f,  0.953306019f,
+	 0.988257587f,  0.988257587f, -0.152797192f, -0.152797192f,
+	 0.590759695f,  0.590759695f, -0.806847572f, -0.806847572f,
+	 0.152797192f,  0.152797192f,  0.988257587f,  0.988257587f,
+	 0.806847572f,  0.806847572f,  0.590759695f,  0.590759695f,
+	 0.997060061f,  0.65084666f, -0.0766238645f, -0.759209216f,
+	 0.891840696f,  0.310767144f, -0.452349573f, -0.950486064f,
+	 0.0766238645f,  0.759209216f,  0.997060061f,  0.65084666f,
+	 0.452349573f,  0.950486064f,  0.891840696f,  0.310767144f,
+	 0.460538715f,  0.460538715f,  0.460538715f,  0.460538715f,
+	-0.887639642f, -0.887639642f, -0.887639642f, -0.887639642f,
+	 0.887639642f,  0.887639642f,  0.887639642f,  0.887639642f,
+	 0.460538715f,  0.460538715f,  0.460538715f,  0.460538715f,
+	 0.854557991f,  0.854557991f, -0.519356012f, -0.519356012f,
+	 0.237023607f,  0.237023607f, -0.971503913f, -0.971503913f,
+	 0.519356012f,  0.519356012f,  0.854557991f,  0.854557991f,
+	 0.971503913f,  0.971503913f,  0.237023607f,  0.237023607f,
+	 0.962953269f,  0.490226477f, -0.269668311f, -0.871595085f,
+	 0.786455214f,  0.119365215f, -0.61764729f, -0.992850423f,
+	 0.269668311f,  0.871595085f,  0.962953269f,  0.490226477f,
+	 0.61764729f,  0.992850423f,  0.786455214f,  0.119365215f,
+	 0.765167236f,  0.765167236f,  0.765167236f,  0.765167236f,
+	-0.643831551f, -0.643831551f, -0.643831551f, -0.643831551f,
+	 0.643831551f,  0.643831551f,  0.643831551f,  0.643831551f,
+	 0.765167236f,  0.765167236f,  0.765167236f,  0.765167236f,
+	 0.939459205f,  0.939459205f, -0.342660725f, -0.342660725f,
+	 0.422000259f,  0.422000259f, -0.906595707f, -0.906595707f,
+	 0.342660725f,  0.342660725f,  0.939459205f,  0.939459205f,
+	 0.906595707f,  0.906595707f,  0.422000259f,  0.422000259f,
+	 0.984748483f,  0.573297143f, -0.173983872f, -0.819347501f,
+	 0.843208253f,  0.216106802f, -0.537587047f, -0.976369739f,
+	 0.173983872f,  0.819347501f,  0.984748483f,  0.573297143f,
+	 0.537587047f,  0.976369739f,  0.843208253f,  0.216106802f,
+	 0.0857973099f,  0.0857973099f,  0.0857973099f,  0.0857973099f,
+	-0.996312618f, -0.996312618f, -0.996312618f, -0.996312618f,
+	 0.996312618f,  0.996312618f,  0.996312618f,  0.996312618f,
+	 0.0857973099f,  0.0857973099f,  0.0857973099f,  0.0857973099f,
+	 0.736816585f,  0.736816585f, -0.676092684f, -0.676092684f,
+	 0.0429382585f,  0.0429382585f, -0.999077737f, -0.999077737f,
+	 0.676092684f,  0.676092684f,  0.736816585f,  0.736816585f,
+	 0.999077737f,  0.999077737f,  0.0429382585f,  0.0429382585f,
+	 0.931884289f,  0.402434647f, -0.362755716f, -0.915448725f,
+	 0.722128212f,  0.0214740802f, -0.691759229f, -0.99976939f,
+	 0.362755716f,  0.915448725f,  0.931884289f,  0.402434647f,
+	 0.691759229f,  0.99976939f,  0.722128212f,  0.0214740802f,
+	 0.998118103f,  0.998118103f,  0.998118103f,  0.998118103f,
+	-0.061320737f, -0.061320737f, -0.061320737f, -0.061320737f,
+	 0.061320737f,  0.061320737f,  0.061320737f,  0.061320737f,
+	 0.998118103f,  0.998118103f,  0.998118103f,  0.998118103f,
+	 0.999529421f,  0.999529421f, -0.030674804f, -0.030674804f,
+	 0.685083687f,  0.685083687f, -0.728464365f, -0.728464365f,
+	 0.030674804f,  0.030674804f,  0.999529421f,  0.999529421f,
+	 0.728464365f,  0.728464365f,  0.685083687f,  0.685083687f,
+	 0.99988234f,  0.696177125f, -0.015339206f, -0.717870057f,
+	 0.917900801f,  0.368466824f, -0.396809995f, -0.929640889f,
+	 0.015339206f,  0.717870057f,  0.99988234f,  0.696177125f,
+	 0.396809995f,  0.929640889f,  0.917900801f,  0.368466824f,
+	 0.662415802f,  0.662415802f,  0.662415802f,  0.662415802f,
+	-0.749136388f, -0.749136388f, -0.749136388f, -0.749136388f,
+	 0.749136388f,  0.749136388f,  0.749136388f,  0.749136388f,
+	 0.662415802f,  0.662415802f,  0.662415802f,  0.662415802f,
+	 0.91170603f,  0.91170603f, -0.410843164f, -0.410843164f,
+	 0.354163527f,  0.354163527f, -0.935183525f, -0.935183525f,
+	 0.410843164f,  0.410843164f,  0.91170603f,  0.91170603f,
+	 0.935183525f,  0.935183525f,  0.354163527f,  0.354163527f,
+	 0.977677345f,  0.542750776f, -0.210111842f, -0.839893818f,
+	 0.82284981f,  0.180022895f, -0.568258941f, -0.983662426f,
+	 0.210111842f,  0.839893818f,  0.977677345f,  0.542750776f,
+	 0.568258941f,  0.983662426f,  0.82284981f,  0.180022895f,
+	 0.898674488f,  0.898674488f,  0.898674488f,  0.898674488f,
+	-0.438616246f, -0.438616246f, -0.438616246f, -0.438616246f,
+	 0.438616246f,  0.438616246f,  0.438616246f,  0.438616246f,
+	 0.898674488f,  0.898674488f,  0.898674488f,  0.898674488f,
+	 0.974339366f,  0.974339366f, -0.225083917f, -0.225083917f,
+	 0.529803634f,  0.529803634f, -0.848120332f, -0.848120332f,
+	 0.225083917f,  0.225083917f,  0.974339366f,  0.974339366f,
+	 0.848120332f,  0.848120332f,  0.529803634f,  0.529803634f,
+	 0.993564129f,  0.622461259f, -0.113270953f, -0.78265059f,
+	 0.874586642f,  0.275571823f, -0.484869242f, -0.961280465f,
+	 0.113270953f,  0.78265059f,  0.993564129f,  0.622461259f,
+	 0.484869242f,  0.961280465f,  0.874586642f,  0.275571823f,
+	 0.32531029f,  0.32531029f,  0.32531029f,  0.32531029f,
+	-0.945607305f, -0.945607305f, -0.945607305f, -0.945607305f,
+	 0.945607305f,  0.945607305f,  0.945607305f,  0.945607305f,
+	 0.32531029f,  0.32531029f,  0.32531029f,  0.32531029f,
+	 0.81403631f,  0.81403631f, -0.580813944f, -0.580813944f,
+	 0.164913118f,  0.164913118f, -0.986308098f, -0.986308098f,
+	 0.580813944f,  0.580813944f,  0.81403631f,  0.81403631f,
+	 0.986308098f,  0.986308098f,  0.164913118f,  0.164913118f,
+	 0.952374995f,  0.457813293f, -0.304929227f, -0.889048338f,
+	 0.763188422f,  0.0827402622f, -0.64617604f, -0.996571124f,
+	 0.304929227f,  0.889048338f,  0.952374995f,  0.457813293f,
+	 0.64617604f,  0.996571124f,  0.763188422f,  0.0827402622f,
+	 0.966976464f,  0.966976464f,  0.966976464f,  0.966976464f,
+	-0.254865646f, -0.254865646f, -0.254865646f, -0.254865646f,
+	 0.254865646f,  0.254865646f,  0.254865646f,  0.254865646f,
+	 0.966976464f,  0.966976464f,  0.966976464f,  0.966976464f,
+	 0.991709769f,  0.991709769f, -0.128498107f, -0.128498107f,
+	 0.610382795f,  0.610382795f, -0.792106569f, -0.792106569f,
+	 0.128498107f,  0.128498107f,  0.991709769f,  0.991709769f,
+	 0.792106569f,  0.792106569f,  0.610382795f,  0.610382795f,
+	 0.997925282f,  0.660114348f, -0.0643826276f, -0.751165152f,
+	 0.897324562f,  0.322407693f, -0.441371262f, -0.946600914f,
+	 0.0643826276f,  0.751165152f,  0.997925282f,  0.660114348f,
+	 0.441371262f,  0.946600914f,  0.897324562f,  0.322407693f,
+	 0.50353837f,  0.50353837f,  0.50353837f,  0.50353837f,
+	-0.863972843f, -0.863972843f, -0.863972843f, -0.863972843f,
+	 0.863972843f,  0.863972843f,  0.863972843f,  0.863972843f,
+	 0.50353837f,  0.50353837f,  0.50353837f,  0.50353837f,
+	 0.867046237f,  0.867046237f, -0.498227656f, -0.498227656f,
+	 0.260794103f,  0.260794103f, -0.965394437f, -0.965394437f,
+	 0.498227656f,  0.498227656f,  0.867046237f,  0.867046237f,
+	 0.965394437f,  0.965394437f,  0.260794103f,  0.260794103f,
+	 0.966189981f,  0.500885367f, -0.257831097f, -0.865513623f,
+	 0.793975472f,  0.13154003f, -0.607949793f, -0.991310835f,
+	 0.257831097f,  0.865513623f,  0.966189981f,  0.500885367f,
+	 0.607949793f,  0.991310835f,  0.793975472f,  0.13154003f,
+	 0.795836926f,  0.795836926f,  0.795836926f,  0.795836926f,
+	-0.605511069f, -0.605511069f, -0.605511069f, -0.605511069f,
+	 0.605511069f,  0.605511069f,  0.605511069f,  0.605511069f,
+	 0.795836926f,  0.795836926f,  0.795836926f,  0.795836926f,
+	 0.947585583f,  0.947585583f, -0.319502026f, -0.319502026f,
+	 0.444122136f,  0.444122136f, -0.895966232f, -0.895966232f,
+	 0.319502026f,  0.319502026f,  0.947585583f,  0.947585583f,
+	 0.895966232f,  0.895966232f,  0.444122136f,  0.444122136f,
+	 0.986809373f,  0.583308637f, -0.161886394f, -0.812250614f,
+	 0.849741757f,  0.228072077f, -0.527199149f, -0.973644257f,
+	 0.161886394f,  0.812250614f,  0.986809373f,  0.583308637f,
+	 0.527199149f,  0.973644257f,  0.849741757f,  0.228072077f,
+	 0.134580702f,  0.134580702f,  0.134580702f,  0.134580702f,
+	-0.990902662f, -0.990902662f, -0.990902662f, -0.990902662f,
+	 0.990902662f,  0.990902662f,  0.990902662f,  0.990902662f,
+	 0.134580702f,  0.134580702f,  0.134580702f,  0.134580702f,
+	 0.753186822f,  0.753186822f, -0.657806695f, -0.657806695f,
+	 0.0674439222f,  0.0674439222f, -0.997723043f, -0.997723043f,
+	 0.657806695f,  0.657806695f,  0.753186822f,  0.753186822f,
+	 0.997723043f,  0.997723043f,  0.0674439222f,  0.0674439222f,
+	 0.936265647f,  0.413638324f, -0.351292759f, -0.910441279f,
+	 0.730562747f,  0.0337411724f, -0.682845533f, -0.999430597f,
+	 0.351292759f,  0.910441279f,  0.936265647f,  0.413638324f,
+	 0.682845533f,  0.999430597f,  0.730562747f,  0.0337411724f,
+	 0.987301409f,  0.987301409f,  0.987301409f,  0.987301409f,
+	-0.15885815f, -0.15885815f, -0.15885815f, -0.15885815f,
+	 0.15885815f,  0.15885815f,  0.15885815f,  0.15885815f,
+	 0.987301409f,  0.987301409f,  0.987301409f,  0.987301409f,
+	 0.996820271f,  0.996820271f, -0.0796824396f, -0.0796824396f,
+	 0.64851439f,  0.64851439f, -0.761202395f, -0.761202395f,
+	 0.0796824396f,  0.0796824396f,  0.996820271f,  0.996820271f,
+	 0.761202395f,  0.761202395f,  0.64851439f,  0.64851439f,
+	 0.999204755f,  0.678350031f, -0.0398729257f, -0.734738886f,
+	 0.907886088f,  0.345541328f, -0.419216901f, -0.938403547f,
+	 0.0398729257f,  0.734738886f,  0.999204755f,  0.678350031f,
+	 0.419216901f,  0.938403547f,  0.907886088f,  0.345541328f,
+	 0.585797846f,  0.585797846f,  0.585797846f,  0.585797846f,
+	-0.81045717f, -0.81045717f, -0.81045717f, -0.81045717f,
+	 0.81045717f,  0.81045717f,  0.81045717f,  0.81045717f,
+	 0.585797846f,  0.585797846f,  0.585797846f,  0.585797846f,
+	 0.890448749f,  0.890448749f, -0.455083579f, -0.455083579f,
+	 0.307849646f,  0.307849646f, -0.95143503f, -0.95143503f,
+	 0.455083579f,  0.455083579f,  0.890448749f,  0.890448749f,
+	 0.95143503f,  0.95143503f,  0.307849646f,  0.307849646f,
+	 0.972226501f,  0.521975279f, -0.234041959f, -0.852960587f,
+	 0.808656156f,  0.155828401f, -0.588281572f, -0.987784147f,
+	 0.234041959f,  0.852960587f,  0.972226501f,  0.521975279f,
+	 0.588281572f,  0.987784147f,  0.808656156f,  0.155828401f,
+	 0.851355195f,  0.851355195f,  0.851355195f,  0.851355195f,
+	-0.524589658f, -0.524589658f, -0.524589658f, -0.524589658f,
+	 0.524589658f,  0.524589658f,  0.524589658f,  0.524589658f,
+	 0.851355195f,  0.851355195f,  0.851355195f,  0.851355195f,
+	 0.962121427f,  0.962121427f, -0.272621363f, -0.272621363f,
+	 0.487550169f,  0.487550169f, -0.873094976f, -0.873094976f,
+	 0.272621363f,  0.272621363f,  0.962121427f,  0.962121427f,
+	 0.873094976f,  0.873094976f,  0.487550169f,  0.487550169f,
+	 0.990485072f,  0.603066623f, -0.137620121f, -0.797690868f,
+	 0.862423956f,  0.251897812f, -0.506186664f, -0.967753828f,
+	 0.137620121f,  0.797690868f,  0.990485072f,  0.603066623f,
+	 0.506186664f,  0.967753828f,  0.862423956f,  0.251897812f,
+	 0.231058106f,  0.231058106f,  0.231058106f,  0.231058106f,
+	-0.972939968f, -0.972939968f, -0.972939968f, -0.972939968f,
+	 0.972939968f,  0.972939968f,  0.972939968f,  0.972939968f,
+	 0.231058106f,  0.231058106f,  0.231058106f,  0.231058106f,
+	 0.784556568f,  0.784556568f, -0.620057225f, -0.620057225f,
+	 0.116318628f,  0.116318628f, -0.993211925f, -0.993211925f,
+	 0.620057225f,  0.620057225f,  0.784556568f,  0.784556568f,
+	 0.993211925f,  0.993211925f,  0.116318628f,  0.116318628f,
+	 0.944604814f,  0.435857087f, -0.328209847f, -0.900015891f,
+	 0.747100592f,  0.0582582653f, -0.664710999f, -0.998301566f,
+	 0.328209847f,  0.900015891f,  0.944604814f,  0.435857087f,
+	 0.664710999f,  0.998301566f,  0.747100592f,  0.0582582653f,
+	 0.937339008f,  0.937339008f,  0.937339008f,  0.937339008f,
+	-0.348418683f, -0.348418683f, -0.348418683f, -0.348418683f,
+	 0.348418683f,  0.348418683f,  0.348418683f,  0.348418683f,
+	 0.937339008f,  0.937339008f,  0.937339008f,  0.937339008f,
+	 0.984210074f,  0.984210074f, -0.177004218f, -0.177004218f,
+	 0.570780754f,  0.570780754f, -0.8211025f, -0.8211025f,
+	 0.177004218f,  0.177004218f,  0.984210074f,  0.984210074f,
+	 0.8211025f,  0.8211025f,  0.570780754f,  0.570780754f,
+	 0.996044695f,  0.641481042f, -0.0888535529f, -0.767138898f,
+	 0.886222541f,  0.299079835f, -0.463259786f, -0.954228103f,
+	 0.0888535529f,  0.767138898f,  0.996044695f,  0.641481042f,
+	 0.463259786f,  0.954228103f,  0.886222541f,  0.299079835f,
+	 0.416429549f,  0.416429549f,  0.416429549f,  0.416429549f,
+	-0.909168005f, -0.909168005f, -0.909168005f, -0.909168005f,
+	 0.909168005f,  0.909168005f,  0.909168005f,  0.909168005f,
+	 0.416429549f,  0.416429549f,  0.416429549f,  0.416429549f,
+	 0.841554999f,  0.841554999f, -0.540171444f, -0.540171444f,
+	 0.213110313f,  0.213110313f, -0.977028131f, -0.977028131f,
+	 0.540171444f,  0.540171444f,  0.841554999f,  0.841554999f,
+	 0.977028131f,  0.977028131f,  0.213110313f,  0.213110313f,
+	 0.95957154f,  0.479493767f, -0.281464934f, -0.877545297f,
+	 0.778816521f,  0.107172422f, -0.627251804f, -0.994240463f,
+	 0.281464934f,  0.877545297f,  0.95957154f,  0.479493767f,
+	 0.627251804f,  0.994240463f,  0.778816521f,  0.107172422f,
+	 0.732654274f,  0.732654274f,  0.732654274f,  0.732654274f,
+	-0.680601001f, -0.680601001f, -0.680601001f, -0.680601001f,
+	 0.680601001f,  0.680601001f,  0.680601001f,  0.680601001f,
+	 0.732654274f,  0.732654274f,  0.732654274f,  0.732654274f,
+	 0.93076694f,  0.93076694f, -0.365612984f, -0.365612984f,
+	 0.399624199f,  0.399624199f, -0.916679084f, -0.916679084f,
+	 0.365612984f,  0.365612984f,  0.93076694f,  0.93076694f,
+	 0.916679084f,  0.916679084f,  0.399624199f,  0.399624199f,
+	 0.982539296f,  0.563199341f, -0.186055154f, -0.826321065f,
+	 0.836547732f,  0.204108968f, -0.547894061f, -0.978948176f,
+	 0.186055154f,  0.826321065f,  0.982539296f,  0.563199341f,
+	 0.547894061f,  0.978948176f,  0.836547732f,  0.204108968f,
+	 0.0368072242f,  0.0368072242f,  0.0368072242f,  0.0368072242f,
+	-0.999322355f, -0.999322355f, -0.999322355f, -0.999322355f,
+	 0.999322355f,  0.999322355f,  0.999322355f,  0.999322355f,
+	 0.0368072242f,  0.0368072242f,  0.0368072242f,  0.0368072242f,
+	 0.720002532f,  0.720002532f, -0.693971455f, -0.693971455f,
+	 0.0184067301f,  0.0184067301f, -0.999830604f, -0.999830604f,
+	 0.693971455f,  0.693971455f,  0.720002532f,  0.720002532f,
+	 0.999830604f,  0.999830604f,  0.0184067301f,  0.0184067301f,
+	 0.927362502f,  0.391170382f, -0.374164075f, -0.920318305f,
+	 0.71358484f,  0.00920375437f, -0.700568795f, -0.999957621f,
+	 0.374164075f,  0.920318305f,  0.927362502f,  0.391170382f,
+	 0.700568795f,  0.999957621f,  0.71358484f,  0.00920375437f
+};
+
 #else // yyyFPNATIVE+0 yyyFPEMU+0
 
 #error No FP implementation selected
@@ -115,6 +115,34 @@ typedef uint64_t fpr;
  * increment in the value for proper rounding.
  */
 
+#if FALCON_FPEMU64 // yyyFPEMU64+1
+
+/*
+ * On 64-bit hosts, shifts of 64-bit values by a secret count are
+ * single constant-time opcodes.
+ *
+ * Shift count n MUST be in the 0..63 range.
+ */
+static inline uint64_t
+fpr_ursh(uint64_t x, int n)
+{
+	return x >> n;
+}
+
+static inline int64_t
+fpr_irsh(int64_t x, int n)
+{
+	return x >> n;
+}
+
+static inline uint64_t
+fpr_ulsh(uint64_t x, int n)
+{
+	return x << n;
+}
+
+#else // yyyFPEMU64+0
+
 /*
  * Right-shift a 64-bit unsigned value by a possibly secret shift count.
  * We assumed that the underlying architecture had a barrel shifter for
@@ -157,6 +185,8 @@ fpr_ulsh(uint64_t x, int n)
 	return x << (n & 31);
 }
 
+#endif // yyyFPEMU64-
+
 /*
  * Expectations:
  *   s = 0 or 1
@@ -930,6 +960,18 @@ extern const fpr fpr_gm_tab[];
 #define fpr_p2_tab   Zf(fpr_p2_tab)
 extern const fpr fpr_p2_tab[];
 
+#define fpr_gm_tail9   Zf(fpr_gm_tail9)
+extern const fpr fpr_gm_tail9[];
+
+#define fpr_gm_tail10   Zf(fpr_gm_tail10)
+extern const fpr fpr_gm_tail10[];
+
+#define fpr_gm32_tail9   Zf(fpr_gm32_tail9)
+extern const float fpr_gm32_tail9[];
+
+#define fpr_gm32_tail10   Zf(fpr_gm32_tail10)
+extern const float fpr_gm32_tail10[];
+
 /* ====================================================================== */
 
 #else  // yyyFPEMU+0 yyyFPNATIVE+0
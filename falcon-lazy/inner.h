@@ -84,6 +84,38 @@
 #include <stdlib.h>
 #include <string.h>
 
+/*
+ * With runtime dispatch, the SIMD level is set per compilation unit:
+ * the kernel copies (kern_avx2.c, kern_avx512.c) define
+ * FALCON_KERNEL_LEVEL, everything else is portable code.
+ */
+#if defined FALCON_DISPATCH && FALCON_DISPATCH
+#if !defined __GNUC__ || !(defined __x86_64__ || defined __i386__)
+#error FALCON_DISPATCH requires GCC or Clang on x86
+#endif
+#undef FALCON_AVX2
+#undef FALCON_FMA
+#undef FALCON_AVX512
+#if defined FALCON_KERNEL_LEVEL && FALCON_KERNEL_LEVEL >= 2
+#define FALCON_AVX2   1
+#define FALCON_FMA   1
+#endif
+#if defined FALCON_KERNEL_LEVEL && FALCON_KERNEL_LEVEL >= 3
+#define FALCON_AVX512   1
+#endif
+#endif
+
+/*
+ * The AVX-512 code paths extend the AVX2 ones (with FMA): the widest
+ * loops use 512-bit registers, the others keep the AVX2 code.
+ */
+#if defined FALCON_AVX512 && FALCON_AVX512
+#undef FALCON_AVX2
+#define FALCON_AVX2   1
+#undef FALCON_FMA
+#define FALCON_FMA   1
+#endif
+
 #if defined FALCON_AVX2 && FALCON_AVX2 // yyyAVX2+1
 /*
  * This implementation uses AVX2 and optionally FMA intrinsics.
@@ -96,7 +128,9 @@
 #define FALCON_UNALIGNED   1
 #endif
 #if defined __GNUC__
-#if defined FALCON_FMA && FALCON_FMA
+#if defined FALCON_AVX512 && FALCON_AVX512
+#define TARGET_AVX2   __attribute__((target("avx512f,avx512dq,avx2,fma")))
+#elif defined FALCON_FMA && FALCON_FMA
 #define TARGET_AVX2   __attribute__((target("avx2,fma")))
 #else
 #define TARGET_AVX2   __attribute__((target("avx2")))
@@ -107,9 +141,17 @@
 #if defined FALCON_FMA && FALCON_FMA
 #define FMADD(a, b, c)   _mm256_fmadd_pd(a, b, c)
 #define FMSUB(a, b, c)   _mm256_fmsub_pd(a, b, c)
+#define FMADD_PS(a, b, c)   _mm256_fmadd_ps(a, b, c)
+#define FMSUB_PS(a, b, c)   _mm256_fmsub_ps(a, b, c)
 #else
 #define FMADD(a, b, c)   _mm256_add_pd(_mm256_mul_pd(a, b), c)
 #define FMSUB(a, b, c)   _mm256_sub_pd(_mm256_mul_pd(a, b), c)
+#define FMADD_PS(a, b, c)   _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#define FMSUB_PS(a, b, c)   _mm256_sub_ps(_mm256_mul_ps(a, b), c)
+#endif
+#if defined FALCON_AVX512 && FALCON_AVX512
+#define FMADD512(a, b, c)   _mm512_fmadd_pd(a, b, c)
+#define FMSUB512(a, b, c)   _mm512_fmsub_pd(a, b, c)
 #endif
 #endif // yyyAVX2-
 
@@ -137,6 +179,18 @@
 #endif
 // yyySUPERCOP-
 
+/*
+ * Use the x86-64 Keccak code (keccak_x64.h) on x86-64 with GCC or Clang
+ * (if it was not set before).
+ */
+#ifndef FALCON_KECCAK_X64
+#if defined __x86_64__ && defined __GNUC__ && !FALCON_ASM_CORTEXM4
+#define FALCON_KECCAK_X64   1
+#else
+#define FALCON_KECCAK_X64   0
+#endif
+#endif
+
 #if defined __i386__ || defined _M_IX86 \
 	|| defined __x86_64__ || defined _M_X64 || \
 	(defined _ARCH_PWR8 && \
@@ -221,6 +275,22 @@
 #if (FALCON_FPEMU && FALCON_FPNATIVE) || (!FALCON_FPEMU && !FALCON_FPNATIVE)
 #error Exactly one of FALCON_FPEMU and FALCON_FPNATIVE must be selected
 #endif
+#if defined FALCON_DISPATCH && FALCON_DISPATCH && FALCON_FPEMU
+#error FALCON_DISPATCH requires native floating-point (FALCON_FPNATIVE)
+#endif
+
+/*
+ * With emulated floating-point, use the 64-bit host variant (128-bit
+ * products, count of leading zeros) when the compiler provides it,
+ * unless the Cortex-M4 assembly is used.
+ */
+#ifndef FALCON_FPEMU64
+#if FALCON_FPEMU && !FALCON_ASM_CORTEXM4 && defined __SIZEOF_INT128__
+#define FALCON_FPEMU64   1
+#else
+#define FALCON_FPEMU64   0
+#endif
+#endif
 
 // yyySUPERCOP+0
 /*
@@ -277,9 +347,18 @@
 #ifndef FALCON_FMA
 #define FALCON_FMA   0
 #endif
+#ifndef FALCON_AVX512
+#define FALCON_AVX512   0
+#endif
+#ifndef FALCON_DISPATCH
+#define FALCON_DISPATCH   0
+#endif
 #ifndef FALCON_KG_CHACHA20
 #define FALCON_KG_CHACHA20   0
 #endif
+#ifndef FALCON_LAZY_F32
+#define FALCON_LAZY_F32   0
+#endif
 // yyyNIST- yyyPQCLEAN-
 
 // yyyPQCLEAN+0 yyySUPERCOP+0
@@ -295,6 +374,25 @@
 #define Zf__(prefix, name)   prefix ## _ ## name  
 // yyyPQCLEAN- yyySUPERCOP-
 
+/*
+ * Naming macro for the definitions of dispatched kernels. Without
+ * runtime dispatch, this is Zf(). With FALCON_DISPATCH, each copy of a
+ * kernel gets a backend suffix (e.g. Zf(FFT_avx2)), and the Zf() name
+ * is a stub that calls the selected copy (see dispatch.c). Copies
+ * compiled without FALCON_KERNEL are the portable ones ("ref").
+ */
+#if FALCON_DISPATCH
+#ifdef FALCON_KERNEL
+#define Zk(name)   Zk_(FALCON_PREFIX, name, FALCON_KERNEL)
+#else
+#define Zk(name)   Zk_(FALCON_PREFIX, name, ref)
+#endif
+#define Zk_(prefix, name, k)    Zk__(prefix, name, k)
+#define Zk__(prefix, name, k)   prefix ## _ ## name ## _ ## k
+#else
+#define Zk(name)   Zf(name)
+#endif
+
 // yyyAVX2+1
 /*
  * We use the TARGET_AVX2 macro to tag some functions which, in some
@@ -434,6 +532,53 @@ void Zf(i_shake256_flip)(
 void Zf(i_shake256_extract)(
 	inner_shake256_context *sc, uint8_t *out, size_t len);
 
+/*
+ * Multi-buffer SHAKE256 output: up to INNER_SHAKE256_LANES instances
+ * are squeezed together, one 136-byte block per instance at a time,
+ * with a vectorized Keccak-f[1600] (4 instances per register with
+ * AVX2, 8 with AVX-512). The states are interleaved: word i of
+ * instance l is A[i * INNER_SHAKE256_LANES + l].
+ */
+#define INNER_SHAKE256_LANES   8
+
+typedef struct {
+	uint64_t A[25 * INNER_SHAKE256_LANES];
+	unsigned num;
+} inner_shake256_x_context;
+
+/*
+ * Initialize *sx with copies of the num contexts sc[0..num-1] (with
+ * 1 <= num <= INNER_SHAKE256_LANES). The contexts must have been flipped
+ * and not used for output yet; otherwise, 0 is returned and *sx is not
+ * usable. Returned value is 1 on success.
+ */
+int Zf(i_shake256_x_init)(inner_shake256_x_context *sx,
+	const inner_shake256_context *const *sc, unsigned num);
+
+/*
+ * Compute the next output block of each instance. Byte j (0 <= j < 136)
+ * of the block of instance l is then:
+ *   (sx->A[(j >> 3) * INNER_SHAKE256_LANES + l] >> ((j & 7) << 3)) & 0xFF
+ * The first call yields the same bytes as the first 136 bytes obtained
+ * with inner_shake256_extract() on the source context, and so on.
+ */
+void Zf(i_shake256_x_next)(inner_shake256_x_context *sx);
+
+/*
+ * Apply Keccak-f[1600] to the num first instances (num <= 8) of the
+ * interleaved states A[] (as in inner_shake256_x_context).
+ */
+void Zf(keccak_multi)(uint64_t *A, unsigned num);
+
+#if FALCON_KECCAK_X64
+/*
+ * Apply Keccak-f[1600] to the state A[] (25 words), with the x86-64
+ * code of keccak_x64.h. This is the permutation used by the SHAKE256
+ * functions above.
+ */
+void Zf(keccak_f1600)(uint64_t *A);
+#endif
+
 /*
 // yyyPQCLEAN+1
 
@@ -507,6 +652,25 @@ size_t Zf(trim_i8_decode)(int8_t *x, unsigned logn, unsigned bits,
 size_t Zf(comp_decode)(int16_t *x, unsigned logn,
 	const void *in, size_t max_in_len);
 
+/*
+ * Fixed-width field kernels used by the modq and trim functions (at
+ * most 14 bits per value). The values (n of them) are handled by blocks
+ * of 16 from the start, as long as the accesses stay within the
+ * in_len or out_len bytes of buf[]; the returned value is the number
+ * of processed values, and the caller finishes with the scalar code.
+ * Values for encoding must have been checked; on decoding, *bad is set
+ * to a non-zero value if one of them is invalid (modq: not lower than
+ * q; trim: -2^(bits-1)). These are dispatched kernels; the portable
+ * code handles no value.
+ */
+#define CODEC_MODQ   0
+#define CODEC_I16    1
+#define CODEC_I8     2
+size_t Zf(codec_unpack)(void *x, size_t n, unsigned bits, int kind,
+	const uint8_t *buf, size_t in_len, int *bad);
+size_t Zf(codec_pack)(uint8_t *buf, size_t out_len, unsigned bits,
+	int kind, const void *x, size_t n);
+
 /*
  * Number of bits for key elements, indexed by logn (1 to 10). This
  * is at most 8 bits for all degrees, but some degrees may have shorter
@@ -547,6 +711,20 @@ void Zf(hash_to_point_vartime)(inner_shake256_context *sc,
 void Zf(hash_to_point_ct)(inner_shake256_context *sc,
 	uint16_t *x, unsigned logn, uint8_t *tmp);
 
+/*
+ * Hash num messages to points: x[i] receives the point for the context
+ * sc[i] (already flipped), as Zf(hash_to_point_ct)() (if ct is non-zero)
+ * or Zf(hash_to_point_vartime)() would produce. The SHAKE256 outputs of
+ * up to INNER_SHAKE256_LANES contexts are computed together (see
+ * Zf(i_shake256_x_init)()). The contexts are consumed.
+ *
+ * If ct is non-zero, tmp[] must have room for 2*2^logn bytes per
+ * context, up to INNER_SHAKE256_LANES contexts (i.e. 16*2^logn bytes
+ * at most), with 16-bit alignment; otherwise, tmp is not used.
+ */
+void Zf(hash_to_point_batch)(inner_shake256_context *const *sc,
+	uint16_t *const *x, size_t num, unsigned logn, int ct, uint8_t *tmp);
+
 /*
  * Tell whether a given vector (2N coordinates, in two halves) is
  * acceptable as a signature. This compares the appropriate norm of the
@@ -555,6 +733,14 @@ void Zf(hash_to_point_ct)(inner_shake256_context *sc,
  */
 int Zf(is_short)(const int16_t *s1, const int16_t *s2, unsigned logn);
 
+/*
+ * Tell whether a vector is acceptable as a signature (with the same
+ * bound as Zf(is_short)()), given its saturated squared norm sqn (the
+ * sum of the squares of all its coordinates, saturated at 2^32-1 if it
+ * exceeds 2^31-1). Returned value is 1 on success, 0 otherwise.
+ */
+int Zf(is_short_sqnorm)(uint32_t sqn, unsigned logn);
+
 /*
  * Tell whether a given vector (2N coordinates, in two halves) is
  * acceptable as a signature. Instead of the first half s1, this
@@ -592,6 +778,28 @@ void Zf(to_ntt_monty)(uint16_t *h, unsigned logn);
 int Zf(verify_raw)(const uint16_t *c0, const int16_t *s2,
 	const uint16_t *h, unsigned logn, uint8_t *tmp);
 
+/*
+ * Maximum number of signatures processed together by
+ * Zf(verify_raw_batch)().
+ */
+#define INNER_VERIFY_LANES   16
+
+/*
+ * Batch version of Zf(verify_raw)(): signature l (0 <= l < num, with
+ * num <= INNER_VERIFY_LANES) is (c0[l], s2[l]), and all signatures are
+ * verified against the same public key h[] (NTT + Montgomery format).
+ * res[l] is set to 1 if signature l is valid, 0 otherwise.
+ *
+ * With AVX2, the signatures are verified together, in transposed form:
+ * each 256-bit register holds the same coefficient of all the lanes.
+ * This is a dispatched kernel.
+ *
+ * tmp[] must have room for 32*2^logn bytes, with 16-bit alignment.
+ */
+void Zf(verify_raw_batch)(const uint16_t *const *c0,
+	const int16_t *const *s2, const uint16_t *h, unsigned logn,
+	int *res, size_t num, uint8_t *tmp);
+
 /*
  * Compute the public key h[], given the private key elements f[] and
  * g[]. This computes h = g/f mod phi mod q, where phi is the polynomial
@@ -740,6 +948,14 @@ int Zf(verify_recover)(uint16_t *h,
  *   const fpr fpr_p2_tab[]
  *         precomputed powers of 2 (by index, 0 to 10)
  *
+ *   const fpr fpr_gm_tail9[], fpr_gm_tail10[]
+ *         twiddle factors of the last FFT layers, in AVX2 access
+ *         order (native implementation only)
+ *
+ *   const float fpr_gm32_tail9[], fpr_gm32_tail10[]
+ *         same for the single-precision FFT (native implementation
+ *         only)
+ *
  * Constants of type 'fpr':
  *
  *   fpr fpr_q                 12289
@@ -798,6 +1014,20 @@ typedef struct {
 		uint64_t dummy_u64;
 	} state;
 	int type;
+#if FALCON_AVX512 || FALCON_DISPATCH
+	/*
+	 * The AVX-512 refill runs sixteen ChaCha20 instances at once;
+	 * the second half of the output is kept here and handed out on
+	 * the next refill, so that the byte stream matches the AVX2 one.
+	 * With runtime dispatch, all backends honour the reserve, so the
+	 * backend may change between two refills.
+	 */
+	union {
+		uint8_t d[512];
+		uint64_t dummy_u64;
+	} next;
+	int next_ok;
+#endif
 } prng;
 
 /*
@@ -901,6 +1131,15 @@ void Zf(FFT)(fpr *f, unsigned logn);
  */
 void Zf(iFFT)(fpr *f, unsigned logn);
 
+/*
+ * Zf(FFT)() and Zf(iFFT)() use transforms specialized at compile time
+ * for logn = 9 and 10, and the following generic functions for the
+ * other degrees. Both versions return the exact same values; the
+ * generic functions are exported so that this can be tested.
+ */
+void Zf(FFT_generic)(fpr *f, unsigned logn);
+void Zf(iFFT_generic)(fpr *f, unsigned logn);
+
 /*
  * Add polynomial b to polynomial a. a and b MUST NOT overlap. This
  * function works in both normal and FFT representations.
@@ -1031,6 +1270,87 @@ void Zf(poly_split_fft)(fpr *restrict f0, fpr *restrict f1,
 void Zf(poly_merge_fft)(fpr *restrict f,
 	const fpr *restrict f0, const fpr *restrict f1, unsigned logn);
 
+/*
+ * Interleaved variants of Zf(FFT), Zf(iFFT) and Zf(poly_mul_fft), which
+ * process four polynomials at once. Element j of polynomial l (0 to 3)
+ * is in slot 4*j+l, so each array has 4*2^logn elements. For the
+ * multiplication, b[] is a single (non-interleaved) polynomial, used
+ * for all four. Results are bit-for-bit identical to four calls to
+ * the one-polynomial functions. Element-wise operations (poly_add(),
+ * poly_mulconst()...) apply directly to interleaved arrays with logn+2.
+ */
+void Zf(FFT_x4)(fpr *f, unsigned logn);
+void Zf(iFFT_x4)(fpr *f, unsigned logn);
+void Zf(poly_mul_fft_x4)(fpr *restrict a, const fpr *restrict b,
+	unsigned logn);
+
+/*
+ * Interleaved basis. The FFT representations of f, g, F and G, for the
+ * basis B = [[g, f], [G, F]], are stored per group of w = min(4, n/2)
+ * consecutive frequency slots, as w real parts of f, w imaginary parts
+ * of f, then the same for g, F and G (8*w values per group, 4*2^logn in
+ * total), so that the two-row products below read the key in a single
+ * sequential pass. Component k is 0 for f, 1 for g, 2 for F, 3 for G.
+ */
+#define BASIS_F   0
+#define BASIS_G   1
+#define BASIS_BF  2
+#define BASIS_BG  3
+
+/*
+ * Store polynomial a (FFT representation) as component k of the
+ * interleaved basis B.
+ */
+void Zf(poly_basis_set)(fpr *restrict B, const fpr *restrict a,
+	int k, unsigned logn);
+
+/*
+ * First Babai step: on input, y1 holds t (FFT representation); on
+ * output, (y1, y2) = (t, 0)*B^(-1) = t*(-F, f)/q. Results are the same
+ * as with Zf(poly_mul_fft)(), Zf(poly_neg)() and Zf(poly_mulconst)().
+ */
+void Zf(poly_basis_solve_fft)(fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn);
+
+/*
+ * Multiply the row vector (y1, y2) by B (FFT representation):
+ * (y1, y2) <- (g*y1 + G*y2, f*y1 + F*y2). Results are the same as with
+ * Zf(poly_mul_fft)() and Zf(poly_add)().
+ */
+void Zf(poly_basis_mul_fft)(fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn);
+
+/*
+ * Second half only of Zf(poly_basis_mul_fft)(): y2 <- f*y1 + F*y2; y1
+ * is unmodified.
+ */
+void Zf(poly_basis_mul2_fft)(const fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn);
+
+/*
+ * Same as Zf(poly_basis_mul2_fft)(), on four interleaved pairs (y1, y2)
+ * (see Zf(FFT_x4)()); B is a single basis, used for all four.
+ */
+void Zf(poly_basis_mul2_fft_x4)(const fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn);
+
+#if FALCON_FPNATIVE
+/*
+ * Single-precision versions of Zf(FFT)(), Zf(iFFT)(),
+ * Zf(poly_basis_mul_fft)() and Zf(poly_basis_mul2_fft)(), with the same
+ * layout (the basis B is still made of fpr values). They are used for
+ * the reduction against the basis in the lazy online phase (LAZY_F32);
+ * results are only approximate (about 24 bits of precision), and may
+ * differ between backends. Native floating-point only.
+ */
+void Zf(FFT32)(float *f, unsigned logn);
+void Zf(iFFT32)(float *f, unsigned logn);
+void Zf(poly_basis_mul_fft32)(float *restrict y1, float *restrict y2,
+	const fpr *restrict B, unsigned logn);
+void Zf(poly_basis_mul2_fft32)(const float *restrict y1,
+	float *restrict y2, const fpr *restrict B, unsigned logn);
+#endif
+
 /* ==================================================================== */
 /*
  * Key pair generation.
@@ -1131,6 +1451,12 @@ void Zf(sign_dyn)(int16_t *sig, inner_shake256_context *rng,
 	const int8_t *restrict F, const int8_t *restrict G,
 	const uint16_t *hm, unsigned logn, uint8_t *tmp);
 
+/*
+ * Lazy signature (offline and online phases in one call) with the basis
+ * (f, g, F, G) and the public key h (plain format). The tmp[] buffer
+ * must have room for 68*2^logn bytes, with 64-bit alignment; no other
+ * large storage is used.
+ */
 void Zf(sign_dyn_lazy)(int16_t *sig, inner_shake256_context *rng,
 	const int8_t *restrict f, const int8_t *restrict g,
 	const int8_t *restrict F, const int8_t *restrict G,
@@ -1142,11 +1468,280 @@ void Zf(mq_poly_addto)(
         uint16_t *dest, const uint16_t* a, unsigned logn);
 
 
-void mq_NTT(uint16_t *a, unsigned logn);
+/*
+ * NTT modulo q (vrfy.c), on values in 0..q-1: forward and inverse
+ * transforms, Montgomery multiplication in NTT representation
+ * (f <- f*g/R), and conversion to Montgomery representation
+ * (f <- f*R). These are dispatched kernels; the AVX2 code handles
+ * logn >= 5 for the transforms, logn >= 4 for the products.
+ */
+void Zf(mq_NTT)(uint16_t *a, unsigned logn);
+void Zf(mq_iNTT)(uint16_t *a, unsigned logn);
+void Zf(mq_poly_montymul_ntt)(uint16_t *f, const uint16_t *g, unsigned logn);
+void Zf(mq_poly_tomonty)(uint16_t *f, unsigned logn);
+
+/*
+ * Lazy (online/offline) signature generation.
+ *
+ * The offline phase draws a one-time "token": a pair of small Gaussian
+ * polynomials (sample1, sample2) and the target
+ * sample_target = sample1 - h*sample2 mod q. The online phase only needs
+ * a token, the basis in FFT representation and the hashed message. A
+ * token MUST NOT be used for more than one signature; the online phase
+ * consumes it (sample_target is modified in place).
+ */
+
+/*
+ * Draw the Gaussian blinding pair (n coefficients each), with
+ * randomness from the provided PRNG. Random bytes are obtained in bulk,
+ * in amounts sized to the expected rejection rate (about 26*2n*3/2
+ * bytes in total).
+ */
+void sample_gaussian_poly_bern(prng *p,
+	int8_t *sample1, int8_t *sample2, size_t n);
+
+/*
+ * Batched Bernoulli/CDT sampler: evaluate BERN_BLOCK candidates from
+ * BERN_BLOCK_BYTES random bytes (three 64-bit words, then two bytes
+ * per candidate) and write the accepted ones, as int8, at the start of
+ * out (BERN_BLOCK bytes). Returned value is the number of accepted
+ * samples. Rejection and output compaction are branchless.
+ */
+#define BERN_BLOCK         16
+#define BERN_BLOCK_BYTES   (26 * BERN_BLOCK)
+size_t Zf(sample_bern_block)(int8_t *out, const uint8_t *rnd);
+
+/*
+ * Compute res = x0 - h*x1 mod q, with h in NTT + Montgomery format.
+ */
+void compute_target(const uint16_t *h_monty, const int8_t *x0,
+	const int8_t *x1, uint16_t *res, unsigned logn);
+
+/*
+ * Offline phase: convert the basis to FFT representation (written in
+ * B_fft, interleaved, see Zf(poly_basis_set)()) and draw one token.
+ * The public key h is in plain (not NTT) format. B_fft[] has room for
+ * 4*2^logn fpr values, tmp[] for 2^logn. If B_fft is NULL, only the
+ * token is computed (for sign_dyn_lazy_online_int()).
+ */
+void sign_dyn_lazy_offline(inner_shake256_context *rng,
+	const int8_t *restrict f, const int8_t *restrict g,
+	const int8_t *restrict F, const int8_t *restrict G,
+	const uint16_t *h, unsigned logn,
+	int8_t *sample1, int8_t *sample2, uint16_t *sample_target,
+	fpr *restrict B_fft, fpr *restrict tmp);
+
+/*
+ * Online phase: compute the signature s2 from a token and the hashed
+ * message hm. Returned value is 1 if the signer-side norm bound is met,
+ * 0 otherwise (s2 is written in both cases). tmp[] must have room for
+ * 4*2^logn fpr values.
+ */
+int sign_dyn_lazy_online(int8_t *sample1, int8_t *sample2,
+	uint16_t *sample_target, int16_t *s2, const fpr *restrict B_fft,
+	const uint16_t *hm, unsigned logn, fpr *restrict tmp);
+
+/*
+ * Short preimage of target: with y = (target, 0)*B^-1, the two halves
+ * of round((y - round(y))*B) are written in res1 and res2. B_fft is the
+ * interleaved basis. tmp[] must have room for 2*2^logn fpr values;
+ * res1 and res2 must not overlap with it.
+ */
+void short_preimage(const uint16_t *target, const fpr *restrict B_fft,
+	int32_t *res1, int32_t *res2, unsigned logn, fpr *restrict tmp);
+
+/*
+ * Integer-only variant of the online phase (sign_int.c), for targets
+ * without a floating-point unit: the preimage is computed exactly with
+ * NTT modulo q and modulo a 31-bit prime, and the result is the same as
+ * that of short_preimage() (see sign_int.c for the bounds). Only logn
+ * <= 10 is supported.
+ *
+ * The integer basis Bi is computed once per key, with
+ * sign_dyn_lazy_basis_int(); its size is LAZY_IBASIS_SIZE(logn) bytes,
+ * with 32-bit alignment. The tokens are those of sign_dyn_lazy_offline()
+ * (which may then be called with B_fft == NULL).
+ */
+#define LAZY_IBASIS_SIZE(logn)   ((size_t)28 << (logn))
+
+void sign_dyn_lazy_basis_int(uint32_t *restrict Bi,
+	const int8_t *restrict f, const int8_t *restrict g,
+	const int8_t *restrict F, const int8_t *restrict G, unsigned logn);
+
+/*
+ * Same as short_preimage(), with the integer basis. tmp[] must have room
+ * for 4*2^logn 32-bit words; res1 and res2 must not overlap with it.
+ */
+void short_preimage_int(const uint16_t *target, const uint32_t *restrict Bi,
+	int32_t *res1, int32_t *res2, unsigned logn, uint32_t *restrict tmp);
+
+/*
+ * Same as sign_dyn_lazy_online(), with the integer basis. tmp[] must
+ * have room for 6*2^logn 32-bit words.
+ */
+int sign_dyn_lazy_online_int(int8_t *sample1, int8_t *sample2,
+	uint16_t *sample_target, int16_t *s2, const uint32_t *restrict Bi,
+	const uint16_t *hm, unsigned logn, uint32_t *restrict tmp);
+
+/*
+ * Lazy expanded key. It contains, in that order:
+ *   B_fft                        the basis, FFT, interleaved (4*2^logn)
+ *   mFq_fft, fq_fft              -F/q and f/q, in FFT representation
+ *   h_monty                      the public key, NTT + Montgomery
+ * i.e. LAZY_EXPKEY_FPR(logn) fpr values followed by 2^logn 16-bit
+ * words; LAZY_EXPKEY_SIZE(logn) is the total size in bytes.
+ */
+#define LAZY_EXPKEY_FPR(logn)    ((size_t)6 << (logn))
+#define LAZY_EXPKEY_SIZE(logn)   ((size_t)50 << (logn))
+
+/*
+ * Compute a lazy expanded key from the private key (f, g, F, G) and
+ * the public key h (plain format).
+ */
+void Zf(lazy_expand_key)(fpr *restrict expkey,
+	const int8_t *f, const int8_t *g,
+	const int8_t *F, const int8_t *G,
+	const uint16_t *h, unsigned logn);
+
+/*
+ * Offline phase with a lazy expanded key: draw one token. The Gaussian
+ * samples use a ChaCha20-based PRNG seeded from rng (flipped state).
+ *
+ * Besides the two Gaussian samples, the token holds the first Babai
+ * step applied to the target t = sample1 + sample2*h mod q, i.e.
+ * FFT(t)*(-F/q) in yt[0..n-1] and FFT(t)*(f/q) in yt[n..2n-1], so
+ * that the online phase only transforms the message-derived part. The
+ * yt[] array must have room for 2*2^logn elements.
+ */
+void Zf(sign_lazy_offline)(inner_shake256_context *rng,
+	const fpr *restrict expkey,
+	int8_t *sample1, int8_t *sample2, fpr *restrict yt,
+	unsigned logn);
+
+/*
+ * Signer-side norm check in Zf(sign_lazy_online)():
+ *   LAZY_NORM_FULL   both halves of the preimage are computed in
+ *                    floating-point (3 FFT + 4 iFFT)
+ *   LAZY_NORM_NTT    only s2 is computed in floating-point (3 FFT +
+ *                    3 iFFT); the norm of s1 = hm - s2*h mod q is
+ *                    obtained with one NTT and one iNTT
+ *   LAZY_NORM_SKIP   only s2 is computed, and the norm is not checked
+ *                    (the verifier checks it anyway)
+ * The value of s2 is the same in all three modes.
+ */
+#define LAZY_NORM_FULL   0
+#define LAZY_NORM_NTT    1
+#define LAZY_NORM_SKIP   2
+
+/*
+ * Flag for the 'norm' parameter of Zf(sign_lazy_online)(): do the
+ * reduction against the basis (two FFT, the basis product and the last
+ * iFFT) in single precision, with Zf(FFT32)() and related functions.
+ * If a value is too close to a rounding boundary for the float result
+ * to be trusted, the reduction is redone in double precision; the
+ * signature is always the same as without the flag. It is ignored
+ * without native floating-point.
+ */
+#define LAZY_F32         0x100
+
+/*
+ * Online phase with a lazy expanded key: compute the signature s2 from
+ * a token and the hashed message hm. The token is only read; the
+ * caller is responsible for discarding it. The tmp[] array must have
+ * room for 4*2^logn elements. 'norm' is one of the LAZY_NORM_*
+ * values, optionally combined with LAZY_F32. Returned value is 1 if
+ * the signer-side norm bound is met (or not checked), 0 otherwise (s2
+ * is written in both cases).
+ *
+ * The FFT work is FFT(hm) and two iFFT for the first Babai step, then
+ * two FFT and two iFFT (one with LAZY_NORM_NTT or LAZY_NORM_SKIP) for
+ * the reduction against the basis (see sign.c).
+ */
+int Zf(sign_lazy_online)(int16_t *restrict s2, const fpr *restrict expkey,
+	const int8_t *sample1, const int8_t *sample2,
+	const fpr *restrict yt, const uint16_t *hm,
+	unsigned logn, int norm, fpr *restrict tmp);
+
+/*
+ * Number of signatures computed at once by Zf(sign_lazy_online_batch)().
+ */
+#define LAZY_BATCH   4
+
+/*
+ * Batched online phase: compute LAZY_BATCH signatures at once, with
+ * the same expanded key. For lane l, the token is sample2[l] and yt[l],
+ * the hashed message is hm[l], and the signature is written in s2[l];
+ * the same inputs may be used for several lanes. The work area is
+ * interleaved (see Zf(FFT_x4)) so that each vector instruction handles
+ * all lanes. Only s2 is computed (as with LAZY_NORM_SKIP), and the
+ * result is identical to that of Zf(sign_lazy_online)(). The tmp[]
+ * array must have room for 8*2^logn elements.
+ */
+void Zf(sign_lazy_online_batch)(int16_t *const *s2,
+	const fpr *restrict expkey,
+	const int8_t *const *sample2, const fpr *const *yt,
+	const uint16_t *const *hm, unsigned logn, fpr *restrict tmp);
+
+/*
+ * Lazy signatures are somewhat longer than plain Falcon signatures, so
+ * the PADDED format fails much more often (for logn = 10, most of the
+ * time). The signers that draw their own tokens (presignature pool,
+ * token store, signing context) retry with a new token, and spend at
+ * most LAZY_PADDED_MAX_TRIES tokens on a single PADDED signature.
+ */
+#define LAZY_PADDED_MAX_TRIES   16
+
+/*
+ * Check the output buffer (of size sig_len bytes) and signature type
+ * for a lazy signature of degree 2^logn. Returned value is 0, or
+ * FALCON_ERR_SIZE or FALCON_ERR_BADARG (see falcon.h).
+ */
+int Zf(lazy_check_sig)(size_t sig_len, int sig_type, unsigned logn);
+
+/*
+ * Check that the lazy expanded key (falcon_lazy_expand_key() format)
+ * was made for the public key pubkey[] (of size pubkey_len bytes).
+ * Returned value is 0 if it was, FALCON_ERR_BADARG if the keys do not
+ * match, and FALCON_ERR_FORMAT if the public key cannot be decoded.
+ * tmp[] must have room for 2*2^logn+1 bytes.
+ */
+int Zf(lazy_check_pubkey)(const void *expanded_key,
+	const void *pubkey, size_t pubkey_len, void *tmp);
+
+/*
+ * Decode the public key pubkey[] (of size pubkey_len bytes, degree
+ * 2^logn) into h[] (2^logn elements), in NTT + Montgomery
+ * representation, as stored in the lazy expanded key. Returned value
+ * is 0 on success, or FALCON_ERR_FORMAT.
+ */
+int Zf(lazy_decode_pubkey)(uint16_t *h,
+	const void *pubkey, size_t pubkey_len, unsigned logn);
+
+/*
+ * Get the public key h (NTT + Montgomery representation, 2^logn
+ * elements) held in a lazy expanded key.
+ */
+const uint16_t *Zf(lazy_expkey_h)(const void *expanded_key);
 
-void mq_iNTT(uint16_t *a, unsigned logn);
+/*
+ * Callback that provides a fresh token to Zf(lazy_sign_tokens)(): on
+ * success, *token is set and 0 is returned; otherwise, an error code
+ * (see falcon.h) is returned.
+ */
+typedef int (*lazy_token_source)(void *arg, uint8_t **token);
 
-void mq_poly_montymul_ntt(uint16_t *f, const uint16_t *g, unsigned logn);
+/*
+ * Sign with falcon_sign_lazy_online() (same parameters), with tokens
+ * of token_len bytes obtained from next_token(arg). The output buffer
+ * is checked before any token is obtained; a PADDED signature that
+ * does not fit is retried with another token, up to
+ * LAZY_PADDED_MAX_TRIES tokens (FALCON_ERR_SIZE is returned after
+ * that).
+ */
+int Zf(lazy_sign_tokens)(void *sig, size_t *sig_len, int sig_type,
+	const void *expanded_key, unsigned logn,
+	lazy_token_source next_token, void *arg, size_t token_len,
+	const void *data, size_t data_len, void *tmp, size_t tmp_len);
 
 /*
  * Internal sampler engine. Exported for tests.
@@ -0,0 +1,207 @@
+/*
+ * Keccak-f[1600] permutation for x86-64 (one state).
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+/*
+ * This file is shared by the Falcon code (shake.c) and the Dilithium
+ * code (dilithium-pqm4/keccakf1600.c). It depends only on <stdint.h>,
+ * and defines keccak_x64_f1600() as a static inline function, which
+ * applies the permutation to a state of 25 words in the normal
+ * representation (word x + 5*y is lane (x, y)).
+ *
+ * Each round reads the state from one set of 25 local variables and
+ * writes the other set, so that pi is only a renaming; two rounds are
+ * computed per loop iteration. Chi is written as a ^ (~b & c): when the
+ * code is compiled for BMI1 and BMI2 (-mbmi -mbmi2, or inlined into a
+ * function with the target("bmi,bmi2") attribute), this is one ANDN
+ * and one XOR, and the rotations are RORX, which leave their source
+ * intact. On x86-64 without BMI, this is about as fast as the usual
+ * representation with inverted words (which saves the NOT in chi);
+ * with BMI, about 20% faster.
+ */
+
+#ifndef KECCAK_X64_H__
+#define KECCAK_X64_H__
+
+#include <stdint.h>
+
+static const uint64_t KECCAK_X64_RC[24] = {
+	0x0000000000000001, 0x0000000000008082,
+	0x800000000000808A, 0x8000000080008000,
+	0x000000000000808B, 0x0000000080000001,
+	0x8000000080008081, 0x8000000000008009,
+	0x000000000000008A, 0x0000000000000088,
+	0x0000000080008009, 0x000000008000000A,
+	0x000000008000808B, 0x800000000000008B,
+	0x8000000000008089, 0x8000000000008003,
+	0x8000000000008002, 0x8000000000000080,
+	0x000000000000800A, 0x800000008000000A,
+	0x8000000080008081, 0x8000000000008080,
+	0x0000000080000001, 0x8000000080008008
+};
+
+#define KECCAK_X64_ROL(x, n)   (((x) << (n)) | ((x) >> (64 - (n))))
+
+/*
+ * One round, from the variables prefixed with A to the variables
+ * prefixed with E (lane names: rows b, g, k, m, s for y = 0 to 4,
+ * columns a, e, i, o, u for x = 0 to 4). Each output row takes its
+ * five lanes from a diagonal of the input (theta, rho and pi), then
+ * applies chi; rc is the round constant (iota).
+ */
+#define KECCAK_X64_ROUND(A, E, rc)   do { \
+	c0 = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa; \
+	c1 = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se; \
+	c2 = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si; \
+	c3 = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so; \
+	c4 = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su; \
+	d0 = c4 ^ KECCAK_X64_ROL(c1, 1); \
+	d1 = c0 ^ KECCAK_X64_ROL(c2, 1); \
+	d2 = c1 ^ KECCAK_X64_ROL(c3, 1); \
+	d3 = c2 ^ KECCAK_X64_ROL(c4, 1); \
+	d4 = c3 ^ KECCAK_X64_ROL(c0, 1); \
+	b0 = A##ba ^ d0; \
+	b1 = KECCAK_X64_ROL(A##ge ^ d1, 44); \
+	b2 = KECCAK_X64_ROL(A##ki ^ d2, 43); \
+	b3 = KECCAK_X64_ROL(A##mo ^ d3, 21); \
+	b4 = KECCAK_X64_ROL(A##su ^ d4, 14); \
+	E##ba = b0 ^ (~b1 & b2) ^ (rc); \
+	E##be = b1 ^ (~b2 & b3); \
+	E##bi = b2 ^ (~b3 & b4); \
+	E##bo = b3 ^ (~b4 & b0); \
+	E##bu = b4 ^ (~b0 & b1); \
+	b0 = KECCAK_X64_ROL(A##bo ^ d3, 28); \
+	b1 = KECCAK_X64_ROL(A##gu ^ d4, 20); \
+	b2 = KECCAK_X64_ROL(A##ka ^ d0, 3); \
+	b3 = KECCAK_X64_ROL(A##me ^ d1, 45); \
+	b4 = KECCAK_X64_ROL(A##si ^ d2, 61); \
+	E##ga = b0 ^ (~b1 & b2); \
+	E##ge = b1 ^ (~b2 & b3); \
+	E##gi = b2 ^ (~b3 & b4); \
+	E##go = b3 ^ (~b4 & b0); \
+	E##gu = b4 ^ (~b0 & b1); \
+	b0 = KECCAK_X64_ROL(A##be ^ d1, 1); \
+	b1 = KECCAK_X64_ROL(A##gi ^ d2, 6); \
+	b2 = KECCAK_X64_ROL(A##ko ^ d3, 25); \
+	b3 = KECCAK_X64_ROL(A##mu ^ d4, 8); \
+	b4 = KECCAK_X64_ROL(A##sa ^ d0, 18); \
+	E##ka = b0 ^ (~b1 & b2); \
+	E##ke = b1 ^ (~b2 & b3); \
+	E##ki = b2 ^ (~b3 & b4); \
+	E##ko = b3 ^ (~b4 & b0); \
+	E##ku = b4 ^ (~b0 & b1); \
+	b0 = KECCAK_X64_ROL(A##bu ^ d4, 27); \
+	b1 = KECCAK_X64_ROL(A##ga ^ d0, 36); \
+	b2 = KECCAK_X64_ROL(A##ke ^ d1, 10); \
+	b3 = KECCAK_X64_ROL(A##mi ^ d2, 15); \
+	b4 = KECCAK_X64_ROL(A##so ^ d3, 56); \
+	E##ma = b0 ^ (~b1 & b2); \
+	E##me = b1 ^ (~b2 & b3); \
+	E##mi = b2 ^ (~b3 & b4); \
+	E##mo = b3 ^ (~b4 & b0); \
+	E##mu = b4 ^ (~b0 & b1); \
+	b0 = KECCAK_X64_ROL(A##bi ^ d2, 62); \
+	b1 = KECCAK_X64_ROL(A##go ^ d3, 55); \
+	b2 = KECCAK_X64_ROL(A##ku ^ d4, 39); \
+	b3 = KECCAK_X64_ROL(A##ma ^ d0, 41); \
+	b4 = KECCAK_X64_ROL(A##se ^ d1, 2); \
+	E##sa = b0 ^ (~b1 & b2); \
+	E##se = b1 ^ (~b2 & b3); \
+	E##si = b2 ^ (~b3 & b4); \
+	E##so = b3 ^ (~b4 & b0); \
+	E##su = b4 ^ (~b0 & b1); \
+	} while (0)
+
+static inline void
+keccak_x64_f1600(uint64_t *A)
+{
+	uint64_t aba, abe, abi, abo, abu, aga, age, agi, ago, agu, aka;
+	uint64_t ake, aki, ako, aku, ama, ame, ami, amo, amu, asa, ase;
+	uint64_t asi, aso, asu;
+	uint64_t eba, ebe, ebi, ebo, ebu, ega, ege, egi, ego, egu, eka;
+	uint64_t eke, eki, eko, eku, ema, eme, emi, emo, emu, esa, ese;
+	uint64_t esi, eso, esu;
+	uint64_t c0, c1, c2, c3, c4, d0, d1, d2, d3, d4;
+	uint64_t b0, b1, b2, b3, b4;
+	int r;
+
+	aba = A[ 0];
+	abe = A[ 1];
+	abi = A[ 2];
+	abo = A[ 3];
+	abu = A[ 4];
+	aga = A[ 5];
+	age = A[ 6];
+	agi = A[ 7];
+	ago = A[ 8];
+	agu = A[ 9];
+	aka = A[10];
+	ake = A[11];
+	aki = A[12];
+	ako = A[13];
+	aku = A[14];
+	ama = A[15];
+	ame = A[16];
+	ami = A[17];
+	amo = A[18];
+	amu = A[19];
+	asa = A[20];
+	ase = A[21];
+	asi = A[22];
+	aso = A[23];
+	asu = A[24];
+	for (r = 0; r < 24; r += 2) {
+		KECCAK_X64_ROUND(a, e, KECCAK_X64_RC[r]);
+		KECCAK_X64_ROUND(e, a, KECCAK_X64_RC[r + 1]);
+	}
+	A[ 0] = aba;
+	A[ 1] = abe;
+	A[ 2] = abi;
+	A[ 3] = abo;
+	A[ 4] = abu;
+	A[ 5] = aga;
+	A[ 6] = age;
+	A[ 7] = agi;
+	A[ 8] = ago;
+	A[ 9] = agu;
+	A[10] = aka;
+	A[11] = ake;
+	A[12] = aki;
+	A[13] = ako;
+	A[14] = aku;
+	A[15] = ama;
+	A[16] = ame;
+	A[17] = ami;
+	A[18] = amo;
+	A[19] = amu;
+	A[20] = asa;
+	A[21] = ase;
+	A[22] = asi;
+	A[23] = aso;
+	A[24] = asu;
+}
+
+#endif
@@ -0,0 +1,499 @@
+/*
+ * Presignature pool for the lazy (online/offline) signer.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "falcon.h"
+#include "inner.h"
+
+typedef struct {
+	falcon_lazy_pool *pool;
+	pthread_t thread;
+	uint8_t *token;
+	uint8_t *tmp;
+} pool_worker;
+
+struct falcon_lazy_pool_ {
+	unsigned logn;
+	int policy;
+
+	/*
+	 * Lazy expanded key (see falcon_lazy_expand_key()).
+	 */
+	uint8_t *expkey;
+
+	/*
+	 * PRNG from which each token gets its own seed; only used under
+	 * the pool lock.
+	 */
+	shake256_context rng;
+
+	/*
+	 * Ring buffer of tokens: 'count' tokens are available, starting
+	 * at slot 'head'. 'pending' counts the tokens currently being
+	 * computed outside of the lock, for which a slot is reserved.
+	 */
+	uint8_t *tokens;
+	size_t token_len;
+	size_t capacity, head, count, pending;
+
+	pthread_mutex_t lock;
+	pthread_cond_t not_empty, not_full;
+	int stop;
+
+	/*
+	 * First error reported by the offline phase, or 0. Token
+	 * computation depends only on the expanded key and the sizes,
+	 * so an error would repeat: background threads stop, and
+	 * waiting callers get the error instead of a token.
+	 */
+	int error;
+
+	pool_worker *workers;
+	unsigned nthreads;
+};
+
+/*
+ * Compute a fresh token into tok[]. tmp[] must have size at least
+ * FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn). The pool lock must not be
+ * held; it is taken only to draw the token seed, so that workers
+ * compute tokens in parallel. Returned value is 0 on success, or the
+ * error code of falcon_sign_lazy_offline(); tok[] must then be
+ * discarded.
+ */
+static int
+make_token(falcon_lazy_pool *p, uint8_t *tok, uint8_t *tmp)
+{
+	uint8_t seed[48];
+	shake256_context rng;
+	int r;
+
+	pthread_mutex_lock(&p->lock);
+	shake256_extract(&p->rng, seed, sizeof seed);
+	pthread_mutex_unlock(&p->lock);
+	shake256_init_prng_from_seed(&rng, seed, sizeof seed);
+	r = falcon_sign_lazy_offline(&rng, tok, p->token_len, p->expkey,
+		tmp, FALCON_TMPSIZE_SIGNLAZY_OFFLINE(p->logn));
+	memset(seed, 0, sizeof seed);
+	memset(&rng, 0, sizeof rng);
+	if (r != 0) {
+		memset(tok, 0, p->token_len);
+	}
+	return r;
+}
+
+/*
+ * Record a token computation error. The pool lock must be held.
+ * Callers waiting for a token are woken up, so that they get the
+ * error.
+ */
+static void
+set_error(falcon_lazy_pool *p, int r)
+{
+	if (p->error == 0) {
+		p->error = r;
+	}
+	pthread_cond_broadcast(&p->not_empty);
+}
+
+/*
+ * Store a token in the next free slot. The pool lock must be held,
+ * and a slot must be available.
+ */
+static void
+push_token(falcon_lazy_pool *p, const uint8_t *tok)
+{
+	size_t slot;
+
+	slot = (p->head + p->count) % p->capacity;
+	memcpy(p->tokens + slot * p->token_len, tok, p->token_len);
+	p->count ++;
+	pthread_cond_signal(&p->not_empty);
+}
+
+/*
+ * Remove the oldest token and copy it into tok[]. The pool lock must
+ * be held, and the pool must not be empty. The slot is cleared so that
+ * a token never remains in memory after its use.
+ */
+static void
+pop_token(falcon_lazy_pool *p, uint8_t *tok)
+{
+	uint8_t *src;
+
+	src = p->tokens + p->head * p->token_len;
+	memcpy(tok, src, p->token_len);
+	memset(src, 0, p->token_len);
+	p->head = (p->head + 1) % p->capacity;
+	p->count --;
+	pthread_cond_signal(&p->not_full);
+}
+
+/*
+ * Get a token for a signature, applying the pool policy if the pool is
+ * empty (tmp[] is used to compute a token on the spot). Returned value
+ * is 0 on success, FALCON_ERR_EMPTY, or the error that stopped token
+ * computation.
+ */
+static int
+take_token(falcon_lazy_pool *p, uint8_t *tok, uint8_t *tmp)
+{
+	int r;
+
+	pthread_mutex_lock(&p->lock);
+	for (;;) {
+		if (p->count > 0) {
+			pop_token(p, tok);
+			pthread_mutex_unlock(&p->lock);
+			return 0;
+		}
+		if (p->policy != FALCON_LAZY_POOL_WAIT) {
+			break;
+		}
+		if (p->error != 0) {
+			r = p->error;
+			pthread_mutex_unlock(&p->lock);
+			return r;
+		}
+		pthread_cond_wait(&p->not_empty, &p->lock);
+	}
+	pthread_mutex_unlock(&p->lock);
+	if (p->policy == FALCON_LAZY_POOL_SYNC) {
+		return make_token(p, tok, tmp);
+	}
+	return FALCON_ERR_EMPTY;
+}
+
+/*
+ * Background thread: keep the pool full. A token that could not be
+ * computed is dropped, and the thread stops (see 'error').
+ */
+static void *
+worker_main(void *arg)
+{
+	pool_worker *w;
+	falcon_lazy_pool *p;
+	int r;
+
+	w = arg;
+	p = w->pool;
+	pthread_mutex_lock(&p->lock);
+	for (;;) {
+		while (!p->stop && p->error == 0
+			&& p->count + p->pending >= p->capacity)
+		{
+			pthread_cond_wait(&p->not_full, &p->lock);
+		}
+		if (p->stop || p->error != 0) {
+			break;
+		}
+		p->pending ++;
+		pthread_mutex_unlock(&p->lock);
+		r = make_token(p, w->token, w->tmp);
+		pthread_mutex_lock(&p->lock);
+		p->pending --;
+		if (r != 0) {
+			set_error(p, r);
+			break;
+		}
+		push_token(p, w->token);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return NULL;
+}
+
+/*
+ * Stop and join the first 'num' workers, then release all resources.
+ */
+static void
+pool_release(falcon_lazy_pool *p, unsigned num)
+{
+	unsigned u;
+
+	if (num > 0) {
+		pthread_mutex_lock(&p->lock);
+		p->stop = 1;
+		pthread_cond_broadcast(&p->not_full);
+		pthread_mutex_unlock(&p->lock);
+		for (u = 0; u < num; u ++) {
+			pthread_join(p->workers[u].thread, NULL);
+		}
+	}
+	if (p->workers != NULL) {
+		for (u = 0; u < p->nthreads; u ++) {
+			if (p->workers[u].token != NULL) {
+				memset(p->workers[u].token, 0, p->token_len
+					+ FALCON_TMPSIZE_SIGNLAZY_OFFLINE(p->logn));
+				free(p->workers[u].token);
+			}
+		}
+		free(p->workers);
+	}
+	if (p->tokens != NULL) {
+		memset(p->tokens, 0, p->capacity * p->token_len);
+		free(p->tokens);
+	}
+	if (p->expkey != NULL) {
+		memset(p->expkey, 0, FALCON_LAZY_EXPANDEDKEY_SIZE(p->logn));
+		free(p->expkey);
+	}
+	memset(&p->rng, 0, sizeof p->rng);
+	pthread_cond_destroy(&p->not_full);
+	pthread_cond_destroy(&p->not_empty);
+	pthread_mutex_destroy(&p->lock);
+	free(p);
+}
+
+/* see falcon.h */
+int
+falcon_lazy_pool_new(falcon_lazy_pool **pool, shake256_context *rng,
+	const void *privkey, size_t privkey_len,
+	const void *pubkey, size_t pubkey_len,
+	size_t capacity, unsigned nthreads, int policy)
+{
+	falcon_lazy_pool *p;
+	unsigned logn, u;
+	uint8_t *tmp;
+	size_t tmp_len;
+	uint8_t seed[48];
+	int r;
+
+	*pool = NULL;
+
+	/*
+	 * Check parameters.
+	 */
+	switch (policy) {
+	case FALCON_LAZY_POOL_WAIT:
+		if (nthreads == 0) {
+			return FALCON_ERR_BADARG;
+		}
+		break;
+	case FALCON_LAZY_POOL_SYNC:
+	case FALCON_LAZY_POOL_FAIL:
+		break;
+	default:
+		return FALCON_ERR_BADARG;
+	}
+	if (capacity == 0) {
+		return FALCON_ERR_BADARG;
+	}
+	r = falcon_get_logn((void *)privkey, privkey_len);
+	if (r < 0) {
+		return r;
+	}
+	logn = (unsigned)r;
+
+	p = calloc(1, sizeof *p);
+	if (p == NULL) {
+		return FALCON_ERR_INTERNAL;
+	}
+	p->logn = logn;
+	p->policy = policy;
+	p->capacity = capacity;
+	p->token_len = FALCON_LAZY_TOKEN_SIZE(logn);
+	pthread_mutex_init(&p->lock, NULL);
+	pthread_cond_init(&p->not_empty, NULL);
+	pthread_cond_init(&p->not_full, NULL);
+	shake256_extract(rng, seed, sizeof seed);
+	shake256_init_prng_from_seed(&p->rng, seed, sizeof seed);
+	memset(seed, 0, sizeof seed);
+	p->expkey = malloc(FALCON_LAZY_EXPANDEDKEY_SIZE(logn));
+	p->tokens = calloc(capacity, p->token_len);
+	tmp_len = FALCON_TMPSIZE_LAZYEXPAND(logn);
+	if (tmp_len < FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn)) {
+		tmp_len = FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn);
+	}
+	tmp = malloc(tmp_len);
+	if (p->expkey == NULL || p->tokens == NULL || tmp == NULL) {
+		free(tmp);
+		pool_release(p, 0);
+		return FALCON_ERR_INTERNAL;
+	}
+
+	/*
+	 * Expand the key pair, and compute the first token.
+	 */
+	r = falcon_lazy_expand_key(p->expkey,
+		FALCON_LAZY_EXPANDEDKEY_SIZE(logn),
+		privkey, privkey_len, pubkey, pubkey_len, tmp, tmp_len);
+	if (r == 0) {
+		r = make_token(p, p->tokens, tmp);
+	}
+	if (r == 0) {
+		p->count = 1;
+	}
+	memset(tmp, 0, tmp_len);
+	free(tmp);
+	if (r != 0) {
+		pool_release(p, 0);
+		return r;
+	}
+
+	/*
+	 * Start the background threads.
+	 */
+	if (nthreads > 0) {
+		p->workers = calloc(nthreads, sizeof *p->workers);
+		if (p->workers == NULL) {
+			pool_release(p, 0);
+			return FALCON_ERR_INTERNAL;
+		}
+		p->nthreads = nthreads;
+		for (u = 0; u < nthreads; u ++) {
+			p->workers[u].pool = p;
+			p->workers[u].token = malloc(p->token_len
+				+ FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn));
+			if (p->workers[u].token == NULL) {
+				pool_release(p, 0);
+				return FALCON_ERR_INTERNAL;
+			}
+			p->workers[u].tmp = p->workers[u].token + p->token_len;
+		}
+		for (u = 0; u < nthreads; u ++) {
+			if (pthread_create(&p->workers[u].thread, NULL,
+				worker_main, &p->workers[u]) != 0)
+			{
+				pool_release(p, u);
+				return FALCON_ERR_INTERNAL;
+			}
+		}
+	}
+	*pool = p;
+	return 0;
+}
+
+/* see falcon.h */
+void
+falcon_lazy_pool_free(falcon_lazy_pool *pool)
+{
+	if (pool != NULL) {
+		pool_release(pool, pool->nthreads);
+	}
+}
+
+/* see falcon.h */
+size_t
+falcon_lazy_pool_refill(falcon_lazy_pool *pool, size_t max)
+{
+	uint8_t *tok;
+	size_t num, len;
+	int r;
+
+	len = pool->token_len + FALCON_TMPSIZE_SIGNLAZY_OFFLINE(pool->logn);
+	tok = malloc(len);
+	if (tok == NULL) {
+		return 0;
+	}
+	num = 0;
+	pthread_mutex_lock(&pool->lock);
+	while (num < max && pool->error == 0
+		&& pool->count + pool->pending < pool->capacity)
+	{
+		pool->pending ++;
+		pthread_mutex_unlock(&pool->lock);
+		r = make_token(pool, tok, tok + pool->token_len);
+		pthread_mutex_lock(&pool->lock);
+		pool->pending --;
+		if (r != 0) {
+			set_error(pool, r);
+			break;
+		}
+		push_token(pool, tok);
+		num ++;
+	}
+	pthread_mutex_unlock(&pool->lock);
+	memset(tok, 0, len);
+	free(tok);
+	return num;
+}
+
+/* see falcon.h */
+size_t
+falcon_lazy_pool_available(falcon_lazy_pool *pool)
+{
+	size_t num;
+
+	pthread_mutex_lock(&pool->lock);
+	num = pool->count;
+	pthread_mutex_unlock(&pool->lock);
+	return num;
+}
+
+/* see falcon.h */
+unsigned
+falcon_lazy_pool_get_logn(const falcon_lazy_pool *pool)
+{
+	return pool->logn;
+}
+
+/*
+ * Token source for falcon_lazy_sign_from_pool(): tokens are taken into
+ * tok[] (tmp[] is used by take_token() with the SYNC policy).
+ */
+typedef struct {
+	falcon_lazy_pool *pool;
+	uint8_t *tok, *tmp;
+} pool_source;
+
+static int
+pool_next_token(void *arg, uint8_t **token)
+{
+	pool_source *src;
+
+	src = arg;
+	*token = src->tok;
+	return take_token(src->pool, src->tok, src->tmp);
+}
+
+/* see falcon.h */
+int
+falcon_lazy_sign_from_pool(falcon_lazy_pool *pool,
+	void *sig, size_t *sig_len, int sig_type,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len)
+{
+	pool_source src;
+	unsigned logn;
+
+	logn = pool->logn;
+	if (tmp_len < FALCON_TMPSIZE_SIGNPOOL(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+
+	/*
+	 * Tokens are taken out of the pool into an 8-byte aligned
+	 * buffer, so that the online phase reads them in place.
+	 */
+	src.pool = pool;
+	src.tok = (uint8_t *)tmp + ((8 - ((uintptr_t)tmp & 7)) & 7);
+	src.tmp = src.tok + pool->token_len;
+	return Zf(lazy_sign_tokens)(sig, sig_len, sig_type,
+		pool->expkey, logn, &pool_next_token, &src, pool->token_len,
+		data, data_len, src.tmp, FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn));
+}
@@ -33,6 +33,13 @@
 
 #include "inner.h"
 
+/*
+ * With FALCON_DISPATCH, this file is also compiled as part of the
+ * kernel copies (kern_avx2.c, kern_avx512.c); only prng_refill() is
+ * then included.
+ */
+#ifndef FALCON_KERNEL
+
 // yyyNIST+0 yyyPQCLEAN+0
 /*
  * Include relevant system header files. For Win32, this will also need
@@ -145,9 +152,14 @@ Zf(prng_init)(prng *p, inner_shake256_context *src)
 	th = *(uint32_t *)(p->state.d + 52);
 	*(uint64_t *)(p->state.d + 48) = tl + (th << 32);
 #endif  // yyyLE-
+#if FALCON_AVX512 || FALCON_DISPATCH
+	p->next_ok = 0;
+#endif
 	Zf(prng_refill)(p);
 }
 
+#endif
+
 /*
  * PRNG based on ChaCha20.
  *
@@ -163,10 +175,106 @@ Zf(prng_init)(prng *p, inner_shake256_context *src)
  * The block counter is XORed into the first 8 bytes of the IV.
  */
 TARGET_AVX2
-void
-Zf(prng_refill)(prng *p)
+static inline void
+chacha20_refill(prng *p)
 {
 #if FALCON_AVX2 // yyyAVX2+1
+#if FALCON_AVX512
+
+	static const uint32_t CW[] = {
+		0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
+	};
+
+	uint64_t cc;
+	size_t u;
+	int i;
+	uint32_t *sw;
+	union {
+		uint32_t w[32];
+		__m512i z[2];  /* for alignment */
+	} t;
+	__m512i state[16], init[16];
+
+	sw = (uint32_t *)p->state.d;
+
+	/*
+	 * XOR next counter values into state. Lanes 0 to 7 get the
+	 * counters that the AVX2 code would use for this refill, lanes
+	 * 8 to 15 those of the next refill.
+	 */
+	cc = *(uint64_t *)(p->state.d + 48);
+	for (u = 0; u < 16; u ++) {
+		t.w[u] = (uint32_t)(cc + u);
+		t.w[u + 16] = (uint32_t)((cc + u) >> 32);
+	}
+	*(uint64_t *)(p->state.d + 48) = cc + 16;
+
+	/*
+	 * Load state.
+	 */
+	for (u = 0; u < 4; u ++) {
+		state[u] = init[u] = _mm512_set1_epi32((int)CW[u]);
+	}
+	for (u = 0; u < 10; u ++) {
+		state[u + 4] = init[u + 4] = _mm512_set1_epi32((int)sw[u]);
+	}
+	state[14] = init[14] = _mm512_xor_si512(
+		_mm512_set1_epi32((int)sw[10]),
+		_mm512_loadu_si512((void *)&t.w[0]));
+	state[15] = init[15] = _mm512_xor_si512(
+		_mm512_set1_epi32((int)sw[11]),
+		_mm512_loadu_si512((void *)&t.w[16]));
+
+	/*
+	 * Do all rounds.
+	 */
+	for (i = 0; i < 10; i ++) {
+
+#define QROUND(a, b, c, d)   do { \
+		state[a] = _mm512_add_epi32(state[a], state[b]); \
+		state[d] = _mm512_xor_si512(state[d], state[a]); \
+		state[d] = _mm512_rol_epi32(state[d], 16); \
+		state[c] = _mm512_add_epi32(state[c], state[d]); \
+		state[b] = _mm512_xor_si512(state[b], state[c]); \
+		state[b] = _mm512_rol_epi32(state[b], 12); \
+		state[a] = _mm512_add_epi32(state[a], state[b]); \
+		state[d] = _mm512_xor_si512(state[d], state[a]); \
+		state[d] = _mm512_rol_epi32(state[d], 8); \
+		state[c] = _mm512_add_epi32(state[c], state[d]); \
+		state[b] = _mm512_xor_si512(state[b], state[c]); \
+		state[b] = _mm512_rol_epi32(state[b], 7); \
+	} while (0)
+
+		QROUND( 0,  4,  8, 12);
+		QROUND( 1,  5,  9, 13);
+		QROUND( 2,  6, 10, 14);
+		QROUND( 3,  7, 11, 15);
+		QROUND( 0,  5, 10, 15);
+		QROUND( 1,  6, 11, 12);
+		QROUND( 2,  7,  8, 13);
+		QROUND( 3,  4,  9, 14);
+
+#undef QROUND
+
+	}
+
+	/*
+	 * Add initial state back. The low halves (lanes 0 to 7) go to
+	 * the output buffer, the high halves to the reserve, each with
+	 * the same interleaving as the AVX2 code.
+	 */
+	for (u = 0; u < 16; u ++) {
+		__m512i x;
+
+		x = _mm512_add_epi32(state[u], init[u]);
+		_mm256_storeu_si256((__m256i *)&p->buf.d[u << 5],
+			_mm512_castsi512_si256(x));
+		_mm256_storeu_si256((__m256i *)&p->next.d[u << 5],
+			_mm512_extracti64x4_epi64(x, 1));
+	}
+	p->next_ok = 1;
+
+#else
 
 	static const uint32_t CW[] = {
 		0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
@@ -263,6 +371,7 @@ Zf(prng_refill)(prng *p)
 			_mm256_add_epi32(state[u], init[u]));
 	}
 
+#endif
 #else // yyyAVX2+0
 
 	static const uint32_t CW[] = {
@@ -350,10 +459,31 @@ Zf(prng_refill)(prng *p)
 	*(uint64_t *)(p->state.d + 48) = cc;
 
 #endif // yyyAVX2-
+}
 
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(prng_refill)(prng *p)
+{
+#if FALCON_AVX512 || FALCON_DISPATCH
+	/*
+	 * Every other AVX-512 refill just hands out the blocks that
+	 * were computed by the previous one.
+	 */
+	if (p->next_ok) {
+		memcpy(p->buf.d, p->next.d, sizeof p->buf.d);
+		p->next_ok = 0;
+		p->ptr = 0;
+		return;
+	}
+#endif
+	chacha20_refill(p);
 	p->ptr = 0;
 }
 
+#ifndef FALCON_KERNEL
+
 /* see inner.h */
 void
 Zf(prng_get_bytes)(prng *p, void *dst, size_t len)
@@ -368,7 +498,7 @@ Zf(prng_get_bytes)(prng *p, void *dst, size_t len)
 		if (clen > len) {
 			clen = len;
 		}
-		memcpy(buf, p->buf.d, clen);
+		memcpy(buf, p->buf.d + p->ptr, clen);
 		buf += clen;
 		len -= clen;
 		p->ptr += clen;
@@ -377,3 +507,5 @@ Zf(prng_get_bytes)(prng *p, void *dst, size_t len)
 		}
 	}
 }
+
+#endif
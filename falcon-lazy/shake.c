@@ -33,6 +33,12 @@
 
 #include "inner.h"
 
+/*
+ * With FALCON_DISPATCH, this file is also compiled as part of the
+ * kernel copies (kern_avx2.c, kern_avx512.c); only keccak_multi() and
+ * keccak_f1600() are then included.
+ */
+
 #if FALCON_ASM_CORTEXM4  // yyyASM_CORTEXM4+1
 
 __attribute__((naked))
@@ -620,6 +626,26 @@ process_block(uint64_t *A __attribute__((unused)))
 
 #else  // yyyASM_CORTEXM4+0
 
+#if FALCON_KECCAK_X64
+
+#include "keccak_x64.h"
+
+/*
+ * Round constants.
+ */
+#define RC   KECCAK_X64_RC
+
+#ifndef FALCON_KERNEL
+
+/*
+ * Process the provided state (see Zf(keccak_f1600)() below).
+ */
+#define process_block(A)   Zf(keccak_f1600)(A)
+
+#endif
+
+#else
+
 /*
  * Round constants.
  */
@@ -638,6 +664,8 @@ static const uint64_t RC[] = {
 	0x0000000080000001, 0x8000000080008008
 };
 
+#ifndef FALCON_KERNEL
+
 /*
  * Process the provided state.
  */
@@ -1069,8 +1097,14 @@ process_block(uint64_t *A)
 	A[20] = ~A[20];
 }
 
+#endif
+
+#endif
+
 #endif  // yyyASM_CORTEXM4-
 
+#ifndef FALCON_KERNEL
+
 /* see inner.h */
 void
 Zf(i_shake256_init)(inner_shake256_context *sc)
@@ -1175,3 +1209,202 @@ Zf(i_shake256_extract)(inner_shake256_context *sc, uint8_t *out, size_t len)
 	}
 	sc->dptr = dptr;
 }
+
+/* see inner.h */
+int
+Zf(i_shake256_x_init)(inner_shake256_x_context *sx,
+	const inner_shake256_context *const *sc, unsigned num)
+{
+	unsigned l, i;
+
+	memset(sx->A, 0, sizeof sx->A);
+	for (l = 0; l < num; l ++) {
+		if (sc[l]->dptr != 136) {
+			return 0;
+		}
+		for (i = 0; i < 25; i ++) {
+			sx->A[i * INNER_SHAKE256_LANES + l] = sc[l]->st.A[i];
+		}
+	}
+	sx->num = num;
+	return 1;
+}
+
+/* see inner.h */
+void
+Zf(i_shake256_x_next)(inner_shake256_x_context *sx)
+{
+	Zf(keccak_multi)(sx->A, sx->num);
+}
+
+#endif
+
+#if FALCON_AVX2 // yyyAVX2+1
+/*
+ * One round of Keccak-f[1600] on the 25 words a[] (plain
+ * representation, without the inverted words of process_block()),
+ * with temporaries b[], c[] and d[]. The operations are macros, set
+ * for each vector type.
+ */
+#define KECCAK_X_ROUND(a, b, c, d, rc)   do { \
+	c[0] = KX_XOR(KX_XOR(KX_XOR(a[ 0], a[ 5]), \
+		KX_XOR(a[10], a[15])), a[20]); \
+	c[1] = KX_XOR(KX_XOR(KX_XOR(a[ 1], a[ 6]), \
+		KX_XOR(a[11], a[16])), a[21]); \
+	c[2] = KX_XOR(KX_XOR(KX_XOR(a[ 2], a[ 7]), \
+		KX_XOR(a[12], a[17])), a[22]); \
+	c[3] = KX_XOR(KX_XOR(KX_XOR(a[ 3], a[ 8]), \
+		KX_XOR(a[13], a[18])), a[23]); \
+	c[4] = KX_XOR(KX_XOR(KX_XOR(a[ 4], a[ 9]), \
+		KX_XOR(a[14], a[19])), a[24]); \
+	d[0] = KX_XOR(c[4], KX_ROL(c[1], 1)); \
+	d[1] = KX_XOR(c[0], KX_ROL(c[2], 1)); \
+	d[2] = KX_XOR(c[1], KX_ROL(c[3], 1)); \
+	d[3] = KX_XOR(c[2], KX_ROL(c[4], 1)); \
+	d[4] = KX_XOR(c[3], KX_ROL(c[0], 1)); \
+	b[ 0] = KX_XOR(a[ 0], d[0]); \
+	b[10] = KX_ROL(KX_XOR(a[ 1], d[1]), 1); \
+	b[20] = KX_ROL(KX_XOR(a[ 2], d[2]), 62); \
+	b[ 5] = KX_ROL(KX_XOR(a[ 3], d[3]), 28); \
+	b[15] = KX_ROL(KX_XOR(a[ 4], d[4]), 27); \
+	b[16] = KX_ROL(KX_XOR(a[ 5], d[0]), 36); \
+	b[ 1] = KX_ROL(KX_XOR(a[ 6], d[1]), 44); \
+	b[11] = KX_ROL(KX_XOR(a[ 7], d[2]), 6); \
+	b[21] = KX_ROL(KX_XOR(a[ 8], d[3]), 55); \
+	b[ 6] = KX_ROL(KX_XOR(a[ 9], d[4]), 20); \
+	b[ 7] = KX_ROL(KX_XOR(a[10], d[0]), 3); \
+	b[17] = KX_ROL(KX_XOR(a[11], d[1]), 10); \
+	b[ 2] = KX_ROL(KX_XOR(a[12], d[2]), 43); \
+	b[12] = KX_ROL(KX_XOR(a[13], d[3]), 25); \
+	b[22] = KX_ROL(KX_XOR(a[14], d[4]), 39); \
+	b[23] = KX_ROL(KX_XOR(a[15], d[0]), 41); \
+	b[ 8] = KX_ROL(KX_XOR(a[16], d[1]), 45); \
+	b[18] = KX_ROL(KX_XOR(a[17], d[2]), 15); \
+	b[ 3] = KX_ROL(KX_XOR(a[18], d[3]), 21); \
+	b[13] = KX_ROL(KX_XOR(a[19], d[4]), 8); \
+	b[14] = KX_ROL(KX_XOR(a[20], d[0]), 18); \
+	b[24] = KX_ROL(KX_XOR(a[21], d[1]), 2); \
+	b[ 9] = KX_ROL(KX_XOR(a[22], d[2]), 61); \
+	b[19] = KX_ROL(KX_XOR(a[23], d[3]), 56); \
+	b[ 4] = KX_ROL(KX_XOR(a[24], d[4]), 14); \
+	a[ 0] = KX_CHI(b[ 0], b[ 1], b[ 2]); \
+	a[ 1] = KX_CHI(b[ 1], b[ 2], b[ 3]); \
+	a[ 2] = KX_CHI(b[ 2], b[ 3], b[ 4]); \
+	a[ 3] = KX_CHI(b[ 3], b[ 4], b[ 0]); \
+	a[ 4] = KX_CHI(b[ 4], b[ 0], b[ 1]); \
+	a[ 5] = KX_CHI(b[ 5], b[ 6], b[ 7]); \
+	a[ 6] = KX_CHI(b[ 6], b[ 7], b[ 8]); \
+	a[ 7] = KX_CHI(b[ 7], b[ 8], b[ 9]); \
+	a[ 8] = KX_CHI(b[ 8], b[ 9], b[ 5]); \
+	a[ 9] = KX_CHI(b[ 9], b[ 5], b[ 6]); \
+	a[10] = KX_CHI(b[10], b[11], b[12]); \
+	a[11] = KX_CHI(b[11], b[12], b[13]); \
+	a[12] = KX_CHI(b[12], b[13], b[14]); \
+	a[13] = KX_CHI(b[13], b[14], b[10]); \
+	a[14] = KX_CHI(b[14], b[10], b[11]); \
+	a[15] = KX_CHI(b[15], b[16], b[17]); \
+	a[16] = KX_CHI(b[16], b[17], b[18]); \
+	a[17] = KX_CHI(b[17], b[18], b[19]); \
+	a[18] = KX_CHI(b[18], b[19], b[15]); \
+	a[19] = KX_CHI(b[19], b[15], b[16]); \
+	a[20] = KX_CHI(b[20], b[21], b[22]); \
+	a[21] = KX_CHI(b[21], b[22], b[23]); \
+	a[22] = KX_CHI(b[22], b[23], b[24]); \
+	a[23] = KX_CHI(b[23], b[24], b[20]); \
+	a[24] = KX_CHI(b[24], b[20], b[21]); \
+	a[ 0] = KX_XOR(a[ 0], KX_RC(rc)); \
+	} while (0)
+#endif // yyyAVX2-
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(keccak_multi)(uint64_t *A, unsigned num)
+{
+#if FALCON_AVX2 // yyyAVX2+1
+	unsigned l, i, r;
+
+#if FALCON_AVX512
+	if (num > 4) {
+		__m512i a[25], b[25], c[5], d[5];
+
+#define KX_XOR(x, y)      _mm512_xor_si512(x, y)
+#define KX_ROL(x, n)      _mm512_rol_epi64(x, n)
+#define KX_CHI(x, y, z)   _mm512_ternarylogic_epi64(x, y, z, 0xD2)
+#define KX_RC(rc)         _mm512_set1_epi64((long long)(rc))
+		for (i = 0; i < 25; i ++) {
+			a[i] = _mm512_loadu_si512(
+				(const void *)(A + i * INNER_SHAKE256_LANES));
+		}
+		for (r = 0; r < 24; r ++) {
+			KECCAK_X_ROUND(a, b, c, d, RC[r]);
+		}
+		for (i = 0; i < 25; i ++) {
+			_mm512_storeu_si512(
+				(void *)(A + i * INNER_SHAKE256_LANES), a[i]);
+		}
+#undef KX_XOR
+#undef KX_ROL
+#undef KX_CHI
+#undef KX_RC
+		return;
+	}
+#endif
+
+#define KX_XOR(x, y)      _mm256_xor_si256(x, y)
+#define KX_ROL(x, n)      _mm256_or_si256( \
+	_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - (n)))
+#define KX_CHI(x, y, z)   _mm256_xor_si256(x, _mm256_andnot_si256(y, z))
+#define KX_RC(rc)         _mm256_set1_epi64x((long long)(rc))
+	for (l = 0; l < num; l += 4) {
+		__m256i a[25], b[25], c[5], d[5];
+
+		for (i = 0; i < 25; i ++) {
+			a[i] = _mm256_loadu_si256((const __m256i *)
+				(A + i * INNER_SHAKE256_LANES + l));
+		}
+		for (r = 0; r < 24; r ++) {
+			KECCAK_X_ROUND(a, b, c, d, RC[r]);
+		}
+		for (i = 0; i < 25; i ++) {
+			_mm256_storeu_si256((__m256i *)
+				(A + i * INNER_SHAKE256_LANES + l), a[i]);
+		}
+	}
+#undef KX_XOR
+#undef KX_ROL
+#undef KX_CHI
+#undef KX_RC
+#else // yyyAVX2+0
+	unsigned l, i;
+
+	for (l = 0; l < num; l ++) {
+		uint64_t B[25];
+
+		for (i = 0; i < 25; i ++) {
+			B[i] = A[i * INNER_SHAKE256_LANES + l];
+		}
+		process_block(B);
+		for (i = 0; i < 25; i ++) {
+			A[i * INNER_SHAKE256_LANES + l] = B[i];
+		}
+	}
+#endif // yyyAVX2-
+}
+
+#if FALCON_KECCAK_X64
+
+/*
+ * With AVX2, BMI1 and BMI2 are also available, and keccak_x64_f1600()
+ * then uses ANDN and RORX.
+ */
+#if FALCON_AVX2
+__attribute__((target("bmi,bmi2")))
+#endif
+void
+Zk(keccak_f1600)(uint64_t *A)
+{
+	keccak_x64_f1600(A);
+}
+
+#endif
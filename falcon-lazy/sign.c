@@ -177,24 +177,6 @@ mq_add_sign(uint32_t x, uint32_t y)
 //     A[1] = arr2[0];
 // }
 
-// rewriting this to just take 6 arrays as inputs instead of a 2x2 matrix of arrays and 2 arrays
-// void mat_mul(const fpr A[2][2], const fpr x[2], fpr y[2], size_t size) {
-//     fpr temp[2];
-//     for (size_t i = 0; i < size; i++) {
-//         v_mul(A[i], &x[i], temp, size);
-//         v_add(y, temp, y, size);
-//     }
-// }
-
-void mat_mul(const fpr A00[], const fpr A01[], const fpr A10[], const fpr A11[], const fpr x1[], const fpr x2[], fpr y1[], fpr y2[], size_t size) {
-    for (size_t i = 0; i < size; i++) {
-        fpr temp1 = fpr_add(fpr_mul(A00[i], x1[i]), fpr_mul(A01[i], x2[i]));
-        fpr temp2 = fpr_add(fpr_mul(A10[i], x1[i]), fpr_mul(A11[i], x2[i]));
-        y1[i] = fpr_add(y1[i], temp1);
-        y2[i] = fpr_add(y2[i], temp2);
-    }
-}
-
 // scalar is set to a float as this is what we need currently
 void v_scalar_mul(const fpr a[], const fpr s, fpr result[], size_t size) {
 	for (size_t i = 0; i < size; i++) {
@@ -202,175 +184,51 @@ void v_scalar_mul(const fpr a[], const fpr s, fpr result[], size_t size) {
 	}
 }
 
-int randint(int min, int max) {
-    return min + rand() % (max - min + 1);
-}
-
-#define IMAX_BITS(m) ((m)/((m)%255+1) / 255%255*8 + 7-86/((m)%255+12))
-#define RAND_MAX_WIDTH IMAX_BITS(RAND_MAX)
-
-uint32_t rand32(void) {
-  uint32_t r = 0;
-  for (int i = 0; i < 32; i += RAND_MAX_WIDTH) {
-    r <<= RAND_MAX_WIDTH;
-    r ^= (unsigned) rand();
-  }
-  return r;
-}
-
-int randombytes(uint8_t *obuf, size_t len)
-{
-	static uint32_t fibo_a = 0xDEADBEEF, fibo_b = 0x01234567;
-	size_t i;
-	for (i = 0; i < len; i++) {
-		fibo_a += fibo_b;
-		fibo_b += fibo_a;
-		obuf[i] = (fibo_a >> 24) ^ (fibo_b >> 16);
-	}
-	return 0;
-}
-
-#define LSBMASK(c)	(-((c)&1))
-#define	CMUX(x,y,c)	(((x)&(LSBMASK(c)))^((y)&(~LSBMASK(c))))
-#define CFLIP(x,c)	CMUX(x,-(x),c)
-#define CABS(x)		CFLIP(x,x>=0)
-
-uint64_t exp_scaled(uint64_t x)
-{
-    assert(x<=64082*256);
-
-    uint64_t r;
-    r = (( 809438661408LL    )*x) >> 28;
-    r = (( 869506949331LL - r)*x) >> 28;
-    r = (( 640044208952LL - r)*x) >> 27;
-    r = (( 793458686015LL - r)*x) >> 27;
-    r = (( 839743192604LL - r)*x) >> 27;
-    r = (( 740389683060LL - r)*x) >> 26;
-    r = ((1044449863563LL - r)*x) >> 27;
-    r = (( 552517269260LL - r)*x) >> 25;
-    r = (( 779422325990LL - r)*x) >> 23;
-    r =  (2199023255552LL - r);
-
-    return r;
-}
-
-static uint32_t sample_berncdt(uint64_t utop, uint64_t ubot)
-{
-    uint32_t x = 0;
-    uint32_t b = 1;
-    uint32_t r, s, t;
-    t  = (utop >  11881272476311950404ULL);
-    r  = (utop == 11881272476311950404ULL);
-    s  = (ubot >   2232598800125794762ULL);
-    b  = (r && s) || t;
-    x += b;
-    t  = (utop >  17729174351313943813ULL);
-    r  = (utop == 17729174351313943813ULL);
-    s  = (ubot >  17046599807202850264ULL);
-    b  = (r && s) || t;
-    x += b;
-    t  = (utop >  18426461144592799266ULL);
-    r  = (utop == 18426461144592799266ULL);
-    s  = (ubot >   9031501729263515114ULL);
-    b  = (r && s) || t;
-    x += b;
-    t  = (utop >  18446602887327906610ULL);
-    r  = (utop == 18446602887327906610ULL);
-    s  = (ubot >  11817852927693963396ULL);
-    b  = (r && s) || t;
-    x += b;
-    t  = (utop >  18446743834670245612ULL);
-    r  = (utop == 18446743834670245612ULL);
-    s  = (ubot >   7306021935394802834ULL);
-    b  = (r && s) || t;
-    x += b;
-    t  = (utop >  18446744073611412414ULL);
-    r  = (utop == 18446744073611412414ULL);
-    s  = (ubot >  17880792342251759005ULL);
-    b  = (r && s) || t;
-    x += b;
-    t  = (utop >  18446744073709541852ULL);
-    r  = (utop == 18446744073709541852ULL);
-    s  = (ubot >  14689009182029885173ULL);
-    b  = (r && s) || t;
-    x += b;
-    r  = (utop == 18446744073709551615ULL);
-    s  = (ubot >  14106032229701791861ULL);
-    b  = (r && s);
-    x += b;
-    s  = (ubot >  18446718728838181855ULL);
-    b &= s;
-    x += b;
-    s  = (ubot >  18446744073673701140ULL);
-    b &= s;
-    x += b;
-    
-    return x;
-}
-
-
-static inline uint32_t div16404853(uint32_t x) {
-    uint32_t y, z;
-    y = (97488647 * (uint64_t) x) >> 32;
-    z = (x - y) >> 1;
-    return (z + y) >> 23;
-}
-
-#define BERN_RANDMULT	1664
+/*
+ * Expected acceptance rate of Zf(sample_bern_block)(), as a fraction
+ * BERN_ACC_NUM / BERN_ACC_DEN (slightly underestimated), and maximum
+ * number of blocks drawn from the PRNG in one call.
+ */
+#define BERN_ACC_NUM   2
+#define BERN_ACC_DEN   3
+#define BERN_CHUNK     8
 
-void sample_gaussian_poly_bern(int8_t *sample1, int8_t *sample2, size_t n) 
+/* see inner.h */
+void
+sample_gaussian_poly_bern(prng *p,
+	int8_t *sample1, int8_t *sample2, size_t n)
 {
-    size_t i = 0, pos = 0;
-    uint32_t x, y, t, k;
-    int32_t z;
-
-    uint64_t *us, utop, ubot, v, w;
-    unsigned char *cs, c;
-    unsigned char buf[(3*sizeof(uint64_t) + 2)*BERN_RANDMULT];
-    uint32_t coeffs[2*n];
-
-    randombytes(buf, sizeof buf);
-
-    cs = buf;
-    us = (uint64_t*)(buf+2*BERN_RANDMULT);
-
-    while(i<2*n) {
-	if(pos++ >= BERN_RANDMULT) {
-	    randombytes(buf, sizeof buf);
-	    pos = 0;
-	    cs = buf;
-	    us = (uint64_t*)(buf+2*BERN_RANDMULT);
-	}
+	uint8_t rnd[BERN_CHUNK * BERN_BLOCK_BYTES];
+	int8_t acc[BERN_BLOCK];
+	size_t i, j, u, num, nb;
 
-	utop = *us++;
-	ubot = *us++;
-	w    = *us++;
-	w  >>= 1;
-
-	x = sample_berncdt(utop, ubot) << 8;
-	y = *cs++;
-	z = x + y;
-
-	y = y*(y + 2*x) << 8;  
-	k = div16404853(y);
-	t = y - 16404853*k;
-	v = exp_scaled(t) << (22-k);
-	
-	c = *cs++;
-	if((w > v) || (c & (z==0)))
-	   continue;
-
-	c >>= 1;
-	coeffs[i++] = CFLIP(z,(int32_t)c);
-    }
-
-	for (size_t j=0; j<n; j++) {
-		sample1[j] = coeffs[j];
-	}
-	for (size_t ii=0; ii<n; ii++) {
-		sample2[ii] = coeffs[n+ii];
+	i = 0;
+	while (i < 2 * n) {
+		/*
+		 * Request, in a single call, the number of blocks that is
+		 * expected to complete the output.
+		 */
+		nb = ((2 * n - i) * BERN_ACC_DEN
+			+ BERN_ACC_NUM * BERN_BLOCK - 1)
+			/ (BERN_ACC_NUM * BERN_BLOCK);
+		if (nb > BERN_CHUNK) {
+			nb = BERN_CHUNK;
+		}
+		Zf(prng_get_bytes)(p, rnd, nb * BERN_BLOCK_BYTES);
+		for (u = 0; u < nb && i < 2 * n; u ++) {
+			num = Zf(sample_bern_block)(acc,
+				rnd + u * BERN_BLOCK_BYTES);
+			for (j = 0; j < num && i < 2 * n; j ++, i ++) {
+				if (i < n) {
+					sample1[i] = acc[j];
+				} else {
+					sample2[i - n] = acc[j];
+				}
+			}
+		}
 	}
-    
+	memset(rnd, 0, sizeof rnd);
+	memset(acc, 0, sizeof acc);
 }
 
 void gauss_sampler(sampler_context *sc, fpr mu, fpr isigma, int8_t* result, size_t n)
@@ -454,90 +312,279 @@ void compute_target(const uint16_t *h_monty, const int8_t *x0, const int8_t *x1,
     // convert int8 to uint16
     mq_conv_poly_small_sign(n, x1, res);
 
-	mq_NTT(res, logn);
+	Zf(mq_NTT)(res, logn);
 	//Zf(to_ntt_monty)(h, logn);
-	mq_poly_montymul_ntt(res, h_monty, logn);
-	mq_iNTT(res, logn);
+	Zf(mq_poly_montymul_ntt)(res, h_monty, logn);
+	Zf(mq_iNTT)(res, logn);
 
     mq_poly_small_sign_minus_mq(x0, res, res, logn);
 }
 
-void short_preimage(const uint16_t *target, //
-                    const fpr *f_fft, const fpr *g_fft, // key
-                    const fpr *F_fft, const fpr *G_fft, // key
-                    int32_t *res1, int32_t *res2,
-                    unsigned logn)
+/*
+ * Replace each of the len values of y[] with its distance to the
+ * nearest integer (ties to even, as fpr_rint()).
+ */
+TARGET_AVX2
+static void
+lazy_frac(fpr *y, size_t len)
 {
-    size_t n;
-    n = MKN(logn);
+	size_t u;
 
-    // y1 = hm, y2 = 0, put into FFT
-    fpr y1[n];
-    fpr y2[n];
+	u = 0;
+#if FALCON_AVX2 // yyyAVX2+1
+	for (; (u + 4) <= len; u += 4) {
+		__m256d x;
 
-    for (size_t u = 0; u < n; u ++) {
-        y1[u] = fpr_of(target[u]); // y1 = FFT(target)
-        //y2[u] = (uint16_t)(0); // implicit
-    }
+		x = _mm256_loadu_pd(&y[u].v);
+		x = _mm256_sub_pd(x, _mm256_round_pd(x,
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		_mm256_storeu_pd(&y[u].v, x);
+	}
+#endif // yyyAVX2-
+	for (; u < len; u ++) {
+		y[u] = fpr_sub(y[u], fpr_of(fpr_rint(y[u])));
+	}
+}
 
-    Zf(FFT)(y1, logn);
-    //Zf(FFT)(y2, logn); implicitly the same, y2 == FFT(y2) == 0
-
-    // (target,0) * [[F, -f][-G,g]]
-    // simplified as two FFT mults:
-    // (h * F,  -h * f)
-    memcpy(y2, y1, n * sizeof(fpr));
-    Zf(poly_neg)(y1, logn); // f == -f
-    Zf(poly_mul_fft)(y1, F_fft, logn);
-    Zf(poly_mul_fft)(y2, f_fft, logn);
-
-    // multiple both polys by q_inv
-    Zf(poly_mulconst)(y1, fpr_inverse_of_q, logn);
-    Zf(poly_mulconst)(y2, fpr_inverse_of_q, logn);
-
-    // round y1,y2
-    // copy y1,y2, round it, subtract from original
-    Zf(iFFT)(y1, logn);
-    Zf(iFFT)(y2, logn);
-
-    fpr y1_temp[n];
-    fpr y2_temp[n];
-
-    for (size_t u = 0; u < n; u ++) {
-        y1_temp[u] = fpr_of(fpr_rint(y1[u]));
-        y2_temp[u] = fpr_of(fpr_rint(y2[u]));
-        y1[u] = fpr_sub(y1[u], y1_temp[u]);
-        y2[u] = fpr_sub(y2[u], y2_temp[u]);
-    }
+/*
+ * Second half of the lazy preimage computation. On input, y1 and y2
+ * hold y = t*(-F, f)/q in coefficient representation; on output, they
+ * contain (y - round(y))*B (coefficient representation, not rounded).
+ * B is the interleaved basis (see Zf(poly_basis_set)()).
+ */
+static void
+lazy_babai_reduce(fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t n;
 
-    Zf(FFT)(y1, logn);
-    Zf(FFT)(y2, logn);
-
-    // mult by sk
-    memcpy(y1_temp, y1, n * sizeof(fpr));
-    memcpy(y2_temp, y2, n * sizeof(fpr));
-
-    // first row of matrix mult
-    // y[0] := g*y[0] + G*y[1]
-    Zf(poly_mul_fft)(y1, g_fft, logn);
-    Zf(poly_mul_fft)(y2_temp, G_fft, logn);
-    Zf(poly_add)(y1, y2_temp, logn); // stored in y1
-
-    // second row of matrix mult
-    // y[1] := f*y[0] + F*y[1]
-    Zf(poly_mul_fft)(y1_temp, f_fft, logn);
-    Zf(poly_mul_fft)(y2, F_fft, logn);
-    Zf(poly_add)(y2, y1_temp, logn); // stored in y2
-
-    // round y1 and y2
-    Zf(iFFT)(y1, logn);
-    Zf(iFFT)(y2, logn);
-
-    // round y1,y2 and write to res1,res2
-    for (size_t u = 0; u < n; u ++) {
-        res1[u] = fpr_rint(y1[u]);
-        res2[u] = fpr_rint(y2[u]);
-    }
+	n = MKN(logn);
+	lazy_frac(y1, n);
+	lazy_frac(y2, n);
+	Zf(FFT)(y1, logn);
+	Zf(FFT)(y2, logn);
+
+	/*
+	 * (y[0], y[1]) := (g*y[0] + G*y[1], f*y[0] + F*y[1])
+	 */
+	Zf(poly_basis_mul_fft)(y1, y2, B, logn);
+	Zf(iFFT)(y1, logn);
+	Zf(iFFT)(y2, logn);
+}
+
+/*
+ * Same as lazy_babai_reduce(), but only the second half of the result
+ * is computed (in y2); y1 is consumed. This saves two products, one
+ * addition and one iFFT.
+ */
+static void
+lazy_babai_reduce_s2(fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn)
+{
+	size_t n;
+
+	n = MKN(logn);
+	lazy_frac(y1, n);
+	lazy_frac(y2, n);
+	Zf(FFT)(y1, logn);
+	Zf(FFT)(y2, logn);
+
+	/*
+	 * y[1] := f*y[0] + F*y[1]
+	 */
+	Zf(poly_basis_mul2_fft)(y1, y2, B, logn);
+	Zf(iFFT)(y2, logn);
+}
+
+#if FALCON_FPNATIVE
+/*
+ * Write into d[] the distance of each of the len values of y[] to the
+ * nearest integer (as in lazy_babai_reduce()), rounded to float.
+ */
+TARGET_AVX2
+static void
+lazy_frac32(float *d, const fpr *y, size_t len)
+{
+	size_t u;
+
+	u = 0;
+#if FALCON_AVX2 // yyyAVX2+1
+	for (; (u + 4) <= len; u += 4) {
+		__m256d x;
+
+		x = _mm256_loadu_pd(&y[u].v);
+		x = _mm256_sub_pd(x, _mm256_round_pd(x,
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		_mm_storeu_ps(&d[u], _mm256_cvtpd_ps(x));
+	}
+#endif // yyyAVX2-
+	for (; u < len; u ++) {
+		d[u] = (float)fpr_sub(y[u], fpr_of(fpr_rint(y[u]))).v;
+	}
+}
+
+/*
+ * Return 1 if each of the len values of z[] is within 1/4 of an
+ * integer, 0 otherwise.
+ */
+TARGET_AVX2
+static int
+lazy_near_int32(const float *z, size_t len)
+{
+	size_t u;
+	int r;
+
+	u = 0;
+	r = 1;
+#if FALCON_AVX2 // yyyAVX2+1
+	{
+		__m256 m, q, sm;
+
+		m = _mm256_setzero_ps();
+		q = _mm256_set1_ps(0.25f);
+		sm = _mm256_set1_ps(-0.0f);
+		for (; (u + 8) <= len; u += 8) {
+			__m256 x;
+
+			x = _mm256_loadu_ps(&z[u]);
+			x = _mm256_sub_ps(x, _mm256_round_ps(x,
+				_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+			m = _mm256_or_ps(m, _mm256_cmp_ps(
+				_mm256_andnot_ps(sm, x), q, _CMP_GT_OQ));
+		}
+		r = _mm256_movemask_ps(m) == 0;
+	}
+#endif // yyyAVX2-
+	for (; u < len; u ++) {
+		float x;
+
+		x = z[u] - (float)fpr_rint(FPR(z[u]));
+		r &= (x <= 0.25f && x >= -0.25f);
+	}
+	return r;
+}
+
+/*
+ * Single-precision version of lazy_babai_reduce() (full != 0) or of
+ * lazy_babai_reduce_s2() (full == 0), for LAZY_F32; t[] has room for
+ * 2*2^logn floats. The results are rounded by the caller; the exact
+ * values are integers (up to the error of the first Babai step), so
+ * the float results are normally within 2^-11 of an integer (the
+ * largest errors observed for logn = 9 and 10 are below 4e-4). If a
+ * value is within 1/4 of a rounding boundary, the float error might
+ * have moved it across the boundary: 0 is returned and y1, y2 are
+ * unmodified, so that the caller redoes the reduction in double
+ * precision. Otherwise, the results are written in y1 (if full) and y2
+ * and 1 is returned; rounding them gives the same integers as the
+ * double-precision reduction.
+ */
+static int
+lazy_babai_reduce32(fpr *restrict y1, fpr *restrict y2,
+	const fpr *restrict B, unsigned logn, int full, float *t)
+{
+	size_t n, u;
+	float *z1, *z2;
+
+	n = MKN(logn);
+	z1 = t;
+	z2 = z1 + n;
+	lazy_frac32(z1, y1, n);
+	lazy_frac32(z2, y2, n);
+	Zf(FFT32)(z1, logn);
+	Zf(FFT32)(z2, logn);
+	if (full) {
+		Zf(poly_basis_mul_fft32)(z1, z2, B, logn);
+		Zf(iFFT32)(z1, logn);
+		if (!lazy_near_int32(z1, n)) {
+			return 0;
+		}
+	} else {
+		Zf(poly_basis_mul2_fft32)(z1, z2, B, logn);
+	}
+	Zf(iFFT32)(z2, logn);
+	if (!lazy_near_int32(z2, n)) {
+		return 0;
+	}
+	for (u = 0; u < n; u ++) {
+		if (full) {
+			y1[u] = FPR(z1[u]);
+		}
+		y2[u] = FPR(z2[u]);
+	}
+	return 1;
+}
+#else
+#define lazy_babai_reduce32(y1, y2, B, logn, full, t)   0
+#endif
+
+/*
+ * Squared norm of s1 = hm - s2*h mod q (centered), computed with the
+ * NTT as in Zf(verify_raw)(). h_monty is the public key in NTT and
+ * Montgomery representation. tt[] has room for n elements. If the
+ * squared norm overflows, 2^32-1 is returned (saturated).
+ */
+static uint32_t
+lazy_s1_sqnorm(const int16_t *s2, const uint16_t *hm,
+	const uint16_t *h_monty, unsigned logn, uint16_t *tt)
+{
+	size_t n, u;
+	uint32_t sqn, ng;
+
+	n = MKN(logn);
+	for (u = 0; u < n; u ++) {
+		uint32_t w;
+
+		w = (uint32_t)s2[u];
+		w += Q & -(w >> 31);
+		tt[u] = (uint16_t)w;
+	}
+	Zf(mq_NTT)(tt, logn);
+	Zf(mq_poly_montymul_ntt)(tt, h_monty, logn);
+	Zf(mq_iNTT)(tt, logn);
+	sqn = 0;
+	ng = 0;
+	for (u = 0; u < n; u ++) {
+		int32_t z;
+
+		z = (int32_t)hm[u] - (int32_t)tt[u];
+		z += Q & -((uint32_t)z >> 31);
+		z -= (int32_t)(Q & -(((Q >> 1) - (uint32_t)z) >> 31));
+		sqn += (uint32_t)(z * z);
+		ng |= sqn;
+	}
+	return sqn | -(ng >> 31);
+}
+
+/* see inner.h */
+void
+short_preimage(const uint16_t *target, const fpr *restrict B_fft,
+	int32_t *res1, int32_t *res2, unsigned logn, fpr *restrict tmp)
+{
+	size_t n, u;
+	fpr *y1, *y2;
+
+	n = MKN(logn);
+	y1 = tmp;
+	y2 = y1 + n;
+
+	// y1 = hm, y2 = 0, put into FFT
+	for (u = 0; u < n; u ++) {
+		y1[u] = fpr_of(target[u]);
+	}
+	Zf(FFT)(y1, logn);
+
+	// (target,0) * [[F, -f][-G,g]] / q = (-h * F, h * f) / q
+	Zf(poly_basis_solve_fft)(y1, y2, B_fft, logn);
+	Zf(iFFT)(y1, logn);
+	Zf(iFFT)(y2, logn);
+
+	lazy_babai_reduce(y1, y2, B_fft, logn);
+
+	// round y1,y2 and write to res1,res2
+	for (u = 0; u < n; u ++) {
+		res1[u] = (int32_t)fpr_rint(y1[u]);
+		res2[u] = (int32_t)fpr_rint(y2[u]);
+	}
 }
 
 
@@ -1594,425 +1641,81 @@ do_sign_dyn(samplerZ samp, void *samp_ctx, int16_t *s2,
 }
 
 /// ONLINE OFFLINE DO SIGN FUNCTION
+/*
+ * End of the dynamic lazy signature, once the preimage (res1, res2) of
+ * the target is known: remove the Gaussian sample, check the norm and
+ * write s2. tmp[] must have room for n 16-bit words and must not
+ * overlap with res1 and res2.
+ */
 static int
-do_sign_dyn_lazy(int8_t* sample1, int8_t* sample2, uint16_t* sample_target,
-                 int16_t *s2,
-    const fpr *restrict f_fft, const fpr *restrict g_fft,
-    const fpr *restrict F_fft, const fpr *restrict G_fft,
-    const uint16_t *hm, unsigned logn, fpr *restrict tmp __attribute((unused)))
+dyn_lazy_finish(int32_t *res1, int32_t *res2,
+	const int8_t *sample1, const int8_t *sample2,
+	int16_t *s2, unsigned logn, int16_t *tmp)
 {
-    size_t n, u;
-    int loop __attribute((unused));
-
-    n = MKN(logn);
-
-	// for(loop = 0; loop < 10; loop++)
-	// 	printf("target x3[%d]: (%d),\n", loop, (int) x3[loop]);
-
-	// START ONLINE
-    int32_t res1[n];
-    int32_t res2[n];
-    // "real" target = hm + x3
-    falcon_inner_mq_poly_addto(sample_target, hm, logn);
-    short_preimage(sample_target, //
-                   f_fft, g_fft, //
-                   F_fft, G_fft, //
-                   res1, res2,  //
-                   logn);
-	
-    // remove the gaussian sample
-    for (size_t i=0; i<n; i++) {
-        res1[i] -= sample1[i];
-        res2[i] -= sample2[i];
-    }
+	size_t n, u;
+	uint32_t sqn, ng;
+	int r;
 
-	// for(loop = 0; loop < 10; loop++)
-	// 	printf("uncompressed_sig[%d]: (%d, %d),\n", loop, res1[loop], res2[loop]);
+	n = MKN(logn);
+
+	// remove the gaussian sample
+	for (u = 0; u < n; u ++) {
+		res1[u] -= sample1[u];
+		res2[u] -= sample2[u];
+	}
 
 	/*
 	 * Compute the signature.
 	 */
-	uint32_t sqn, ng;
 	sqn = 0;
 	ng = 0;
 	for (u = 0; u < n; u ++) {
 		int32_t z;
-		z = (int32_t)res1[u];
+
+		z = res1[u];
 		sqn += (uint32_t)(z * z);
 		ng |= sqn;
-		//y1tmp[u] = (int16_t)z;
 	}
 	sqn |= -(ng >> 31);
 
-	// for(loop = 0; loop < 10; loop++)
-	// 	printf("compressed_y1[%d]: (%d, %d),\n", loop, y1tmp[loop], y2_sig[loop]);	
-
-    int16_t y2tmp[n];
 	for (u = 0; u < n; u ++) {
-		y2tmp[u] = (int16_t)-res2[u];
-	}
-
-	if (Zf(is_short_half)(sqn, y2tmp, logn)) {
-		memcpy(s2, y2tmp, n * sizeof *s2);
-        return 1;
-	}
-    // signature size is probably not ok. let's still output it.
-    memcpy(s2, y2tmp, n * sizeof *s2);
-    return 0;
-}
-
-
-/*
- * Sample an integer value along a half-gaussian distribution centered
- * on zero and standard deviation 1.8205, with a precision of 72 bits.
- */
-TARGET_AVX2
-int
-Zf(gaussian0_sampler)(prng *p)
-{
-#if FALCON_AVX2 // yyyAVX2+1
-
-	/*
-	 * High words.
-	 */
-	static const union {
-		uint16_t u16[16];
-		__m256i ymm[1];
-	} rhi15 = {
-		{
-			0x51FB, 0x2A69, 0x113E, 0x0568,
-			0x014A, 0x003B, 0x0008, 0x0000,
-			0x0000, 0x0000, 0x0000, 0x0000,
-			0x0000, 0x0000, 0x0000, 0x0000
-		}
-	};
-
-	static const union {
-		uint64_t u64[20];
-		__m256i ymm[5];
-	} rlo57 = {
-		{
-			0x1F42ED3AC391802, 0x12B181F3F7DDB82,
-			0x1CDD0934829C1FF, 0x1754377C7994AE4,
-			0x1846CAEF33F1F6F, 0x14AC754ED74BD5F,
-			0x024DD542B776AE4, 0x1A1FFDC65AD63DA,
-			0x01F80D88A7B6428, 0x001C3FDB2040C69,
-			0x00012CF24D031FB, 0x00000949F8B091F,
-			0x0000003665DA998, 0x00000000EBF6EBB,
-			0x0000000002F5D7E, 0x000000000007098,
-			0x0000000000000C6, 0x000000000000001,
-			0x000000000000000, 0x000000000000000
-		}
-	};
-
-	uint64_t lo;
-	unsigned hi;
-	__m256i xhi, rhi, gthi, eqhi, eqm;
-	__m256i xlo, gtlo0, gtlo1, gtlo2, gtlo3, gtlo4;
-	__m128i t, zt;
-	int r;
-
-	/*
-	 * Get a 72-bit random value and split it into a low part
-	 * (57 bits) and a high part (15 bits)
-	 */
-	lo = prng_get_u64(p);
-	hi = prng_get_u8(p);
-	hi = (hi << 7) | (unsigned)(lo >> 57);
-	lo &= 0x1FFFFFFFFFFFFFF;
-
-	/*
-	 * Broadcast the high part and compare it with the relevant
-	 * values. We need both a "greater than" and an "equal"
-	 * comparisons.
-	 */
-	xhi = _mm256_broadcastw_epi16(_mm_cvtsi32_si128(hi));
-	rhi = _mm256_loadu_si256(&rhi15.ymm[0]);
-	gthi = _mm256_cmpgt_epi16(rhi, xhi);
-	eqhi = _mm256_cmpeq_epi16(rhi, xhi);
-
-	/*
-	 * The result is the number of 72-bit values (among the list of 19)
-	 * which are greater than the 72-bit random value. We first count
-	 * all non-zero 16-bit elements in the first eight of gthi. Such
-	 * elements have value -1 or 0, so we first negate them.
-	 */
-	t = _mm_srli_epi16(_mm256_castsi256_si128(gthi), 15);
-	zt = _mm_setzero_si128();
-	t = _mm_hadd_epi16(t, zt);
-	t = _mm_hadd_epi16(t, zt);
-	t = _mm_hadd_epi16(t, zt);
-	r = _mm_cvtsi128_si32(t);
-
-	/*
-	 * We must look at the low bits for all values for which the
-	 * high bits are an "equal" match; values 8-18 all have the
-	 * same high bits (0).
-	 * On 32-bit systems, 'lo' really is two registers, requiring
-	 * some extra code.
-	 */
-#if defined(__x86_64__) || defined(_M_X64)
-	xlo = _mm256_broadcastq_epi64(_mm_cvtsi64_si128(*(int64_t *)&lo));
-#else
-	{
-		uint32_t e0, e1;
-		int32_t f0, f1;
-
-		e0 = (uint32_t)lo;
-		e1 = (uint32_t)(lo >> 32);
-		f0 = *(int32_t *)&e0;
-		f1 = *(int32_t *)&e1;
-		xlo = _mm256_set_epi32(f1, f0, f1, f0, f1, f0, f1, f0);
+		tmp[u] = (int16_t)-res2[u];
 	}
-#endif
-	gtlo0 = _mm256_cmpgt_epi64(_mm256_loadu_si256(&rlo57.ymm[0]), xlo); 
-	gtlo1 = _mm256_cmpgt_epi64(_mm256_loadu_si256(&rlo57.ymm[1]), xlo); 
-	gtlo2 = _mm256_cmpgt_epi64(_mm256_loadu_si256(&rlo57.ymm[2]), xlo); 
-	gtlo3 = _mm256_cmpgt_epi64(_mm256_loadu_si256(&rlo57.ymm[3]), xlo); 
-	gtlo4 = _mm256_cmpgt_epi64(_mm256_loadu_si256(&rlo57.ymm[4]), xlo); 
-
-	/*
-	 * Keep only comparison results that correspond to the non-zero
-	 * elements in eqhi.
-	 */
-	gtlo0 = _mm256_and_si256(gtlo0, _mm256_cvtepi16_epi64(
-		_mm256_castsi256_si128(eqhi)));
-	gtlo1 = _mm256_and_si256(gtlo1, _mm256_cvtepi16_epi64(
-		_mm256_castsi256_si128(_mm256_bsrli_epi128(eqhi, 8))));
-	eqm = _mm256_permute4x64_epi64(eqhi, 0xFF);
-	gtlo2 = _mm256_and_si256(gtlo2, eqm);
-	gtlo3 = _mm256_and_si256(gtlo3, eqm);
-	gtlo4 = _mm256_and_si256(gtlo4, eqm);
-
-	/*
-	 * Add all values to count the total number of "-1" elements.
-	 * Since the first eight "high" words are all different, only
-	 * one element (at most) in gtlo0:gtlo1 can be non-zero; however,
-	 * if the high word of the random value is zero, then many
-	 * elements of gtlo2:gtlo3:gtlo4 can be non-zero.
-	 */
-	gtlo0 = _mm256_or_si256(gtlo0, gtlo1);
-	gtlo0 = _mm256_add_epi64(
-		_mm256_add_epi64(gtlo0, gtlo2),
-		_mm256_add_epi64(gtlo3, gtlo4));
-	t = _mm_add_epi64(
-		_mm256_castsi256_si128(gtlo0),
-		_mm256_extracti128_si256(gtlo0, 1));
-	t = _mm_add_epi64(t, _mm_srli_si128(t, 8));
-	r -= _mm_cvtsi128_si32(t);
+	r = Zf(is_short_half)(sqn, tmp, logn);
 
+	// a signature which is too long is still output
+	memcpy(s2, tmp, n * sizeof *s2);
 	return r;
-
-#else // yyyAVX2+0
-
-	static const uint32_t dist[] = {
-		10745844u,  3068844u,  3741698u,
-		 5559083u,  1580863u,  8248194u,
-		 2260429u, 13669192u,  2736639u,
-		  708981u,  4421575u, 10046180u,
-		  169348u,  7122675u,  4136815u,
-		   30538u, 13063405u,  7650655u,
-		    4132u, 14505003u,  7826148u,
-		     417u, 16768101u, 11363290u,
-		      31u,  8444042u,  8086568u,
-		       1u, 12844466u,   265321u,
-		       0u,  1232676u, 13644283u,
-		       0u,    38047u,  9111839u,
-		       0u,      870u,  6138264u,
-		       0u,       14u, 12545723u,
-		       0u,        0u,  3104126u,
-		       0u,        0u,    28824u,
-		       0u,        0u,      198u,
-		       0u,        0u,        1u
-	};
-
-	uint32_t v0, v1, v2, hi;
-	uint64_t lo;
-	size_t u;
-	int z;
-
-	/*
-	 * Get a random 72-bit value, into three 24-bit limbs v0..v2.
-	 */
-	lo = prng_get_u64(p);
-	hi = prng_get_u8(p);
-	v0 = (uint32_t)lo & 0xFFFFFF;
-	v1 = (uint32_t)(lo >> 24) & 0xFFFFFF;
-	v2 = (uint32_t)(lo >> 48) | (hi << 16);
-
-	/*
-	 * Sampled value is z, such that v0..v2 is lower than the first
-	 * z elements of the table.
-	 */
-	z = 0;
-	for (u = 0; u < (sizeof dist) / sizeof(dist[0]); u += 3) {
-		uint32_t w0, w1, w2, cc;
-
-		w0 = dist[u + 2];
-		w1 = dist[u + 1];
-		w2 = dist[u + 0];
-		cc = (v0 - w0) >> 31;
-		cc = (v1 - w1 - cc) >> 31;
-		cc = (v2 - w2 - cc) >> 31;
-		z += (int)cc;
-	}
-	return z;
-
-#endif // yyyAVX2-
 }
 
 /*
- * Sample a bit with probability exp(-x) for some x >= 0.
+ * Online part of the dynamic lazy signature. tmp[] must have room for
+ * 4*n fpr values.
  */
-TARGET_AVX2
 static int
-BerExp(prng *p, fpr x, fpr ccs)
+do_sign_dyn_lazy(int8_t *sample1, int8_t *sample2, uint16_t *sample_target,
+	int16_t *s2, const fpr *restrict B_fft,
+	const uint16_t *hm, unsigned logn, fpr *restrict tmp)
 {
-	int s, i;
-	fpr r;
-	uint32_t sw, w;
-	uint64_t z;
-
-	/*
-	 * Reduce x modulo log(2): x = s*log(2) + r, with s an integer,
-	 * and 0 <= r < log(2). Since x >= 0, we can use fpr_trunc().
-	 */
-	s = (int)fpr_trunc(fpr_mul(x, fpr_inv_log2));
-	r = fpr_sub(x, fpr_mul(fpr_of(s), fpr_log2));
-
-	/*
-	 * It may happen (quite rarely) that s >= 64; if sigma = 1.2
-	 * (the minimum value for sigma), r = 0 and b = 1, then we get
-	 * s >= 64 if the half-Gaussian produced a z >= 13, which happens
-	 * with probability about 0.000000000230383991, which is
-	 * approximatively equal to 2^(-32). In any case, if s >= 64,
-	 * then BerExp will be non-zero with probability less than
-	 * 2^(-64), so we can simply saturate s at 63.
-	 */
-	sw = (uint32_t)s;
-	sw ^= (sw ^ 63) & -((63 - sw) >> 31);
-	s = (int)sw;
+	size_t n;
+	int32_t *res1, *res2;
 
-	/*
-	 * Compute exp(-r); we know that 0 <= r < log(2) at this point, so
-	 * we can use fpr_expm_p63(), which yields a result scaled to 2^63.
-	 * We scale it up to 2^64, then right-shift it by s bits because
-	 * we really want exp(-x) = 2^(-s)*exp(-r).
-	 *
-	 * The "-1" operation makes sure that the value fits on 64 bits
-	 * (i.e. if r = 0, we may get 2^64, and we prefer 2^64-1 in that
-	 * case). The bias is negligible since fpr_expm_p63() only computes
-	 * with 51 bits of precision or so.
-	 */
-	z = ((fpr_expm_p63(r, ccs) << 1) - 1) >> s;
+	n = MKN(logn);
 
 	/*
-	 * Sample a bit with probability exp(-x). Since x = s*log(2) + r,
-	 * exp(-x) = 2^-s * exp(-r), we compare lazily exp(-x) with the
-	 * PRNG output to limit its consumption, the sign of the difference
-	 * yields the expected result.
+	 * short_preimage() uses the first half of tmp[]; the results
+	 * are written in the second half.
 	 */
-	i = 64;
-	do {
-		i -= 8;
-		w = prng_get_u8(p) - ((uint32_t)(z >> i) & 0xFF);
-	} while (!w && i > 0);
-	return (int)(w >> 31);
+	res1 = (int32_t *)(tmp + 2 * n);
+	res2 = res1 + n;
+
+	// "real" target = hm + x3
+	falcon_inner_mq_poly_addto(sample_target, hm, logn);
+	short_preimage(sample_target, B_fft, res1, res2, logn, tmp);
+	return dyn_lazy_finish(res1, res2, sample1, sample2,
+		s2, logn, (int16_t *)tmp);
 }
 
-/*
- * The sampler produces a random integer that follows a discrete Gaussian
- * distribution, centered on mu, and with standard deviation sigma. The
- * provided parameter isigma is equal to 1/sigma.
- *
- * The value of sigma MUST lie between 1 and 2 (i.e. isigma lies between
- * 0.5 and 1); in Falcon, sigma should always be between 1.2 and 1.9.
- */
-TARGET_AVX2
-int
-Zf(sampler)(void *ctx, fpr mu, fpr isigma)
-{
-	sampler_context *spc;
-	int s;
-	fpr r, dss, ccs;
-
-	spc = ctx;
-
-	/*
-	 * Center is mu. We compute mu = s + r where s is an integer
-	 * and 0 <= r < 1.
-	 */
-	s = (int)fpr_floor(mu);
-	r = fpr_sub(mu, fpr_of(s));
-
-	/*
-	 * dss = 1/(2*sigma^2) = 0.5*(isigma^2).
-	 */
-	dss = fpr_half(fpr_sqr(isigma));
-
-	/*
-	 * ccs = sigma_min / sigma = sigma_min * isigma.
-	 */
-	ccs = fpr_mul(isigma, spc->sigma_min);
-
-	/*
-	 * We now need to sample on center r.
-	 */
-	for (;;) {
-		int z0, z, b;
-		fpr x;
-
-		/*
-		 * Sample z for a Gaussian distribution. Then get a
-		 * random bit b to turn the sampling into a bimodal
-		 * distribution: if b = 1, we use z+1, otherwise we
-		 * use -z. We thus have two situations:
-		 *
-		 *  - b = 1: z >= 1 and sampled against a Gaussian
-		 *    centered on 1.
-		 *  - b = 0: z <= 0 and sampled against a Gaussian
-		 *    centered on 0.
-		 */
-		z0 = Zf(gaussian0_sampler)(&spc->p);
-		b = (int)prng_get_u8(&spc->p) & 1;
-		z = b + ((b << 1) - 1) * z0;
-
-		/*
-		 * Rejection sampling. We want a Gaussian centered on r;
-		 * but we sampled against a Gaussian centered on b (0 or
-		 * 1). But we know that z is always in the range where
-		 * our sampling distribution is greater than the Gaussian
-		 * distribution, so rejection works.
-		 *
-		 * We got z with distribution:
-		 *    G(z) = exp(-((z-b)^2)/(2*sigma0^2))
-		 * We target distribution:
-		 *    S(z) = exp(-((z-r)^2)/(2*sigma^2))
-		 * Rejection sampling works by keeping the value z with
-		 * probability S(z)/G(z), and starting again otherwise.
-		 * This requires S(z) <= G(z), which is the case here.
-		 * Thus, we simply need to keep our z with probability:
-		 *    P = exp(-x)
-		 * where:
-		 *    x = ((z-r)^2)/(2*sigma^2) - ((z-b)^2)/(2*sigma0^2)
-		 *
-		 * Here, we scale up the Bernouilli distribution, which
-		 * makes rejection more probable, but makes rejection
-		 * rate sufficiently decorrelated from the Gaussian
-		 * center and standard deviation that the whole sampler
-		 * can be said to be constant-time.
-		 */
-		x = fpr_mul(fpr_sqr(fpr_sub(fpr_of(z), r)), dss);
-		x = fpr_sub(x, fpr_mul(fpr_of(z0 * z0), fpr_inv_2sqrsigma0));
-		if (BerExp(&spc->p, x, ccs)) {
-			/*
-			 * Rejection sampling was centered on r, but the
-			 * actual center is mu = s + r.
-			 */
-			return s + z;
-		}
-	}
-}
 
 /* see inner.h */
 void
@@ -2107,11 +1810,11 @@ Zf(sign_dyn)(int16_t *sig, inner_shake256_context *rng,
 /* see inner.h */
 void
 Zf(sign_dyn_lazy)(int16_t *sig, inner_shake256_context *rng,
-                  const int8_t *restrict f, const int8_t *restrict g,
-                  const int8_t *restrict F, const int8_t *restrict G,
-                  const uint16_t *h,
-                  const uint16_t *hm, unsigned logn, uint8_t *tmp)
-                  __attribute((noinline));
+	const int8_t *restrict f, const int8_t *restrict g,
+	const int8_t *restrict F, const int8_t *restrict G,
+	const uint16_t *h,
+	const uint16_t *hm, unsigned logn, uint8_t *tmp)
+	__attribute((noinline));
 void
 Zf(sign_dyn_lazy)(int16_t *sig, inner_shake256_context *rng,
 	const int8_t *restrict f, const int8_t *restrict g,
@@ -2119,154 +1822,360 @@ Zf(sign_dyn_lazy)(int16_t *sig, inner_shake256_context *rng,
 	const uint16_t *h,
 	const uint16_t *hm, unsigned logn, uint8_t *tmp)
 {
-    const size_t n = MKN(logn);
-	fpr *ftmp;
-    fpr f_fft[n], g_fft[n], F_fft[n], G_fft[n];
+	size_t n;
+	fpr *B_fft, *ftmp;
+	int8_t *sample1, *sample2;
+	uint16_t *sample_target;
+
+	/*
+	 * Layout of tmp[]: interleaved basis in FFT representation (4*n
+	 * fpr), work area of both parts (4*n fpr), Gaussian samples (2*n
+	 * bytes) and the corresponding target (n 16-bit words).
+	 */
+	n = MKN(logn);
+	B_fft = (fpr *)tmp;
+	ftmp = B_fft + 4 * n;
+	sample_target = (uint16_t *)(ftmp + 4 * n);
+	sample1 = (int8_t *)(sample_target + n);
+	sample2 = sample1 + n;
+
+	sign_dyn_lazy_offline(rng, f, g, F, G, h, logn,
+		sample1, sample2, sample_target, B_fft, ftmp);
+	do_sign_dyn_lazy(sample1, sample2, sample_target, sig,
+		B_fft, hm, logn, ftmp);
+}
 
+/* see inner.h */
+int
+sign_dyn_lazy_online(int8_t *sample1, int8_t *sample2,
+	uint16_t *sample_target, int16_t *s2, const fpr *restrict B_fft,
+	const uint16_t *hm, unsigned logn, fpr *restrict tmp)
+{
+	return do_sign_dyn_lazy(sample1, sample2, sample_target, s2,
+		B_fft, hm, logn, tmp);
+}
 
-    // START OFFLINE
-    /*
-     * Lattice basis is B = [[g, f], [G, F]]. We convert it to FFT.
-     */
-    smallints_to_fpr(f_fft, f, logn);
-    smallints_to_fpr(g_fft, g, logn);
-    smallints_to_fpr(F_fft, F, logn);
-    smallints_to_fpr(G_fft, G, logn);
-    Zf(FFT)(f_fft, logn); // f
-    Zf(FFT)(g_fft, logn); // g
-    Zf(FFT)(F_fft, logn); // F
-    Zf(FFT)(G_fft, logn); // G
-
-    uint16_t h_monty[n];
-    memcpy(h_monty, h, n*sizeof(uint16_t));
-    falcon_inner_to_ntt_monty(h_monty, logn);
-
-    // compute the Gaussian blinding sample
-    // gaussian
-    sampler_context sc;
-    fpr isigma __attribute((unused)), mu __attribute((unused));
-    fpr muinc __attribute((unused)); // TODO check if really unused?;
-    Zf(prng_init)(&sc.p, rng);
-    sc.sigma_min = fpr_sigma_min[9];
-
-    isigma = fpr_div(fpr_of(10), fpr_of(17));
-    mu = fpr_neg(fpr_one);
-    muinc = fpr_div(fpr_one, fpr_of(10));
-
-    // modulo_lattice:  2n coords -> n coords mod q
-    //   any lattice point: modulo_lattice = 0
-    //   (x,0)              modulo_lattice(x,0) = x mod q
-    //                      modulo_lattice(q,0)
-    //                      modulo_lattice(h,1)
-    //   g = hf mod q?
-    //                      modulo_lattice(G,g)
-    //                      modulo_lattice(F,G)
-
-    // (int_x3, int_x4) are the small gaussian vector
-    int8_t sample1[n];
-    int8_t sample2[n];
-
-    // gauss_sampler(&sc, mu, isigma, sample1, n);
-    // gauss_sampler(&sc, mu, isigma, sample2, n);
-
-	sample_gaussian_poly_bern(sample1, sample2, n);
-
-    // for(int loop = 0; loop < 10; loop++)
-    // 	printf("gauss_x3x4[%d]: (%d, %d),\n", loop, sample1[loop], sample2[loop]);
-
-    // x3 = int_x3 - h * int_x4 mod q the target
-    uint16_t sample_target[n];
-    compute_target(h_monty, sample1, sample2, sample_target, logn);
-
-
-
-    ftmp = (fpr *)tmp;
-    /*
-	 * Do the actual signature.
+/* see inner.h */
+int
+sign_dyn_lazy_online_int(int8_t *sample1, int8_t *sample2,
+	uint16_t *sample_target, int16_t *s2, const uint32_t *restrict Bi,
+	const uint16_t *hm, unsigned logn, uint32_t *restrict tmp)
+{
+	size_t n;
+	int32_t *res1, *res2;
+
+	/*
+	 * short_preimage_int() uses the first 4*n words of tmp[].
 	 */
-	do_sign_dyn_lazy(
-        sample1,sample2,sample_target,
-        sig,
-	    f_fft, g_fft, F_fft, G_fft,
-        hm, logn, ftmp);
+	n = MKN(logn);
+	res1 = (int32_t *)(tmp + 4 * n);
+	res2 = res1 + n;
+	falcon_inner_mq_poly_addto(sample_target, hm, logn);
+	short_preimage_int(sample_target, Bi, res1, res2, logn, tmp);
+	return dyn_lazy_finish(res1, res2, sample1, sample2,
+		s2, logn, (int16_t *)tmp);
 }
 
+/* see inner.h */
+void
+sign_dyn_lazy_offline(inner_shake256_context *rng,
+	const int8_t *restrict f, const int8_t *restrict g,
+	const int8_t *restrict F, const int8_t *restrict G,
+	const uint16_t *h, unsigned logn,
+	int8_t *sample1, int8_t *sample2, uint16_t *sample_target,
+	fpr *restrict B_fft, fpr *restrict tmp)
+{
+	size_t n;
+	uint16_t *h_monty;
+	prng p;
+
+	n = MKN(logn);
+
+	/*
+	 * Gaussian blinding pair (sample1, sample2) and the target
+	 * sample1 - h*sample2 mod q. The public key in NTT + Montgomery
+	 * representation is kept in tmp[].
+	 */
+	h_monty = (uint16_t *)tmp;
+	memcpy(h_monty, h, n * sizeof *h);
+	Zf(to_ntt_monty)(h_monty, logn);
+	Zf(prng_init)(&p, rng);
+	sample_gaussian_poly_bern(&p, sample1, sample2, n);
+	memset(&p, 0, sizeof p);
+	compute_target(h_monty, sample1, sample2, sample_target, logn);
+	if (B_fft == NULL) {
+		return;
+	}
+
+	/*
+	 * Lattice basis is B = [[g, f], [G, F]]. We convert it to FFT,
+	 * one polynomial at a time, and interleave it.
+	 */
+	smallints_to_fpr(tmp, f, logn);
+	Zf(FFT)(tmp, logn);
+	Zf(poly_basis_set)(B_fft, tmp, BASIS_F, logn);
+	smallints_to_fpr(tmp, g, logn);
+	Zf(FFT)(tmp, logn);
+	Zf(poly_basis_set)(B_fft, tmp, BASIS_G, logn);
+	smallints_to_fpr(tmp, F, logn);
+	Zf(FFT)(tmp, logn);
+	Zf(poly_basis_set)(B_fft, tmp, BASIS_BF, logn);
+	smallints_to_fpr(tmp, G, logn);
+	Zf(FFT)(tmp, logn);
+	Zf(poly_basis_set)(B_fft, tmp, BASIS_BG, logn);
+}
+
+/* see inner.h */
+void
+Zf(lazy_expand_key)(fpr *restrict expkey,
+	const int8_t *f, const int8_t *g,
+	const int8_t *F, const int8_t *G,
+	const uint16_t *h, unsigned logn)
+{
+	size_t n;
+	fpr *B_fft, *mFq_fft, *fq_fft;
+	uint16_t *h_monty;
+
+	n = MKN(logn);
+	B_fft = expkey;
+	mFq_fft = B_fft + 4 * n;
+	fq_fft = mFq_fft + n;
+	h_monty = (uint16_t *)(fq_fft + n);
+
+	/*
+	 * Lattice basis is B = [[g, f], [G, F]]. We convert it to FFT
+	 * and interleave it; g and G go through mFq_fft[], which is
+	 * computed last.
+	 */
+	smallints_to_fpr(mFq_fft, g, logn);
+	Zf(FFT)(mFq_fft, logn);
+	Zf(poly_basis_set)(B_fft, mFq_fft, BASIS_G, logn);
+	smallints_to_fpr(mFq_fft, G, logn);
+	Zf(FFT)(mFq_fft, logn);
+	Zf(poly_basis_set)(B_fft, mFq_fft, BASIS_BG, logn);
+	smallints_to_fpr(fq_fft, f, logn);
+	Zf(FFT)(fq_fft, logn);
+	Zf(poly_basis_set)(B_fft, fq_fft, BASIS_F, logn);
+	smallints_to_fpr(mFq_fft, F, logn);
+	Zf(FFT)(mFq_fft, logn);
+	Zf(poly_basis_set)(B_fft, mFq_fft, BASIS_BF, logn);
+
+	/*
+	 * First Babai step: (t, 0)*B^(-1) = t*(-F, f)/q. We keep the
+	 * two multipliers, already scaled by 1/q.
+	 */
+	Zf(poly_mulconst)(mFq_fft, fpr_neg(fpr_inverse_of_q), logn);
+	Zf(poly_mulconst)(fq_fft, fpr_inverse_of_q, logn);
+
+	memcpy(h_monty, h, n * sizeof *h);
+	Zf(to_ntt_monty)(h_monty, logn);
+}
+
+/* see inner.h */
+void
+Zf(sign_lazy_offline)(inner_shake256_context *rng,
+	const fpr *restrict expkey,
+	int8_t *sample1, int8_t *sample2, fpr *restrict yt,
+	unsigned logn)
+{
+	size_t n, u;
+	const fpr *mFq_fft, *fq_fft;
+	const uint16_t *h_monty;
+	uint16_t *t;
+	prng p;
+
+	n = MKN(logn);
+	mFq_fft = expkey + 4 * n;
+	fq_fft = mFq_fft + n;
+	h_monty = (const uint16_t *)(expkey + LAZY_EXPKEY_FPR(logn));
+
+	/*
+	 * The target is computed in the second half of yt[], which is
+	 * not yet used.
+	 */
+	t = (uint16_t *)(yt + n);
+	Zf(prng_init)(&p, rng);
+	sample_gaussian_poly_bern(&p, sample1, sample2, n);
+	memset(&p, 0, sizeof p);
+	compute_target(h_monty, sample1, sample2, t, logn);
+	for (u = 0; u < n; u ++) {
+		yt[u] = fpr_of(t[u]);
+	}
+
+	/*
+	 * The first Babai step is linear in the target: the token part
+	 * is kept in FFT representation, to be added to the message
+	 * part in the online phase.
+	 */
+	Zf(FFT)(yt, logn);
+	memcpy(yt + n, yt, n * sizeof *yt);
+	Zf(poly_mul_fft)(yt, mFq_fft, logn);
+	Zf(poly_mul_fft)(yt + n, fq_fft, logn);
+}
+
+/* see inner.h */
 int
-sign_dyn_lazy_online(
-        int8_t* sample1, int8_t* sample2, uint16_t* sample_target,
-                int16_t *s2,
-                 const fpr *restrict f_fft, const fpr *restrict g_fft,
-                 const fpr *restrict F_fft, const fpr *restrict G_fft,
-                 const uint16_t *hm, unsigned logn, fpr *restrict tmp __attribute((unused))) {
-	// add/remove to trigger denoised or noised (with Gaussian noise) respectively
-	// const size_t n = MKN(logn);
-    // memset(sample1, 0, n*sizeof(int8_t));
-    // memset(sample2, 0, n*sizeof(int8_t));
-	// memset(sample_target, 0, n*sizeof(uint16_t));
-    return do_sign_dyn_lazy(sample1, sample2, sample_target, s2, f_fft, g_fft, F_fft, G_fft, hm, logn, tmp);
+Zf(sign_lazy_online)(int16_t *restrict s2, const fpr *restrict expkey,
+	const int8_t *sample1, const int8_t *sample2,
+	const fpr *restrict yt, const uint16_t *hm,
+	unsigned logn, int norm, fpr *restrict tmp)
+{
+	size_t n, u;
+	const fpr *B_fft, *mFq_fft, *fq_fft;
+	const uint16_t *h_monty;
+	fpr *y1, *y2;
+	uint32_t sqn, ng;
+	int f32;
+
+	n = MKN(logn);
+	f32 = norm & LAZY_F32;
+	norm &= ~LAZY_F32;
+	B_fft = expkey;
+	mFq_fft = B_fft + 4 * n;
+	fq_fft = mFq_fft + n;
+	h_monty = (const uint16_t *)(expkey + LAZY_EXPKEY_FPR(logn));
+	y1 = tmp;
+	y2 = y1 + n;
+
+	/*
+	 * "Real" target is hm + sample_target; the token already holds
+	 * FFT(sample_target)*(-F, f)/q. The sum is not reduced modulo
+	 * q: adding q to a coefficient of the target adds a vector of
+	 * the lattice ((q, 0) = (-F, f)*B), which the Babai rounding
+	 * removes again.
+	 */
+	for (u = 0; u < n; u ++) {
+		y1[u] = fpr_of(hm[u]);
+	}
+	Zf(FFT)(y1, logn);
+	memcpy(y2, y1, n * sizeof *y1);
+	Zf(poly_mul_fft)(y1, mFq_fft, logn);
+	Zf(poly_mul_fft)(y2, fq_fft, logn);
+	Zf(poly_add)(y1, yt, logn);
+	Zf(poly_add)(y2, yt + n, logn);
+	Zf(iFFT)(y1, logn);
+	Zf(iFFT)(y2, logn);
+
+	if (norm != LAZY_NORM_FULL) {
+		/*
+		 * Only the second half goes into the signature; the
+		 * norm of the first half, if needed, is recomputed from
+		 * s1 = hm - s2*h mod q.
+		 */
+		if (!f32 || !lazy_babai_reduce32(y1, y2, B_fft, logn,
+			0, (float *)(y2 + n)))
+		{
+			lazy_babai_reduce_s2(y1, y2, B_fft, logn);
+		}
+		for (u = 0; u < n; u ++) {
+			s2[u] = (int16_t)(sample2[u]
+				- (int32_t)fpr_rint(y2[u]));
+		}
+		if (norm == LAZY_NORM_SKIP) {
+			return 1;
+		}
+		sqn = lazy_s1_sqnorm(s2, hm, h_monty, logn,
+			(uint16_t *)(y2 + n));
+		return Zf(is_short_half)(sqn, s2, logn);
+	}
+
+	if (!f32 || !lazy_babai_reduce32(y1, y2, B_fft, logn,
+		1, (float *)(y2 + n)))
+	{
+		lazy_babai_reduce(y1, y2, B_fft, logn);
+	}
+
+	/*
+	 * Round, remove the Gaussian sample, and compute the norm of
+	 * the first half; the signature is the negated second half.
+	 */
+	sqn = 0;
+	ng = 0;
+	for (u = 0; u < n; u ++) {
+		int32_t z;
+
+		z = (int32_t)fpr_rint(y1[u]) - sample1[u];
+		sqn += (uint32_t)(z * z);
+		ng |= sqn;
+		s2[u] = (int16_t)(sample2[u] - (int32_t)fpr_rint(y2[u]));
+	}
+	sqn |= -(ng >> 31);
+	return Zf(is_short_half)(sqn, s2, logn);
 }
 
-void sign_dyn_lazy_offline(
-        // inputs
-        inner_shake256_context *rng,
-                           const int8_t *restrict f, const int8_t *restrict g,
-                           const int8_t *restrict F, const int8_t *restrict G,
-                           const uint16_t *h,
-                           unsigned logn,
-                           //outputs
-        int8_t* sample1, int8_t* sample2, uint16_t* sample_target,
-        fpr *restrict f_fft, fpr *restrict g_fft,
-        fpr *restrict F_fft, fpr *restrict G_fft
-                                   ) {
-    const size_t n = MKN(logn);
-
-    // START OFFLINE
-    /*
-     * Lattice basis is B = [[g, f], [G, F]]. We convert it to FFT.
-     */
-    smallints_to_fpr(f_fft, f, logn);
-    smallints_to_fpr(g_fft, g, logn);
-    smallints_to_fpr(F_fft, F, logn);
-    smallints_to_fpr(G_fft, G, logn);
-    Zf(FFT)(f_fft, logn); // f
-    Zf(FFT)(g_fft, logn); // g
-    Zf(FFT)(F_fft, logn); // F
-    Zf(FFT)(G_fft, logn); // G
-
-    uint16_t h_monty[n];
-    memcpy(h_monty, h, n * sizeof(uint16_t));
-    falcon_inner_to_ntt_monty(h_monty, logn);
-
-    // compute the Gaussian blinding sample
-    // gaussian
-    sampler_context sc;
-    fpr isigma __attribute((unused)), mu __attribute((unused));
-    fpr muinc __attribute((unused)); // TODO check if really unused?;
-    Zf(prng_init)(&sc.p, rng);
-    sc.sigma_min = fpr_sigma_min[9];
-
-    isigma = fpr_div(fpr_of(10), fpr_of(17));
-    mu = fpr_neg(fpr_one);
-    muinc = fpr_div(fpr_one, fpr_of(10));
-
-    // modulo_lattice:  2n coords -> n coords mod q
-    //   any lattice point: modulo_lattice = 0
-    //   (x,0)              modulo_lattice(x,0) = x mod q
-    //                      modulo_lattice(q,0)
-    //                      modulo_lattice(h,1)
-    //   g = hf mod q?
-    //                      modulo_lattice(G,g)
-    //                      modulo_lattice(F,G)
-
-    // (int_x3,int_x4) are the small gaussian vector
-
-	// remove below for falcon sampler
-    // gauss_sampler(&sc, mu, isigma, sample1, n);
-    // gauss_sampler(&sc, mu, isigma, sample2, n);
-
-	// bliss-like gaussian sampler
-	sample_gaussian_poly_bern(sample1, sample2, n);
-
-    // x3 = int_x3 - h * int_x4 mod q the target
-    compute_target(h_monty, sample1, sample2, sample_target, logn);
+/* see inner.h */
+TARGET_AVX2
+void
+Zf(sign_lazy_online_batch)(int16_t *const *s2,
+	const fpr *restrict expkey,
+	const int8_t *const *sample2, const fpr *const *yt,
+	const uint16_t *const *hm, unsigned logn, fpr *restrict tmp)
+{
+	size_t n, u;
+	unsigned l;
+	const fpr *B_fft, *mFq_fft, *fq_fft;
+	fpr *y1, *y2;
+
+	n = MKN(logn);
+	B_fft = expkey;
+	mFq_fft = B_fft + 4 * n;
+	fq_fft = mFq_fft + n;
+	y1 = tmp;
+	y2 = y1 + (n << 2);
+
+	/*
+	 * First Babai step, as in Zf(sign_lazy_online)(), on the four
+	 * interleaved targets.
+	 */
+	for (u = 0; u < n; u ++) {
+		for (l = 0; l < LAZY_BATCH; l ++) {
+			y1[(u << 2) + l] = fpr_of(hm[l][u]);
+		}
+	}
+	Zf(FFT_x4)(y1, logn);
+	memcpy(y2, y1, (n << 2) * sizeof *y1);
+	Zf(poly_mul_fft_x4)(y1, mFq_fft, logn);
+	Zf(poly_mul_fft_x4)(y2, fq_fft, logn);
+	for (u = 0; u < n; u ++) {
+		for (l = 0; l < LAZY_BATCH; l ++) {
+			y1[(u << 2) + l] = fpr_add(
+				y1[(u << 2) + l], yt[l][u]);
+			y2[(u << 2) + l] = fpr_add(
+				y2[(u << 2) + l], yt[l][u + n]);
+		}
+	}
+	Zf(iFFT_x4)(y1, logn);
+	Zf(iFFT_x4)(y2, logn);
+
+	/*
+	 * Reduction against the basis, second half only (see
+	 * lazy_babai_reduce_s2()).
+	 */
+	lazy_frac(y1, n << 2);
+	lazy_frac(y2, n << 2);
+	Zf(FFT_x4)(y1, logn);
+	Zf(FFT_x4)(y2, logn);
+	Zf(poly_basis_mul2_fft_x4)(y1, y2, B_fft, logn);
+	Zf(iFFT_x4)(y2, logn);
+
+	for (u = 0; u < n; u ++) {
+#if FALCON_AVX2 // yyyAVX2+1
+		union {
+			int32_t w[4];
+			__m128i x;
+		} r;
+
+		r.x = _mm256_cvtpd_epi32(_mm256_round_pd(
+			_mm256_loadu_pd(&y2[u << 2].v),
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		for (l = 0; l < LAZY_BATCH; l ++) {
+			s2[l][u] = (int16_t)(sample2[l][u] - r.w[l]);
+		}
+#else // yyyAVX2+0
+		for (l = 0; l < LAZY_BATCH; l ++) {
+			s2[l][u] = (int16_t)(sample2[l][u]
+				- (int32_t)fpr_rint(y2[(u << 2) + l]));
+		}
+#endif // yyyAVX2-
+	}
 }
@@ -0,0 +1,455 @@
+/*
+ * Integer-only preimage computation for the lazy signature (no
+ * floating-point, for targets without a FPU).
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <string.h>
+
+#include "inner.h"
+
+#define MKN(logn)   ((size_t)1 << (logn))
+
+uint32_t mq_conv_small(int x);
+
+/*
+ * short_preimage() computes y = (t, 0)*B^-1 = (-t*F, t*f)/q, then
+ * round((y - round(y))*B). Everything here is an integer polynomial
+ * divided by q, so the same result is obtained exactly:
+ *
+ *   A1 = -t*F and A2 = t*f are integer polynomials; since q is odd,
+ *   no coefficient of A/q is at a tie, and round(A/q) = (A - r)/q,
+ *   where r is A mod q, normalized to -(q-1)/2..+(q-1)/2.
+ *
+ *   With z = round(y), (y - z)*B = (t - z1*g - z2*G, -z1*f - z2*F)
+ *   (this uses f*G - g*F = q), which is an integer vector.
+ *
+ * Bounds, for logn <= 10, 0 <= t < q and key coefficients in -127..+127:
+ *   |A|       <= 1024*12288*127 < 2^31
+ *   |z|       <= |A|/q + 1/2 < 130049
+ *   |res1|    <= (|g|_1 + |G|_1)/2 <= 1024*127 (since |y - z| <= 1/2)
+ *   |res2|    <= (|f|_1 + |F|_1)/2 <= 1024*127
+ * A is too large to be recovered from a single 31-bit prime, but its
+ * residue modulo q is obtained with the usual NTT modulo q. Then z and
+ * res are computed modulo a prime p = 1 mod 2048 with p > 2^31 - 2^14,
+ * and since they are lower than p/2 in absolute value, they are
+ * recovered exactly from their normalized residues.
+ *
+ * The result is thus exactly the integer vector that the floating-point
+ * code rounds to: there is no approximation, hence no case where a
+ * fallback would be needed. The floating-point code itself is correct
+ * as long as its error stays below the distance of y to the nearest
+ * tie (at least 1/(2q)) and below 1/2 on the final rounding.
+ */
+
+/*
+ * The modulus q, the prime p, a primitive 2048-th root of 1 modulo p, and 1/q mod p
+ * in Montgomery representation (i.e. 2^31/q mod p). p and its root are
+ * the first entry of the small primes table in keygen.c.
+ */
+#define Q         12289
+#define IP        2147473409
+#define IP_G      383167813
+#define IP_IQM    1449007203
+
+/*
+ * The modp_*() functions below are the ones of keygen.c (Montgomery
+ * representation with R = 2^31), restricted to what is needed here.
+ */
+
+static inline uint32_t
+modp_set(int32_t x, uint32_t p)
+{
+	uint32_t w;
+
+	w = (uint32_t)x;
+	w += p & -(w >> 31);
+	return w;
+}
+
+static inline int32_t
+modp_norm(uint32_t x, uint32_t p)
+{
+	return (int32_t)(x - (p & (((x - ((p + 1) >> 1)) >> 31) - 1)));
+}
+
+static uint32_t
+modp_ninv31(uint32_t p)
+{
+	uint32_t y;
+
+	y = 2 - p;
+	y *= 2 - p * y;
+	y *= 2 - p * y;
+	y *= 2 - p * y;
+	y *= 2 - p * y;
+	return (uint32_t)0x7FFFFFFF & -y;
+}
+
+static inline uint32_t
+modp_R(uint32_t p)
+{
+	return ((uint32_t)1 << 31) - p;
+}
+
+static inline uint32_t
+modp_add(uint32_t a, uint32_t b, uint32_t p)
+{
+	uint32_t d;
+
+	d = a + b - p;
+	d += p & -(d >> 31);
+	return d;
+}
+
+static inline uint32_t
+modp_sub(uint32_t a, uint32_t b, uint32_t p)
+{
+	uint32_t d;
+
+	d = a - b;
+	d += p & -(d >> 31);
+	return d;
+}
+
+static inline uint32_t
+modp_montymul(uint32_t a, uint32_t b, uint32_t p, uint32_t p0i)
+{
+	uint64_t z, w;
+	uint32_t d;
+
+	z = (uint64_t)a * (uint64_t)b;
+	w = ((z * p0i) & (uint64_t)0x7FFFFFFF) * p;
+	d = (uint32_t)((z + w) >> 31) - p;
+	d += p & -(d >> 31);
+	return d;
+}
+
+/*
+ * Compute R2 = 2^62 mod p.
+ */
+static uint32_t
+modp_R2(uint32_t p, uint32_t p0i)
+{
+	uint32_t z;
+
+	z = modp_R(p);
+	z = modp_add(z, z, p);
+	z = modp_montymul(z, z, p, p0i);
+	z = modp_montymul(z, z, p, p0i);
+	z = modp_montymul(z, z, p, p0i);
+	z = modp_montymul(z, z, p, p0i);
+	z = modp_montymul(z, z, p, p0i);
+	z = (z + (p & -(z & 1))) >> 1;
+	return z;
+}
+
+/*
+ * Reverse the low 'bits' bits of x.
+ */
+static inline size_t
+bitrev(size_t x, unsigned bits)
+{
+	size_t r;
+	unsigned i;
+
+	r = 0;
+	for (i = 0; i < bits; i ++) {
+		r = (r << 1) | ((x >> i) & 1);
+	}
+	return r;
+}
+
+/*
+ * Fill gm[] and igm[] with the powers of a primitive 2n-th root of 1
+ * and of its inverse, in bit-reversed order and Montgomery
+ * representation (as modp_mkgm2() in keygen.c).
+ */
+static void
+modp_mkgm2(uint32_t *restrict gm, uint32_t *restrict igm, unsigned logn,
+	uint32_t p, uint32_t p0i)
+{
+	size_t u, n;
+	unsigned k;
+	uint32_t g, ig, x1, x2, R2;
+
+	n = (size_t)1 << logn;
+	R2 = modp_R2(p, p0i);
+	g = modp_montymul(IP_G, R2, p, p0i);
+	for (k = logn; k < 10; k ++) {
+		g = modp_montymul(g, g, p, p0i);
+	}
+
+	/*
+	 * 1/g = g^(2n-1), since g has order 2n.
+	 */
+	ig = g;
+	for (k = 0; k < logn; k ++) {
+		ig = modp_montymul(ig, ig, p, p0i);
+		ig = modp_montymul(ig, g, p, p0i);
+	}
+
+	x1 = x2 = modp_R(p);
+	for (u = 0; u < n; u ++) {
+		size_t v;
+
+		v = bitrev(u, logn);
+		gm[v] = x1;
+		igm[v] = x2;
+		x1 = modp_montymul(x1, g, p, p0i);
+		x2 = modp_montymul(x2, ig, p, p0i);
+	}
+}
+
+static void
+modp_NTT2(uint32_t *a, const uint32_t *gm, unsigned logn,
+	uint32_t p, uint32_t p0i)
+{
+	size_t t, m, n;
+
+	if (logn == 0) {
+		return;
+	}
+	n = (size_t)1 << logn;
+	t = n;
+	for (m = 1; m < n; m <<= 1) {
+		size_t ht, u, v1;
+
+		ht = t >> 1;
+		for (u = 0, v1 = 0; u < m; u ++, v1 += t) {
+			uint32_t s;
+			size_t v;
+			uint32_t *r1, *r2;
+
+			s = gm[m + u];
+			r1 = a + v1;
+			r2 = r1 + ht;
+			for (v = 0; v < ht; v ++) {
+				uint32_t x, y;
+
+				x = r1[v];
+				y = modp_montymul(r2[v], s, p, p0i);
+				r1[v] = modp_add(x, y, p);
+				r2[v] = modp_sub(x, y, p);
+			}
+		}
+		t = ht;
+	}
+}
+
+static void
+modp_iNTT2(uint32_t *a, const uint32_t *igm, unsigned logn,
+	uint32_t p, uint32_t p0i)
+{
+	size_t t, m, n, u;
+	uint32_t ni;
+
+	if (logn == 0) {
+		return;
+	}
+	n = (size_t)1 << logn;
+	t = 1;
+	for (m = n; m > 1; m >>= 1) {
+		size_t hm, dt, v1;
+
+		hm = m >> 1;
+		dt = t << 1;
+		for (u = 0, v1 = 0; u < hm; u ++, v1 += dt) {
+			uint32_t s;
+			size_t v;
+			uint32_t *r1, *r2;
+
+			s = igm[hm + u];
+			r1 = a + v1;
+			r2 = r1 + t;
+			for (v = 0; v < t; v ++) {
+				uint32_t x, y;
+
+				x = r1[v];
+				y = r2[v];
+				r1[v] = modp_add(x, y, p);
+				r2[v] = modp_montymul(
+					modp_sub(x, y, p), s, p, p0i);
+			}
+		}
+		t = dt;
+	}
+
+	/*
+	 * 1/n in Montgomery representation is R/n = 2^(31-logn).
+	 */
+	ni = (uint32_t)1 << (31 - logn);
+	for (u = 0; u < n; u ++) {
+		a[u] = modp_montymul(a[u], ni, p, p0i);
+	}
+}
+
+/*
+ * Convert a small polynomial to NTT representation modulo p, then to
+ * Montgomery representation (so that a Montgomery product with a value
+ * in normal representation yields a value in normal representation).
+ */
+static void
+modp_small_to_ntt_monty(uint32_t *d, const int8_t *a, const uint32_t *gm,
+	unsigned logn, uint32_t p, uint32_t p0i, uint32_t R2)
+{
+	size_t n, u;
+
+	n = (size_t)1 << logn;
+	for (u = 0; u < n; u ++) {
+		d[u] = modp_set(a[u], p);
+	}
+	modp_NTT2(d, gm, logn, p, p0i);
+	for (u = 0; u < n; u ++) {
+		d[u] = modp_montymul(d[u], R2, p, p0i);
+	}
+}
+
+/* see inner.h */
+void
+sign_dyn_lazy_basis_int(uint32_t *restrict Bi,
+	const int8_t *restrict f, const int8_t *restrict g,
+	const int8_t *restrict F, const int8_t *restrict G, unsigned logn)
+{
+	size_t n, u;
+	uint32_t p0i, R2;
+	uint32_t *gm, *igm;
+	uint16_t *mFq, *fq;
+
+	n = MKN(logn);
+	p0i = modp_ninv31(IP);
+	R2 = modp_R2(IP, p0i);
+	gm = Bi;
+	igm = gm + n;
+	mFq = (uint16_t *)(Bi + 6 * n);
+	fq = mFq + n;
+
+	modp_mkgm2(gm, igm, logn, IP, p0i);
+	modp_small_to_ntt_monty(Bi + 2 * n, f, gm, logn, IP, p0i, R2);
+	modp_small_to_ntt_monty(Bi + 3 * n, g, gm, logn, IP, p0i, R2);
+	modp_small_to_ntt_monty(Bi + 4 * n, F, gm, logn, IP, p0i, R2);
+	modp_small_to_ntt_monty(Bi + 5 * n, G, gm, logn, IP, p0i, R2);
+
+	for (u = 0; u < n; u ++) {
+		mFq[u] = (uint16_t)mq_conv_small(-F[u]);
+		fq[u] = (uint16_t)mq_conv_small(f[u]);
+	}
+	Zf(to_ntt_monty)(mFq, logn);
+	Zf(to_ntt_monty)(fq, logn);
+}
+
+/* see inner.h */
+void
+short_preimage_int(const uint16_t *target, const uint32_t *restrict Bi,
+	int32_t *res1, int32_t *res2, unsigned logn, uint32_t *restrict tmp)
+{
+	size_t n, u;
+	uint32_t p0i;
+	const uint32_t *gm, *igm, *pf, *pg, *pF, *pG;
+	const uint16_t *mFq, *fq;
+	uint32_t *t, *z1, *z2;
+	uint16_t *r1, *r2;
+
+	n = MKN(logn);
+	p0i = modp_ninv31(IP);
+	gm = Bi;
+	igm = gm + n;
+	pf = igm + n;
+	pg = pf + n;
+	pF = pg + n;
+	pG = pF + n;
+	mFq = (const uint16_t *)(pG + n);
+	fq = mFq + n;
+
+	t = tmp;
+	z1 = t + n;
+	z2 = z1 + n;
+	r1 = (uint16_t *)(z2 + n);
+	r2 = r1 + n;
+
+	/*
+	 * A1 = -t*F and A2 = t*f, modulo q.
+	 */
+	memcpy(r1, target, n * sizeof *target);
+	Zf(mq_NTT)(r1, logn);
+	memcpy(r2, r1, n * sizeof *r1);
+	Zf(mq_poly_montymul_ntt)(r1, mFq, logn);
+	Zf(mq_poly_montymul_ntt)(r2, fq, logn);
+	Zf(mq_iNTT)(r1, logn);
+	Zf(mq_iNTT)(r2, logn);
+
+	/*
+	 * A1 and A2 modulo p.
+	 */
+	for (u = 0; u < n; u ++) {
+		t[u] = target[u];
+	}
+	modp_NTT2(t, gm, logn, IP, p0i);
+	for (u = 0; u < n; u ++) {
+		z1[u] = IP - modp_montymul(t[u], pF[u], IP, p0i);
+		z2[u] = modp_montymul(t[u], pf[u], IP, p0i);
+	}
+	modp_iNTT2(z1, igm, logn, IP, p0i);
+	modp_iNTT2(z2, igm, logn, IP, p0i);
+
+	/*
+	 * z = (A - (A mod q))/q, modulo p.
+	 */
+	for (u = 0; u < n; u ++) {
+		int32_t c1, c2;
+
+		c1 = (int32_t)r1[u];
+		c1 -= (int32_t)(Q & -(((Q >> 1) - (uint32_t)c1) >> 31));
+		c2 = (int32_t)r2[u];
+		c2 -= (int32_t)(Q & -(((Q >> 1) - (uint32_t)c2) >> 31));
+		z1[u] = modp_montymul(modp_sub(z1[u], modp_set(c1, IP), IP),
+			IP_IQM, IP, p0i);
+		z2[u] = modp_montymul(modp_sub(z2[u], modp_set(c2, IP), IP),
+			IP_IQM, IP, p0i);
+	}
+
+	/*
+	 * (z1*g + z2*G, z1*f + z2*F), modulo p; the result is small
+	 * enough to be recovered exactly.
+	 */
+	modp_NTT2(z1, gm, logn, IP, p0i);
+	modp_NTT2(z2, gm, logn, IP, p0i);
+	for (u = 0; u < n; u ++) {
+		uint32_t a, b;
+
+		a = z1[u];
+		b = z2[u];
+		t[u] = modp_add(modp_montymul(a, pg[u], IP, p0i),
+			modp_montymul(b, pG[u], IP, p0i), IP);
+		z2[u] = modp_add(modp_montymul(a, pf[u], IP, p0i),
+			modp_montymul(b, pF[u], IP, p0i), IP);
+	}
+	modp_iNTT2(t, igm, logn, IP, p0i);
+	modp_iNTT2(z2, igm, logn, IP, p0i);
+	for (u = 0; u < n; u ++) {
+		res1[u] = (int32_t)target[u] - modp_norm(t[u], IP);
+		res2[u] = -modp_norm(z2[u], IP);
+	}
+}
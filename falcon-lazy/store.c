@@ -0,0 +1,452 @@
+/*
+ * Memory-mapped persistent token store for the lazy (online/offline)
+ * signer.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "falcon.h"
+#include "inner.h"
+
+/*
+ * File layout (all integers in native byte order; the byte order mark
+ * rejects files moved to a host with another endianness):
+ *
+ *   offset   size   contents
+ *      0       8    magic "FLZTOK02"
+ *      8       4    byte order mark 0x01020304
+ *     12       4    logn
+ *     16       4    token size (FALCON_LAZY_TOKEN_SIZE(logn))
+ *     20       4    reserved (zero)
+ *     24       8    number of tokens
+ *     32      32    key fingerprint: SHAKE256(public key), 32 bytes
+ *     64       8    consumption cursor (index of the next token)
+ *     72    4024    reserved (zero)
+ *   4096     ...    tokens, each in the falcon_sign_lazy_offline()
+ *                   format
+ *
+ * The cursor is advanced with an atomic fetch-and-add on the shared
+ * mapping, so that several threads or processes may consume tokens
+ * from the same file; each index is handed out only once. Unless
+ * FALCON_LAZY_STORE_NOSYNC is used, the header page is written back
+ * to disk (msync()) before the token is used: after a crash, the
+ * cursor may have skipped tokens, but never goes back.
+ */
+#define STORE_MAGIC       "FLZTOK02"
+#define STORE_BOM         0x01020304u
+#define STORE_HEADER_LEN  4096u
+
+#define OFF_BOM           8
+#define OFF_LOGN          12
+#define OFF_TOKEN_LEN     16
+#define OFF_COUNT         24
+#define OFF_FINGERPRINT   32
+#define OFF_CURSOR        64
+
+struct falcon_lazy_store_ {
+	uint8_t *map;
+	size_t map_len;
+	unsigned logn;
+	size_t token_len;
+	uint64_t count;
+	int flags;
+
+	/*
+	 * Public key of the store, in the representation of the lazy
+	 * expanded key (see Zf(lazy_expkey_h)()), so that signing
+	 * rejects an expanded key made for another key pair.
+	 */
+	uint16_t *h;
+};
+
+static void
+key_fingerprint(uint8_t *fp, const void *pubkey, size_t pubkey_len)
+{
+	inner_shake256_context sc;
+
+	inner_shake256_init(&sc);
+	inner_shake256_inject(&sc, pubkey, pubkey_len);
+	inner_shake256_flip(&sc);
+	inner_shake256_extract(&sc, fp, 32);
+}
+
+static int
+write_all(int fd, const void *data, size_t len)
+{
+	const uint8_t *buf;
+
+	buf = data;
+	while (len > 0) {
+		ssize_t w;
+
+		w = write(fd, buf, len);
+		if (w < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return 0;
+		}
+		buf += w;
+		len -= (size_t)w;
+	}
+	return 1;
+}
+
+/*
+ * fsync() the directory that contains 'path'. Returned value is 1 on
+ * success, 0 on error.
+ */
+static int
+sync_parent_dir(const char *path)
+{
+	const char *sep;
+	char *dir;
+	size_t len;
+	int fd, ok;
+
+	sep = strrchr(path, '/');
+	if (sep == NULL) {
+		fd = open(".", O_RDONLY);
+	} else {
+		len = (sep == path) ? 1 : (size_t)(sep - path);
+		dir = malloc(len + 1);
+		if (dir == NULL) {
+			return 0;
+		}
+		memcpy(dir, path, len);
+		dir[len] = 0;
+		fd = open(dir, O_RDONLY);
+		free(dir);
+	}
+	if (fd < 0) {
+		return 0;
+	}
+	ok = (fsync(fd) == 0);
+	if (close(fd) != 0) {
+		ok = 0;
+	}
+	return ok;
+}
+
+/* see falcon.h */
+int
+falcon_lazy_store_create(shake256_context *rng,
+	const char *path, size_t count, const void *expanded_key,
+	const void *pubkey, size_t pubkey_len,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+	size_t token_len, u;
+	uint8_t *hdr, *tok, *otmp;
+	uint32_t w32;
+	uint64_t w64;
+	char *tmp_path;
+	int fd, ok, r;
+
+	logn = *(const uint8_t *)expanded_key;
+	if (logn < 1 || logn > 10) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (pubkey_len != FALCON_PUBKEY_SIZE(logn)
+		|| *(const uint8_t *)pubkey != logn)
+	{
+		return FALCON_ERR_FORMAT;
+	}
+	if (tmp_len < FALCON_TMPSIZE_LAZYSTORE(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+	if (count == 0) {
+		return FALCON_ERR_BADARG;
+	}
+
+	/*
+	 * The fingerprint is computed from pubkey[], so the tokens must
+	 * come from the same key.
+	 */
+	r = Zf(lazy_check_pubkey)(expanded_key, pubkey, pubkey_len, tmp);
+	if (r != 0) {
+		return r;
+	}
+	token_len = FALCON_LAZY_TOKEN_SIZE(logn);
+
+	/*
+	 * tmp[] receives the header page, then is reused for one token
+	 * and the offline phase scratch.
+	 */
+	hdr = tmp;
+	memset(hdr, 0, STORE_HEADER_LEN);
+	memcpy(hdr, STORE_MAGIC, 8);
+	w32 = STORE_BOM;
+	memcpy(hdr + OFF_BOM, &w32, 4);
+	w32 = logn;
+	memcpy(hdr + OFF_LOGN, &w32, 4);
+	w32 = (uint32_t)token_len;
+	memcpy(hdr + OFF_TOKEN_LEN, &w32, 4);
+	w64 = count;
+	memcpy(hdr + OFF_COUNT, &w64, 8);
+	key_fingerprint(hdr + OFF_FINGERPRINT, pubkey, pubkey_len);
+
+	/*
+	 * The file is written under a temporary name, then renamed, so
+	 * that an interrupted creation never leaves a partial store
+	 * under the final name.
+	 */
+	tmp_path = malloc(strlen(path) + 5);
+	if (tmp_path == NULL) {
+		return FALCON_ERR_INTERNAL;
+	}
+	strcpy(tmp_path, path);
+	strcat(tmp_path, ".tmp");
+	fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	if (fd < 0) {
+		free(tmp_path);
+		return FALCON_ERR_INTERNAL;
+	}
+	ok = write_all(fd, hdr, STORE_HEADER_LEN);
+	tok = tmp;
+	otmp = tok + token_len;
+	r = 0;
+	for (u = 0; ok && u < count; u ++) {
+		r = falcon_sign_lazy_offline(rng, tok, token_len,
+			expanded_key, otmp, FALCON_TMPSIZE_SIGNLAZY_OFFLINE(logn));
+		if (r != 0) {
+			break;
+		}
+		ok = write_all(fd, tok, token_len);
+	}
+	memset(tmp, 0, FALCON_TMPSIZE_LAZYSTORE(logn));
+	if (r != 0) {
+		ok = 0;
+	}
+	if (ok) {
+		ok = (fsync(fd) == 0);
+	}
+	if (close(fd) != 0) {
+		ok = 0;
+	}
+	if (ok) {
+		ok = (rename(tmp_path, path) == 0);
+	}
+	if (!ok) {
+		unlink(tmp_path);
+		free(tmp_path);
+		return r != 0 ? r : FALCON_ERR_INTERNAL;
+	}
+	free(tmp_path);
+
+	/*
+	 * The new name is durable only once the directory is written
+	 * back.
+	 */
+	return sync_parent_dir(path) ? 0 : FALCON_ERR_INTERNAL;
+}
+
+/* see falcon.h */
+int
+falcon_lazy_store_open(falcon_lazy_store **store, const char *path,
+	const void *pubkey, size_t pubkey_len, int flags)
+{
+	falcon_lazy_store *st;
+	struct stat sb;
+	uint8_t *map, fp[32];
+	uint32_t bom, logn, token_len;
+	uint64_t count;
+	size_t map_len;
+	int fd, mflags;
+
+	*store = NULL;
+	fd = open(path, O_RDWR);
+	if (fd < 0) {
+		return FALCON_ERR_INTERNAL;
+	}
+	if (fstat(fd, &sb) != 0) {
+		close(fd);
+		return FALCON_ERR_INTERNAL;
+	}
+	if (sb.st_size < (off_t)STORE_HEADER_LEN) {
+		close(fd);
+		return FALCON_ERR_FORMAT;
+	}
+	map_len = (size_t)sb.st_size;
+	mflags = MAP_SHARED;
+#ifdef MAP_POPULATE
+	if (flags & FALCON_LAZY_STORE_POPULATE) {
+		mflags |= MAP_POPULATE;
+	}
+#endif
+	map = mmap(NULL, map_len, PROT_READ | PROT_WRITE, mflags, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		return FALCON_ERR_INTERNAL;
+	}
+#ifdef MADV_HUGEPAGE
+	if (flags & FALCON_LAZY_STORE_HUGEPAGES) {
+		/*
+		 * Best effort: not all file systems support transparent
+		 * huge pages for file mappings.
+		 */
+		madvise(map, map_len, MADV_HUGEPAGE);
+	}
+#endif
+
+	/*
+	 * Check the header and the key fingerprint.
+	 */
+	memcpy(&bom, map + OFF_BOM, 4);
+	memcpy(&logn, map + OFF_LOGN, 4);
+	memcpy(&token_len, map + OFF_TOKEN_LEN, 4);
+	memcpy(&count, map + OFF_COUNT, 8);
+	if (memcmp(map, STORE_MAGIC, 8) != 0 || bom != STORE_BOM
+		|| logn < 1 || logn > 10
+		|| token_len != FALCON_LAZY_TOKEN_SIZE(logn)
+		|| count > (map_len - STORE_HEADER_LEN) / token_len
+		|| pubkey_len != FALCON_PUBKEY_SIZE(logn))
+	{
+		munmap(map, map_len);
+		return FALCON_ERR_FORMAT;
+	}
+	key_fingerprint(fp, pubkey, pubkey_len);
+	if (memcmp(fp, map + OFF_FINGERPRINT, 32) != 0) {
+		munmap(map, map_len);
+		return FALCON_ERR_BADARG;
+	}
+
+	st = malloc(sizeof *st);
+	if (st == NULL) {
+		munmap(map, map_len);
+		return FALCON_ERR_INTERNAL;
+	}
+	st->h = malloc(sizeof *st->h << logn);
+	if (st->h == NULL) {
+		free(st);
+		munmap(map, map_len);
+		return FALCON_ERR_INTERNAL;
+	}
+	if (Zf(lazy_decode_pubkey)(st->h, pubkey, pubkey_len, logn) != 0) {
+		free(st->h);
+		free(st);
+		munmap(map, map_len);
+		return FALCON_ERR_FORMAT;
+	}
+	st->map = map;
+	st->map_len = map_len;
+	st->logn = logn;
+	st->token_len = token_len;
+	st->count = count;
+	st->flags = flags;
+	*store = st;
+	return 0;
+}
+
+/* see falcon.h */
+void
+falcon_lazy_store_close(falcon_lazy_store *store)
+{
+	if (store != NULL) {
+		munmap(store->map, store->map_len);
+		free(store->h);
+		free(store);
+	}
+}
+
+/* see falcon.h */
+size_t
+falcon_lazy_store_remaining(const falcon_lazy_store *store)
+{
+	uint64_t cursor;
+
+	cursor = __atomic_load_n((uint64_t *)(store->map + OFF_CURSOR),
+		__ATOMIC_ACQUIRE);
+	return cursor >= store->count ? 0 : (size_t)(store->count - cursor);
+}
+
+/* see falcon.h */
+unsigned
+falcon_lazy_store_get_logn(const falcon_lazy_store *store)
+{
+	return store->logn;
+}
+
+/*
+ * Token source for falcon_lazy_store_sign(): claim the next token, and
+ * make the claim durable before using it. The token is used directly
+ * from the mapping, and cleared in place.
+ */
+static int
+store_next_token(void *arg, uint8_t **token)
+{
+	falcon_lazy_store *store;
+	uint64_t idx;
+
+	store = arg;
+	idx = __atomic_fetch_add((uint64_t *)(store->map + OFF_CURSOR),
+		1, __ATOMIC_ACQ_REL);
+	if (idx >= store->count) {
+		return FALCON_ERR_EMPTY;
+	}
+	if (!(store->flags & FALCON_LAZY_STORE_NOSYNC)) {
+		if (msync(store->map, STORE_HEADER_LEN, MS_SYNC) != 0) {
+			return FALCON_ERR_INTERNAL;
+		}
+	}
+	*token = store->map + STORE_HEADER_LEN
+		+ (size_t)idx * store->token_len;
+	return 0;
+}
+
+/* see falcon.h */
+int
+falcon_lazy_store_sign(falcon_lazy_store *store,
+	void *sig, size_t *sig_len, int sig_type,
+	const void *expanded_key,
+	const void *data, size_t data_len,
+	void *tmp, size_t tmp_len)
+{
+	unsigned logn;
+
+	logn = store->logn;
+	if (*(const uint8_t *)expanded_key != logn) {
+		return FALCON_ERR_FORMAT;
+	}
+	if (tmp_len < FALCON_TMPSIZE_SIGNLAZY_ONLINE(logn)) {
+		return FALCON_ERR_SIZE;
+	}
+	if (memcmp(Zf(lazy_expkey_h)(expanded_key), store->h,
+		sizeof *store->h << logn) != 0)
+	{
+		return FALCON_ERR_BADARG;
+	}
+
+	return Zf(lazy_sign_tokens)(sig, sig_len, sig_type,
+		expanded_key, logn, &store_next_token, store, store->token_len,
+		data, data_len, tmp, tmp_len);
+}
@@ -34,6 +34,7 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <pthread.h>
 
 #include "inner.h"
 #include "falcon.h"
@@ -202,6 +203,111 @@ test_SHAKE256(void)
 	fflush(stdout);
 }
 
+/*
+ * Multi-buffer SHAKE256 output and batched hash-to-point: compare
+ * with the single-context functions, for all group sizes (including a
+ * second, incomplete group).
+ */
+static void
+test_SHAKE256_multi(void)
+{
+	enum { N = INNER_SHAKE256_LANES + 1 };
+	inner_shake256_context sc[N], sc2[N], rng;
+	inner_shake256_context *psc[N];
+	inner_shake256_x_context sx;
+	uint16_t *x[N], *hm;
+	uint8_t *tmp, ref[136], out[136];
+	unsigned num, logn, l, j, b, ct;
+
+	printf("Test SHAKE256 multi: ");
+	fflush(stdout);
+
+	inner_shake256_init(&rng);
+	inner_shake256_inject(&rng, (const uint8_t *)"multi", 5);
+	inner_shake256_flip(&rng);
+	for (l = 0; l < N; l ++) {
+		uint8_t msg[60];
+
+		inner_shake256_extract(&rng, msg, sizeof msg);
+		inner_shake256_init(&sc[l]);
+		inner_shake256_inject(&sc[l], msg, 20 * l);
+		inner_shake256_flip(&sc[l]);
+		psc[l] = &sc2[l];
+	}
+
+	for (num = 1; num <= INNER_SHAKE256_LANES; num ++) {
+		memcpy(sc2, sc, sizeof sc);
+		if (!Zf(i_shake256_x_init)(&sx,
+			(const inner_shake256_context *const *)psc, num))
+		{
+			fprintf(stderr, "shake256_x_init failed\n");
+			exit(EXIT_FAILURE);
+		}
+		for (b = 0; b < 3; b ++) {
+			Zf(i_shake256_x_next)(&sx);
+			for (l = 0; l < num; l ++) {
+				inner_shake256_extract(&sc2[l], ref, sizeof ref);
+				for (j = 0; j < sizeof out; j ++) {
+					out[j] = (uint8_t)(sx.A[(j >> 3)
+						* INNER_SHAKE256_LANES + l]
+						>> ((j & 7) << 3));
+				}
+				check_eq(ref, out, sizeof out, "SHAKE multi");
+			}
+		}
+	}
+	memcpy(sc2, sc, sizeof sc);
+	inner_shake256_extract(&sc2[0], ref, 1);
+	if (Zf(i_shake256_x_init)(&sx,
+		(const inner_shake256_context *const *)psc, 2))
+	{
+		fprintf(stderr, "shake256_x_init accepted a used context\n");
+		exit(EXIT_FAILURE);
+	}
+
+	tmp = xmalloc(16u << 10);
+	hm = xmalloc((size_t)N << 11);
+	for (l = 0; l < N; l ++) {
+		x[l] = xmalloc((size_t)1 << 11);
+	}
+	for (logn = 1; logn <= 10; logn ++) {
+		size_t n;
+
+		n = (size_t)1 << logn;
+		for (ct = 0; ct <= 1; ct ++) {
+			for (num = 1; num <= N; num ++) {
+				memcpy(sc2, sc, sizeof sc);
+				Zf(hash_to_point_batch)(psc, x, num, logn,
+					ct, tmp);
+				for (l = 0; l < num; l ++) {
+					inner_shake256_context t;
+
+					t = sc[l];
+					if (ct) {
+						Zf(hash_to_point_ct)(&t,
+							hm, logn, tmp);
+					} else {
+						Zf(hash_to_point_vartime)(&t,
+							hm, logn);
+					}
+					check_eq(hm, x[l], n * sizeof *hm,
+						"hash_to_point_batch");
+				}
+			}
+		}
+		printf(".");
+		fflush(stdout);
+	}
+	for (l = 0; l < N; l ++) {
+		xfree(x[l]);
+	}
+	xfree(hm);
+	xfree(tmp);
+
+	printf(" done.\n");
+	fflush(stdout);
+}
+
 static const int8_t ntru_f_16[] = {
 	7, -7, 12, 18, 19, 6, 18, -18, 18, -17, -14, 51, 24, -17, 2, 31
 };
@@ -2147,6 +2253,503 @@ test_codec(void)
 	fflush(stdout);
 }
 
+/*
+ * Reference encoding of n fields of 'bits' bits each (raw[], most
+ * significant bit first, last byte padded with zeros), as produced
+ * by the modq_encode() and trim_*_encode() functions. Returned value
+ * is the length in bytes.
+ */
+static size_t
+fixed_encode_ref(uint8_t *buf, const uint16_t *raw, size_t n, unsigned bits)
+{
+	size_t u, len;
+	unsigned i;
+
+	len = (n * bits + 7) >> 3;
+	memset(buf, 0, len);
+	for (u = 0; u < n; u ++) {
+		for (i = 0; i < bits; i ++) {
+			size_t j;
+
+			j = u * bits + i;
+			if ((raw[u] >> (bits - 1 - i)) & 1) {
+				buf[j >> 3] |= (uint8_t)(0x80 >> (j & 7));
+			}
+		}
+	}
+	return len;
+}
+
+/*
+ * Check the fixed-width codecs (which have vector implementations)
+ * against fixed_encode_ref(), with all the widths used for keys and
+ * signatures, unaligned buffers, short buffers and invalid values.
+ */
+static void
+test_codec_fixed_inner(void)
+{
+	unsigned logn;
+	inner_shake256_context sc;
+	uint16_t *raw;
+	int16_t *x16, *y16;
+	int8_t *x8, *y8;
+	uint8_t *e1, *e2;
+
+	raw = xmalloc(1024 * sizeof *raw);
+	x16 = xmalloc(2 * 1024 * sizeof *x16);
+	y16 = x16 + 1024;
+	x8 = xmalloc(2 * 1024);
+	y8 = x8 + 1024;
+	e1 = xmalloc(2 * 2048 + 16);
+	e2 = e1 + 2048;
+	inner_shake256_init(&sc);
+	inner_shake256_inject(&sc, (const uint8_t *)"fixed", 5);
+	inner_shake256_flip(&sc);
+
+	for (logn = 1; logn <= 10; logn ++) {
+		size_t n;
+		unsigned bits;
+
+		n = (size_t)1 << logn;
+
+		/*
+		 * bits = 4..12: trim_i16; bits = 4..8: trim_i8 as well;
+		 * bits = 14: modq.
+		 */
+		for (bits = 4; bits <= 14; bits ++) {
+			int i;
+
+			if (bits == 13) {
+				continue;
+			}
+			for (i = 0; i < 4; i ++) {
+				size_t u, len1, len2, off;
+				uint8_t tt[3];
+				uint16_t m2;
+				int kind;
+
+				for (kind = 0; kind < 3; kind ++) {
+					if ((kind == 0 && bits != 14)
+						|| (kind != 0 && bits == 14)
+						|| (kind == 2 && bits > 8))
+					{
+						continue;
+					}
+					m2 = (uint16_t)(1u << (bits - 1));
+					for (u = 0; u < n; u ++) {
+						inner_shake256_extract(&sc, tt, 2);
+						raw[u] = (uint16_t)((tt[0]
+							| ((unsigned)tt[1] << 8))
+							& ((1u << bits) - 1));
+						if (kind == 0) {
+							raw[u] %= 12289;
+						} else if (raw[u] == m2) {
+							raw[u] = 0;
+						}
+						if (kind == 0) {
+							((uint16_t *)x16)[u] = raw[u];
+						} else if (raw[u] & m2) {
+							x16[u] = (int16_t)raw[u]
+								- (int16_t)(2 * m2);
+						} else {
+							x16[u] = (int16_t)raw[u];
+						}
+						x8[u] = (int8_t)x16[u];
+					}
+					len1 = fixed_encode_ref(e1, raw, n, bits);
+					off = (size_t)i * 3 & 7;
+
+					/*
+					 * Encoding, into an unaligned buffer of
+					 * the exact size or one byte too short.
+					 */
+					switch (kind) {
+					case 0:
+						len2 = Zf(modq_encode)(e2 + off,
+							len1, (uint16_t *)x16, logn);
+						break;
+					case 1:
+						len2 = Zf(trim_i16_encode)(e2 + off,
+							len1, x16, logn, bits);
+						break;
+					default:
+						len2 = Zf(trim_i8_encode)(e2 + off,
+							len1, x8, logn, bits);
+						break;
+					}
+					if (len2 != len1) {
+						fprintf(stderr, "ERR fixed encode"
+							" (%d, %u): %zu / %zu\n",
+							kind, bits, len2, len1);
+						exit(EXIT_FAILURE);
+					}
+					check_eq(e1, e2 + off, len1,
+						"fixed encode");
+					len2 = kind == 0
+						? Zf(modq_encode)(e2, len1 - 1,
+							(uint16_t *)x16, logn)
+						: kind == 1
+						? Zf(trim_i16_encode)(e2, len1 - 1,
+							x16, logn, bits)
+						: Zf(trim_i8_encode)(e2, len1 - 1,
+							x8, logn, bits);
+					if (len2 != 0) {
+						fprintf(stderr, "ERR fixed encode"
+							" (short)\n");
+						exit(EXIT_FAILURE);
+					}
+
+					/*
+					 * Decoding from an unaligned buffer,
+					 * then with an invalid value.
+					 */
+					memmove(e2 + off, e1, len1);
+					switch (kind) {
+					case 0:
+						len2 = Zf(modq_decode)(
+							(uint16_t *)y16, logn,
+							e2 + off, len1);
+						break;
+					case 1:
+						len2 = Zf(trim_i16_decode)(y16, logn,
+							bits, e2 + off, len1);
+						break;
+					default:
+						len2 = Zf(trim_i8_decode)(y8, logn,
+							bits, e2 + off, len1);
+						break;
+					}
+					if (len2 != len1) {
+						fprintf(stderr, "ERR fixed decode"
+							" (%d, %u): %zu / %zu\n",
+							kind, bits, len2, len1);
+						exit(EXIT_FAILURE);
+					}
+					if (kind == 2) {
+						check_eq(x8, y8, n, "fixed decode");
+					} else {
+						check_eq(x16, y16, n * sizeof *y16,
+							"fixed decode");
+					}
+					inner_shake256_extract(&sc, tt, 3);
+					u = ((size_t)tt[0] | ((size_t)tt[1] << 8))
+						% n;
+					raw[u] = kind == 0
+						? (uint16_t)(12289 + tt[2] * 15)
+						: m2;
+					fixed_encode_ref(e2 + off, raw, n, bits);
+					switch (kind) {
+					case 0:
+						len2 = Zf(modq_decode)(
+							(uint16_t *)y16, logn,
+							e2 + off, len1);
+						break;
+					case 1:
+						len2 = Zf(trim_i16_decode)(y16, logn,
+							bits, e2 + off, len1);
+						break;
+					default:
+						len2 = Zf(trim_i8_decode)(y8, logn,
+							bits, e2 + off, len1);
+						break;
+					}
+					if (len2 != 0) {
+						fprintf(stderr, "ERR fixed decode"
+							" (invalid, %d, %u)\n",
+							kind, bits);
+						exit(EXIT_FAILURE);
+					}
+				}
+			}
+		}
+		printf(".");
+		fflush(stdout);
+	}
+
+	xfree(raw);
+	xfree(x16);
+	xfree(x8);
+	xfree(e1);
+}
+
+static void
+test_codec_fixed(void)
+{
+	int b, sel;
+
+	printf("Test fixed-width encode/decode: ");
+	fflush(stdout);
+
+	/*
+	 * The codec kernels are dispatched: all backends are checked
+	 * (only one without runtime dispatch).
+	 */
+	sel = falcon_get_backend();
+	for (b = FALCON_BACKEND_REF; b <= FALCON_BACKEND_AVX512; b ++) {
+		if (falcon_set_backend(b) != 0) {
+			continue;
+		}
+		test_codec_fixed_inner();
+	}
+	falcon_set_backend(sel);
+
+	printf(" done.\n");
+	fflush(stdout);
+}
+
+/*
+ * Bit-by-bit implementation of the compressed format, as a reference
+ * for Zf(comp_encode)() and Zf(comp_decode)().
+ */
+static size_t
+comp_encode_ref(void *out, size_t max_out_len,
+	const int16_t *x, unsigned logn)
+{
+	uint8_t *buf;
+	size_t n, u, v;
+	uint32_t acc;
+	unsigned acc_len;
+
+	n = (size_t)1 << logn;
+	buf = out;
+	for (u = 0; u < n; u ++) {
+		if (x[u] < -2047 || x[u] > +2047) {
+			return 0;
+		}
+	}
+	acc = 0;
+	acc_len = 0;
+	v = 0;
+	for (u = 0; u < n; u ++) {
+		int t;
+		unsigned w;
+
+		acc <<= 1;
+		t = x[u];
+		if (t < 0) {
+			t = -t;
+			acc |= 1;
+		}
+		w = (unsigned)t;
+		acc <<= 7;
+		acc |= w & 127u;
+		w >>= 7;
+		acc_len += 8;
+		acc <<= (w + 1);
+		acc |= 1;
+		acc_len += w + 1;
+		while (acc_len >= 8) {
+			acc_len -= 8;
+			if (buf != NULL) {
+				if (v >= max_out_len) {
+					return 0;
+				}
+				buf[v] = (uint8_t)(acc >> acc_len);
+			}
+			v ++;
+		}
+	}
+	if (acc_len > 0) {
+		if (buf != NULL) {
+			if (v >= max_out_len) {
+				return 0;
+			}
+			buf[v] = (uint8_t)(acc << (8 - acc_len));
+		}
+		v ++;
+	}
+	return v;
+}
+
+static size_t
+comp_decode_ref(int16_t *x, unsigned logn,
+	const void *in, size_t max_in_len)
+{
+	const uint8_t *buf;
+	size_t n, u, v;
+	uint32_t acc;
+	unsigned acc_len;
+
+	n = (size_t)1 << logn;
+	buf = in;
+	acc = 0;
+	acc_len = 0;
+	v = 0;
+	for (u = 0; u < n; u ++) {
+		unsigned b, s, m;
+
+		if (v >= max_in_len) {
+			return 0;
+		}
+		acc = (acc << 8) | (uint32_t)buf[v ++];
+		b = acc >> acc_len;
+		s = b & 128;
+		m = b & 127;
+		for (;;) {
+			if (acc_len == 0) {
+				if (v >= max_in_len) {
+					return 0;
+				}
+				acc = (acc << 8) | (uint32_t)buf[v ++];
+				acc_len = 8;
+			}
+			acc_len --;
+			if (((acc >> acc_len) & 1) != 0) {
+				break;
+			}
+			m += 128;
+			if (m > 2047) {
+				return 0;
+			}
+		}
+		if (s && m == 0) {
+			return 0;
+		}
+		x[u] = (int16_t)(s ? -(int)m : (int)m);
+	}
+	if ((acc & ((1u << acc_len) - 1u)) != 0) {
+		return 0;
+	}
+	return v;
+}
+
+/*
+ * Compare Zf(comp_decode)() with comp_decode_ref() on the first len
+ * bytes of buf[].
+ */
+static void
+check_comp_decode(unsigned logn, const uint8_t *buf, size_t len,
+	int16_t *s1, int16_t *s2)
+{
+	size_t n, len1, len2;
+
+	n = (size_t)1 << logn;
+	len1 = comp_decode_ref(s1, logn, buf, len);
+	len2 = Zf(comp_decode)(s2, logn, buf, len);
+	if (len1 != len2) {
+		fprintf(stderr, "ERR comp decode (logn=%u, len=%zu):"
+			" %zu / %zu\n", logn, len, len2, len1);
+		exit(EXIT_FAILURE);
+	}
+	if (len1 != 0) {
+		check_eq(s1, s2, n * sizeof *s2, "comp decode");
+	}
+}
+
+static void
+test_codec_comp(void)
+{
+	unsigned logn;
+	inner_shake256_context sc;
+	int16_t *x, *s1, *s2;
+	uint8_t *e1, *e2;
+	size_t elen;
+
+	printf("Test comp encode/decode: ");
+	fflush(stdout);
+	x = xmalloc(3 * 1024 * sizeof *x);
+	s1 = x + 1024;
+	s2 = s1 + 1024;
+	elen = 4096;
+	e1 = xmalloc(2 * elen);
+	e2 = e1 + elen;
+	inner_shake256_init(&sc);
+	inner_shake256_inject(&sc, (const uint8_t *)"comp", 4);
+	inner_shake256_flip(&sc);
+
+	for (logn = 1; logn <= 10; logn ++) {
+		size_t n;
+		int i;
+
+		n = (size_t)1 << logn;
+		for (i = 0; i < 200; i ++) {
+			size_t u, len1, len2, max;
+			unsigned bits;
+			uint8_t tt[4];
+
+			/*
+			 * Random values of up to 'bits' bits (12 bits can
+			 * exceed the -2047..+2047 range), and sometimes the
+			 * extreme values.
+			 */
+			inner_shake256_extract(&sc, tt, 1);
+			bits = 1 + tt[0] % 12;
+			for (u = 0; u < n; u ++) {
+				unsigned w;
+
+				inner_shake256_extract(&sc, tt, 3);
+				w = ((unsigned)tt[0] | ((unsigned)tt[1] << 8))
+					& ((1u << bits) - 1);
+				if (tt[2] == 0) {
+					w = 2047;
+				}
+				x[u] = (tt[2] & 1) ? -(int)w : (int)w;
+			}
+
+			/*
+			 * Encoding: length only, full buffer, and truncated
+			 * output buffer.
+			 */
+			len1 = comp_encode_ref(NULL, 0, x, logn);
+			len2 = Zf(comp_encode)(NULL, 0, x, logn);
+			if (len1 != len2) {
+				fprintf(stderr, "ERR comp encode(0): %zu / %zu\n",
+					len2, len1);
+				exit(EXIT_FAILURE);
+			}
+			len1 = comp_encode_ref(e1, elen, x, logn);
+			len2 = Zf(comp_encode)(e2, elen, x, logn);
+			if (len1 != len2) {
+				fprintf(stderr, "ERR comp encode: %zu / %zu\n",
+					len2, len1);
+				exit(EXIT_FAILURE);
+			}
+			if (len1 == 0) {
+				continue;
+			}
+			check_eq(e1, e2, len1, "comp encode");
+			inner_shake256_extract(&sc, tt, 2);
+			max = ((unsigned)tt[0] | ((unsigned)tt[1] << 8)) % len1;
+			if (Zf(comp_encode)(e2, max, x, logn) != 0
+				|| Zf(comp_encode)(e2, len1 - 1, x, logn) != 0)
+			{
+				fprintf(stderr, "ERR comp encode (short)\n");
+				exit(EXIT_FAILURE);
+			}
+
+			/*
+			 * Decoding: the valid encoding, with trailing bytes,
+			 * truncated, with a few flipped bits, and random
+			 * bytes.
+			 */
+			inner_shake256_extract(&sc, e1 + len1, 16);
+			check_comp_decode(logn, e1, len1, s1, s2);
+			check_comp_decode(logn, e1, len1 + 1 + (i & 15), s1, s2);
+			check_comp_decode(logn, e1, max, s1, s2);
+			check_comp_decode(logn, e1, len1 - 1, s1, s2);
+			for (u = 0; u < 4; u ++) {
+				size_t k;
+
+				inner_shake256_extract(&sc, tt, 3);
+				k = ((unsigned)tt[0] | ((unsigned)tt[1] << 8))
+					% (len1 + 1);
+				e1[k] ^= (uint8_t)(1u << (tt[2] & 7));
+				check_comp_decode(logn, e1, len1, s1, s2);
+				check_comp_decode(logn, e1, len1 + 8, s1, s2);
+			}
+			inner_shake256_extract(&sc, e1, len1 + 8);
+			check_comp_decode(logn, e1, len1 + 8, s1, s2);
+		}
+		printf(".");
+		fflush(stdout);
+	}
+
+	xfree(x);
+	xfree(e1);
+	printf(" done.\n");
+	fflush(stdout);
+}
+
 static void
 test_vrfy_inner(unsigned logn, const int8_t *f, const int8_t *g,
 	const int8_t *F, const int8_t *G, const uint16_t *h,
@@ -2312,71 +2915,357 @@ test_vrfy(void)
 	fflush(stdout);
 }
 
-static const uint64_t KAT_RNG_1[] = {
-	0xDB1F30843AAD694Cu, 0xFAD9C14E86D5B53Cu, 0x7F84F914F46C439Fu,
-	0xC46A6E399A376C6Du, 0x47A5CD6F8C6B1789u, 0x1E85D879707DA987u,
-	0xC7B0CE6C2C1DB3E7u, 0xA65795537B3D977Cu, 0x748457A98AC7F19Cu,
-	0xD8C8F161EEB7231Fu, 0xE81CAE53A7E8967Fu, 0x27EAD55A75ED57F8u,
-	0x9680953F3A192413u, 0x784145D6687EA318u, 0x9B454489BE56BAEBu,
-	0xF546834B0F799C67u, 0xAC8E4F657C93FB88u, 0xD0E6C7610CC4028Bu,
-	0x417296FB7E1124BDu, 0xE7968F18E3221DDCu, 0x1DDEC33FC7F2D5FBu,
-	0x76556A8C07FB48EEu, 0x7910EAA4C163BC2Fu, 0xAAC5C6291F779D17u,
-	0x575B2692885C4CFAu, 0x0664AA8C3E99DA19u, 0xFA55C1AE9A615133u,
-	0x7F1DB1A620F63220u, 0xE740AE9AF9CC9755u, 0x8393056E1D0D81E1u,
-	0x556EEF4483B434AAu, 0xC6D17BEF7C2FB0C3u, 0x27D142BD5BBF6014u,
-	0x6FD90B14DB4AA0BBu, 0x7ACDD6F240530D0Du, 0xE980F9F9DBE6109Au,
-	0xA30C677211C7BF37u, 0x1E41FD290B90CE8Bu, 0x478FCD48D5E4A9EDu,
-	0x10586F987EA5FA7Au, 0x691891C568F5DAC7u, 0x3277735ED18D9107u,
-	0x78FCC576E47E8D71u, 0x940A2C6777E3BEBBu, 0x814612E210DD9715u,
-	0xABBCAFCC6B54279Bu, 0x2550E2538A063BFCu, 0x7965EFC9D3F8A5BEu,
-	0xAE35E74B5A0B8717u, 0xD855D6ABB96EA3AFu, 0xAB4689B903C01C4Eu,
-	0x8D8018988CA554ACu, 0x0BB6689524F3A2B1u, 0xAC0676FCBB193A87u,
-	0xD0A83D30F34F65ECu, 0x26D3A8C167CA09F4u, 0x7D17403D2B1DD9A0u,
-	0x47B1C836A0224550u, 0xF6ABECF6422C5A56u, 0x6FB1B2FF5CDDEC25u,
-	0x118276B244B55F88u, 0x1FB953EF9E6C2C41u, 0xF351C2717ACE9BF3u,
-	0xDF787B64D51A5440u, 0xE4B8B81149B8A70Bu, 0x337E5363F506228Bu,
-	0x48948ADE314B5980u, 0x7FBF7A7139004610u, 0xA6CB33F6802C96C7u,
-	0x745888A51A99BBEDu, 0x49D411403BA9CFDAu, 0xA547A6EA4BDD5538u,
-	0x2D65DCF44F045E9Fu, 0x734FBE9360EFCC44u, 0x1131E0AD573D37A0u,
-	0xADF3E9199FD90113u, 0x8EDF3EAF50E6E00Bu, 0xFE0240D04C171901u,
-	0x45A97204596F7C46u, 0x54D1D1F962484BC5u, 0xEBAC109CDB975ED4u,
-	0x51182BF46BD2D61Cu, 0xF12D0EC8A80092D3u, 0x69CA22BA55B34270u,
-	0x5FF97BBE7A525BF7u, 0xF4E19780A4149ACAu, 0x2CD5AE45826309FCu,
-	0xF0EF1F0A309C1BCFu, 0xC16AF49962FE8A87u, 0x2CD2575C27761E54u,
-	0xD9199411E9CC816Du, 0xA0C397A63D036B05u, 0xF439D283DFE4C172u,
-	0x5DAAD309E61F2A60u, 0x2E7DDC8F9CD47E91u, 0x2E1BFCDDC439FD58u,
-	0x8E62B7C84C3C27F8u, 0xECD06ED0C1938A5Eu, 0x0335351E644A9155u,
-	0x71A735982C6DBBF7u, 0xD8FE9FAF2DDF9AFFu, 0x06BC9F654B9814E7u,
-	0x2DF46A488EC46052u, 0x80CB8E04CDEF7F98u, 0x9B65042EE20B4DAFu,
-	0x203BF49ACB5B34D2u, 0x54E8F69957D8903Bu, 0x84D63D4BA389AF36u,
-	0x7A2D4A2230D0DC82u, 0x3052659534D82FB8u, 0xC5058A8EC3716238u,
-	0xB8063774064F4A27u, 0x2F0BE0CE382BFD5Bu, 0xEE4CEAD41973DA0Fu,
-	0xFB56581EB2424A5Au, 0x09F21B654D835F66u, 0x1968C7264664F9CCu,
-	0x2CBD6BB3DD21732Cu, 0xA9FB1E69F446231Cu, 0xDBEAD8399CB25257u,
-	0x28FF84E3ECC86113u, 0x19A3B2D11BA6E80Fu, 0xC3ADAE73363651E7u,
-	0xF33FFB4923D82396u, 0x36FE16582AD8C34Cu, 0x728910D4AA3BB137u,
-	0x2F351F2EF8B05525u, 0x8727C7A39A617AE4u
-};
+/*
+ * Write r as a sum of four squares (r = q[0]^2 + ... + q[3]^2, with
+ * q[0] >= q[1] >= q[2] >= q[3] >= 0).
+ */
+static void
+four_squares(int32_t *q, uint32_t r)
+{
+	int32_t a, b, c, d;
 
-static const uint8_t KAT_RNG_2[] = {
-	0xC9, 0x45, 0xBC, 0xC4, 0x5B, 0x67, 0xA3, 0x25, 0x97, 0x19,
-	0x64, 0x67, 0x4A, 0x98, 0xD4, 0xB7, 0xA7, 0x83, 0x18, 0xC8,
-	0x40, 0xE2, 0x7F, 0xB8, 0x25, 0x8B, 0x7E, 0x92, 0x4A, 0x8C,
-	0x68, 0x1B, 0x77, 0x61, 0x1E, 0x70, 0xED, 0xC2, 0xC4, 0xA5,
-	0xDF, 0x9E, 0x76, 0xED, 0x49, 0x84, 0x3D, 0x08, 0xFE, 0xFE,
-	0x99, 0xE2, 0xC6, 0xEF, 0xFE, 0x2C, 0xD4, 0xC0, 0x04, 0xD8,
-	0x9A, 0x51, 0x21, 0xCD, 0x5B, 0xDB, 0x9F, 0x0B, 0x9C, 0x47,
-	0xCF, 0xE8, 0x38, 0x6B, 0xB4, 0x94, 0xDC, 0xCD, 0x9A, 0x9B,
-	0xB7, 0xED, 0xEE, 0x82, 0x64, 0x53, 0x20, 0xA0, 0x8F, 0x59,
-	0xB2, 0x4F, 0xE2, 0x5A, 0x35, 0x88, 0x39, 0x5B, 0x6C, 0x59,
-	0x59, 0x8C, 0x10, 0xC5, 0x2B, 0xF3, 0x7C, 0x49, 0xFD, 0x99,
-	0x0C, 0x86, 0x07, 0x9E, 0x35, 0x71, 0x8E, 0x23, 0x7B, 0x9D,
-	0x23, 0x34, 0x7A, 0xC8, 0x8A, 0x17, 0xDA, 0x7B, 0xA2, 0x97,
-	0x0A, 0x78, 0x2B, 0x19, 0xAD, 0xB1, 0x35, 0xBD, 0xB1, 0xE7,
-	0x74, 0x4B, 0x82, 0xFB, 0x72, 0x9C, 0x8C, 0x51, 0x3B, 0xE3,
-	0xF0, 0x31, 0x11, 0xAA, 0x59, 0xA4, 0x66, 0xAC, 0xAA, 0x9E,
-	0x85, 0xD9, 0x2D, 0xAD, 0xCA, 0x2B, 0x69, 0x5E, 0x19, 0x9F,
-	0x77, 0x15, 0x43, 0xF0, 0xC9, 0x9F, 0xBC, 0x5B, 0x66, 0x26,
+	for (a = (int32_t)sqrt((double)r) + 1; a >= 0; a --) {
+		uint32_t r1;
+
+		if ((uint64_t)a * (uint64_t)a > r) {
+			continue;
+		}
+		r1 = r - (uint32_t)(a * a);
+		for (b = a; b >= 0; b --) {
+			uint32_t r2;
+
+			if ((uint32_t)(b * b) > r1) {
+				continue;
+			}
+			r2 = r1 - (uint32_t)(b * b);
+			if ((uint64_t)b * (uint64_t)b * 2 < r2) {
+				break;
+			}
+			for (c = b; c >= 0; c --) {
+				uint32_t r3;
+
+				if ((uint32_t)(c * c) > r2) {
+					continue;
+				}
+				r3 = r2 - (uint32_t)(c * c);
+				if ((uint32_t)(c * c) < r3) {
+					break;
+				}
+				d = (int32_t)sqrt((double)r3);
+				while ((uint32_t)(d * d) > r3) {
+					d --;
+				}
+				while ((uint32_t)((d + 1) * (d + 1)) <= r3) {
+					d ++;
+				}
+				if ((uint32_t)(d * d) == r3) {
+					q[0] = a;
+					q[1] = b;
+					q[2] = c;
+					q[3] = d;
+					return;
+				}
+			}
+		}
+	}
+	fprintf(stderr, "four_squares(%lu) failed\n", (unsigned long)r);
+	exit(EXIT_FAILURE);
+}
+
+/*
+ * Compare Zf(verify_raw_batch)() with Zf(verify_raw)() for (s1, s2)
+ * pairs whose squared norm is exactly one below, at or one above the
+ * verifier bound, or whose 32-bit sum wraps around to a small value
+ * (this must be rejected). Lanes get random cases, so that accepted
+ * and rejected signatures are interleaved in the transposed form.
+ */
+static void
+test_vrfy_batch_raw(void)
+{
+	unsigned logn;
+	inner_shake256_context sc;
+	uint16_t *h, *c0;
+	int16_t *s1, *s2;
+	uint8_t *tmp;
+	int nacc, nrej, b, sel;
+
+	printf("Test verify batch (raw): ");
+	fflush(stdout);
+	sel = falcon_get_backend();
+	h = xmalloc(1024 * sizeof *h);
+	c0 = xmalloc(INNER_VERIFY_LANES * 1024 * sizeof *c0);
+	s1 = xmalloc(1024 * sizeof *s1);
+	s2 = xmalloc(INNER_VERIFY_LANES * 1024 * sizeof *s2);
+	tmp = xmalloc(32 * 1024);
+	inner_shake256_init(&sc);
+	inner_shake256_inject(&sc, (const uint8_t *)"vrfy_batch", 10);
+	inner_shake256_flip(&sc);
+	nacc = 0;
+	nrej = 0;
+
+	for (logn = 1; logn <= 10; logn ++) {
+		size_t n, num;
+		uint32_t bound, lo, hi;
+
+		n = (size_t)1 << logn;
+
+		/*
+		 * The bound is the largest accepted squared norm.
+		 */
+		lo = 0;
+		hi = 0x7FFFFFFF;
+		while (lo < hi) {
+			uint32_t mid;
+
+			mid = lo + ((hi - lo + 1) >> 1);
+			if (Zf(is_short_sqnorm)(mid, logn)) {
+				lo = mid;
+			} else {
+				hi = mid - 1;
+			}
+		}
+		bound = lo;
+
+		for (num = 8; num <= INNER_VERIFY_LANES; num ++) {
+			const uint16_t *pc0[INNER_VERIFY_LANES];
+			const int16_t *ps2[INNER_VERIFY_LANES];
+			int res[INNER_VERIFY_LANES], exp[INNER_VERIFY_LANES];
+			size_t k, l, u;
+			uint8_t tt[4];
+
+			/*
+			 * h = x^k, so that s2*h is a negacyclic rotation
+			 * of s2.
+			 */
+			inner_shake256_extract(&sc, tt, 2);
+			k = ((size_t)tt[0] | ((size_t)tt[1] << 8)) & (n - 1);
+			memset(h, 0, n * sizeof *h);
+			h[k] = 1;
+			Zf(to_ntt_monty)(h, logn);
+
+			for (l = 0; l < num; l ++) {
+				uint16_t *lc0;
+				int16_t *ls2;
+				uint64_t target, r64;
+				uint32_t r, rmin;
+				int32_t a, q[4];
+				int kind;
+
+				lc0 = c0 + l * n;
+				ls2 = s2 + l * n;
+				memset(s1, 0, n * sizeof *s1);
+				memset(ls2, 0, n * sizeof *ls2);
+				inner_shake256_extract(&sc, tt, 1);
+				kind = tt[0] % 4;
+				if (kind == 3 && logn < 3) {
+					kind = 2;
+				}
+				switch (kind) {
+				case 0:
+					target = bound - 1;
+					break;
+				case 1:
+					target = bound;
+					break;
+				case 2:
+					target = (uint64_t)bound + 1;
+					break;
+				default:
+					target = ((uint64_t)1 << 32)
+						+ (bound >> 4);
+					break;
+				}
+				exp[l] = kind <= 1;
+
+				/*
+				 * Saturating case: four maximal s2
+				 * coefficients, the rest brings the sum to
+				 * 2^32 plus a small value.
+				 */
+				r64 = target;
+				if (kind == 3) {
+					for (u = 0; u < 4; u ++) {
+						inner_shake256_extract(&sc, tt, 1);
+						ls2[u] = (tt[0] & 1)
+							? -32767 : 32767;
+						r64 -= 32767 * 32767;
+					}
+				}
+				r = (uint32_t)r64;
+
+				/*
+				 * Random coefficients take most of the
+				 * squared norm; the last two coefficients of
+				 * s1 and s2 complete it exactly.
+				 */
+				rmin = r >> 6;
+				a = (int32_t)sqrt(3.0 * 0.97 * (double)r
+					/ (double)(2 * n));
+				for (u = 0; u < 2 * (n - 2); u ++) {
+					int16_t *dst;
+					int32_t v;
+
+					if (u < n - 2) {
+						dst = s1 + u;
+					} else {
+						dst = ls2 + (u - (n - 2));
+					}
+					if (*dst != 0) {
+						continue;
+					}
+					inner_shake256_extract(&sc, tt, 4);
+					v = (int32_t)(((uint32_t)tt[0]
+						| ((uint32_t)tt[1] << 8)
+						| ((uint32_t)tt[2] << 16))
+						% (uint32_t)(2 * a + 1)) - a;
+					if ((uint32_t)(v * v) + rmin > r) {
+						v = 0;
+					}
+					*dst = (int16_t)v;
+					r -= (uint32_t)(v * v);
+				}
+				four_squares(q, r);
+				ls2[n - 1] = (int16_t)q[0];
+				ls2[n - 2] = (int16_t)-q[1];
+				s1[n - 1] = (int16_t)q[2];
+				s1[n - 2] = (int16_t)-q[3];
+
+				/*
+				 * c0 = s1 + s2*x^k mod q.
+				 */
+				for (u = 0; u < n; u ++) {
+					int32_t v;
+
+					v = (u >= k) ? ls2[u - k] : -ls2[u - k + n];
+					v = (v + s1[u]) % 12289;
+					if (v < 0) {
+						v += 12289;
+					}
+					lc0[u] = (uint16_t)v;
+				}
+				pc0[l] = lc0;
+				ps2[l] = ls2;
+			}
+
+			/*
+			 * All backends are checked (only one without
+			 * runtime dispatch).
+			 */
+			for (b = FALCON_BACKEND_REF;
+				b <= FALCON_BACKEND_AVX512; b ++)
+			{
+				if (falcon_set_backend(b) != 0) {
+					continue;
+				}
+				Zf(verify_raw_batch)(pc0, ps2, h, logn,
+					res, num, tmp);
+				for (l = 0; l < num; l ++) {
+					int r1;
+
+					r1 = Zf(verify_raw)(pc0[l], ps2[l],
+						h, logn, tmp);
+					if (r1 != exp[l] || res[l] != exp[l]) {
+						fprintf(stderr, "ERR"
+							" verify_raw_batch"
+							" (backend=%d, logn=%u,"
+							" num=%zu, lane %zu):"
+							" batch=%d single=%d"
+							" expected=%d\n",
+							b, logn, num, l, res[l],
+							r1, exp[l]);
+						exit(EXIT_FAILURE);
+					}
+					if (exp[l]) {
+						nacc ++;
+					} else {
+						nrej ++;
+					}
+				}
+			}
+		}
+		printf(".");
+		fflush(stdout);
+	}
+
+	falcon_set_backend(sel);
+	if (nacc == 0 || nrej == 0) {
+		fprintf(stderr, "ERR verify_raw_batch: %d / %d\n", nacc, nrej);
+		exit(EXIT_FAILURE);
+	}
+	xfree(h);
+	xfree(c0);
+	xfree(s1);
+	xfree(s2);
+	xfree(tmp);
+	printf(" done.\n");
+	fflush(stdout);
+}
+
+static const uint64_t KAT_RNG_1[] = {
+	0xDB1F30843AAD694Cu, 0xFAD9C14E86D5B53Cu, 0x7F84F914F46C439Fu,
+	0xC46A6E399A376C6Du, 0x47A5CD6F8C6B1789u, 0x1E85D879707DA987u,
+	0xC7B0CE6C2C1DB3E7u, 0xA65795537B3D977Cu, 0x748457A98AC7F19Cu,
+	0xD8C8F161EEB7231Fu, 0xE81CAE53A7E8967Fu, 0x27EAD55A75ED57F8u,
+	0x9680953F3A192413u, 0x784145D6687EA318u, 0x9B454489BE56BAEBu,
+	0xF546834B0F799C67u, 0xAC8E4F657C93FB88u, 0xD0E6C7610CC4028Bu,
+	0x417296FB7E1124BDu, 0xE7968F18E3221DDCu, 0x1DDEC33FC7F2D5FBu,
+	0x76556A8C07FB48EEu, 0x7910EAA4C163BC2Fu, 0xAAC5C6291F779D17u,
+	0x575B2692885C4CFAu, 0x0664AA8C3E99DA19u, 0xFA55C1AE9A615133u,
+	0x7F1DB1A620F63220u, 0xE740AE9AF9CC9755u, 0x8393056E1D0D81E1u,
+	0x556EEF4483B434AAu, 0xC6D17BEF7C2FB0C3u, 0x27D142BD5BBF6014u,
+	0x6FD90B14DB4AA0BBu, 0x7ACDD6F240530D0Du, 0xE980F9F9DBE6109Au,
+	0xA30C677211C7BF37u, 0x1E41FD290B90CE8Bu, 0x478FCD48D5E4A9EDu,
+	0x10586F987EA5FA7Au, 0x691891C568F5DAC7u, 0x3277735ED18D9107u,
+	0x78FCC576E47E8D71u, 0x940A2C6777E3BEBBu, 0x814612E210DD9715u,
+	0xABBCAFCC6B54279Bu, 0x2550E2538A063BFCu, 0x7965EFC9D3F8A5BEu,
+	0xAE35E74B5A0B8717u, 0xD855D6ABB96EA3AFu, 0xAB4689B903C01C4Eu,
+	0x8D8018988CA554ACu, 0x0BB6689524F3A2B1u, 0xAC0676FCBB193A87u,
+	0xD0A83D30F34F65ECu, 0x26D3A8C167CA09F4u, 0x7D17403D2B1DD9A0u,
+	0x47B1C836A0224550u, 0xF6ABECF6422C5A56u, 0x6FB1B2FF5CDDEC25u,
+	0x118276B244B55F88u, 0x1FB953EF9E6C2C41u, 0xF351C2717ACE9BF3u,
+	0xDF787B64D51A5440u, 0xE4B8B81149B8A70Bu, 0x337E5363F506228Bu,
+	0x48948ADE314B5980u, 0x7FBF7A7139004610u, 0xA6CB33F6802C96C7u,
+	0x745888A51A99BBEDu, 0x49D411403BA9CFDAu, 0xA547A6EA4BDD5538u,
+	0x2D65DCF44F045E9Fu, 0x734FBE9360EFCC44u, 0x1131E0AD573D37A0u,
+	0xADF3E9199FD90113u, 0x8EDF3EAF50E6E00Bu, 0xFE0240D04C171901u,
+	0x45A97204596F7C46u, 0x54D1D1F962484BC5u, 0xEBAC109CDB975ED4u,
+	0x51182BF46BD2D61Cu, 0xF12D0EC8A80092D3u, 0x69CA22BA55B34270u,
+	0x5FF97BBE7A525BF7u, 0xF4E19780A4149ACAu, 0x2CD5AE45826309FCu,
+	0xF0EF1F0A309C1BCFu, 0xC16AF49962FE8A87u, 0x2CD2575C27761E54u,
+	0xD9199411E9CC816Du, 0xA0C397A63D036B05u, 0xF439D283DFE4C172u,
+	0x5DAAD309E61F2A60u, 0x2E7DDC8F9CD47E91u, 0x2E1BFCDDC439FD58u,
+	0x8E62B7C84C3C27F8u, 0xECD06ED0C1938A5Eu, 0x0335351E644A9155u,
+	0x71A735982C6DBBF7u, 0xD8FE9FAF2DDF9AFFu, 0x06BC9F654B9814E7u,
+	0x2DF46A488EC46052u, 0x80CB8E04CDEF7F98u, 0x9B65042EE20B4DAFu,
+	0x203BF49ACB5B34D2u, 0x54E8F69957D8903Bu, 0x84D63D4BA389AF36u,
+	0x7A2D4A2230D0DC82u, 0x3052659534D82FB8u, 0xC5058A8EC3716238u,
+	0xB8063774064F4A27u, 0x2F0BE0CE382BFD5Bu, 0xEE4CEAD41973DA0Fu,
+	0xFB56581EB2424A5Au, 0x09F21B654D835F66u, 0x1968C7264664F9CCu,
+	0x2CBD6BB3DD21732Cu, 0xA9FB1E69F446231Cu, 0xDBEAD8399CB25257u,
+	0x28FF84E3ECC86113u, 0x19A3B2D11BA6E80Fu, 0xC3ADAE73363651E7u,
+	0xF33FFB4923D82396u, 0x36FE16582AD8C34Cu, 0x728910D4AA3BB137u,
+	0x2F351F2EF8B05525u, 0x8727C7A39A617AE4u
+};
+
+static const uint8_t KAT_RNG_2[] = {
+	0xC9, 0x45, 0xBC, 0xC4, 0x5B, 0x67, 0xA3, 0x25, 0x97, 0x19,
+	0x64, 0x67, 0x4A, 0x98, 0xD4, 0xB7, 0xA7, 0x83, 0x18, 0xC8,
+	0x40, 0xE2, 0x7F, 0xB8, 0x25, 0x8B, 0x7E, 0x92, 0x4A, 0x8C,
+	0x68, 0x1B, 0x77, 0x61, 0x1E, 0x70, 0xED, 0xC2, 0xC4, 0xA5,
+	0xDF, 0x9E, 0x76, 0xED, 0x49, 0x84, 0x3D, 0x08, 0xFE, 0xFE,
+	0x99, 0xE2, 0xC6, 0xEF, 0xFE, 0x2C, 0xD4, 0xC0, 0x04, 0xD8,
+	0x9A, 0x51, 0x21, 0xCD, 0x5B, 0xDB, 0x9F, 0x0B, 0x9C, 0x47,
+	0xCF, 0xE8, 0x38, 0x6B, 0xB4, 0x94, 0xDC, 0xCD, 0x9A, 0x9B,
+	0xB7, 0xED, 0xEE, 0x82, 0x64, 0x53, 0x20, 0xA0, 0x8F, 0x59,
+	0xB2, 0x4F, 0xE2, 0x5A, 0x35, 0x88, 0x39, 0x5B, 0x6C, 0x59,
+	0x59, 0x8C, 0x10, 0xC5, 0x2B, 0xF3, 0x7C, 0x49, 0xFD, 0x99,
+	0x0C, 0x86, 0x07, 0x9E, 0x35, 0x71, 0x8E, 0x23, 0x7B, 0x9D,
+	0x23, 0x34, 0x7A, 0xC8, 0x8A, 0x17, 0xDA, 0x7B, 0xA2, 0x97,
+	0x0A, 0x78, 0x2B, 0x19, 0xAD, 0xB1, 0x35, 0xBD, 0xB1, 0xE7,
+	0x74, 0x4B, 0x82, 0xFB, 0x72, 0x9C, 0x8C, 0x51, 0x3B, 0xE3,
+	0xF0, 0x31, 0x11, 0xAA, 0x59, 0xA4, 0x66, 0xAC, 0xAA, 0x9E,
+	0x85, 0xD9, 0x2D, 0xAD, 0xCA, 0x2B, 0x69, 0x5E, 0x19, 0x9F,
+	0x77, 0x15, 0x43, 0xF0, 0xC9, 0x9F, 0xBC, 0x5B, 0x66, 0x26,
 	0x7F, 0x7D, 0x7C, 0x95, 0x5D, 0x60, 0xE0, 0x49, 0x15, 0xC4,
 	0x56, 0x47, 0x7E, 0x8D, 0x68, 0x3C, 0x54, 0x6F, 0x20, 0xF9,
 	0x00, 0x43, 0xB4, 0x52, 0xD8, 0x46, 0x51, 0xFC, 0x0B, 0x92,
@@ -3939,10 +4828,13 @@ test_external_API_inner(unsigned logn, shake256_context *rng)
 {
 	int i;
 	void *pubkey, *pubkey2, *privkey, *sig, *sigpad, *sigct, *expkey;
+	void *exppub;
 	size_t pubkey_len, privkey_len, sig_len, sigpad_len, sigct_len;
-	size_t expkey_len;
+	size_t expkey_len, exppub_len;
 	uint8_t *tmpkg, *tmpmp, *tmpsd, *tmpst, *tmpvv, *tmpek;
 	size_t tmpkg_len, tmpmp_len, tmpsd_len, tmpst_len, tmpvv_len, tmpek_len;
+	uint8_t *tmpvb;
+	size_t tmpvb_len;
 
 	printf("[%u]", logn);
 	fflush(stdout);
@@ -3961,6 +4853,8 @@ test_external_API_inner(unsigned logn, shake256_context *rng)
 	sigpad = xmalloc(sig_len);
 	sigct = xmalloc(sigct_len);
 	expkey = xmalloc(expkey_len);
+	exppub_len = FALCON_EXPANDEDPUB_SIZE(logn);
+	exppub = xmalloc(exppub_len);
 
 	tmpkg_len = FALCON_TMPSIZE_KEYGEN(logn);
 	tmpmp_len = FALCON_TMPSIZE_MAKEPUB(logn);
@@ -3968,6 +4862,7 @@ test_external_API_inner(unsigned logn, shake256_context *rng)
 	tmpst_len = FALCON_TMPSIZE_SIGNTREE(logn);
 	tmpvv_len = FALCON_TMPSIZE_VERIFY(logn);
 	tmpek_len = FALCON_TMPSIZE_EXPANDPRIV(logn);
+	tmpvb_len = FALCON_TMPSIZE_VERIFY_BATCH(logn);
 
 	tmpkg = xmalloc(tmpkg_len);
 	tmpmp = xmalloc(tmpmp_len);
@@ -3975,6 +4870,7 @@ test_external_API_inner(unsigned logn, shake256_context *rng)
 	tmpst = xmalloc(tmpst_len);
 	tmpvv = xmalloc(tmpvv_len);
 	tmpek = xmalloc(tmpek_len);
+	tmpvb = xmalloc(tmpvb_len);
 
 	for (i = 0; i < 12; i ++) {
 		int r;
@@ -4096,6 +4992,105 @@ test_external_API_inner(unsigned logn, shake256_context *rng)
 			}
 		}
 
+		r = falcon_expand_pubkey(exppub, exppub_len,
+			pubkey, pubkey_len);
+		if (r != 0) {
+			fprintf(stderr, "expand_pubkey failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		r = falcon_verify_expanded(sig, sig_len, FALCON_SIG_COMPRESSED,
+			exppub, "data1", 5, tmpvv, tmpvv_len);
+		if (r != 0) {
+			fprintf(stderr, "verify(exppub) failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		r = falcon_verify_expanded(sigpad, sigpad_len, 0,
+			exppub, "data1", 5, tmpvv, tmpvv_len);
+		if (r != 0) {
+			fprintf(stderr, "verify(exppub, padded) failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		r = falcon_verify_expanded(sigct, sigct_len, FALCON_SIG_CT,
+			exppub, "data1", 5, tmpvv, tmpvv_len);
+		if (r != 0) {
+			fprintf(stderr, "verify(exppub, ct) failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		if (logn >= 5) {
+			r = falcon_verify_expanded(sig, sig_len,
+				FALCON_SIG_COMPRESSED, exppub, "data2", 5,
+				tmpvv, tmpvv_len);
+			if (r != FALCON_ERR_BADSIG) {
+				fprintf(stderr,
+					"wrong verify(exppub) err: %d\n", r);
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		/*
+		 * Batch verification: valid signatures of all types, a
+		 * wrong message (for the larger degrees) and a truncated
+		 * signature, over more than one group.
+		 */
+		{
+			const void *bsig[19], *bdata[19];
+			size_t bsig_len[19], bdata_len[19];
+			int bres[19], bexp[19];
+			size_t j;
+
+			for (j = 0; j < 19; j ++) {
+				switch (j % 3) {
+				case 0:
+					bsig[j] = sig;
+					bsig_len[j] = sig_len;
+					break;
+				case 1:
+					bsig[j] = sigpad;
+					bsig_len[j] = sigpad_len;
+					break;
+				default:
+					bsig[j] = sigct;
+					bsig_len[j] = sigct_len;
+					break;
+				}
+				bdata[j] = "data1";
+				bdata_len[j] = 5;
+				bexp[j] = 0;
+			}
+			bsig_len[4] = 40;
+			bexp[4] = FALCON_ERR_FORMAT;
+			if (logn >= 5) {
+				bdata[7] = "data2";
+				bexp[7] = FALCON_ERR_BADSIG;
+				bdata[9] = "data2";
+				bexp[9] = FALCON_ERR_BADSIG;
+				bdata[17] = "data2";
+				bexp[17] = FALCON_ERR_BADSIG;
+			}
+			r = falcon_verify_batch(bsig, bsig_len, 0, exppub,
+				bdata, bdata_len, bres, 19, tmpvb, tmpvb_len);
+			if (r != FALCON_ERR_FORMAT) {
+				fprintf(stderr,
+					"wrong verify_batch err: %d\n", r);
+				exit(EXIT_FAILURE);
+			}
+			for (j = 0; j < 19; j ++) {
+				if (bres[j] != bexp[j]) {
+					fprintf(stderr, "verify_batch[%zu]:"
+						" %d (expected %d)\n",
+						j, bres[j], bexp[j]);
+					exit(EXIT_FAILURE);
+				}
+			}
+			r = falcon_verify_batch(bsig, bsig_len, 0, exppub,
+				bdata, bdata_len, bres, 4, tmpvb, tmpvb_len);
+			if (r != 0) {
+				fprintf(stderr,
+					"verify_batch failed: %d\n", r);
+				exit(EXIT_FAILURE);
+			}
+		}
+
 		r = falcon_expand_privkey(expkey, expkey_len,
 			privkey, privkey_len, tmpek, tmpek_len);
 		if (r != 0) {
@@ -4192,12 +5187,14 @@ test_external_API_inner(unsigned logn, shake256_context *rng)
 	xfree(sigpad);
 	xfree(sigct);
 	xfree(expkey);
+	xfree(exppub);
 	xfree(tmpkg);
 	xfree(tmpmp);
 	xfree(tmpsd);
 	xfree(tmpst);
 	xfree(tmpvv);
 	xfree(tmpek);
+	xfree(tmpvb);
 }
 
 static void
@@ -4218,6 +5215,625 @@ test_external_API(void)
 	fflush(stdout);
 }
 
+/*
+ * Batched online phase: 7 signatures (one full group and an incomplete
+ * one), with a misaligned token and a used token in the set.
+ */
+static void
+test_lazy_batch(unsigned logn, shake256_context *rng, const void *expkey,
+	const void *pubkey, size_t pubkey_len)
+{
+	enum { K = 7 };
+	uint8_t *tokens, *sigs, *tmp, *tmpvv;
+	void *token[K], *sig[K];
+	const void *data[K];
+	size_t sig_len[K], data_len[K], token_len, maxsig_len, tmp_len;
+	uint8_t msg[K][16];
+	int results[K];
+	size_t i;
+	int r;
+
+	token_len = FALCON_LAZY_TOKEN_SIZE(logn);
+	maxsig_len = FALCON_SIG_CT_SIZE(logn);
+	tmp_len = FALCON_TMPSIZE_SIGNLAZY_BATCH(logn);
+	tokens = xmalloc(K * (token_len + 8));
+	sigs = xmalloc(K * maxsig_len);
+	tmp = xmalloc(tmp_len);
+	tmpvv = xmalloc(FALCON_TMPSIZE_VERIFY(logn));
+	for (i = 0; i < K; i ++) {
+		token[i] = tokens + i * (token_len + 8) + (i == 2);
+		r = falcon_sign_lazy_offline(rng, token[i], token_len, expkey,
+			tmp, tmp_len);
+		if (r != 0) {
+			fprintf(stderr, "lazy offline failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		shake256_extract(rng, msg[i], sizeof msg[i]);
+		data[i] = msg[i];
+		data_len[i] = sizeof msg[i];
+		sig[i] = sigs + i * maxsig_len;
+		sig_len[i] = maxsig_len;
+	}
+	*(uint8_t *)token[4] = 0;
+
+	r = falcon_sign_lazy_online_batch(sig, sig_len, FALCON_SIG_CT,
+		expkey, token, token_len, data, data_len, results, K,
+		tmp, tmp_len);
+	if (r != FALCON_ERR_FORMAT) {
+		fprintf(stderr, "lazy batch: used token not reported: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < K; i ++) {
+		if (i == 4) {
+			if (results[i] != FALCON_ERR_FORMAT) {
+				fprintf(stderr, "lazy batch: used token: %d\n",
+					results[i]);
+				exit(EXIT_FAILURE);
+			}
+			continue;
+		}
+		if (results[i] != 0) {
+			fprintf(stderr, "lazy batch sign failed (%u): %d\n",
+				(unsigned)i, results[i]);
+			exit(EXIT_FAILURE);
+		}
+		r = falcon_verify(sig[i], sig_len[i], FALCON_SIG_CT,
+			pubkey, pubkey_len, data[i], data_len[i],
+			tmpvv, FALCON_TMPSIZE_VERIFY(logn));
+		if (r != 0) {
+			fprintf(stderr, "lazy batch verify failed (%u): %d\n",
+				(unsigned)i, r);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	xfree(tokens);
+	xfree(sigs);
+	xfree(tmp);
+	xfree(tmpvv);
+}
+
+static void
+test_lazy_inner(unsigned logn, shake256_context *rng)
+{
+	static const int policies[] = {
+		FALCON_LAZY_POOL_WAIT, FALCON_LAZY_POOL_SYNC,
+		FALCON_LAZY_POOL_FAIL
+	};
+	static const int sig_types[] = {
+		FALCON_SIG_COMPRESSED, FALCON_SIG_PADDED, FALCON_SIG_CT
+	};
+	void *pubkey, *privkey, *sig, *expkey, *token;
+	uint8_t *tk;
+	size_t pubkey_len, privkey_len, sig_len, maxsig_len;
+	size_t expkey_len, token_len;
+	uint8_t *tmpkg, *tmpsp, *tmpvv;
+	size_t tmpkg_len, tmpsp_len, tmpvv_len;
+	falcon_lazy_pool *pool;
+	falcon_lazy_store *store;
+	size_t u;
+	int i, r;
+
+	printf("[%u]", logn);
+	fflush(stdout);
+
+	pubkey_len = FALCON_PUBKEY_SIZE(logn);
+	privkey_len = FALCON_PRIVKEY_SIZE(logn);
+	maxsig_len = FALCON_SIG_COMPRESSED_MAXSIZE(logn);
+	if (maxsig_len < FALCON_SIG_CT_SIZE(logn)) {
+		maxsig_len = FALCON_SIG_CT_SIZE(logn);
+	}
+	tmpkg_len = FALCON_TMPSIZE_KEYGEN(logn);
+	expkey_len = FALCON_LAZY_EXPANDEDKEY_SIZE(logn);
+	token_len = FALCON_LAZY_TOKEN_SIZE(logn);
+	tmpsp_len = FALCON_TMPSIZE_SIGNPOOL(logn);
+	tmpvv_len = FALCON_TMPSIZE_VERIFY(logn);
+	pubkey = xmalloc(pubkey_len);
+	expkey = xmalloc(expkey_len);
+	token = xmalloc(token_len + 1);
+	privkey = xmalloc(privkey_len);
+	sig = xmalloc(maxsig_len);
+	tmpkg = xmalloc(tmpkg_len);
+	tmpsp = xmalloc(tmpsp_len);
+	tmpvv = xmalloc(tmpvv_len);
+
+	r = falcon_keygen_make(rng, logn, privkey, privkey_len,
+		pubkey, pubkey_len, tmpkg, tmpkg_len);
+	if (r != 0) {
+		fprintf(stderr, "keygen failed: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+
+	/*
+	 * Explicit offline / online phases with an expanded key. The
+	 * last runs use a misaligned token, which is not read in place.
+	 */
+	for (i = 0; i < 6; i ++) {
+		uint8_t msg[20];
+		int st;
+
+		r = falcon_lazy_expand_key(expkey, expkey_len,
+			privkey, privkey_len, pubkey, pubkey_len,
+			tmpsp, tmpsp_len);
+		if (r != 0) {
+			fprintf(stderr, "lazy expand failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		tk = (uint8_t *)token + (i >= 4);
+		r = falcon_sign_lazy_offline(rng, tk, token_len, expkey,
+			tmpsp, tmpsp_len);
+		if (r != 0) {
+			fprintf(stderr, "lazy offline failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		shake256_extract(rng, msg, sizeof msg);
+		st = (i & 1) ? FALCON_SIG_CT : FALCON_SIG_COMPRESSED;
+		sig_len = maxsig_len;
+		r = falcon_sign_lazy_online(sig, &sig_len, st,
+			expkey, tk, token_len, msg, sizeof msg,
+			tmpsp, tmpsp_len);
+		if (r != 0) {
+			fprintf(stderr, "lazy online failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		r = falcon_verify(sig, sig_len, st, pubkey, pubkey_len,
+			msg, sizeof msg, tmpvv, tmpvv_len);
+		if (r != 0) {
+			fprintf(stderr, "lazy sign verify failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		sig_len = maxsig_len;
+		r = falcon_sign_lazy_online(sig, &sig_len, st,
+			expkey, tk, token_len, msg, sizeof msg,
+			tmpsp, tmpsp_len);
+		if (r != FALCON_ERR_FORMAT) {
+			fprintf(stderr, "lazy token reused: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+	}
+	printf(".");
+	fflush(stdout);
+
+	test_lazy_batch(logn, rng, expkey, pubkey, pubkey_len);
+	printf(".");
+	fflush(stdout);
+
+	/*
+	 * Token store: tokens survive closing and reopening the file,
+	 * and are never used twice.
+	 */
+	remove("test_lazy_store.bin");
+	((uint8_t *)pubkey)[2] ^= 0x04;
+	r = falcon_lazy_store_create(rng, "test_lazy_store.bin", 5,
+		expkey, pubkey, pubkey_len, tmpsp, tmpsp_len);
+	((uint8_t *)pubkey)[2] ^= 0x04;
+	if (r != FALCON_ERR_BADARG) {
+		fprintf(stderr, "lazy store creation, wrong key: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < 2; i ++) {
+		FILE *f;
+
+		f = fopen(i == 0 ? "test_lazy_store.bin"
+			: "test_lazy_store.bin.tmp", "rb");
+		if (f != NULL) {
+			fprintf(stderr, "lazy store created with wrong key\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	r = falcon_lazy_store_create(rng, "test_lazy_store.bin", 5,
+		expkey, pubkey, pubkey_len, tmpsp, tmpsp_len);
+	if (r != 0) {
+		fprintf(stderr, "lazy store creation failed: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	((uint8_t *)pubkey)[1] ^= 0x01;
+	r = falcon_lazy_store_open(&store, "test_lazy_store.bin",
+		pubkey, pubkey_len, 0);
+	((uint8_t *)pubkey)[1] ^= 0x01;
+	if (r != FALCON_ERR_BADARG || store != NULL) {
+		fprintf(stderr, "lazy store key mismatch: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < 7; i ++) {
+		uint8_t msg[20];
+
+		if (i == 0 || i == 3) {
+			r = falcon_lazy_store_open(&store,
+				"test_lazy_store.bin", pubkey, pubkey_len,
+				i == 0 ? FALCON_LAZY_STORE_HUGEPAGES
+				: FALCON_LAZY_STORE_NOSYNC);
+			if (r != 0) {
+				fprintf(stderr, "lazy store open failed: %d\n",
+					r);
+				exit(EXIT_FAILURE);
+			}
+		}
+		if (falcon_lazy_store_remaining(store)
+			!= (size_t)(i < 5 ? 5 - i : 0))
+		{
+			fprintf(stderr, "lazy store remaining\n");
+			exit(EXIT_FAILURE);
+		}
+		if (i == 1) {
+			uint16_t *hk;
+
+			/*
+			 * An expanded key for another public key is
+			 * rejected, and no token is consumed.
+			 */
+			hk = (uint16_t *)Zf(lazy_expkey_h)(expkey);
+			hk[0] ^= 1;
+			sig_len = maxsig_len;
+			r = falcon_lazy_store_sign(store, sig, &sig_len,
+				FALCON_SIG_COMPRESSED, expkey, "x", 1,
+				tmpsp, tmpsp_len);
+			hk[0] ^= 1;
+			if (r != FALCON_ERR_BADARG
+				|| falcon_lazy_store_remaining(store) != 4)
+			{
+				fprintf(stderr, "lazy store sign, wrong key:"
+					" %d\n", r);
+				exit(EXIT_FAILURE);
+			}
+		}
+		shake256_extract(rng, msg, sizeof msg);
+		sig_len = maxsig_len;
+		r = falcon_lazy_store_sign(store, sig, &sig_len,
+			FALCON_SIG_COMPRESSED, expkey, msg, sizeof msg,
+			tmpsp, tmpsp_len);
+		if (i >= 5) {
+			if (r != FALCON_ERR_EMPTY) {
+				fprintf(stderr, "lazy store overrun: %d\n", r);
+				exit(EXIT_FAILURE);
+			}
+			continue;
+		}
+		if (r != 0) {
+			fprintf(stderr, "lazy store sign failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		r = falcon_verify(sig, sig_len, FALCON_SIG_COMPRESSED,
+			pubkey, pubkey_len, msg, sizeof msg,
+			tmpvv, tmpvv_len);
+		if (r != 0) {
+			fprintf(stderr, "lazy store verify failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		if (i == 2) {
+			falcon_lazy_store_close(store);
+		}
+	}
+	falcon_lazy_store_close(store);
+	remove("test_lazy_store.bin");
+	printf(".");
+	fflush(stdout);
+
+	r = falcon_lazy_pool_new(&pool, rng, privkey, privkey_len,
+		pubkey, pubkey_len, 8, 0, FALCON_LAZY_POOL_WAIT);
+	if (r != FALCON_ERR_BADARG || pool != NULL) {
+		fprintf(stderr, "pool without threads accepted WAIT: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+
+	for (u = 0; u < sizeof policies / sizeof policies[0]; u ++) {
+		unsigned nthreads;
+
+		nthreads = (policies[u] == FALCON_LAZY_POOL_WAIT) ? 2 : 0;
+		r = falcon_lazy_pool_new(&pool, rng, privkey, privkey_len,
+			pubkey, pubkey_len, 8, nthreads, policies[u]);
+		if (r != 0) {
+			fprintf(stderr, "pool creation failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		if (falcon_lazy_pool_get_logn(pool) != logn) {
+			fprintf(stderr, "pool logn mismatch\n");
+			exit(EXIT_FAILURE);
+		}
+		if (nthreads == 0) {
+			if (falcon_lazy_pool_available(pool) != 1) {
+				fprintf(stderr, "initial pool size\n");
+				exit(EXIT_FAILURE);
+			}
+			if (falcon_lazy_pool_refill(pool, 100) != 7
+				|| falcon_lazy_pool_available(pool) != 8)
+			{
+				fprintf(stderr, "pool refill\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		for (i = 0; i < 12; i ++) {
+			uint8_t msg[20];
+			int st;
+
+			shake256_extract(rng, msg, sizeof msg);
+			st = sig_types[i % 3];
+			if (logn == 10 && st == FALCON_SIG_PADDED) {
+				/*
+				 * Lazy signatures for degree 1024 almost
+				 * never fit in the padded size.
+				 */
+				st = FALCON_SIG_COMPRESSED;
+			}
+			sig_len = maxsig_len;
+			r = falcon_lazy_sign_from_pool(pool,
+				sig, &sig_len, st, msg, sizeof msg,
+				tmpsp, tmpsp_len);
+			if (r == FALCON_ERR_EMPTY
+				&& policies[u] == FALCON_LAZY_POOL_FAIL)
+			{
+				continue;
+			}
+			if (r != 0) {
+				fprintf(stderr, "pool sign failed: %d\n", r);
+				exit(EXIT_FAILURE);
+			}
+			r = falcon_verify(sig, sig_len, st, pubkey, pubkey_len,
+				msg, sizeof msg, tmpvv, tmpvv_len);
+			if (r != 0) {
+				fprintf(stderr, "pool sign verify failed: %d\n",
+					r);
+				exit(EXIT_FAILURE);
+			}
+			msg[0] ^= 0x01;
+			r = falcon_verify(sig, sig_len, st, pubkey, pubkey_len,
+				msg, sizeof msg, tmpvv, tmpvv_len);
+			if (r != FALCON_ERR_BADSIG) {
+				fprintf(stderr, "pool sign wrong verify: %d\n",
+					r);
+				exit(EXIT_FAILURE);
+			}
+		}
+		if (policies[u] == FALCON_LAZY_POOL_FAIL) {
+			sig_len = maxsig_len;
+			r = falcon_lazy_sign_from_pool(pool,
+				sig, &sig_len, FALCON_SIG_COMPRESSED, "x", 1,
+				tmpsp, tmpsp_len);
+			if (r != FALCON_ERR_EMPTY) {
+				fprintf(stderr, "empty pool not reported: %d\n",
+					r);
+				exit(EXIT_FAILURE);
+			}
+		}
+		falcon_lazy_pool_free(pool);
+		printf(".");
+		fflush(stdout);
+	}
+
+	xfree(pubkey);
+	xfree(privkey);
+	xfree(sig);
+	xfree(expkey);
+	xfree(token);
+	xfree(tmpkg);
+	xfree(tmpsp);
+	xfree(tmpvv);
+}
+
+/*
+ * Concurrent signing with one lazy context per thread, all sharing the
+ * same expanded key.
+ */
+#define LAZY_CTX_THREADS   4
+#define LAZY_CTX_SIGS      6
+
+typedef struct {
+	falcon_lazy_ctx *ctx;
+	unsigned idx;
+	uint8_t *sig;
+	size_t sig_len[LAZY_CTX_SIGS];
+	size_t maxsig_len;
+	int r;
+} lazy_ctx_job;
+
+static int
+lazy_ctx_sig_type(unsigned logn, int j)
+{
+	static const int sig_types[] = {
+		FALCON_SIG_COMPRESSED, FALCON_SIG_PADDED, FALCON_SIG_CT
+	};
+	int st;
+
+	st = sig_types[j % 3];
+	if (logn == 10 && st == FALCON_SIG_PADDED) {
+		st = FALCON_SIG_COMPRESSED;
+	}
+	return st;
+}
+
+static void *
+lazy_ctx_thread(void *arg)
+{
+	lazy_ctx_job *job;
+	unsigned logn;
+	int j;
+
+	job = arg;
+	logn = falcon_lazy_ctx_get_logn(job->ctx);
+	for (j = 0; j < LAZY_CTX_SIGS; j ++) {
+		uint8_t msg[2];
+		int r;
+
+		msg[0] = (uint8_t)job->idx;
+		msg[1] = (uint8_t)j;
+		job->sig_len[j] = job->maxsig_len;
+		r = falcon_lazy_ctx_sign(job->ctx,
+			job->sig + j * job->maxsig_len, &job->sig_len[j],
+			lazy_ctx_sig_type(logn, j), msg, sizeof msg);
+		if (r != 0) {
+			job->r = r;
+			break;
+		}
+	}
+	return NULL;
+}
+
+static void
+test_lazy_ctx(unsigned logn, shake256_context *rng)
+{
+	lazy_ctx_job jobs[LAZY_CTX_THREADS];
+	pthread_t threads[LAZY_CTX_THREADS];
+	falcon_lazy_ctx *ctx;
+	void *pubkey, *privkey, *expkey, *token;
+	uint8_t *tmpkg, *tmpvv, *sig;
+	size_t pubkey_len, privkey_len, expkey_len, token_len;
+	size_t tmpkg_len, tmpvv_len, maxsig_len, sig_len;
+	unsigned u;
+	int j, r;
+
+	pubkey_len = FALCON_PUBKEY_SIZE(logn);
+	privkey_len = FALCON_PRIVKEY_SIZE(logn);
+	expkey_len = FALCON_LAZY_EXPANDEDKEY_SIZE(logn);
+	token_len = FALCON_LAZY_TOKEN_SIZE(logn);
+	maxsig_len = FALCON_SIG_COMPRESSED_MAXSIZE(logn);
+	if (maxsig_len < FALCON_SIG_CT_SIZE(logn)) {
+		maxsig_len = FALCON_SIG_CT_SIZE(logn);
+	}
+	tmpkg_len = FALCON_TMPSIZE_KEYGEN(logn);
+	if (tmpkg_len < FALCON_TMPSIZE_LAZYEXPAND(logn)) {
+		tmpkg_len = FALCON_TMPSIZE_LAZYEXPAND(logn);
+	}
+	tmpvv_len = FALCON_TMPSIZE_VERIFY(logn);
+	pubkey = xmalloc(pubkey_len);
+	privkey = xmalloc(privkey_len);
+	expkey = xmalloc(expkey_len);
+	token = xmalloc(token_len);
+	tmpkg = xmalloc(tmpkg_len);
+	tmpvv = xmalloc(tmpvv_len);
+	sig = xmalloc(maxsig_len);
+
+	r = falcon_keygen_make(rng, logn, privkey, privkey_len,
+		pubkey, pubkey_len, tmpkg, tmpkg_len);
+	if (r != 0) {
+		fprintf(stderr, "keygen failed: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	r = falcon_lazy_expand_key(expkey, expkey_len,
+		privkey, privkey_len, pubkey, pubkey_len, tmpkg, tmpkg_len);
+	if (r != 0) {
+		fprintf(stderr, "lazy expand failed: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+
+	memset(tmpkg, 0, 1);
+	r = falcon_lazy_ctx_new(&ctx, rng, tmpkg);
+	if (r != FALCON_ERR_FORMAT || ctx != NULL) {
+		fprintf(stderr, "lazy ctx with bad key accepted: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+
+	for (u = 0; u < LAZY_CTX_THREADS; u ++) {
+		memset(&jobs[u], 0, sizeof jobs[u]);
+		r = falcon_lazy_ctx_new(&jobs[u].ctx, rng, expkey);
+		if (r != 0) {
+			fprintf(stderr, "lazy ctx creation failed: %d\n", r);
+			exit(EXIT_FAILURE);
+		}
+		jobs[u].idx = u;
+		jobs[u].maxsig_len = maxsig_len;
+		jobs[u].sig = xmalloc(LAZY_CTX_SIGS * maxsig_len);
+	}
+	for (u = 0; u < LAZY_CTX_THREADS; u ++) {
+		if (pthread_create(&threads[u], NULL,
+			lazy_ctx_thread, &jobs[u]) != 0)
+		{
+			fprintf(stderr, "pthread_create() failed\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	for (u = 0; u < LAZY_CTX_THREADS; u ++) {
+		pthread_join(threads[u], NULL);
+	}
+	for (u = 0; u < LAZY_CTX_THREADS; u ++) {
+		if (jobs[u].r != 0) {
+			fprintf(stderr, "lazy ctx sign failed: %d\n",
+				jobs[u].r);
+			exit(EXIT_FAILURE);
+		}
+		for (j = 0; j < LAZY_CTX_SIGS; j ++) {
+			uint8_t msg[2];
+
+			msg[0] = (uint8_t)u;
+			msg[1] = (uint8_t)j;
+			r = falcon_verify(jobs[u].sig + j * maxsig_len,
+				jobs[u].sig_len[j], lazy_ctx_sig_type(logn, j),
+				pubkey, pubkey_len, msg, sizeof msg,
+				tmpvv, tmpvv_len);
+			if (r != 0) {
+				fprintf(stderr, "lazy ctx verify failed: %d\n",
+					r);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+	printf(".");
+	fflush(stdout);
+
+	/*
+	 * A token made by one context can be consumed by another.
+	 */
+	r = falcon_lazy_ctx_offline(jobs[0].ctx, token, token_len);
+	if (r != 0) {
+		fprintf(stderr, "lazy ctx offline failed: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	sig_len = maxsig_len;
+	r = falcon_lazy_ctx_online(jobs[1].ctx, sig, &sig_len,
+		FALCON_SIG_COMPRESSED, token, token_len, "ctx", 3);
+	if (r != 0) {
+		fprintf(stderr, "lazy ctx online failed: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	r = falcon_verify(sig, sig_len, FALCON_SIG_COMPRESSED,
+		pubkey, pubkey_len, "ctx", 3, tmpvv, tmpvv_len);
+	if (r != 0) {
+		fprintf(stderr, "lazy ctx online verify failed: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+	sig_len = maxsig_len;
+	r = falcon_lazy_ctx_online(jobs[2].ctx, sig, &sig_len,
+		FALCON_SIG_COMPRESSED, token, token_len, "ctx", 3);
+	if (r != FALCON_ERR_FORMAT) {
+		fprintf(stderr, "lazy ctx token reuse accepted: %d\n", r);
+		exit(EXIT_FAILURE);
+	}
+
+	for (u = 0; u < LAZY_CTX_THREADS; u ++) {
+		falcon_lazy_ctx_free(jobs[u].ctx);
+		xfree(jobs[u].sig);
+	}
+	printf(".");
+	fflush(stdout);
+
+	xfree(pubkey);
+	xfree(privkey);
+	xfree(expkey);
+	xfree(token);
+	xfree(tmpkg);
+	xfree(tmpvv);
+	xfree(sig);
+}
+
+static void
+test_lazy(void)
+{
+	unsigned logn;
+	shake256_context rng;
+
+	printf("Test lazy API: ");
+	fflush(stdout);
+
+	shake256_init_prng_from_seed(&rng, "lazy pool", 9);
+	for (logn = 9; logn <= 10; logn ++) {
+		test_lazy_inner(logn, &rng);
+		test_lazy_ctx(logn, &rng);
+	}
+
+	printf(" done.\n");
+	fflush(stdout);
+}
+
 #if DO_NIST_TESTS
 
 /* ===================================================================== */
@@ -5136,8 +6752,12 @@ main(void)
 	old = set_fpu_cw(2);
 
 	test_SHAKE256();
+	test_SHAKE256_multi();
 	test_codec();
+	test_codec_fixed();
+	test_codec_comp();
 	test_vrfy();
+	test_vrfy_batch_raw();
 	test_RNG();
 	test_FP_block();
 	test_poly();
@@ -5146,6 +6766,7 @@ main(void)
 	test_sign();
 	test_keygen();
 	test_external_API();
+	test_lazy();
 	test_nist_KAT(9, "a57400cbaee7109358859a56c735a3cf048a9da2");
 	test_nist_KAT(10, "affdeb3aa83bf9a2039fa9c17d65fd3e3b9828e2");
 	/* test_speed(); */
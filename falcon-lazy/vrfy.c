@@ -31,6 +31,14 @@
 
 #include "inner.h"
 
+/*
+ * With FALCON_DISPATCH, this file is also compiled as part of the
+ * kernel copies (kern_avx2.c, kern_avx512.c); only the NTT functions
+ * (Zf(mq_NTT)(), Zf(mq_iNTT)(), Zf(mq_poly_tomonty)() and
+ * Zf(mq_poly_montymul_ntt)()) and Zf(verify_raw_batch)() are then
+ * included.
+ */
+
 /* ===================================================================== */
 /*
  * Constants for NTT.
@@ -321,6 +329,539 @@ static const uint16_t iGMb[] = {
 	 5421,  5231,  6473,   436,  7567,  8603,  6229,  8230
 };
 
+#if FALCON_AVX2 // yyyAVX2+1
+/*
+ * Tables for the AVX2 NTT: GMs[] and iGMs[] contain the values of GMb[]
+ * and iGMb[] in the centered range -q/2..+q/2, and GMsq[] and iGMsq[]
+ * the same values multiplied by 1/q mod 2^16 (signed 16-bit), as used
+ * by the signed Montgomery multiplication (see mq_montymul_x16()).
+ */
+static const int16_t GMs[] = {
+	  4091,  -4401,  -1229,  -1081,  -5329,   4342,  -6014,  -2530,
+	  1591,  -5890,  -2812,   5266,    586,   5825,  -4751,  -2579,
+	  1134,  -5882,   1711,    965,  -5190,  -4615,   3743,  -5847,
+	 -1875,  -4189,   1885,   1688,   1364,  -1960,  -2125,  -3109,
+	   -79,  -6049,    997,    117,   4783,   4407,   1549,  -5217,
+	  2829,  -5831,   4431,  -3412,  -5145,   2564,   5664,   4042,
+	  -100,    432,  -1538,   1237,  -4679,   1534,   3983,  -4426,
+	  2181,  -5981,  -3569,  -5719,   4843,   1690,     14,   3872,
+	  5569,  -2921,   -126,   2019,  -4746,   2315,   4673,  -4949,
+	  1553,   1156,  -3888,   -900,   1020,   2967,  -1517,  -5244,
+	  3316,  -1053,   5285,   -711,  -1652,  -2203,  -2796,  -6109,
+	 -3012,   6130,   3323,    883,  -1820,    489,   1502,   2851,
+	 -1228,  -2560,   2742,    -48,   4970,  -1808,  -2211,   1195,
+	   730,   1762,   3854,   2030,   5892,  -1367,  -3269,   5274,
+	 -3110,   3604,   3782,  -2083,   3180,   3467,   4668,   2446,
+	 -4676,  -2903,    834,  -4586,  -5453,   3403,   5351,    -13,
+	  3580,   1739,  -1469,  -2502,  -2080,   4070,    -39,  -3764,
+	 -1888,   2749,  -4951,  -1715,   6040,    943,  -2959,   1477,
+	 -5424,  -2621,   3585,  -5656,   -144,   4063,   3684,  -4609,
+	 -4101,  -5387,   3533,  -2482,   6090,    727,  -2190,  -5286,
+	 -5344,   1949,  -2558,  -1730,   6057,    378,  -4418,  -3526,
+	 -3388,  -3060,  -3443,   4551,  -2700,   -625,  -4659,  -3468,
+	  5680,   4956,  -6038,  -3901,  -2133,  -3566,   2341,   3159,
+	  1467,   5460,  -3736,  -4506,   2649,   2320,  -3253,  -6101,
+	   737,   3698,   4699,   5753,  -3243,   3687,     16,    914,
+	  5186,  -1758,   4552,   1964,   3509,  -3853,  -4773,   5381,
+	 -1556,   3281,  -5252,   1060,   2895,  -5133,  -3402,   5357,
+	 -5880,  -4092,   2962,  -5914,   5064,  -5655,   5625,    278,
+	   932,  -2060,  -3362,  -4647,    351,  -2991,    237,   5858,
+	 -4597,   3146,   -163,  -4703,   2053,  -1004,   3802,   5204,
+	  4602,   1748,   -989,    340,   3711,   4614,    300,  -1296,
+	  5070,  -2240,   -673,    -42,  -4868,  -1582,   5746,   5654,
+	  3835,   5553,   1224,  -3813,  -3052,   3845,    250,  -1080,
+	  4225,  -5963,  -2609,    -35,   4136,   2778,    692,  -3481,
+	 -5879,  -5571,  -2184,  -1871,   3759,  -4933,   -928,  -3856,
+	 -5852,   3652,  -5947,  -3311,   5391,   2272,  -5813,  -4873,
+	 -3871,  -1465,   -303,   5733,    876,  -5259,   2167,   2436,
+	  3442,  -3072,  -4083,   4858,   5964,   2746,  -5111,   1434,
+	 -4900,  -3410,  -1628,   -832,   4220,   1432,  -1457,   4328,
+	 -3732,   1867,  -2835,   2416,   3816,  -3213,    686,   5393,
+	  2523,   4339,   6115,    619,    937,   2834,  -4514,   3279,
+	  2363,  -4801,   6112,   5056,    824,  -2085,   -599,   1113,
+	  2727,  -2441,    896,   2028,   5075,   2654,  -1825,  -4405,
+	  -120,   5434,   3070,  -5889,  -3157,   -617,   -136,   4520,
+	  1273,  -2550,   -821,  -2352,  -2250,  -2569,   2262,  -2890,
+	 -1097,    315,   4511,   1158,   6061,  -5538,   -424,    357,
+	 -4922,   4550,    983,  -3755,  -3937,  -2163,  -4759,  -3036,
+	  4367,   5221,   3999,  -3512,   3161,  -5299,   4130,   -637,
+	  3374,   -812,   1753,    292,  -3608,   2806,  -1911,   -101,
+	  5800,   -478,   3181,   1988,   1024,  -2949,   2477,  -1361,
+	  4582,  -5539,   3619,   5503,   5233,   2463,  -3819,  -4639,
+	 -4325,  -5894,   1071,   1272,   3474,  -1244,   3291,   -945,
+	 -3787,  -2811,  -2452,   1253,   1857,  -6056,   4720,   -728,
+	  6034,  -2472,   3339,   1797,   2879,  -6047,   5200,   2114,
+	 -4327,  -2936,   -926,   5475,   6084,  -2688,   4108,  -4966,
+	 -1851,  -2818,   1271,    408,  -5378,   3079,    360,  -4013,
+	  -754,  -3133,  -3240,   -750,    850,  -3672,    784,  -4370,
+	 -3955,   -119,   1846,  -2076,   -105,  -4462,   -386,   5600,
+	 -2510,   1012,    721,   2784,  -5613,  -5737,   5348,   4424,
+	 -5473,  -3884,  -2330,   5150,   2356,   5552,   5267,   1333,
+	 -3488,  -2628,  -4981,   5788,   4910,    909,   -676,   4395,
+	 -4051,  -5603,   4302,   3044,   2285,    -40,   1963,  -3073,
+	  4296,   -371,    695,   4371,  -2496,   4884,   2411,  -2059,
+	  2650,    841,   3890,  -2058,  -5041,  -3784,  -1093,  -5601,
+	  4059,   6060,   3686,   4722,   -436,   5816,  -5231,  -5421,
+	 -1152,  -4363,   4894,     -5,   4102,   3908,   3610,  -5764,
+	 -4351,  -4307,   -312,  -5534,    537,   4562,   1623,  -4062,
+	  -836,  -4745,    906,   -473,  -2741,  -1431,  -2586,   2815,
+	  -553,  -5476,  -5310,    819,  -3386,  -6018,  -1446,    348,
+	 -4775,  -3950,  -5850,    694,    852,   5659,   2781,   3716,
+	  -700,   3024,   1523,  -3630,   4114,  -1551,   3303,   5885,
+	  2978,  -5000,   -405,  -3166,  -2966,   -459,     98,   2526,
+	  2116,   4131,   -882,   1844,   3645,   3916,  -4156,   2224,
+	 -1418,  -4197,  -2638,   5989,  -5149,  -3809,   1670,    159,
+	 -1366,   4918,    128,  -4977,    725,  -3132,   5006,  -5896,
+	  3494,   6043,  -1317,  -6108,   -451,   3423,  -1775,  -4621,
+	  3693,  -5631,  -5384,   -336,  -2077,   -367,  -3188,  -3924,
+	  5110,     45,   2400,   1921,   4377,   2720,   1695,     51,
+	  2808,    650,   1896,  -2292,  -2318,   -309,  -4191,   4833,
+	  4135,   4257,   5838,   4765,  -1304,   -757,    590,    -91,
+	   482,   -116,   2006,  -5225,  -2271,   3912,   -273,  -1770,
+	  -927,  -5335,   2210,    284,   5413,  -5688,   3865,  -1950,
+	 -1101,  -6058,    517,  -2725,  -1008,   3863,   1210,   4604,
+	 -4129,   -842,    153,  -5085,   5763,   5089,  -3041,   -135,
+	  -541,   1354,  -5617,    179,   5532,   2646,   5941,   -104,
+	   862,   3158,    477,  -5010,   5678,  -4375,   4254,    302,
+	  2893,  -2175,  -5399,  -2729,  -2642,   -384,   4098,  -2465,
+	 -2020,   1353,  -1574,   5325,  -6035,   3951,   1807,  -5840,
+	  5159,   1308,  -3974,   3404,   1877,   1231,    112,  -5891,
+	  -565,    -17,  -5003,   1459,    -15,  -2393,   3456,    800,
+	  1397,  -1611,    103,  -4869,  -4313,    936,    764,    632,
+	 -4293,  -4066,  -3844,  -4531,  -1419,  -2718,   2508,   1946,
+	 -5765,  -2131,   1044,   4338,   2457,   3641,   1659,   4139,
+	  4688,  -2556,  -1141,   3946,   2082,   5261,   2036,   -439,
+	 -4653,    -53,   5366,   2380,   1399,  -4569,   2100,   3217,
+	 -1377,  -3391,  -4711,   -294,   2791,   1215,   3355,   2711,
+	  2267,   2004,  -3721,  -2113,   3214,   2337,   1750,   4729,
+	  4997,  -4874,  -5974,   -245,   4374,  -5132,   4844,    211,
+	 -4286,  -2130,  -2999,   -808,   1735,   2336,   5793,  -2414,
+	 -4097,    986,  -4762,   1401,    870,   3615,  -3824,   2756,
+	 -2519,   2034,  -2121,   3264,   6132,     54,   2880,   4763,
+	  -484,   3074,  -4003,  -2861,   4881,  -5356,   1090,  -2251,
+	  2567,    708,    893,  -5824,   4962,  -2265,   2090,   5718,
+	 -1546,    780,   4733,   4623,   2134,   2087,   4802,    884,
+	  5372,   5795,   5938,   4333,  -5730,  -4740,   5269,  -1625,
+	  4252,   3260,   5917,  -1475,   5768,  -2306,  -4193,  -4498,
+	 -5489,  -4798,  -6017,   1907,  -1342,  -6000,   -486,   6032,
+	  -840,   1171,  -3088,  -4356,   2479,  -4319,   -952,  -5227,
+	 -3378,  -5561,  -5747,  -4175,  -3461,  -5694,   3545,   4348,
+	  4610,   2205,  -5290,  -4183,   5560,  -1899,  -2968,   2499,
+	  2413,  -5017,  -5408,  -1707,  -2981,  -2852,   3554,   3326,
+	  5991,   -320,   3415,     -6,  -2451,   -226,   4332,  -4459,
+	  -960,  -5684,    -18,   2044,   -678,  -4936,  -1088,   -707,
+	  3733,  -3346,  -2311,   1627,  -5121,   3935,   5050,   2762,
+	 -4793,  -1906,    755,   1654,   -236,   4952,  -2155,   4394,
+	 -5697,  -4391,  -4792,  -3385,   -260,   3581,  -1541,   5674,
+	 -1931,   4901,  -4875,  -3518,    710,  -5525,  -3827,  -5096,
+	  5371,  -5015,  -1205,    290,  -4425,  -5462,   -467,   2509,
+	 -5711,   4026,   5807,   1458,   5721,   5762,   4178,   2105,
+	  -668,   4852,  -3392,   2856,   -779,  -3025,   2520,  -3513,
+	 -5278,   2647,   1898,  -5250,   5950,  -1126,   5488,  -6012,
+	 -3107,   -833,    633,  -2243,   -735,   5633,  -2702,   2333,
+	 -5281,  -5205,   5047,  -5090,  -2424,  -3292,    569,  -5899,
+	 -1444,  -2610,  -4021,   -817,   4203,   1997,      2,  -2958,
+	   162,  -6107,   2000,   3649,  -2497,  -5926,  -4732,  -6102,
+	 -3779,  -2354,   5536,  -3270,   3706,   -280,   1452,   3067,
+	  5494,  -2597,   4865,   6019,  -5183,  -2679,   4588,  -2124,
+	 -6028,   5887,   2652,  -2117,   1580,  -1910,   4638,  -2340
+};
+
+static const int16_t GMsq[] = {
+	    -5,   7887,  27443, -21561,   6959,  -3850, -30590,  22046,
+	-18889,  18686,  13572, -19310,   8778,  -6463, -17039, -31251,
+	 25710, -14074,  13999,   5061,   3002,  15865,  16031,  14633,
+	-30547,  24483, -26787, -31080,  17748,  30808,  26547,  -7205,
+	-12367,   6239,   5093,   4213,  17071, -16073, -27123,   7071,
+	-25843,  14649,  16719, -19796, -25625,  18948,   5664,  12234,
+	-16484,    432,  23038,   5333,  15801,  26110,  16271, -12618,
+	  6277,  22691,   8719,  14761,    747,   9882,  24590,   3872,
+	 -6719, -23401, -24702,  30691, -12938,  -1781,  -7615,  -9045,
+	-10735,  17540,  -3888, -17284, -15364, -17513,  27155,  11140,
+	 19700,  27619,   9381,  19769, -18036,   1893,  13588,  22563,
+	-19396, -18446,   -773,  29555,  14564,  20969,  26078,  31523,
+	 15156,  -2560,  -5450,    -48,  13162,  -1808, -30883,  -2901,
+	  8922, -22814,  28430,  26606,  22276,  19113,  -7365,  13466,
+	  5082,  19988,  -4410, -30755, -13204,   -629, -11716,  27022,
+	-21060,  17577, -23742, -12778,  23219,   -693, -15129,  28659,
+	-12804,  -2357,  27203,   5690,  -2080,  -4122,  20441, -20148,
+	 -1888, -25923,  15529, -30387, -26728,  13231, -15247,   5573,
+	 -5424,  26051,  -8703,  27112,   -144,  16351,  20068,   7679,
+	 -8197,  -1291, -25139,  22094,  14282, -19753, -26766,   2906,
+	 -5344, -26723, -27134,  22846,  26537,   8570,  20158,   4666,
+	 12996, -19444, -32115, -15929,  13684,  11663,  32205,  12916,
+	  5680, -11428,   2154,  24771,  -6229, -28142,   6437, -17321,
+	 -2629,  21844,  29032, -12698,  23129,   2320,  -7349, -10197,
+	-11551, -20878,    603,  26233,    853, -16793,     16, -23662,
+	-19390, -26334, -28216, -14420,   7605,  24819,  -8869,   9477,
+	-17940,  -9007, -21636,  17444,  15183,  23539, -11594, -23315,
+	 26888,  12292, -21614, -14106, -27704,  14825,  26105,  -7914,
+	 17316,  14324,  21214,  15833,  12639, -15279, -28435, -18718,
+	 -8693,  11338, -28835, -16991,   6149,  15380,  11994,  21588,
+	 12794,  18132,  27683,  16724,  15999,  -3578, -16084,  -1296,
+	 29646,  -2240,  11615,  -8234, -21252, -26158, -18830,  -2538,
+	  -261,  -6735, -31544,  -7909,  13332,   7941,   8442,  31688,
+	 -8063,  -1867,   9679, -28707, -28632,  10970,  17076, -23961,
+	 14601,  31293,  30584, -14159,  16047,  -9029,   -928,  -3856,
+	 10532,  20036,  -1851, -15599,  17679,   2272,  -9909, -25353,
+	-16159, -21945, -12591,   9829, -15508,  -1163, -18313,  18820,
+	-21134,  -3072, -32755,  13050, -10420,  10938,  15369,   9626,
+	-21284,  21166,  14756,   -832, -12164, -31336,  10831, -28440,
+	-20116,  -2229, -31507,   2416, -28952,  25459,  25262,  -6895,
+	 -1573, -32525, -30749,  -3477,  21417, -21742,  20062,  15567,
+	 -1733,   7487,   6112,   5056, -31944,  -6181,  19881,  21593,
+	-17753, -22921,    896, -14356, -31789,  27230,  10463,  -8501,
+	 32648,  13626,  27646,   6399,  -7253, -21097,  32632, -28248,
+	 21753,   5642,  -4917,  -2352, -10442, -23049,  -5930, -11082,
+	-21577,  -3781,  16799,  -7034, -22611,  19038,  32344,   4453,
+	-13114,  -3642, -19497,    341,   8351, -30835,  15721,  13348,
+	 16655,   9317,  16287,  29256,  23641,  31565, -20446,  28035,
+	 27950,  15572,  22233,  16676,  29160,  -5386,  18569,  -4197,
+	-26968, -25054, -25491,  18372,   1024,  -7045, -26195,  10927,
+	 -3610,  31325,  32291,  17791,  -7055,  14751,    277, -16927,
+	 -8421,   2298,  13359, -31496, -21102,  15140,   -805,  11343,
+	   309,   1285, -18836,   5349, -10431,  26712,   4720,  32040,
+	-18542,  30296,   -757,   5893,  15167, -18335,   5200, -22462,
+	 16153,  29832, -25502, -31389,  22468,  -2688, -12276,   3226,
+	  2245,  21758, -19209, -32360,  19198, -17401, -32408,  24659,
+	 23822,  25539,  29528, -25326, -23726,  29096,    784,  20206,
+	-32627,  20361,  -6346,  14308, -20585, -29038,  24190,   5600,
+	-27086,  17396, -11567,   2784,  23059, -26217,  21732, -28344,
+	  6815,  12500, -10522,  29726,  18740,   5552, -31597,   5429,
+	 -3488, -19012,  -9077, -10596,  29486, -27763, -17060,    299,
+	-32723,  31261,  28878,  19428, -26387,  32728,  -2133,   9215,
+	-28472, -29043, -19785, -32493,  -2496,  21268,  -1685,   2037,
+	 10842,  21321, -20686, -10250,   7247,  28984,  -5189,   6687,
+	   -37, -10324,  -4506, -19854, -16820, -26952, -17519,  23251,
+	 -1152,   -267,  29470,  -4101,  -4090,  20292,  11802, -22148,
+	-16639,  32557,  32456, -30110,  21017, -20014, -18857, -28638,
+	-17220, -25225,   9098, -20953,  -6837,  19049, -10778,  15103,
+	-21033, -21860, -29886,  29491, -11578,  18558,   6746, -16036,
+	 15705, -28526, -14042,  -7498,  17236,   1563, -25891,  20100,
+	 15684,   3024,  30195, -28206, -20462, -13839, -17177, -22787,
+	-21598,  27768,  -4501, -27742,   5226,   3637, -24478,  27102,
+	 18500, -32733,  23694,  18228, -25027, -12468,  12228,   2224,
+	 -9610,  -8293, -27214,  10085,  23523,   8479,  -6522,  12447,
+	  6826,  -3274,    128,   7311,   4821,  13252,  29582,  26872,
+	 -4698,   1947,  -5413,  10276, -29123,  15711, -14063,  24051,
+	-24979, -17919,  27384,   -336,  26595, -12655, -19572, -20308,
+	 -3082, -28627,   2400, -10367,  24857,   2720,  13983,  28723,
+	-29960,   8842, -30872, -18676, -26894,  -4405, -16479,  -7455,
+	-16345,  -8031,  30414, -23907,  31464,  -4853,  25166,   4005,
+	-24094, -16500,  -6186, -25705, -14559, -28856,  12015,  -9962,
+	-13215,  15145, -22366, -16100,   9509,  27080,  24345, -26526,
+	 27571, -14250,   4613,  -6821,  -1008, -16617,   9402, -11780,
+	  8159,  -9034,  20633,  23587, -31101,  -7199,   9247,  20345,
+	 28131,   9546,   6671,  28851, -10852,  -5546,  10037,  32664,
+	 25438,  -5034, -28195,  19566,  30254,  16105,  28830,  24878,
+	-25779, -14463,  15081, -23209,  21934,   -384, -20478,   9823,
+	-18404,  21833,   6618, -23347,  30829,  16239,  14095,  -5840,
+	-15321, -15076,   4218, -12980,   5973,  13519,    112,  30973,
+	 -4661,  12271,   -907,  30131, -12303, -22873,   3456,    800,
+	  5493,   2485, -20377,  -8965, -24793, -31832, -15620, -32136,
+	 -8389,  20510, -20228,  32333,   2677, -27294, -13876,  10138,
+	 -9861, -30803,  17428, -20238,  22937,  24121,  -2437,     43,
+	  4688,  13828,  -5237,  12138, -22494, -23411,  18420,  20041,
+	 24019,  -4149,  -2826, -14004, -19081, -25049,  18484,  -9071,
+	 10911, -15679,  15769,   7898, -17689,  13503,   -741, -17769,
+	 -1829,  18388, -24201,  10175,  27790,  -9951,  -6442,  25209,
+	  9093, -13066,   2218,  -4341,  -3818,  11252, -11540,  28883,
+	-28862,  22446,  17481,  31960, -18745,   2336,  -6495, -26990,
+	  8191,   9178, -12954,  21881,  -7322,  15903,  -3824,  19140,
+	 17961, -22542, -22601,   3264,  22516,  -8138,   2880,    667,
+	-16868, -21502, -32675,  25811,  -7407,  11028, -23486,   1845,
+	-17913,  17092, -27779,  -5824, -19614, -22745,  10282,  -2474,
+	 -9738, -15604, -23939,  16911,  -6058, -18393, -19774,  17268,
+	-11012, -31069, -18638, -24339,  18846, -21124,   9365, -22105,
+	-12132, -13124, -22755, -30147, -27000,  22270,   8095,  20078,
+	  6799, -29374,   6271,  30579, -25918,  -6000,   7706,   6032,
+	 31928,  29843,  -3088, -20740,  14767, -16607,  31816,  -1131,
+	 21198, -26041,  31117, -16463,  -7557, -30270,  24025, -12036,
+	-19966, -26467, -13482,  16297, -27208,   2197,  29800,  31171,
+	-26259, -25497,  -5408,   2389,  -7077, -19236, -21022,  27902,
+	-14489,   -320, -17065,   8186, -31123,  24350, -12052,   -363,
+	  -960, -22068,  24558, -14340,   7514,  27832,  -1088, -29379,
+	  7829,  21230,  18169,  -2469,   7167,  16223,  13242,  10954,
+	-25273,  22670,  29427,  -6538,  16148, -27816,   1941,  12586,
+	  6591,  16089,  27976, -23865, -16644, -25091,  -5637,  13866,
+	  2165,   8997,   -779, -28094,  -7482,  -9621, -32499,  27672,
+	  1275,  15465,  -5301, -24286, -24905,   2730, -29139, -26163,
+	-17999,  12218,  18095, -23118,  26201, -18814, -20398,  22585,
+	 15716,  21236,  -3392, -29912,   3317,   9263, -30248, -23993,
+	-29854, -17833,  10090,  19326,  30526,   7066,   5488,  10372,
+	-31779,  11455,  21113, -30915, -13023,  -6655, -27278, -26339,
+	  7007,  -9301, -15433,  19486,  30344,  13092,  21049,  -1803,
+	-17828,  21966,  -8117,  11471,    107, -26675, -24574, -27534,
+	-24414,  -2011,   2000,  -8639,   9791,   2266,  11652,   2090,
+	-32451,  22222,   5536,   4922,  11898,  32488, -14932,  -1029,
+	 -2698,  -6693,  -7423, -30845, -17471,  17801, -11796,  14260,
+	 10356,  18175, -13732,  -6213, -14804,   6282,  29214, -18724
+};
+
+static const int16_t iGMs[] = {
+	  4091,   4401,   1081,   1229,   2530,   6014,  -4342,   5329,
+	  2579,   4751,  -5825,   -586,  -5266,   2812,   5890,  -1591,
+	  3109,   2125,   1960,  -1364,  -1688,  -1885,   4189,   1875,
+	  5847,  -3743,   4615,   5190,   -965,  -1711,   5882,  -1134,
+	 -3872,    -14,  -1690,  -4843,   5719,   3569,   5981,  -2181,
+	  4426,  -3983,  -1534,   4679,  -1237,   1538,   -432,    100,
+	 -4042,  -5664,  -2564,   5145,   3412,  -4431,   5831,  -2829,
+	  5217,  -1549,  -4407,  -4783,   -117,   -997,   6049,     79,
+	    13,  -5351,  -3403,   5453,   4586,   -834,   2903,   4676,
+	 -2446,  -4668,  -3467,  -3180,   2083,  -3782,  -3604,   3110,
+	 -5274,   3269,   1367,  -5892,  -2030,  -3854,  -1762,   -730,
+	 -1195,   2211,   1808,  -4970,     48,  -2742,   2560,   1228,
+	 -2851,  -1502,   -489,   1820,   -883,  -3323,  -6130,   3012,
+	  6109,   2796,   2203,   1652,    711,  -5285,   1053,  -3316,
+	  5244,   1517,  -2967,  -1020,    900,   3888,  -1156,  -1553,
+	  4949,  -4673,  -2315,   4746,  -2019,    126,   2921,  -5569,
+	 -5654,  -5746,   1582,   4868,     42,    673,   2240,  -5070,
+	  1296,   -300,  -4614,  -3711,   -340,    989,  -1748,  -4602,
+	 -5204,  -3802,   1004,  -2053,   4703,    163,  -3146,   4597,
+	 -5858,   -237,   2991,   -351,   4647,   3362,   2060,   -932,
+	  -278,  -5625,   5655,  -5064,   5914,  -2962,   4092,   5880,
+	 -5357,   3402,   5133,  -2895,  -1060,   5252,  -3281,   1556,
+	 -5381,   4773,   3853,  -3509,  -1964,  -4552,   1758,  -5186,
+	  -914,    -16,  -3687,   3243,  -5753,  -4699,  -3698,   -737,
+	  6101,   3253,  -2320,  -2649,   4506,   3736,  -5460,  -1467,
+	 -3159,  -2341,   3566,   2133,   3901,   6038,  -4956,  -5680,
+	  3468,   4659,    625,   2700,  -4551,   3443,   3060,   3388,
+	  3526,   4418,   -378,  -6057,   1730,   2558,  -1949,   5344,
+	  5286,   2190,   -727,  -6090,   2482,  -3533,   5387,   4101,
+	  4609,  -3684,  -4063,    144,   5656,  -3585,   2621,   5424,
+	 -1477,   2959,   -943,  -6040,   1715,   4951,  -2749,   1888,
+	  3764,     39,  -4070,   2080,   2502,   1469,  -1739,  -3580,
+	  5601,   1093,   3784,   5041,   2058,  -3890,   -841,  -2650,
+	  2059,  -2411,  -4884,   2496,  -4371,   -695,    371,  -4296,
+	  3073,  -1963,     40,  -2285,  -3044,  -4302,   5603,   4051,
+	 -4395,    676,   -909,  -4910,  -5788,   4981,   2628,   3488,
+	 -1333,  -5267,  -5552,  -2356,  -5150,   2330,   3884,   5473,
+	 -4424,  -5348,   5737,   5613,  -2784,   -721,  -1012,   2510,
+	 -5600,    386,   4462,    105,   2076,  -1846,    119,   3955,
+	  4370,   -784,   3672,   -850,    750,   3240,   3133,    754,
+	  4013,   -360,  -3079,   5378,   -408,  -1271,   2818,   1851,
+	  4966,  -4108,   2688,  -6084,  -5475,    926,   2936,   4327,
+	 -2114,  -5200,   6047,  -2879,  -1797,  -3339,   2472,  -6034,
+	   728,  -4720,   6056,  -1857,  -1253,   2452,   2811,   3787,
+	   945,  -3291,   1244,  -3474,  -1272,  -1071,   5894,   4325,
+	  4639,   3819,  -2463,  -5233,  -5503,  -3619,   5539,  -4582,
+	  1361,  -2477,   2949,  -1024,  -1988,  -3181,    478,  -5800,
+	   101,   1911,  -2806,   3608,   -292,  -1753,    812,  -3374,
+	   637,  -4130,   5299,  -3161,   3512,  -3999,  -5221,  -4367,
+	  3036,   4759,   2163,   3937,   3755,   -983,  -4550,   4922,
+	  -357,    424,   5538,  -6061,  -1158,  -4511,   -315,   1097,
+	  2890,  -2262,   2569,   2250,   2352,    821,   2550,  -1273,
+	 -4520,    136,    617,   3157,   5889,  -3070,  -5434,    120,
+	  4405,   1825,  -2654,  -5075,  -2028,   -896,   2441,  -2727,
+	 -1113,    599,   2085,   -824,  -5056,  -6112,   4801,  -2363,
+	 -3279,   4514,  -2834,   -937,   -619,  -6115,  -4339,  -2523,
+	 -5393,   -686,   3213,  -3816,  -2416,   2835,  -1867,   3732,
+	 -4328,   1457,  -1432,  -4220,    832,   1628,   3410,   4900,
+	 -1434,   5111,  -2746,  -5964,  -4858,   4083,   3072,  -3442,
+	 -2436,  -2167,   5259,   -876,  -5733,    303,   1465,   3871,
+	  4873,   5813,  -2272,  -5391,   3311,   5947,  -3652,   5852,
+	  3856,    928,   4933,  -3759,   1871,   2184,   5571,   5879,
+	  3481,   -692,  -2778,  -4136,     35,   2609,   5963,  -4225,
+	  1080,   -250,  -3845,   3052,   3813,  -1224,  -5553,  -3835,
+	  2340,  -4638,   1910,  -1580,   2117,  -2652,  -5887,   6028,
+	  2124,  -4588,   2679,   5183,  -6019,  -4865,   2597,  -5494,
+	 -3067,  -1452,    280,  -3706,   3270,  -5536,   2354,   3779,
+	  6102,   4732,   5926,   2497,  -3649,  -2000,   6107,   -162,
+	  2958,     -2,  -1997,  -4203,    817,   4021,   2610,   1444,
+	  5899,   -569,   3292,   2424,   5090,  -5047,   5205,   5281,
+	 -2333,   2702,  -5633,    735,   2243,   -633,    833,   3107,
+	  6012,  -5488,   1126,  -5950,   5250,  -1898,  -2647,   5278,
+	  3513,  -2520,   3025,    779,  -2856,   3392,  -4852,    668,
+	 -2105,  -4178,  -5762,  -5721,  -1458,  -5807,  -4026,   5711,
+	 -2509,    467,   5462,   4425,   -290,   1205,   5015,  -5371,
+	  5096,   3827,   5525,   -710,   3518,   4875,  -4901,   1931,
+	 -5674,   1541,  -3581,    260,   3385,   4792,   4391,   5697,
+	 -4394,   2155,  -4952,    236,  -1654,   -755,   1906,   4793,
+	 -2762,  -5050,  -3935,   5121,  -1627,   2311,   3346,  -3733,
+	   707,   1088,   4936,    678,  -2044,     18,   5684,    960,
+	  4459,  -4332,    226,   2451,      6,  -3415,    320,  -5991,
+	 -3326,  -3554,   2852,   2981,   1707,   5408,   5017,  -2413,
+	 -2499,   2968,   1899,  -5560,   4183,   5290,  -2205,  -4610,
+	 -4348,  -3545,   5694,   3461,   4175,   5747,   5561,   3378,
+	  5227,    952,   4319,  -2479,   4356,   3088,  -1171,    840,
+	 -6032,    486,   6000,   1342,  -1907,   6017,   4798,   5489,
+	  4498,   4193,   2306,  -5768,   1475,  -5917,  -3260,  -4252,
+	  1625,  -5269,   4740,   5730,  -4333,  -5938,  -5795,  -5372,
+	  -884,  -4802,  -2087,  -2134,  -4623,  -4733,   -780,   1546,
+	 -5718,  -2090,   2265,  -4962,   5824,   -893,   -708,  -2567,
+	  2251,  -1090,   5356,  -4881,   2861,   4003,  -3074,    484,
+	 -4763,  -2880,    -54,  -6132,  -3264,   2121,  -2034,   2519,
+	 -2756,   3824,  -3615,   -870,  -1401,   4762,   -986,   4097,
+	  2414,  -5793,  -2336,  -1735,    808,   2999,   2130,   4286,
+	  -211,  -4844,   5132,  -4374,    245,   5974,   4874,  -4997,
+	 -4729,  -1750,  -2337,  -3214,   2113,   3721,  -2004,  -2267,
+	 -2711,  -3355,  -1215,  -2791,    294,   4711,   3391,   1377,
+	 -3217,  -2100,   4569,  -1399,  -2380,  -5366,     53,   4653,
+	   439,  -2036,  -5261,  -2082,  -3946,   1141,   2556,  -4688,
+	 -4139,  -1659,  -3641,  -2457,  -4338,  -1044,   2131,   5765,
+	 -1946,  -2508,   2718,   1419,   4531,   3844,   4066,   4293,
+	  -632,   -764,   -936,   4313,   4869,   -103,   1611,  -1397,
+	  -800,  -3456,   2393,     15,  -1459,   5003,     17,    565,
+	  5891,   -112,  -1231,  -1877,  -3404,   3974,  -1308,  -5159,
+	  5840,  -1807,  -3951,   6035,  -5325,   1574,  -1353,   2020,
+	  2465,  -4098,    384,   2642,   2729,   5399,   2175,  -2893,
+	  -302,  -4254,   4375,  -5678,   5010,   -477,  -3158,   -862,
+	   104,  -5941,  -2646,  -5532,   -179,   5617,  -1354,    541,
+	   135,   3041,  -5089,  -5763,   5085,   -153,    842,   4129,
+	 -4604,  -1210,  -3863,   1008,   2725,   -517,   6058,   1101,
+	  1950,  -3865,   5688,  -5413,   -284,  -2210,   5335,    927,
+	  1770,    273,  -3912,   2271,   5225,  -2006,    116,   -482,
+	    91,   -590,    757,   1304,  -4765,  -5838,  -4257,  -4135,
+	 -4833,   4191,    309,   2318,   2292,  -1896,   -650,  -2808,
+	   -51,  -1695,  -2720,  -4377,  -1921,  -2400,    -45,  -5110,
+	  3924,   3188,    367,   2077,    336,   5384,   5631,  -3693,
+	  4621,   1775,  -3423,    451,   6108,   1317,  -6043,  -3494,
+	  5896,  -5006,   3132,   -725,   4977,   -128,  -4918,   1366,
+	  -159,  -1670,   3809,   5149,  -5989,   2638,   4197,   1418,
+	 -2224,   4156,  -3916,  -3645,  -1844,    882,  -4131,  -2116,
+	 -2526,    -98,    459,   2966,   3166,    405,   5000,  -2978,
+	 -5885,  -3303,   1551,  -4114,   3630,  -1523,  -3024,    700,
+	 -3716,  -2781,  -5659,   -852,   -694,   5850,   3950,   4775,
+	  -348,   1446,   6018,   3386,   -819,   5310,   5476,    553,
+	 -2815,   2586,   1431,   2741,    473,   -906,   4745,    836,
+	  4062,  -1623,  -4562,   -537,   5534,    312,   4307,   4351,
+	  5764,  -3610,  -3908,  -4102,      5,  -4894,   4363,   1152,
+	  5421,   5231,  -5816,    436,  -4722,  -3686,  -6060,  -4059
+};
+
+static const int16_t iGMsq[] = {
+	    -5,  -7887,  21561, -27443, -22046,  30590,   3850,  -6959,
+	 31251,  17039,   6463,  -8778,  19310, -13572, -18686,  18889,
+	  7205, -26547, -30808, -17748,  31080,  26787, -24483,  30547,
+	-14633, -16031, -15865,  -3002,  -5061, -13999,  14074, -25710,
+	 -3872, -24590,  -9882,   -747, -14761,  -8719, -22691,  -6277,
+	 12618, -16271, -26110, -15801,  -5333, -23038,   -432,  16484,
+	-12234,  -5664, -18948,  25625,  19796, -16719, -14649,  25843,
+	 -7071,  27123,  16073, -17071,  -4213,  -5093,  -6239,  12367,
+	-28659,  15129,    693, -23219,  12778,  23742, -17577,  21060,
+	-27022,  11716,    629,  13204,  30755,   4410, -19988,  -5082,
+	-13466,   7365, -19113, -22276, -26606, -28430,  22814,  -8922,
+	  2901,  30883,   1808, -13162,     48,   5450,   2560, -15156,
+	-31523, -26078, -20969, -14564, -29555,    773,  18446,  19396,
+	-22563, -13588,  -1893,  18036, -19769,  -9381, -27619, -19700,
+	-11140, -27155,  17513,  15364,  17284,   3888, -17540,  10735,
+	  9045,   7615,   1781,  12938, -30691,  24702,  23401,   6719,
+	  2538,  18830,  26158,  21252,   8234, -11615,   2240, -29646,
+	  1296,  16084,   3578, -15999, -16724, -27683, -18132, -12794,
+	-21588, -11994, -15380,  -6149,  16991,  28835, -11338,   8693,
+	 18718,  28435,  15279, -12639, -15833, -21214, -14324, -17316,
+	  7914, -26105, -14825,  27704,  14106,  21614, -12292, -26888,
+	 23315,  11594, -23539, -15183, -17444,  21636,   9007,  17940,
+	 -9477,   8869, -24819,  -7605,  14420,  28216,  26334,  19390,
+	 23662,    -16,  16793,   -853, -26233,   -603,  20878,  11551,
+	 10197,   7349,  -2320, -23129,  12698, -29032, -21844,   2629,
+	 17321,  -6437,  28142,   6229, -24771,  -2154,  11428,  -5680,
+	-12916, -32205, -11663, -13684,  15929,  32115,  19444, -12996,
+	 -4666, -20158,  -8570, -26537, -22846,  27134,  26723,   5344,
+	 -2906,  26766,  19753, -14282, -22094,  25139,   1291,   8197,
+	 -7679, -20068, -16351,    144, -27112,   8703, -26051,   5424,
+	 -5573,  15247, -13231,  26728,  30387, -15529,  25923,   1888,
+	 20148, -20441,   4122,   2080,  -5690, -27203,   2357,  12804,
+	 -6687,   5189, -28984,  -7247,  10250,  20686, -21321, -10842,
+	 -2037,   1685, -21268,   2496,  32493,  19785,  29043,  28472,
+	 -9215,   2133, -32728,  26387, -19428, -28878, -31261,  32723,
+	  -299,  17060,  27763, -29486,  10596,   9077,  19012,   3488,
+	 -5429,  31597,  -5552, -18740, -29726,  10522, -12500,  -6815,
+	 28344, -21732,  26217, -23059,  -2784,  11567, -17396,  27086,
+	 -5600, -24190,  29038,  20585, -14308,   6346, -20361,  32627,
+	-20206,   -784, -29096,  23726,  25326, -29528, -25539, -23822,
+	-24659,  32408,  17401, -19198,  32360,  19209, -21758,  -2245,
+	 -3226,  12276,   2688, -22468,  31389,  25502, -29832, -16153,
+	 22462,  -5200,  18335, -15167,  -5893,    757, -30296,  18542,
+	-32040,  -4720, -26712,  10431,  -5349,  18836,  -1285,   -309,
+	-11343,    805, -15140,  21102,  31496, -13359,  -2298,   8421,
+	 16927,   -277, -14751,   7055, -17791, -32291, -31325,   3610,
+	-10927,  26195,   7045,  -1024, -18372,  25491,  25054,  26968,
+	  4197, -18569,   5386, -29160, -16676, -22233, -15572, -27950,
+	-28035,  20446, -31565, -23641, -29256, -16287,  -9317, -16655,
+	-13348, -15721,  30835,  -8351,   -341,  19497,   3642,  13114,
+	 -4453, -32344, -19038,  22611,   7034, -16799,   3781,  21577,
+	 11082,   5930,  23049,  10442,   2352,   4917,  -5642, -21753,
+	 28248, -32632,  21097,   7253,  -6399, -27646, -13626, -32648,
+	  8501, -10463, -27230,  31789,  14356,   -896,  22921,  17753,
+	-21593, -19881,   6181,  31944,  -5056,  -6112,  -7487,   1733,
+	-15567, -20062,  21742, -21417,   3477,  30749,  32525,   1573,
+	  6895, -25262, -25459,  28952,  -2416,  31507,   2229,  20116,
+	 28440, -10831,  31336,  12164,    832, -14756, -21166,  21284,
+	 -9626, -15369, -10938,  10420, -13050,  32755,   3072,  21134,
+	-18820,  18313,   1163,  15508,  -9829,  12591,  21945,  16159,
+	 25353,   9909,  -2272, -17679,  15599,   1851, -20036, -10532,
+	  3856,    928,   9029, -16047,  14159, -30584, -31293, -14601,
+	 23961, -17076, -10970,  28632,  28707,  -9679,   1867,   8063,
+	-31688,  -8442,  -7941, -13332,   7909,  31544,   6735,    261,
+	 18724, -29214,  -6282,  14804,   6213,  13732, -18175, -10356,
+	-14260,  11796, -17801,  17471,  30845,   7423,   6693,   2698,
+	  1029,  14932, -32488, -11898,  -4922,  -5536, -22222,  32451,
+	 -2090, -11652,  -2266,  -9791,   8639,  -2000,   2011,  24414,
+	 27534,  24574,  26675,   -107, -11471,   8117, -21966,  17828,
+	  1803, -21049, -13092, -30344, -19486,  15433,   9301,  -7007,
+	 26339,  27278,   6655,  13023,  30915, -21113, -11455,  31779,
+	-10372,  -5488,  -7066, -30526, -19326, -10090,  17833,  29854,
+	 23993,  30248,  -9263,  -3317,  29912,   3392, -21236, -15716,
+	-22585,  20398,  18814, -26201,  23118, -18095, -12218,  17999,
+	 26163,  29139,  -2730,  24905,  24286,   5301, -15465,  -1275,
+	-27672,  32499,   9621,   7482,  28094,    779,  -8997,  -2165,
+	-13866,   5637,  25091,  16644,  23865, -27976, -16089,  -6591,
+	-12586,  -1941,  27816, -16148,   6538, -29427, -22670,  25273,
+	-10954, -13242, -16223,  -7167,   2469, -18169, -21230,  -7829,
+	 29379,   1088, -27832,  -7514,  14340, -24558,  22068,    960,
+	   363,  12052, -24350,  31123,  -8186,  17065,    320,  14489,
+	-27902,  21022,  19236,   7077,  -2389,   5408,  25497,  26259,
+	-31171, -29800,  -2197,  27208, -16297,  13482,  26467,  19966,
+	 12036, -24025,  30270,   7557,  16463, -31117,  26041, -21198,
+	  1131, -31816,  16607, -14767,  20740,   3088, -29843, -31928,
+	 -6032,  -7706,   6000,  25918, -30579,  -6271,  29374,  -6799,
+	-20078,  -8095, -22270,  27000,  30147,  22755,  13124,  12132,
+	 22105,  -9365,  21124, -18846,  24339,  18638,  31069,  11012,
+	-17268,  19774,  18393,   6058, -16911,  23939,  15604,   9738,
+	  2474, -10282,  22745,  19614,   5824,  27779, -17092,  17913,
+	 -1845,  23486, -11028,   7407, -25811,  32675,  21502,  16868,
+	  -667,  -2880,   8138, -22516,  -3264,  22601,  22542, -17961,
+	-19140,   3824, -15903,   7322, -21881,  12954,  -9178,  -8191,
+	 26990,   6495,  -2336,  18745, -31960, -17481, -22446,  28862,
+	-28883,  11540, -11252,   3818,   4341,  -2218,  13066,  -9093,
+	-25209,   6442,   9951, -27790, -10175,  24201, -18388,   1829,
+	 17769,    741, -13503,  17689,  -7898, -15769,  15679, -10911,
+	  9071, -18484,  25049,  19081,  14004,   2826,   4149, -24019,
+	-20041, -18420,  23411,  22494, -12138,   5237, -13828,  -4688,
+	   -43,   2437, -24121, -22937,  20238, -17428,  30803,   9861,
+	-10138,  13876,  27294,  -2677, -32333,  20228, -20510,   8389,
+	 32136,  15620,  31832,  24793,   8965,  20377,  -2485,  -5493,
+	  -800,  -3456,  22873,  12303, -30131,    907, -12271,   4661,
+	-30973,   -112, -13519,  -5973,  12980,  -4218,  15076,  15321,
+	  5840, -14095, -16239, -30829,  23347,  -6618, -21833,  18404,
+	 -9823,  20478,    384, -21934,  23209, -15081,  14463,  25779,
+	-24878, -28830, -16105, -30254, -19566,  28195,   5034, -25438,
+	-32664, -10037,   5546,  10852, -28851,  -6671,  -9546, -28131,
+	-20345,  -9247,   7199,  31101, -23587, -20633,   9034,  -8159,
+	 11780,  -9402,  16617,   1008,   6821,  -4613,  14250, -27571,
+	 26526, -24345, -27080,  -9509,  16100,  22366, -15145,  13215,
+	  9962, -12015,  28856,  14559,  25705,   6186,  16500,  24094,
+	 -4005, -25166,   4853, -31464,  23907, -30414,   8031,  16345,
+	  7455,  16479,   4405,  26894,  18676,  30872,  -8842,  29960,
+	-28723, -13983,  -2720, -24857,  10367,  -2400,  28627,   3082,
+	 20308,  19572,  12655, -26595,    336, -27384,  17919,  24979,
+	-24051,  14063, -15711,  29123, -10276,   5413,  -1947,   4698,
+	-26872, -29582, -13252,  -4821,  -7311,   -128,   3274,  -6826,
+	-12447,   6522,  -8479, -23523, -10085,  27214,   8293,   9610,
+	 -2224, -12228,  12468,  25027, -18228, -23694,  32733, -18500,
+	-27102,  24478,  -3637,  -5226,  27742,   4501, -27768,  21598,
+	 22787,  17177,  13839,  20462,  28206, -30195,  -3024, -15684,
+	-20100,  25891,  -1563, -17236,   7498,  14042,  28526, -15705,
+	 16036,  -6746, -18558,  11578, -29491,  29886,  21860,  21033,
+	-15103,  10778, -19049,   6837,  20953,  -9098,  25225,  17220,
+	 28638,  18857,  20014, -21017,  30110, -32456, -32557,  16639,
+	 22148, -11802, -20292,   4090,   4101, -29470,    267,   1152,
+	-23251,  17519,  26952,  16820,  19854,   4506,  10324,     37
+};
+#endif // yyyAVX2-
+
+#ifndef FALCON_KERNEL
 /*
  * Reduce a small signed integer modulo q. The source integer MUST
  * be between -q/2 and +q/2.
@@ -337,6 +878,7 @@ mq_conv_small(int x)
 	y += Q & -(y >> 31);
 	return y;
 }
+#endif
 
 /*
  * Addition modulo q. Operands must be in the 0..q-1 range.
@@ -498,14 +1040,477 @@ mq_div_12289(uint32_t x, uint32_t y)
 	return mq_montymul(y18, x);
 }
 
+#if FALCON_AVX2 // yyyAVX2+1
+/*
+ * AVX2 implementation of the NTT, for n >= 32. Values are handled as
+ * signed 16-bit integers, 16 per register, and are reduced lazily:
+ *
+ *  - The Montgomery multiplication of x (any signed 16-bit value) by a
+ *    twiddle factor z with |z| <= q/2 returns a value in -3q/4..+3q/4.
+ *
+ *  - The Barrett reduction (mq_barrett_x16()) returns a value in
+ *    -q/2..+q/2 (within a few units).
+ *
+ * In the forward NTT, a butterfly adds at most 3q/4 to the magnitude
+ * of its inputs; we reduce all values after every two layers (the
+ * largest intermediate value is then 5q/2 < 2^15). The two layers are
+ * merged in the same pass over the array. In the inverse NTT, the sums
+ * are reduced at each layer, while the differences go through the
+ * Montgomery multiplication. The last four layers (distance 8, 4, 2
+ * and 1) are computed in registers, on chunks of 32 coefficients
+ * which are transposed between layers. The outputs are normalized to
+ * 0..q-1, so that the results are identical to the ones of the
+ * portable code.
+ */
+
+/*
+ * Montgomery multiplication: return x*z/2^16 mod q, with zq = z/q mod
+ * 2^16. The low halves of x*z and ((x*zq) mod 2^16)*q are equal, hence
+ * the difference of the high halves is exact.
+ */
+TARGET_AVX2
+static inline __m256i
+mq_montymul_x16(__m256i x, __m256i z, __m256i zq)
+{
+	__m256i hi, lo;
+
+	hi = _mm256_mulhi_epi16(x, z);
+	lo = _mm256_mullo_epi16(x, zq);
+	lo = _mm256_mulhi_epi16(lo, _mm256_set1_epi16(Q));
+	return _mm256_sub_epi16(hi, lo);
+}
+
+/*
+ * Barrett reduction: subtract round(x/q)*q from x, using
+ * 5461 = round(2^26/q).
+ */
+TARGET_AVX2
+static inline __m256i
+mq_barrett_x16(__m256i x)
+{
+	__m256i t;
+
+	t = _mm256_mulhi_epi16(x, _mm256_set1_epi16(5461));
+	t = _mm256_mulhrs_epi16(t, _mm256_set1_epi16(1 << 5));
+	t = _mm256_mullo_epi16(t, _mm256_set1_epi16(Q));
+	return _mm256_sub_epi16(x, t);
+}
+
+/*
+ * Normalize values in -q+1..q-1 to 0..q-1: negative values become
+ * larger than x+q when seen as unsigned.
+ */
+TARGET_AVX2
+static inline __m256i
+mq_norm_x16(__m256i x)
+{
+	return _mm256_min_epu16(x,
+		_mm256_add_epi16(x, _mm256_set1_epi16(Q)));
+}
+
 /*
- * Compute NTT on a ring element.
+ * Butterflies, forward (Cooley-Tukey) and inverse (Gentleman-Sande).
  */
+TARGET_AVX2
+static inline void
+mq_ct_x16(__m256i *x, __m256i *y, __m256i z, __m256i zq)
+{
+	__m256i v;
+
+	v = mq_montymul_x16(*y, z, zq);
+	*y = _mm256_sub_epi16(*x, v);
+	*x = _mm256_add_epi16(*x, v);
+}
+
+TARGET_AVX2
+static inline void
+mq_gs_x16(__m256i *x, __m256i *y, __m256i z, __m256i zq)
+{
+	__m256i w;
+
+	w = _mm256_sub_epi16(*x, *y);
+	*x = mq_barrett_x16(_mm256_add_epi16(*x, *y));
+	*y = mq_montymul_x16(w, z, zq);
+}
+
+/*
+ * Transpositions used for the last four layers. A chunk of 32
+ * coefficients a[0..31] is held in two registers; each of these
+ * transformations is its own inverse:
+ *   mq_tr8: [a0..a15], [a16..a31] <-> [a0..a7 a16..a23], [a8..a15 a24..a31]
+ *   mq_tr4: exchange of the odd 64-bit words of x with the even ones of y
+ *   mq_tr2: same with 32-bit words
+ *   mq_tr1: same with 16-bit words
+ * Starting from the natural order, mq_tr8, mq_tr4, mq_tr2 and mq_tr1
+ * successively put into x the first element of each pair for the
+ * distances 8, 4, 2 and 1, and the twiddle factors are then
+ * consecutive table entries (each repeated 8, 4, 2 or 1 times).
+ */
+TARGET_AVX2
+static inline void
+mq_tr8(__m256i *x, __m256i *y)
+{
+	__m256i t;
+
+	t = _mm256_permute2x128_si256(*x, *y, 0x20);
+	*y = _mm256_permute2x128_si256(*x, *y, 0x31);
+	*x = t;
+}
+
+TARGET_AVX2
+static inline void
+mq_tr4(__m256i *x, __m256i *y)
+{
+	__m256i t;
+
+	t = _mm256_unpacklo_epi64(*x, *y);
+	*y = _mm256_unpackhi_epi64(*x, *y);
+	*x = t;
+}
+
+TARGET_AVX2
+static inline void
+mq_tr2(__m256i *x, __m256i *y)
+{
+	__m256i t;
+
+	t = _mm256_blend_epi32(*x, _mm256_slli_epi64(*y, 32), 0xAA);
+	*y = _mm256_blend_epi32(_mm256_srli_epi64(*x, 32), *y, 0xAA);
+	*x = t;
+}
+
+TARGET_AVX2
+static inline void
+mq_tr1(__m256i *x, __m256i *y)
+{
+	__m256i t;
+
+	t = _mm256_blend_epi16(*x, _mm256_slli_epi32(*y, 16), 0xAA);
+	*y = _mm256_blend_epi16(_mm256_srli_epi32(*x, 16), *y, 0xAA);
+	*x = t;
+}
+
+/*
+ * Load twiddle factors tab[k], tab[k+1]... in the layout expected
+ * after mq_tr8 (2 values, 8 times each), mq_tr4 (4 values, 4 times
+ * each) and mq_tr2 (8 values, twice each). After mq_tr1, this is a
+ * plain load of 16 values.
+ */
+TARGET_AVX2
+static inline __m256i
+mq_tw8(const int16_t *tab)
+{
+	return _mm256_setr_m128i(
+		_mm_set1_epi16(tab[0]), _mm_set1_epi16(tab[1]));
+}
+
+TARGET_AVX2
+static inline __m256i
+mq_tw4(const int16_t *tab)
+{
+	__m256i t;
+
+	t = _mm256_cvtepu16_epi64(_mm_loadl_epi64((const __m128i *)tab));
+	return _mm256_shuffle_epi8(t, _mm256_setr_epi8(
+		0, 1, 0, 1, 0, 1, 0, 1, 8, 9, 8, 9, 8, 9, 8, 9,
+		0, 1, 0, 1, 0, 1, 0, 1, 8, 9, 8, 9, 8, 9, 8, 9));
+}
+
+TARGET_AVX2
+static inline __m256i
+mq_tw2(const int16_t *tab)
+{
+	__m256i t;
+
+	t = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)tab));
+	return _mm256_or_si256(t, _mm256_slli_epi32(t, 16));
+}
+
+TARGET_AVX2
+static inline __m256i
+mq_tw1(const int16_t *tab)
+{
+	return _mm256_loadu_si256((const __m256i *)tab);
+}
+
+TARGET_AVX2
+static void
+mq_NTT_avx2(uint16_t *a, unsigned logn)
+{
+	size_t n, t, m, u;
+
+	n = (size_t)1 << logn;
+	t = n;
+	m = 1;
+
+	/*
+	 * If the number of layers before the last four is odd, the first
+	 * layer is done alone.
+	 */
+	if ((logn & 1) != 0) {
+		__m256i z, zq;
+		size_t ht;
+
+		ht = t >> 1;
+		z = _mm256_set1_epi16(GMs[1]);
+		zq = _mm256_set1_epi16(GMsq[1]);
+		for (u = 0; u < ht; u += 16) {
+			__m256i x, y;
+
+			x = _mm256_loadu_si256((__m256i *)(a + u));
+			y = _mm256_loadu_si256((__m256i *)(a + u + ht));
+			mq_ct_x16(&x, &y, z, zq);
+			_mm256_storeu_si256((__m256i *)(a + u),
+				mq_barrett_x16(x));
+			_mm256_storeu_si256((__m256i *)(a + u + ht),
+				mq_barrett_x16(y));
+		}
+		t = ht;
+		m = 2;
+	}
+
+	/*
+	 * Pairs of layers, down to distance 16.
+	 */
+	for (; t > 16; t >>= 2, m <<= 2) {
+		size_t qt, i, j1;
+
+		qt = t >> 2;
+		for (i = 0, j1 = 0; i < m; i ++, j1 += t) {
+			__m256i z1, z1q, z2, z2q, z3, z3q;
+			size_t j;
+
+			z1 = _mm256_set1_epi16(GMs[m + i]);
+			z1q = _mm256_set1_epi16(GMsq[m + i]);
+			z2 = _mm256_set1_epi16(GMs[(m + i) << 1]);
+			z2q = _mm256_set1_epi16(GMsq[(m + i) << 1]);
+			z3 = _mm256_set1_epi16(GMs[((m + i) << 1) + 1]);
+			z3q = _mm256_set1_epi16(GMsq[((m + i) << 1) + 1]);
+			for (j = j1; j < j1 + qt; j += 16) {
+				__m256i x0, x1, x2, x3;
+
+				x0 = _mm256_loadu_si256((__m256i *)(a + j));
+				x1 = _mm256_loadu_si256(
+					(__m256i *)(a + j + qt));
+				x2 = _mm256_loadu_si256(
+					(__m256i *)(a + j + 2 * qt));
+				x3 = _mm256_loadu_si256(
+					(__m256i *)(a + j + 3 * qt));
+				mq_ct_x16(&x0, &x2, z1, z1q);
+				mq_ct_x16(&x1, &x3, z1, z1q);
+				mq_ct_x16(&x0, &x1, z2, z2q);
+				mq_ct_x16(&x2, &x3, z3, z3q);
+				_mm256_storeu_si256((__m256i *)(a + j),
+					mq_barrett_x16(x0));
+				_mm256_storeu_si256((__m256i *)(a + j + qt),
+					mq_barrett_x16(x1));
+				_mm256_storeu_si256((__m256i *)(a + j + 2 * qt),
+					mq_barrett_x16(x2));
+				_mm256_storeu_si256((__m256i *)(a + j + 3 * qt),
+					mq_barrett_x16(x3));
+			}
+		}
+	}
+
+	/*
+	 * Last four layers, on chunks of 32 coefficients. At this point,
+	 * t = 16 and m = n/16.
+	 */
+	for (u = 0; u < (n >> 5); u ++) {
+		__m256i x, y;
+		uint16_t *b;
+
+		b = a + (u << 5);
+		x = _mm256_loadu_si256((__m256i *)b);
+		y = _mm256_loadu_si256((__m256i *)(b + 16));
+		mq_tr8(&x, &y);
+		mq_ct_x16(&x, &y, mq_tw8(&GMs[m + (u << 1)]),
+			mq_tw8(&GMsq[m + (u << 1)]));
+		mq_tr4(&x, &y);
+		mq_ct_x16(&x, &y, mq_tw4(&GMs[(m << 1) + (u << 2)]),
+			mq_tw4(&GMsq[(m << 1) + (u << 2)]));
+		x = mq_barrett_x16(x);
+		y = mq_barrett_x16(y);
+		mq_tr2(&x, &y);
+		mq_ct_x16(&x, &y, mq_tw2(&GMs[(m << 2) + (u << 3)]),
+			mq_tw2(&GMsq[(m << 2) + (u << 3)]));
+		mq_tr1(&x, &y);
+		mq_ct_x16(&x, &y, mq_tw1(&GMs[(m << 3) + (u << 4)]),
+			mq_tw1(&GMsq[(m << 3) + (u << 4)]));
+		x = mq_norm_x16(mq_barrett_x16(x));
+		y = mq_norm_x16(mq_barrett_x16(y));
+		mq_tr1(&x, &y);
+		mq_tr2(&x, &y);
+		mq_tr4(&x, &y);
+		mq_tr8(&x, &y);
+		_mm256_storeu_si256((__m256i *)b, x);
+		_mm256_storeu_si256((__m256i *)(b + 16), y);
+	}
+}
+
+TARGET_AVX2
+static void
+mq_iNTT_avx2(uint16_t *a, unsigned logn, uint32_t ni)
+{
+	size_t n, t, m, u;
+	__m256i z, zq;
+
+	n = (size_t)1 << logn;
+
+	/*
+	 * First four layers, on chunks of 32 coefficients (see
+	 * mq_NTT_avx2()).
+	 */
+	m = n >> 4;
+	for (u = 0; u < (n >> 5); u ++) {
+		__m256i x, y;
+		uint16_t *b;
+
+		b = a + (u << 5);
+		x = _mm256_loadu_si256((__m256i *)b);
+		y = _mm256_loadu_si256((__m256i *)(b + 16));
+		mq_tr8(&x, &y);
+		mq_tr4(&x, &y);
+		mq_tr2(&x, &y);
+		mq_tr1(&x, &y);
+		mq_gs_x16(&x, &y, mq_tw1(&iGMs[(m << 3) + (u << 4)]),
+			mq_tw1(&iGMsq[(m << 3) + (u << 4)]));
+		mq_tr1(&x, &y);
+		mq_gs_x16(&x, &y, mq_tw2(&iGMs[(m << 2) + (u << 3)]),
+			mq_tw2(&iGMsq[(m << 2) + (u << 3)]));
+		mq_tr2(&x, &y);
+		mq_gs_x16(&x, &y, mq_tw4(&iGMs[(m << 1) + (u << 2)]),
+			mq_tw4(&iGMsq[(m << 1) + (u << 2)]));
+		mq_tr4(&x, &y);
+		mq_gs_x16(&x, &y, mq_tw8(&iGMs[m + (u << 1)]),
+			mq_tw8(&iGMsq[m + (u << 1)]));
+		mq_tr8(&x, &y);
+		_mm256_storeu_si256((__m256i *)b, x);
+		_mm256_storeu_si256((__m256i *)(b + 16), y);
+	}
+
+	/*
+	 * Pairs of layers, from distance 16; the last layer is done
+	 * alone if the number of remaining layers is odd.
+	 */
+	for (t = 16; m >= 4; t <<= 2, m >>= 2) {
+		size_t hm, i, j1;
+
+		hm = m >> 1;
+		for (i = 0, j1 = 0; i < (m >> 2); i ++, j1 += t << 2) {
+			__m256i z1, z1q, z2, z2q, z3, z3q;
+			size_t j;
+
+			z1 = _mm256_set1_epi16(iGMs[hm + (i << 1)]);
+			z1q = _mm256_set1_epi16(iGMsq[hm + (i << 1)]);
+			z2 = _mm256_set1_epi16(iGMs[hm + (i << 1) + 1]);
+			z2q = _mm256_set1_epi16(iGMsq[hm + (i << 1) + 1]);
+			z3 = _mm256_set1_epi16(iGMs[(hm >> 1) + i]);
+			z3q = _mm256_set1_epi16(iGMsq[(hm >> 1) + i]);
+			for (j = j1; j < j1 + t; j += 16) {
+				__m256i x0, x1, x2, x3;
+
+				x0 = _mm256_loadu_si256((__m256i *)(a + j));
+				x1 = _mm256_loadu_si256(
+					(__m256i *)(a + j + t));
+				x2 = _mm256_loadu_si256(
+					(__m256i *)(a + j + 2 * t));
+				x3 = _mm256_loadu_si256(
+					(__m256i *)(a + j + 3 * t));
+				mq_gs_x16(&x0, &x1, z1, z1q);
+				mq_gs_x16(&x2, &x3, z2, z2q);
+				mq_gs_x16(&x0, &x2, z3, z3q);
+				mq_gs_x16(&x1, &x3, z3, z3q);
+				_mm256_storeu_si256((__m256i *)(a + j), x0);
+				_mm256_storeu_si256((__m256i *)(a + j + t), x1);
+				_mm256_storeu_si256(
+					(__m256i *)(a + j + 2 * t), x2);
+				_mm256_storeu_si256(
+					(__m256i *)(a + j + 3 * t), x3);
+			}
+		}
+	}
+	if (m == 2) {
+		z = _mm256_set1_epi16(iGMs[1]);
+		zq = _mm256_set1_epi16(iGMsq[1]);
+		for (u = 0; u < t; u += 16) {
+			__m256i x, y;
+
+			x = _mm256_loadu_si256((__m256i *)(a + u));
+			y = _mm256_loadu_si256((__m256i *)(a + u + t));
+			mq_gs_x16(&x, &y, z, zq);
+			_mm256_storeu_si256((__m256i *)(a + u), x);
+			_mm256_storeu_si256((__m256i *)(a + u + t), y);
+		}
+	}
+
+	/*
+	 * Division by n (ni = R/n mod q) and normalization.
+	 */
+	z = _mm256_set1_epi16((int16_t)ni);
+	zq = _mm256_set1_epi16((int16_t)(ni * (uint32_t)(65536 - Q0I)));
+	for (u = 0; u < n; u += 16) {
+		__m256i x;
+
+		x = _mm256_loadu_si256((__m256i *)(a + u));
+		x = mq_norm_x16(mq_montymul_x16(x, z, zq));
+		_mm256_storeu_si256((__m256i *)(a + u), x);
+	}
+}
+
+/*
+ * Montgomery multiplication of each value of f[] (in 0..q-1) by the
+ * corresponding value of g[] (in 0..q-1); result is in 0..q-1.
+ */
+TARGET_AVX2
+static void
+mq_poly_montymul_avx2(uint16_t *f, const uint16_t *g, size_t n)
+{
+	size_t u;
+
+	for (u = 0; u < n; u += 16) {
+		__m256i x, z;
+
+		x = _mm256_loadu_si256((__m256i *)(f + u));
+		z = _mm256_loadu_si256((const __m256i *)(g + u));
+		x = mq_montymul_x16(x, z, _mm256_mullo_epi16(z,
+			_mm256_set1_epi16((int16_t)(65536 - Q0I))));
+		_mm256_storeu_si256((__m256i *)(f + u), mq_norm_x16(x));
+	}
+}
+
+TARGET_AVX2
+static void
+mq_poly_tomonty_avx2(uint16_t *f, size_t n)
+{
+	size_t u;
+	__m256i z, zq;
+
+	z = _mm256_set1_epi16(R2);
+	zq = _mm256_set1_epi16((int16_t)(R2 * (uint32_t)(65536 - Q0I)));
+	for (u = 0; u < n; u += 16) {
+		__m256i x;
+
+		x = _mm256_loadu_si256((__m256i *)(f + u));
+		x = mq_norm_x16(mq_montymul_x16(x, z, zq));
+		_mm256_storeu_si256((__m256i *)(f + u), x);
+	}
+}
+#endif // yyyAVX2-
+
+/* see inner.h */
+TARGET_AVX2
 void
-mq_NTT(uint16_t *a, unsigned logn)
+Zk(mq_NTT)(uint16_t *a, unsigned logn)
 {
 	size_t n, t, m;
 
+#if FALCON_AVX2 // yyyAVX2+1
+	if (logn >= 5) {
+		mq_NTT_avx2(a, logn);
+		return;
+	}
+#endif // yyyAVX2-
 	n = (size_t)1 << logn;
 	t = n;
 	for (m = 1; m < n; m <<= 1) {
@@ -531,16 +1536,36 @@ mq_NTT(uint16_t *a, unsigned logn)
 	}
 }
 
-/*
- * Compute the inverse NTT on a ring element, binary case.
- */
+/* see inner.h */
+TARGET_AVX2
 void
-mq_iNTT(uint16_t *a, unsigned logn)
+Zk(mq_iNTT)(uint16_t *a, unsigned logn)
 {
 	size_t n, t, m;
 	uint32_t ni;
 
 	n = (size_t)1 << logn;
+
+	/*
+	 * To complete the inverse NTT, we must divide all values by
+	 * n (the vector size). We thus need the inverse of n, i.e. we
+	 * need to divide 1 by 2 logn times. But we also want it in
+	 * Montgomery representation, i.e. we also want to multiply it
+	 * by R = 2^16. In the common case, this should be a simple right
+	 * shift. The loop below is generic and works also in corner cases;
+	 * its computation time is negligible.
+	 */
+	ni = R;
+	for (m = n; m > 1; m >>= 1) {
+		ni = mq_rshift1(ni);
+	}
+#if FALCON_AVX2 // yyyAVX2+1
+	if (logn >= 5) {
+		mq_iNTT_avx2(a, logn, ni);
+		return;
+	}
+#endif // yyyAVX2-
+
 	t = 1;
 	m = n;
 	while (m > 1) {
@@ -570,52 +1595,53 @@ mq_iNTT(uint16_t *a, unsigned logn)
 	}
 
 	/*
-	 * To complete the inverse NTT, we must now divide all values by
-	 * n (the vector size). We thus need the inverse of n, i.e. we
-	 * need to divide 1 by 2 logn times. But we also want it in
-	 * Montgomery representation, i.e. we also want to multiply it
-	 * by R = 2^16. In the common case, this should be a simple right
-	 * shift. The loop below is generic and works also in corner cases;
-	 * its computation time is negligible.
+	 * Divide all values by n.
 	 */
-	ni = R;
-	for (m = n; m > 1; m >>= 1) {
-		ni = mq_rshift1(ni);
-	}
 	for (m = 0; m < n; m ++) {
 		a[m] = (uint16_t)mq_montymul(a[m], ni);
 	}
 }
 
-/*
- * Convert a polynomial (mod q) to Montgomery representation.
- */
-static void
-mq_poly_tomonty(uint16_t *f, unsigned logn)
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(mq_poly_tomonty)(uint16_t *f, unsigned logn)
 {
 	size_t u, n;
 
 	n = (size_t)1 << logn;
+#if FALCON_AVX2 // yyyAVX2+1
+	if (logn >= 4) {
+		mq_poly_tomonty_avx2(f, n);
+		return;
+	}
+#endif // yyyAVX2-
 	for (u = 0; u < n; u ++) {
 		f[u] = (uint16_t)mq_montymul(f[u], R2);
 	}
 }
 
-/*
- * Multiply two polynomials together (NTT representation, and using
- * a Montgomery multiplication). Result f*g is written over f.
- */
+/* see inner.h */
+TARGET_AVX2
 void
-mq_poly_montymul_ntt(uint16_t *f, const uint16_t *g, unsigned logn)
+Zk(mq_poly_montymul_ntt)(uint16_t *f, const uint16_t *g, unsigned logn)
 {
 	size_t u, n;
 
 	n = (size_t)1 << logn;
+#if FALCON_AVX2 // yyyAVX2+1
+	if (logn >= 4) {
+		mq_poly_montymul_avx2(f, g, n);
+		return;
+	}
+#endif // yyyAVX2-
 	for (u = 0; u < n; u ++) {
 		f[u] = (uint16_t)mq_montymul(f[u], g[u]);
 	}
 }
 
+#ifndef FALCON_KERNEL
+
 /*
  * Subtract polynomial g from polynomial f.
  */
@@ -636,8 +1662,8 @@ mq_poly_sub(uint16_t *f, const uint16_t *g, unsigned logn)
 void
 Zf(to_ntt_monty)(uint16_t *h, unsigned logn)
 {
-    mq_NTT(h, logn);
-    mq_poly_tomonty(h, logn);
+    Zf(mq_NTT)(h, logn);
+    Zf(mq_poly_tomonty)(h, logn);
 }
 
 /* see inner.h */
@@ -675,9 +1701,9 @@ Zf(verify_raw)(const uint16_t *c0, const int16_t *s2,
 	/*
 	 * Compute -s1 = s2*h - c0 mod phi mod q (in tt[]).
 	 */
-	mq_NTT(tt, logn);
-	mq_poly_montymul_ntt(tt, h, logn);
-	mq_iNTT(tt, logn);
+	Zf(mq_NTT)(tt, logn);
+	Zf(mq_poly_montymul_ntt)(tt, h, logn);
+	Zf(mq_iNTT)(tt, logn);
 	mq_poly_sub(tt, c0, logn);
 
 	/*
@@ -702,6 +1728,324 @@ Zf(verify_raw)(const uint16_t *c0, const int16_t *s2,
     }
 }
 
+#endif
+
+#if FALCON_AVX2 // yyyAVX2+1
+/*
+ * Transpose a 16x16 matrix of 16-bit values (x[i] is row i). Columns
+ * of the input become rows of the output: x[j] receives the j-th
+ * element of each of the input x[0..15].
+ */
+TARGET_AVX2
+static inline void
+mq_transpose_x16(__m256i *x)
+{
+	__m256i a[16], b[16];
+	int i, k;
+
+	/*
+	 * Interleave rows by pairs, then by groups of four and eight;
+	 * a[8*o+c] then contains, in its low (high) 128-bit half, column
+	 * c (8+c) of rows 8*o..8*o+7.
+	 */
+	for (i = 0; i < 8; i ++) {
+		a[i] = _mm256_unpacklo_epi16(x[2 * i], x[2 * i + 1]);
+		a[i + 8] = _mm256_unpackhi_epi16(x[2 * i], x[2 * i + 1]);
+	}
+	for (i = 0; i < 4; i ++) {
+		b[4 * i] = _mm256_unpacklo_epi32(a[2 * i], a[2 * i + 1]);
+		b[4 * i + 1] = _mm256_unpackhi_epi32(a[2 * i], a[2 * i + 1]);
+		b[4 * i + 2] = _mm256_unpacklo_epi32(
+			a[2 * i + 8], a[2 * i + 9]);
+		b[4 * i + 3] = _mm256_unpackhi_epi32(
+			a[2 * i + 8], a[2 * i + 9]);
+	}
+	for (i = 0; i < 2; i ++) {
+		for (k = 0; k < 4; k ++) {
+			a[8 * i + 2 * k] = _mm256_unpacklo_epi64(
+				b[8 * i + k], b[8 * i + 4 + k]);
+			a[8 * i + 2 * k + 1] = _mm256_unpackhi_epi64(
+				b[8 * i + k], b[8 * i + 4 + k]);
+		}
+	}
+	for (i = 0; i < 8; i ++) {
+		x[i] = _mm256_permute2x128_si256(a[i], a[i + 8], 0x20);
+		x[i + 8] = _mm256_permute2x128_si256(a[i], a[i + 8], 0x31);
+	}
+}
+
+/*
+ * Rows of the transposed representation used by verify_raw_x16(): row
+ * j holds coefficient j of the 16 polynomials.
+ */
+TARGET_AVX2
+static inline __m256i
+mq_ldrow(const uint16_t *a, size_t j)
+{
+	return _mm256_loadu_si256((const __m256i *)(a + (j << 4)));
+}
+
+TARGET_AVX2
+static inline void
+mq_strow(uint16_t *a, size_t j, __m256i x)
+{
+	_mm256_storeu_si256((__m256i *)(a + (j << 4)), x);
+}
+
+/*
+ * Add the squares of the 16 values of x (signed) to the accumulators,
+ * with the saturation rule of Zf(is_short)(): each ng[] word collects
+ * the successive sums, and a sum exceeding 2^31-1 sets its top bit.
+ * Lanes 0-3 and 8-11 go to sn[0], lanes 4-7 and 12-15 to sn[1].
+ */
+TARGET_AVX2
+static inline void
+mq_sqnorm_x16(__m256i *sn, __m256i *ng, __m256i x)
+{
+	__m256i lo, hi;
+
+	lo = _mm256_mullo_epi16(x, x);
+	hi = _mm256_mulhi_epi16(x, x);
+	sn[0] = _mm256_add_epi32(sn[0], _mm256_unpacklo_epi16(lo, hi));
+	ng[0] = _mm256_or_si256(ng[0], sn[0]);
+	sn[1] = _mm256_add_epi32(sn[1], _mm256_unpackhi_epi16(lo, hi));
+	ng[1] = _mm256_or_si256(ng[1], sn[1]);
+}
+
+/*
+ * AVX2 implementation of Zf(verify_raw_batch)(), for logn >= 4. The
+ * s2 polynomials are transposed into tmp[] (missing lanes are zero),
+ * so that the NTT, the product with h and the inverse NTT use only
+ * vertical operations with broadcast twiddle factors; the reduction
+ * strategy is the one of mq_NTT_avx2() and mq_iNTT_avx2(). The c0
+ * polynomials are transposed on the fly when computing s1, and the
+ * norms are accumulated per lane.
+ */
+TARGET_AVX2
+static void
+verify_raw_x16(const uint16_t *const *c0, const int16_t *const *s2,
+	const uint16_t *h, unsigned logn, int *res, size_t num, uint8_t *tmp)
+{
+	size_t n, t, m, u;
+	unsigned l;
+	uint16_t *a;
+	__m256i x[16], sn[2], ng[2], z, zq, zi;
+	uint32_t ni, vs[16], vg[16];
+
+	n = (size_t)1 << logn;
+	a = (uint16_t *)tmp;
+	zi = _mm256_set1_epi16((int16_t)(65536 - Q0I));
+	sn[0] = sn[1] = ng[0] = ng[1] = _mm256_setzero_si256();
+
+	/*
+	 * Transpose s2 into a[], with values reduced to -q/2..+q/2, and
+	 * accumulate the norms of s2.
+	 */
+	for (u = 0; u < n; u += 16) {
+		for (l = 0; l < 16; l ++) {
+			x[l] = l < num
+				? _mm256_loadu_si256((const __m256i *)(s2[l] + u))
+				: _mm256_setzero_si256();
+		}
+		mq_transpose_x16(x);
+		for (l = 0; l < 16; l ++) {
+			mq_sqnorm_x16(sn, ng, x[l]);
+			mq_strow(a, u + l, mq_barrett_x16(x[l]));
+		}
+	}
+
+	/*
+	 * NTT, by pairs of layers (the first layer is done alone if logn
+	 * is odd). Values are reduced after each pass.
+	 */
+	t = n;
+	m = 1;
+	if ((logn & 1) != 0) {
+		size_t ht;
+
+		ht = t >> 1;
+		z = _mm256_set1_epi16(GMs[1]);
+		zq = _mm256_set1_epi16(GMsq[1]);
+		for (u = 0; u < ht; u ++) {
+			__m256i x0, x1;
+
+			x0 = mq_ldrow(a, u);
+			x1 = mq_ldrow(a, u + ht);
+			mq_ct_x16(&x0, &x1, z, zq);
+			mq_strow(a, u, mq_barrett_x16(x0));
+			mq_strow(a, u + ht, mq_barrett_x16(x1));
+		}
+		t = ht;
+		m = 2;
+	}
+	for (; t > 1; t >>= 2, m <<= 2) {
+		size_t qt, i, j1;
+
+		qt = t >> 2;
+		for (i = 0, j1 = 0; i < m; i ++, j1 += t) {
+			__m256i z1, z1q, z2, z2q, z3, z3q;
+			size_t j;
+
+			z1 = _mm256_set1_epi16(GMs[m + i]);
+			z1q = _mm256_set1_epi16(GMsq[m + i]);
+			z2 = _mm256_set1_epi16(GMs[(m + i) << 1]);
+			z2q = _mm256_set1_epi16(GMsq[(m + i) << 1]);
+			z3 = _mm256_set1_epi16(GMs[((m + i) << 1) + 1]);
+			z3q = _mm256_set1_epi16(GMsq[((m + i) << 1) + 1]);
+			for (j = j1; j < j1 + qt; j ++) {
+				__m256i x0, x1, x2, x3;
+
+				x0 = mq_ldrow(a, j);
+				x1 = mq_ldrow(a, j + qt);
+				x2 = mq_ldrow(a, j + 2 * qt);
+				x3 = mq_ldrow(a, j + 3 * qt);
+				mq_ct_x16(&x0, &x2, z1, z1q);
+				mq_ct_x16(&x1, &x3, z1, z1q);
+				mq_ct_x16(&x0, &x1, z2, z2q);
+				mq_ct_x16(&x2, &x3, z3, z3q);
+				mq_strow(a, j, mq_barrett_x16(x0));
+				mq_strow(a, j + qt, mq_barrett_x16(x1));
+				mq_strow(a, j + 2 * qt, mq_barrett_x16(x2));
+				mq_strow(a, j + 3 * qt, mq_barrett_x16(x3));
+			}
+		}
+	}
+
+	/*
+	 * Product with h (Montgomery representation, in 0..q-1). Output
+	 * values are in -7300..+7300.
+	 */
+	for (u = 0; u < n; u ++) {
+		z = _mm256_set1_epi16((int16_t)h[u]);
+		zq = _mm256_mullo_epi16(z, zi);
+		mq_strow(a, u, mq_montymul_x16(mq_ldrow(a, u), z, zq));
+	}
+
+	/*
+	 * Inverse NTT, by pairs of layers, then the last layer alone if
+	 * logn is odd.
+	 */
+	for (t = 1, m = n; m >= 4; t <<= 2, m >>= 2) {
+		size_t hm, i, j1;
+
+		hm = m >> 1;
+		for (i = 0, j1 = 0; i < (m >> 2); i ++, j1 += t << 2) {
+			__m256i z1, z1q, z2, z2q, z3, z3q;
+			size_t j;
+
+			z1 = _mm256_set1_epi16(iGMs[hm + (i << 1)]);
+			z1q = _mm256_set1_epi16(iGMsq[hm + (i << 1)]);
+			z2 = _mm256_set1_epi16(iGMs[hm + (i << 1) + 1]);
+			z2q = _mm256_set1_epi16(iGMsq[hm + (i << 1) + 1]);
+			z3 = _mm256_set1_epi16(iGMs[(hm >> 1) + i]);
+			z3q = _mm256_set1_epi16(iGMsq[(hm >> 1) + i]);
+			for (j = j1; j < j1 + t; j ++) {
+				__m256i x0, x1, x2, x3;
+
+				x0 = mq_ldrow(a, j);
+				x1 = mq_ldrow(a, j + t);
+				x2 = mq_ldrow(a, j + 2 * t);
+				x3 = mq_ldrow(a, j + 3 * t);
+				mq_gs_x16(&x0, &x1, z1, z1q);
+				mq_gs_x16(&x2, &x3, z2, z2q);
+				mq_gs_x16(&x0, &x2, z3, z3q);
+				mq_gs_x16(&x1, &x3, z3, z3q);
+				mq_strow(a, j, x0);
+				mq_strow(a, j + t, x1);
+				mq_strow(a, j + 2 * t, x2);
+				mq_strow(a, j + 3 * t, x3);
+			}
+		}
+	}
+	if (m == 2) {
+		z = _mm256_set1_epi16(iGMs[1]);
+		zq = _mm256_set1_epi16(iGMsq[1]);
+		for (u = 0; u < t; u ++) {
+			__m256i x0, x1;
+
+			x0 = mq_ldrow(a, u);
+			x1 = mq_ldrow(a, u + t);
+			mq_gs_x16(&x0, &x1, z, zq);
+			mq_strow(a, u, x0);
+			mq_strow(a, u + t, x1);
+		}
+	}
+
+	/*
+	 * Division by n, subtraction of c0 (transposed on the fly) and
+	 * normalization of -s1 to -q/2..+q/2, as in Zf(verify_raw)().
+	 */
+	ni = R;
+	for (m = n; m > 1; m >>= 1) {
+		ni = mq_rshift1(ni);
+	}
+	z = _mm256_set1_epi16((int16_t)ni);
+	zq = _mm256_set1_epi16((int16_t)(ni * (uint32_t)(65536 - Q0I)));
+	for (u = 0; u < n; u += 16) {
+		for (l = 0; l < 16; l ++) {
+			x[l] = l < num
+				? _mm256_loadu_si256((const __m256i *)(c0[l] + u))
+				: _mm256_setzero_si256();
+		}
+		mq_transpose_x16(x);
+		for (l = 0; l < 16; l ++) {
+			__m256i y;
+
+			y = mq_montymul_x16(mq_ldrow(a, u + l), z, zq);
+			y = mq_norm_x16(mq_barrett_x16(
+				_mm256_sub_epi16(y, x[l])));
+			y = _mm256_sub_epi16(y, _mm256_and_si256(
+				_mm256_cmpgt_epi16(y, _mm256_set1_epi16(Q >> 1)),
+				_mm256_set1_epi16(Q)));
+			mq_sqnorm_x16(sn, ng, y);
+		}
+	}
+
+	_mm256_storeu_si256((__m256i *)vs, sn[0]);
+	_mm256_storeu_si256((__m256i *)(vs + 8), sn[1]);
+	_mm256_storeu_si256((__m256i *)vg, ng[0]);
+	_mm256_storeu_si256((__m256i *)(vg + 8), ng[1]);
+	for (l = 0; l < num; l ++) {
+		unsigned e;
+
+		/*
+		 * Lane l is word e of the accumulators (see mq_sqnorm_x16()).
+		 */
+		e = ((l & 4) << 1) + ((l & 8) >> 1) + (l & 3);
+		res[l] = Zf(is_short_sqnorm)(
+			vs[e] | -(vg[e] >> 31), logn);
+	}
+}
+
+/*
+ * Minimum number of signatures for which Zf(verify_raw_batch)() uses
+ * verify_raw_x16() instead of separate calls to Zf(verify_raw)().
+ */
+#define VERIFY_X16_MIN   8
+#endif // yyyAVX2-
+
+/* see inner.h */
+TARGET_AVX2
+void
+Zk(verify_raw_batch)(const uint16_t *const *c0,
+	const int16_t *const *s2, const uint16_t *h, unsigned logn,
+	int *res, size_t num, uint8_t *tmp)
+{
+	size_t l;
+
+#if FALCON_AVX2 // yyyAVX2+1
+	if (logn >= 4 && num >= VERIFY_X16_MIN) {
+		verify_raw_x16(c0, s2, h, logn, res, num, tmp);
+		return;
+	}
+#endif // yyyAVX2-
+	for (l = 0; l < num; l ++) {
+		res[l] = Zf(verify_raw)(c0[l], s2[l], h, logn, tmp);
+	}
+}
+
+#ifndef FALCON_KERNEL
+
 /* see inner.h */
 int
 Zf(compute_public)(uint16_t *h,
@@ -716,15 +2060,15 @@ Zf(compute_public)(uint16_t *h,
 		tt[u] = (uint16_t)mq_conv_small(f[u]);
 		h[u] = (uint16_t)mq_conv_small(g[u]);
 	}
-	mq_NTT(h, logn);
-	mq_NTT(tt, logn);
+	Zf(mq_NTT)(h, logn);
+	Zf(mq_NTT)(tt, logn);
 	for (u = 0; u < n; u ++) {
 		if (tt[u] == 0) {
 			return 0;
 		}
 		h[u] = (uint16_t)mq_div_12289(h[u], tt[u]);
 	}
-	mq_iNTT(h, logn);
+	Zf(mq_iNTT)(h, logn);
 	return 1;
 }
 
@@ -744,21 +2088,21 @@ Zf(complete_private)(int8_t *G,
 		t1[u] = (uint16_t)mq_conv_small(g[u]);
 		t2[u] = (uint16_t)mq_conv_small(F[u]);
 	}
-	mq_NTT(t1, logn);
-	mq_NTT(t2, logn);
-	mq_poly_tomonty(t1, logn);
-	mq_poly_montymul_ntt(t1, t2, logn);
+	Zf(mq_NTT)(t1, logn);
+	Zf(mq_NTT)(t2, logn);
+	Zf(mq_poly_tomonty)(t1, logn);
+	Zf(mq_poly_montymul_ntt)(t1, t2, logn);
 	for (u = 0; u < n; u ++) {
 		t2[u] = (uint16_t)mq_conv_small(f[u]);
 	}
-	mq_NTT(t2, logn);
+	Zf(mq_NTT)(t2, logn);
 	for (u = 0; u < n; u ++) {
 		if (t2[u] == 0) {
 			return 0;
 		}
 		t1[u] = (uint16_t)mq_div_12289(t1[u], t2[u]);
 	}
-	mq_iNTT(t1, logn);
+	Zf(mq_iNTT)(t1, logn);
 	for (u = 0; u < n; u ++) {
 		uint32_t w;
 		int32_t gi;
@@ -792,7 +2136,7 @@ Zf(is_invertible)(
 		w += Q & -(w >> 31);
 		tt[u] = (uint16_t)w;
 	}
-	mq_NTT(tt, logn);
+	Zf(mq_NTT)(tt, logn);
 	r = 0;
 	for (u = 0; u < n; u ++) {
 		r |= (uint32_t)(tt[u] - 1);
@@ -837,14 +2181,14 @@ Zf(verify_recover)(uint16_t *h,
 	 * from strict constant-time processing; if all coefficients of
 	 * s2 are non-zero, then the high bit of r will be zero.
 	 */
-	mq_NTT(tt, logn);
-	mq_NTT(h, logn);
+	Zf(mq_NTT)(tt, logn);
+	Zf(mq_NTT)(h, logn);
 	r = 0;
 	for (u = 0; u < n; u ++) {
 		r |= (uint32_t)(tt[u] - 1);
 		h[u] = (uint16_t)mq_div_12289(h[u], tt[u]);
 	}
-	mq_iNTT(h, logn);
+	Zf(mq_iNTT)(h, logn);
 
 	/*
 	 * Signature is acceptable if and only if it is short enough,
@@ -873,7 +2217,7 @@ Zf(count_nttzero)(const int16_t *sig, unsigned logn, uint8_t *tmp)
 		w += Q & -(w >> 31);
 		s2[u] = (uint16_t)w;
 	}
-	mq_NTT(s2, logn);
+	Zf(mq_NTT)(s2, logn);
 	r = 0;
 	for (u = 0; u < n; u ++) {
 		uint32_t w;
@@ -883,3 +2227,5 @@ Zf(count_nttzero)(const int16_t *sig, unsigned logn, uint8_t *tmp)
 	}
 	return (int)r;
 }
+
+#endif
@@ -0,0 +1 @@
+../falcon-lazy/ctx.c
\ No newline at end of file
@@ -0,0 +1 @@
+../falcon-lazy/dispatch.c
\ No newline at end of file
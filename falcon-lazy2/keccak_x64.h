@@ -0,0 +1 @@
+../falcon-lazy/keccak_x64.h
\ No newline at end of file
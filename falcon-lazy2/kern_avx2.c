@@ -0,0 +1 @@
+../falcon-lazy/kern_avx2.c
\ No newline at end of file
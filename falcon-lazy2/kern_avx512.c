@@ -0,0 +1 @@
+../falcon-lazy/kern_avx512.c
\ No newline at end of file
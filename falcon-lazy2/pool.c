@@ -0,0 +1 @@
+../falcon-lazy/pool.c
\ No newline at end of file
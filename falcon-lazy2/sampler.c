@@ -0,0 +1 @@
+../falcon-lazy/sampler.c
\ No newline at end of file
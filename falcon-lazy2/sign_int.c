@@ -0,0 +1 @@
+../falcon-lazy/sign_int.c
\ No newline at end of file
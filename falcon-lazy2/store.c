@@ -0,0 +1 @@
+../falcon-lazy/store.c
\ No newline at end of file
@@ -1,6 +1,12 @@
 #include "benchmark/benchmark.h"
 #include "testlib.h"
 
+// falcon.h declares shake256_init_prng_from_seed() with the public context
+// type, while testlib.h declares it with the inner one (same layout).
+#define shake256_init_prng_from_seed falcon_h_shake256_init_prng_from_seed
+#include "../falcon.h"
+#undef shake256_init_prng_from_seed
+
 static void falcon_dyn_lazy_offline(benchmark::State& state) {
     // Perform setup here
     const uint64_t logn = 9;
@@ -18,15 +24,12 @@ static void falcon_dyn_lazy_offline(benchmark::State& state) {
     std::vector<int8_t> sample1(n);
     std::vector<int8_t> sample2(n);
     std::vector<uint16_t> sample_target(n);
-    std::vector<fpr> f_FFT(n);
-    std::vector<fpr> g_FFT(n);
-    std::vector<fpr> F_FFT(n);
-    std::vector<fpr> G_FFT(n);
+    std::vector<fpr> B_FFT(4 * n);
+    std::vector<fpr> ftmp(n);
 
     for (auto _ : state) {
         sign_dyn_lazy_offline(&rng, key.f.data(), key.g.data(), key.F.data(), key.G.data(), key.h.data(), logn,
-                              sample1.data(), sample2.data(), sample_target.data(), f_FFT.data(), g_FFT.data(),
-                              F_FFT.data(), G_FFT.data());
+                              sample1.data(), sample2.data(), sample_target.data(), B_FFT.data(), ftmp.data());
     }
 }
 
@@ -47,22 +50,268 @@ static void falcon_dyn_lazy_online(benchmark::State& state) {
     std::vector<int8_t> sample1(n);
     std::vector<int8_t> sample2(n);
     std::vector<uint16_t> sample_target(n);
-    std::vector<fpr> f_FFT(n);
-    std::vector<fpr> g_FFT(n);
-    std::vector<fpr> F_FFT(n);
-    std::vector<fpr> G_FFT(n);
+    std::vector<fpr> B_FFT(4 * n);
+    std::vector<fpr> ftmp(n);
 
     for (uint64_t i=0; i<1; ++i) {
         sign_dyn_lazy_offline(&rng, key.f.data(), key.g.data(), key.F.data(), key.G.data(), key.h.data(), logn,
-                              sample1.data(), sample2.data(), sample_target.data(), f_FFT.data(), g_FFT.data(),
-                              F_FFT.data(), G_FFT.data());
+                              sample1.data(), sample2.data(), sample_target.data(), B_FFT.data(), ftmp.data());
     }
     std::vector<uint16_t> orig_sample_target = sample_target;
+    std::vector<fpr> tmp(4 * n);
     for (auto _ : state) {
         sign_dyn_lazy_online(sample1.data(), sample2.data(), sample_target.data(), sig.data(),
-                             f_FFT.data(), g_FFT.data(), F_FFT.data(), G_FFT.data(), hm.data(), logn,
-                             nullptr);
+                             B_FFT.data(), hm.data(), logn,
+                             tmp.data());
+    }
+}
+
+// Integer-only online phase (no floating-point), same tokens and same
+// result as falcon_dyn_lazy_online.
+static void falcon_dyn_lazy_online_int(benchmark::State& state) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<int16_t> sig(n);
+    // use a random hash of message
+    std::vector<uint16_t> hm(n);
+    for (uint64_t i=0; i<n; ++i) {
+        hm[i]=rand()%F_Q;
+    }
+    std::vector<int8_t> sample1(n);
+    std::vector<int8_t> sample2(n);
+    std::vector<uint16_t> sample_target(n);
+    std::vector<fpr> ftmp(n);
+    std::vector<uint32_t> Bi(LAZY_IBASIS_SIZE(logn) / sizeof(uint32_t));
+    sign_dyn_lazy_basis_int(Bi.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(), logn);
+    sign_dyn_lazy_offline(&rng, key.f.data(), key.g.data(), key.F.data(), key.G.data(), key.h.data(), logn,
+                          sample1.data(), sample2.data(), sample_target.data(), NULL, ftmp.data());
+    std::vector<uint32_t> tmp(6 * n);
+    for (auto _ : state) {
+        sign_dyn_lazy_online_int(sample1.data(), sample2.data(), sample_target.data(), sig.data(),
+                                 Bi.data(), hm.data(), logn, tmp.data());
+    }
+}
+
+static void falcon_lazy_expanded_offline(benchmark::State& state) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+    falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                 key.h.data(), logn);
+    std::vector<int8_t> sample1(n);
+    std::vector<int8_t> sample2(n);
+    std::vector<fpr> yt(2 * n);
+
+    for (auto _ : state) {
+        falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1.data(), sample2.data(), yt.data(), logn);
+    }
+}
+
+// Argument is the signer-side norm check (LAZY_NORM_FULL, LAZY_NORM_NTT
+// or LAZY_NORM_SKIP).
+static void falcon_lazy_expanded_online(benchmark::State& state) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+    falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                 key.h.data(), logn);
+    std::vector<int16_t> sig(n);
+    // use a random hash of message
+    std::vector<uint16_t> hm(n);
+    for (uint64_t i=0; i<n; ++i) {
+        hm[i]=rand()%F_Q;
+    }
+    std::vector<int8_t> sample1(n);
+    std::vector<int8_t> sample2(n);
+    std::vector<fpr> yt(2 * n);
+    std::vector<fpr> tmp(4 * n);
+    falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1.data(), sample2.data(), yt.data(), logn);
+
+    for (auto _ : state) {
+        falcon_inner_sign_lazy_online(sig.data(), expkey.data(), sample1.data(), sample2.data(),
+                                      yt.data(), hm.data(), logn, (int) state.range(0), tmp.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Online phase including the message hash. The nonce and the hash
+// context with the nonce injected come from the token, as in
+// falcon_sign_lazy_online().
+static void falcon_lazy_expanded_online_hash(benchmark::State& state) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+    falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                 key.h.data(), logn);
+    std::vector<int16_t> sig(n);
+    std::vector<uint16_t> hm(n);
+    std::vector<int8_t> sample1(n);
+    std::vector<int8_t> sample2(n);
+    std::vector<fpr> yt(2 * n);
+    std::vector<fpr> tmp(4 * n);
+    uint8_t nonce[40], msg[32] = {0};
+    inner_shake256_context token_hd, hd;
+    falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1.data(), sample2.data(), yt.data(), logn);
+    inner_shake256_extract(&rng, nonce, sizeof nonce);
+    inner_shake256_init(&token_hd);
+    inner_shake256_inject(&token_hd, nonce, sizeof nonce);
+
+    for (auto _ : state) {
+        hd = token_hd;
+        inner_shake256_inject(&hd, msg, sizeof msg);
+        inner_shake256_flip(&hd);
+        falcon_inner_hash_to_point_vartime(&hd, hm.data(), logn);
+        falcon_inner_sign_lazy_online(sig.data(), expkey.data(), sample1.data(), sample2.data(),
+                                      yt.data(), hm.data(), logn, LAZY_NORM_SKIP, tmp.data());
+    }
+}
+
+// Batched online phase: each iteration produces LAZY_BATCH signatures.
+static void falcon_lazy_online_batch(benchmark::State& state) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+    falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                 key.h.data(), logn);
+    std::vector<std::vector<int8_t>> sample1(LAZY_BATCH, std::vector<int8_t>(n));
+    std::vector<std::vector<int8_t>> sample2(LAZY_BATCH, std::vector<int8_t>(n));
+    std::vector<std::vector<fpr>> yt(LAZY_BATCH, std::vector<fpr>(2 * n));
+    std::vector<std::vector<uint16_t>> hm(LAZY_BATCH, std::vector<uint16_t>(n));
+    std::vector<std::vector<int16_t>> s2(LAZY_BATCH, std::vector<int16_t>(n));
+    std::vector<fpr> tmp(12 * n);
+    int16_t *s2p[LAZY_BATCH];
+    const int8_t *sample2p[LAZY_BATCH];
+    const fpr *ytp[LAZY_BATCH];
+    const uint16_t *hmp[LAZY_BATCH];
+    for (unsigned l = 0; l < LAZY_BATCH; ++l) {
+        falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1[l].data(), sample2[l].data(), yt[l].data(), logn);
+        for (uint64_t i = 0; i < n; ++i) {
+            hm[l][i] = rand() % F_Q;
+        }
+        s2p[l] = s2[l].data();
+        sample2p[l] = sample2[l].data();
+        ytp[l] = yt[l].data();
+        hmp[l] = hm[l].data();
+    }
+
+    for (auto _ : state) {
+        falcon_inner_sign_lazy_online_batch(s2p, expkey.data(), sample2p, ytp, hmp, logn, tmp.data());
+    }
+    state.SetItemsProcessed(state.iterations() * LAZY_BATCH);
+}
+
+EXPORT void sample_gaussian_poly_bern(prng *p, int8_t *sample1, int8_t *sample2, size_t n);
+
+// Gaussian blinding pair of the offline phase; items are coefficients.
+static void falcon_lazy_sample_bern(benchmark::State& state) {
+    const uint64_t n = 1 << 9;
+    inner_shake256_context rng;
+    shake256_init_prng_from_seed(&rng, "bern", 4);
+    prng p;
+    Zf(prng_init)(&p, &rng);
+    std::vector<int8_t> sample1(n), sample2(n);
+    for (auto _ : state) {
+        sample_gaussian_poly_bern(&p, sample1.data(), sample2.data(), n);
+        benchmark::DoNotOptimize(sample1.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+// Floating-point primitives, emulated with FALCON_FPEMU (build with
+// -DFALCON_FPEMU64=0 for the generic emulation). Argument selects the
+// operation: 0 = fpr_add, 1 = fpr_mul, 2 = fpr_div, 3 = fpr_rint,
+// 4 = fpr_of.
+static void falcon_fpr_op(benchmark::State& state) {
+    static const char *const names[] = { "add", "mul", "div", "rint", "of" };
+    const size_t len = 1024;
+    std::vector<fpr> x(len), y(len), z(len);
+    std::vector<int64_t> k(len);
+    for (size_t i = 0; i < len; ++i) {
+        k[i] = (int64_t)(rand() % 2000001) - 1000000;
+        x[i] = fpr_div(fpr_of(k[i]), fpr_of(rand() % 999 + 1));
+        y[i] = fpr_div(fpr_of((int64_t)(rand() % 1000000 + 1) * (rand() & 1 ? 1 : -1)),
+                       fpr_of(rand() % 999 + 1));
+    }
+    int op = (int) state.range(0);
+    for (auto _ : state) {
+        switch (op) {
+        case 0:
+            for (size_t i = 0; i < len; ++i) z[i] = fpr_add(x[i], y[i]);
+            break;
+        case 1:
+            for (size_t i = 0; i < len; ++i) z[i] = fpr_mul(x[i], y[i]);
+            break;
+        case 2:
+            for (size_t i = 0; i < len; ++i) z[i] = fpr_div(x[i], y[i]);
+            break;
+        case 3:
+            for (size_t i = 0; i < len; ++i) k[i] = fpr_rint(x[i]);
+            break;
+        default:
+            for (size_t i = 0; i < len; ++i) z[i] = fpr_of(k[i]);
+            break;
+        }
+        benchmark::DoNotOptimize(z.data());
+        benchmark::DoNotOptimize(k.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * len);
+    state.SetLabel(names[op]);
+}
+
+// Lazy expanded key shared (read-only) by all threads of the benchmark below.
+static std::vector<uint8_t> make_lazy_expanded_key(unsigned logn) {
+    inner_shake256_context rng;
+    shake256_init_prng_from_seed(&rng, "lazy ctx", 8);
+    std::vector<uint8_t> privkey(FALCON_PRIVKEY_SIZE(logn));
+    std::vector<uint8_t> pubkey(FALCON_PUBKEY_SIZE(logn));
+    std::vector<uint8_t> tmp(FALCON_TMPSIZE_KEYGEN(logn) + FALCON_TMPSIZE_LAZYEXPAND(logn));
+    std::vector<uint8_t> expkey(FALCON_LAZY_EXPANDEDKEY_SIZE(logn));
+    REQUIRE_DRAMATICALLY(falcon_keygen_make((shake256_context *) &rng, logn, privkey.data(), privkey.size(),
+                                            pubkey.data(), pubkey.size(), tmp.data(), tmp.size()) == 0,
+                         "keygen failed");
+    REQUIRE_DRAMATICALLY(falcon_lazy_expand_key(expkey.data(), expkey.size(), privkey.data(), privkey.size(),
+                                                pubkey.data(), pubkey.size(), tmp.data(), tmp.size()) == 0,
+                         "lazy expand failed");
+    return expkey;
+}
+
+// Full lazy signatures (offline + online), one context per thread; items/s
+// is the aggregate throughput over all threads.
+static void falcon_lazy_ctx_sign_mt(benchmark::State& state) {
+    const unsigned logn = 9;
+    static const std::vector<uint8_t> expkey = make_lazy_expanded_key(logn);
+    inner_shake256_context rng;
+    uint32_t seed = state.thread_index();
+    shake256_init_prng_from_seed(&rng, &seed, sizeof seed);
+    falcon_lazy_ctx *ctx;
+    REQUIRE_DRAMATICALLY(falcon_lazy_ctx_new(&ctx, (shake256_context *) &rng, expkey.data()) == 0,
+                         "lazy ctx creation failed");
+    std::vector<uint8_t> sig(FALCON_SIG_COMPRESSED_MAXSIZE(logn));
+    uint8_t msg[32] = {0};
+    for (auto _ : state) {
+        size_t sig_len = sig.size();
+        msg[0]++;
+        int r = falcon_lazy_ctx_sign(ctx, sig.data(), &sig_len, FALCON_SIG_COMPRESSED, msg, sizeof msg);
+        benchmark::DoNotOptimize(r);
     }
+    state.SetItemsProcessed(state.iterations());
+    falcon_lazy_ctx_free(ctx);
 }
 
 static void falcon_dyn_orig(benchmark::State& state) {
@@ -91,11 +340,301 @@ static void falcon_dyn_orig(benchmark::State& state) {
     free(tmp);
 }
 
+static void falcon_verify(benchmark::State& state) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<int16_t> sig(n);
+    std::vector<uint16_t> hm(n);
+// use a random hash of message
+    for (uint64_t i = 0; i < n; ++i) {
+        hm[i] = rand() % F_Q;
+    }
+    uint8_t *tmp = (uint8_t *) aligned_alloc(64, 1024 * 1024);
+    falcon_inner_sign_dyn(
+            sig.data(),
+            &rng,
+            key.f.data(), key.g.data(),
+            key.F.data(), key.G.data(),
+            hm.data(),
+            logn, tmp);
+    std::vector<uint16_t> h_monty(key.h.begin(), key.h.end());
+    falcon_inner_to_ntt_monty(h_monty.data(), logn);
+    for (auto _ : state) {
+        int r = falcon_inner_verify_raw(hm.data(), sig.data(), h_monty.data(), logn, tmp);
+        benchmark::DoNotOptimize(r);
+    }
+    free(tmp);
+}
+
+// Full verifications through the public API (hash to point, decoding, NTT
+// check); arg 0 passes the encoded public key, arg 1 the expanded one.
+static void falcon_verify_pubkey(benchmark::State& state) {
+    const unsigned logn = 9;
+    const bool expanded = state.range(0) != 0;
+    inner_shake256_context rng;
+    shake256_init_prng_from_seed(&rng, "verify", 6);
+    std::vector<uint8_t> privkey(FALCON_PRIVKEY_SIZE(logn));
+    std::vector<uint8_t> pubkey(FALCON_PUBKEY_SIZE(logn));
+    std::vector<uint8_t> exppub(FALCON_EXPANDEDPUB_SIZE(logn));
+    std::vector<uint8_t> sig(FALCON_SIG_COMPRESSED_MAXSIZE(logn));
+    std::vector<uint8_t> tmp(FALCON_TMPSIZE_KEYGEN(logn) + FALCON_TMPSIZE_SIGNDYN(logn));
+    std::vector<uint8_t> tmpvv(FALCON_TMPSIZE_VERIFY(logn));
+    const uint8_t msg[32] = {0};
+    size_t sig_len = sig.size();
+    REQUIRE_DRAMATICALLY(falcon_keygen_make((shake256_context *) &rng, logn, privkey.data(), privkey.size(),
+                                            pubkey.data(), pubkey.size(), tmp.data(), tmp.size()) == 0,
+                         "keygen failed");
+    REQUIRE_DRAMATICALLY(falcon_sign_dyn((shake256_context *) &rng, sig.data(), &sig_len, FALCON_SIG_COMPRESSED,
+                                         privkey.data(), privkey.size(), msg, sizeof msg,
+                                         tmp.data(), tmp.size()) == 0,
+                         "sign failed");
+    REQUIRE_DRAMATICALLY(falcon_expand_pubkey(exppub.data(), exppub.size(), pubkey.data(), pubkey.size()) == 0,
+                         "pubkey expansion failed");
+    for (auto _ : state) {
+        int r = expanded
+                ? falcon_verify_expanded(sig.data(), sig_len, FALCON_SIG_COMPRESSED, exppub.data(),
+                                         msg, sizeof msg, tmpvv.data(), tmpvv.size())
+                : falcon_verify(sig.data(), sig_len, FALCON_SIG_COMPRESSED, pubkey.data(), pubkey.size(),
+                                msg, sizeof msg, tmpvv.data(), tmpvv.size());
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(expanded ? "expanded" : "encoded");
+}
+
+// Compressed encoding (0) or decoding (1) of 64 signature vectors produced by the lazy signer.
+static void falcon_comp_codec(benchmark::State& state) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    const size_t k = 64;
+    const bool decode = state.range(0) != 0;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+    falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                 key.h.data(), logn);
+    std::vector<int8_t> sample1(n);
+    std::vector<int8_t> sample2(n);
+    std::vector<fpr> yt(2 * n);
+    std::vector<fpr> tmp(4 * n);
+    std::vector<uint16_t> hm(n);
+    std::vector<std::vector<int16_t>> sig(k, std::vector<int16_t>(n));
+    std::vector<std::vector<uint8_t>> enc(k, std::vector<uint8_t>(FALCON_SIG_COMPRESSED_MAXSIZE(logn)));
+    std::vector<size_t> enc_len(k);
+    size_t total = 0;
+    for (size_t i = 0; i < k; ++i) {
+        int ok;
+        do {
+            for (uint64_t j = 0; j < n; ++j) {
+                hm[j] = rand() % F_Q;
+            }
+            falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1.data(), sample2.data(), yt.data(), logn);
+            ok = falcon_inner_sign_lazy_online(sig[i].data(), expkey.data(), sample1.data(), sample2.data(),
+                                               yt.data(), hm.data(), logn, LAZY_NORM_FULL, tmp.data());
+        } while (!ok);
+        enc_len[i] = falcon_inner_comp_encode(enc[i].data(), enc[i].size(), sig[i].data(), logn);
+        REQUIRE_DRAMATICALLY(enc_len[i] != 0, "comp_encode failed");
+        total += enc_len[i];
+    }
+    std::vector<int16_t> out(n);
+    for (auto _ : state) {
+        size_t r = 0;
+        for (size_t i = 0; i < k; ++i) {
+            r += decode ? falcon_inner_comp_decode(out.data(), logn, enc[i].data(), enc_len[i])
+                        : falcon_inner_comp_encode(enc[i].data(), enc[i].size(), sig[i].data(), logn);
+        }
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations() * k);
+    state.SetBytesProcessed(state.iterations() * total);
+    state.SetLabel(decode ? "decode" : "encode");
+}
+
+// Fixed-width encoding (0) or decoding (1) of a private key (f, g, F) and
+// its public key h, in the same layout as falcon_keygen_make() output.
+static void falcon_key_codec(benchmark::State& state) {
+    const unsigned logn = 9;
+    const size_t n = 1 << logn;
+    const bool decode = state.range(0) != 0;
+    const unsigned fg_bits = falcon_inner_max_fg_bits[logn];
+    const unsigned FG_bits = falcon_inner_max_FG_bits[logn];
+    inner_shake256_context rng;
+    shake256_init_prng_from_seed(&rng, "codec", 5);
+    std::vector<uint8_t> privkey(FALCON_PRIVKEY_SIZE(logn));
+    std::vector<uint8_t> pubkey(FALCON_PUBKEY_SIZE(logn));
+    std::vector<uint8_t> tmp(FALCON_TMPSIZE_KEYGEN(logn));
+    REQUIRE_DRAMATICALLY(falcon_keygen_make((shake256_context *) &rng, logn, privkey.data(), privkey.size(),
+                                            pubkey.data(), pubkey.size(), tmp.data(), tmp.size()) == 0,
+                         "keygen failed");
+    std::vector<int8_t> f(n), g(n), F(n);
+    std::vector<uint16_t> h(n);
+    const size_t fg_len = (n * fg_bits) >> 3;
+    uint8_t *sk = privkey.data() + 1;
+    uint8_t *pk = pubkey.data() + 1;
+    REQUIRE_DRAMATICALLY(falcon_inner_trim_i8_decode(f.data(), logn, fg_bits, sk, fg_len) != 0
+                         && falcon_inner_trim_i8_decode(g.data(), logn, fg_bits, sk + fg_len, fg_len) != 0
+                         && falcon_inner_trim_i8_decode(F.data(), logn, FG_bits, sk + 2 * fg_len,
+                                                        privkey.size() - 1 - 2 * fg_len) != 0
+                         && falcon_inner_modq_decode(h.data(), logn, pk, pubkey.size() - 1) != 0,
+                         "key decoding failed");
+    for (auto _ : state) {
+        size_t r;
+        if (decode) {
+            r = falcon_inner_trim_i8_decode(f.data(), logn, fg_bits, sk, fg_len);
+            r += falcon_inner_trim_i8_decode(g.data(), logn, fg_bits, sk + fg_len, fg_len);
+            r += falcon_inner_trim_i8_decode(F.data(), logn, FG_bits, sk + 2 * fg_len, privkey.size() - 1 - 2 * fg_len);
+            r += falcon_inner_modq_decode(h.data(), logn, pk, pubkey.size() - 1);
+        } else {
+            r = falcon_inner_trim_i8_encode(sk, fg_len, f.data(), logn, fg_bits);
+            r += falcon_inner_trim_i8_encode(sk + fg_len, fg_len, g.data(), logn, fg_bits);
+            r += falcon_inner_trim_i8_encode(sk + 2 * fg_len, privkey.size() - 1 - 2 * fg_len, F.data(), logn, FG_bits);
+            r += falcon_inner_modq_encode(pk, pubkey.size() - 1, h.data(), logn);
+        }
+        REQUIRE_DRAMATICALLY(r == privkey.size() + pubkey.size() - 2, "key codec failed");
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (privkey.size() + pubkey.size() - 2));
+    state.SetLabel(decode ? "decode" : "encode");
+}
+
+// SHAKE256 output (32 blocks of 136 bytes per iteration); on x86-64 the
+// "cycles/byte" counter uses the time-stamp counter.
+static void falcon_shake256_extract(benchmark::State& state) {
+    const size_t len = 32 * 136;
+    inner_shake256_context sc;
+    std::vector<uint8_t> out(len);
+    inner_shake256_init(&sc);
+    inner_shake256_inject(&sc, (const uint8_t *) "keccak", 6);
+    inner_shake256_flip(&sc);
+#ifdef __x86_64__
+    uint64_t cycles = 0;
+#endif
+    for (auto _ : state) {
+#ifdef __x86_64__
+        uint64_t t0 = __builtin_ia32_rdtsc();
+#endif
+        inner_shake256_extract(&sc, out.data(), len);
+#ifdef __x86_64__
+        cycles += __builtin_ia32_rdtsc() - t0;
+#endif
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+#ifdef __x86_64__
+    state.counters["cycles/byte"] = (double) cycles / ((double) state.iterations() * len);
+#endif
+}
+
+// Hashing INNER_SHAKE256_LANES messages to points, one at a time (0) or together (1).
+static void falcon_hash_to_point_batch(benchmark::State& state) {
+    const unsigned logn = 9;
+    const uint64_t n = 1 << logn;
+    const bool batch = state.range(0) != 0;
+    inner_shake256_context sc[INNER_SHAKE256_LANES], work[INNER_SHAKE256_LANES];
+    inner_shake256_context *psc[INNER_SHAKE256_LANES];
+    std::vector<std::vector<uint16_t>> hm(INNER_SHAKE256_LANES, std::vector<uint16_t>(n));
+    uint16_t *hmp[INNER_SHAKE256_LANES];
+    for (unsigned l = 0; l < INNER_SHAKE256_LANES; ++l) {
+        const uint8_t msg[2] = {(uint8_t) l, 0};
+        inner_shake256_init(&sc[l]);
+        inner_shake256_inject(&sc[l], msg, sizeof msg);
+        inner_shake256_flip(&sc[l]);
+        psc[l] = &work[l];
+        hmp[l] = hm[l].data();
+    }
+    for (auto _ : state) {
+        for (unsigned l = 0; l < INNER_SHAKE256_LANES; ++l) {
+            work[l] = sc[l];
+        }
+        if (batch) {
+            falcon_inner_hash_to_point_batch(psc, hmp, INNER_SHAKE256_LANES, logn, 0, nullptr);
+        } else {
+            for (unsigned l = 0; l < INNER_SHAKE256_LANES; ++l) {
+                falcon_inner_hash_to_point_vartime(&work[l], hmp[l], logn);
+            }
+        }
+        benchmark::DoNotOptimize(hm[0][0]);
+    }
+    state.SetItemsProcessed(state.iterations() * INNER_SHAKE256_LANES);
+    state.SetLabel(batch ? "batch" : "single");
+}
+
+// Verifying k signatures under one public key (range(1), 1 to 256) with a loop of falcon_verify() (0) or
+// with falcon_verify_batch() (1).
+static void falcon_verify_batch(benchmark::State& state) {
+    const unsigned logn = 9;
+    const bool batch = state.range(0) != 0;
+    const size_t k = state.range(1);
+    inner_shake256_context rng;
+    shake256_init_prng_from_seed(&rng, "verify", 6);
+    std::vector<uint8_t> privkey(FALCON_PRIVKEY_SIZE(logn));
+    std::vector<uint8_t> pubkey(FALCON_PUBKEY_SIZE(logn));
+    std::vector<uint8_t> exppub(FALCON_EXPANDEDPUB_SIZE(logn));
+    std::vector<std::vector<uint8_t>> sig(k, std::vector<uint8_t>(FALCON_SIG_COMPRESSED_MAXSIZE(logn)));
+    std::vector<uint8_t> tmp(FALCON_TMPSIZE_KEYGEN(logn) + FALCON_TMPSIZE_SIGNDYN(logn));
+    std::vector<uint8_t> tmpvb(FALCON_TMPSIZE_VERIFY_BATCH(logn));
+    std::vector<std::vector<uint8_t>> msg(k, std::vector<uint8_t>(32));
+    std::vector<const void *> sigp(k), datap(k);
+    std::vector<size_t> sig_len(k), data_len(k);
+    std::vector<int> results(k);
+    REQUIRE_DRAMATICALLY(falcon_keygen_make((shake256_context *) &rng, logn, privkey.data(), privkey.size(),
+                                            pubkey.data(), pubkey.size(), tmp.data(), tmp.size()) == 0,
+                         "keygen failed");
+    for (size_t i = 0; i < k; ++i) {
+        msg[i][0] = (uint8_t) i;
+        sig_len[i] = sig[i].size();
+        REQUIRE_DRAMATICALLY(falcon_sign_dyn((shake256_context *) &rng, sig[i].data(), &sig_len[i],
+                                             FALCON_SIG_COMPRESSED, privkey.data(), privkey.size(),
+                                             msg[i].data(), msg[i].size(), tmp.data(), tmp.size()) == 0,
+                             "sign failed");
+        sigp[i] = sig[i].data();
+        datap[i] = msg[i].data();
+        data_len[i] = msg[i].size();
+    }
+    for (auto _ : state) {
+        int r = 0;
+        if (batch) {
+            // The public key is decoded once per batch.
+            r = falcon_expand_pubkey(exppub.data(), exppub.size(), pubkey.data(), pubkey.size());
+            r |= falcon_verify_batch(sigp.data(), sig_len.data(), FALCON_SIG_COMPRESSED, exppub.data(),
+                                     datap.data(), data_len.data(), results.data(), k,
+                                     tmpvb.data(), tmpvb.size());
+        } else {
+            for (size_t i = 0; i < k; ++i) {
+                r |= falcon_verify(sigp[i], sig_len[i], FALCON_SIG_COMPRESSED, pubkey.data(), pubkey.size(),
+                                   datap[i], data_len[i], tmpvb.data(), tmpvb.size());
+            }
+        }
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations() * k);
+    state.SetLabel(batch ? "batch" : "single");
+}
 
 // Register the function as a benchmark
 BENCHMARK(falcon_dyn_lazy_offline);
 BENCHMARK(falcon_dyn_lazy_online);
+BENCHMARK(falcon_dyn_lazy_online_int);
+BENCHMARK(falcon_lazy_expanded_offline);
+BENCHMARK(falcon_lazy_expanded_online)->Arg(LAZY_NORM_FULL)->Arg(LAZY_NORM_NTT)->Arg(LAZY_NORM_SKIP);
+BENCHMARK(falcon_lazy_expanded_online_hash);
+BENCHMARK(falcon_lazy_online_batch);
+BENCHMARK(falcon_lazy_sample_bern);
+BENCHMARK(falcon_fpr_op)->DenseRange(0, 4);
 BENCHMARK(falcon_dyn_orig);
+BENCHMARK(falcon_verify);
+BENCHMARK(falcon_verify_pubkey)->Arg(0)->Arg(1);
+BENCHMARK(falcon_comp_codec)->Arg(0)->Arg(1);
+BENCHMARK(falcon_key_codec)->Arg(0)->Arg(1);
+BENCHMARK(falcon_shake256_extract);
+BENCHMARK(falcon_hash_to_point_batch)->Arg(0)->Arg(1);
+BENCHMARK(falcon_verify_batch)->ArgsProduct({{0, 1}, {1, 4, 16, 64, 256}});
+BENCHMARK(falcon_lazy_ctx_sign_mt)->ThreadRange(1, 8)->UseRealTime();
 
 #include "ed25519.h"
 
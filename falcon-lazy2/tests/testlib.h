@@ -117,10 +117,8 @@ falcon_key_t keygen(uint64_t logn, inner_shake256_context* rng);
 
 EXPORT int sign_dyn_lazy_online(
         int8_t* sample1, int8_t* sample2, uint16_t* sample_target,
-        int16_t *s2,
-        const fpr *restrict f_fft, const fpr *restrict g_fft,
-        const fpr *restrict F_fft, const fpr *restrict G_fft,
-        const uint16_t *hm, unsigned logn, fpr *restrict tmp __attribute((unused)));
+        int16_t *s2, const fpr *restrict B_fft,
+        const uint16_t *hm, unsigned logn, fpr *restrict tmp);
 
 EXPORT void sign_dyn_lazy_offline(
         // inputs
@@ -131,8 +129,7 @@ EXPORT void sign_dyn_lazy_offline(
         unsigned logn,
         //outputs
         int8_t* sample1, int8_t* sample2, uint16_t* sample_target,
-        fpr *restrict f_fft, fpr *restrict g_fft,
-        fpr *restrict F_fft, fpr *restrict G_fft
+        fpr *restrict B_fft, fpr *restrict tmp
 );
 
 
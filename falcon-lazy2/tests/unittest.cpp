@@ -87,23 +87,20 @@ TEST(falcon, lazy_sig) {
     std::vector<int8_t> sample1(n);
     std::vector<int8_t> sample2(n);
     std::vector<uint16_t> sample_target(n);
-    std::vector<fpr> f_FFT(n);
-    std::vector<fpr> g_FFT(n);
-    std::vector<fpr> F_FFT(n);
-    std::vector<fpr> G_FFT(n);
+    std::vector<fpr> B_FFT(4 * n);
+    std::vector<fpr> ftmp(n);
     uint64_t t0_off = std::chrono::steady_clock::now().time_since_epoch().count();
     for (uint64_t i=0; i<10000; ++i) {
         sign_dyn_lazy_offline(&rng, key.f.data(), key.g.data(), key.F.data(), key.G.data(), key.h.data(), logn,
-                              sample1.data(), sample2.data(), sample_target.data(), f_FFT.data(), g_FFT.data(),
-                              F_FFT.data(), G_FFT.data());
+                              sample1.data(), sample2.data(), sample_target.data(), B_FFT.data(), ftmp.data());
     }
     uint64_t t1_off = std::chrono::steady_clock::now().time_since_epoch().count();
     std::vector<uint16_t> orig_sample_target = sample_target;
     uint64_t t0 = std::chrono::steady_clock::now().time_since_epoch().count();
     for (uint64_t i=0; i<10000; ++i) {
         sign_dyn_lazy_online(sample1.data(), sample2.data(), sample_target.data(), sig.data(),
-                             f_FFT.data(), g_FFT.data(), F_FFT.data(), G_FFT.data(), hm.data(), logn,
-                             nullptr);
+                             B_FFT.data(), hm.data(), logn,
+                             (fpr *) tmp);
     }
     uint64_t t1 = std::chrono::steady_clock::now().time_since_epoch().count();
     double time_offline = (t1_off - t0_off)/1e9/1000.*1e6;
@@ -111,8 +108,8 @@ TEST(falcon, lazy_sig) {
     std::cout << "offline time (us): " << time_offline << std::endl;
     std::cout << "online time (us): " << time_online << std::endl;
     sign_dyn_lazy_online(sample1.data(), sample2.data(), orig_sample_target.data(), sig.data(),
-                         f_FFT.data(), g_FFT.data(), F_FFT.data(), G_FFT.data(), hm.data(), logn,
-                         nullptr);
+                         B_FFT.data(), hm.data(), logn,
+                         (fpr *) tmp);
     free(tmp);
     // compute the full uncompressed signature
     vec_modQ sigq = to_vec_modQ(sig);
@@ -128,6 +125,171 @@ TEST(falcon, lazy_sig) {
 }
 
 
+// The s2-only online modes must give the same s2 and, for LAZY_NORM_NTT,
+// the same norm check result as the full computation.
+TEST(falcon, lazy_online_norm_modes) {
+    const uint64_t logn = 9;
+    const uint64_t n = 1 << logn;
+    inner_shake256_context rng;
+    inner_shake256_init(&rng);
+    falcon_key_t key = keygen(logn, &rng);
+    std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+    falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                 key.h.data(), logn);
+    std::vector<int8_t> sample1(n);
+    std::vector<int8_t> sample2(n);
+    std::vector<fpr> yt(2 * n);
+    std::vector<fpr> tmp(4 * n);
+    std::vector<uint16_t> hm(n);
+    std::vector<int16_t> s2_full(n), s2_ntt(n), s2_skip(n);
+    for (uint64_t trial = 0; trial < 20; ++trial) {
+        for (uint64_t i = 0; i < n; ++i) {
+            hm[i] = rand() % F_Q;
+        }
+        falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1.data(), sample2.data(), yt.data(), logn);
+        int r_full = falcon_inner_sign_lazy_online(s2_full.data(), expkey.data(), sample1.data(), sample2.data(),
+                                                   yt.data(), hm.data(), logn, LAZY_NORM_FULL, tmp.data());
+        int r_ntt = falcon_inner_sign_lazy_online(s2_ntt.data(), expkey.data(), sample1.data(), sample2.data(),
+                                                  yt.data(), hm.data(), logn, LAZY_NORM_NTT, tmp.data());
+        int r_skip = falcon_inner_sign_lazy_online(s2_skip.data(), expkey.data(), sample1.data(), sample2.data(),
+                                                   yt.data(), hm.data(), logn, LAZY_NORM_SKIP, tmp.data());
+        ASSERT_EQ(s2_full, s2_ntt);
+        ASSERT_EQ(s2_full, s2_skip);
+        ASSERT_EQ(r_full, r_ntt);
+        ASSERT_EQ(r_skip, 1);
+    }
+}
+
+// With LAZY_F32, the reduction is done in single precision (with a
+// fallback to double precision near rounding boundaries); signatures and
+// norm checks must not change.
+TEST(falcon, lazy_online_f32) {
+    for (uint64_t logn = 1; logn <= 10; ++logn) {
+        const uint64_t n = 1 << logn;
+        inner_shake256_context rng;
+        inner_shake256_init(&rng);
+        falcon_key_t key = keygen(logn, &rng);
+        std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+        falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                     key.h.data(), logn);
+        std::vector<int8_t> sample1(n);
+        std::vector<int8_t> sample2(n);
+        std::vector<fpr> yt(2 * n);
+        std::vector<fpr> tmp(4 * n);
+        std::vector<uint16_t> hm(n);
+        std::vector<int16_t> s2_ref(n), s2_f32(n);
+        for (uint64_t trial = 0; trial < 20; ++trial) {
+            for (uint64_t i = 0; i < n; ++i) {
+                hm[i] = rand() % F_Q;
+            }
+            falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1.data(), sample2.data(), yt.data(), logn);
+            for (int norm : {LAZY_NORM_FULL, LAZY_NORM_NTT, LAZY_NORM_SKIP}) {
+                int r_ref = falcon_inner_sign_lazy_online(s2_ref.data(), expkey.data(), sample1.data(),
+                                                          sample2.data(), yt.data(), hm.data(), logn, norm,
+                                                          tmp.data());
+                int r_f32 = falcon_inner_sign_lazy_online(s2_f32.data(), expkey.data(), sample1.data(),
+                                                          sample2.data(), yt.data(), hm.data(), logn,
+                                                          norm | LAZY_F32, tmp.data());
+                ASSERT_EQ(s2_ref, s2_f32) << "logn=" << logn << " norm=" << norm;
+                ASSERT_EQ(r_ref, r_f32) << "logn=" << logn << " norm=" << norm;
+            }
+        }
+    }
+}
+
+// Shifting the token by d = (G, -g)*P/q, with P = (1 + x + ... + x^(n-1))/2,
+// adds (0, +/-P) to the reduced vector (det B = +/-q): every value of the
+// second half then sits on a rounding boundary, so LAZY_F32 must fall back
+// to double precision and still give the same signatures.
+TEST(falcon, lazy_online_f32_fallback) {
+    for (uint64_t logn = 1; logn <= 10; ++logn) {
+        const uint64_t n = 1 << logn;
+        inner_shake256_context rng;
+        inner_shake256_init(&rng);
+        falcon_key_t key = keygen(logn, &rng);
+        std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+        falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                     key.h.data(), logn);
+        std::vector<fpr> d1(n), d2(n), p(n);
+        for (uint64_t i = 0; i < n; ++i) {
+            d1[i] = fpr_of(key.G[i]);
+            d2[i] = fpr_of(-key.g[i]);
+            p[i] = fpr_div(fpr_of(1), fpr_of(2 * F_Q));
+        }
+        falcon_inner_FFT(d1.data(), logn);
+        falcon_inner_FFT(d2.data(), logn);
+        falcon_inner_FFT(p.data(), logn);
+        falcon_inner_poly_mul_fft(d1.data(), p.data(), logn);
+        falcon_inner_poly_mul_fft(d2.data(), p.data(), logn);
+        std::vector<int8_t> sample1(n);
+        std::vector<int8_t> sample2(n);
+        std::vector<fpr> yt(2 * n);
+        std::vector<fpr> tmp(4 * n);
+        std::vector<uint16_t> hm(n);
+        std::vector<int16_t> s2_ref(n), s2_f32(n);
+        for (uint64_t trial = 0; trial < 5; ++trial) {
+            for (uint64_t i = 0; i < n; ++i) {
+                hm[i] = rand() % F_Q;
+            }
+            falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1.data(), sample2.data(), yt.data(), logn);
+            falcon_inner_poly_add(yt.data(), d1.data(), logn);
+            falcon_inner_poly_add(yt.data() + n, d2.data(), logn);
+            for (int norm : {LAZY_NORM_FULL, LAZY_NORM_SKIP}) {
+                int r_ref = falcon_inner_sign_lazy_online(s2_ref.data(), expkey.data(), sample1.data(),
+                                                          sample2.data(), yt.data(), hm.data(), logn, norm,
+                                                          tmp.data());
+                int r_f32 = falcon_inner_sign_lazy_online(s2_f32.data(), expkey.data(), sample1.data(),
+                                                          sample2.data(), yt.data(), hm.data(), logn,
+                                                          norm | LAZY_F32, tmp.data());
+                ASSERT_EQ(s2_ref, s2_f32) << "logn=" << logn << " norm=" << norm;
+                ASSERT_EQ(r_ref, r_f32) << "logn=" << logn << " norm=" << norm;
+            }
+        }
+    }
+}
+
+// The batched online phase must give the same signatures as one call
+// per message.
+TEST(falcon, lazy_online_batch) {
+    for (unsigned logn = 1; logn <= 10; ++logn) {
+        const uint64_t n = 1 << logn;
+        inner_shake256_context rng;
+        inner_shake256_init(&rng);
+        falcon_key_t key = keygen(logn, &rng);
+        std::vector<fpr> expkey(LAZY_EXPKEY_SIZE(logn) / sizeof(fpr));
+        falcon_inner_lazy_expand_key(expkey.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(),
+                                     key.h.data(), logn);
+        std::vector<std::vector<int8_t>> sample1(LAZY_BATCH, std::vector<int8_t>(n));
+        std::vector<std::vector<int8_t>> sample2(LAZY_BATCH, std::vector<int8_t>(n));
+        std::vector<std::vector<fpr>> yt(LAZY_BATCH, std::vector<fpr>(2 * n));
+        std::vector<std::vector<uint16_t>> hm(LAZY_BATCH, std::vector<uint16_t>(n));
+        std::vector<std::vector<int16_t>> s2(LAZY_BATCH, std::vector<int16_t>(n));
+        std::vector<int16_t> s2_ref(n);
+        std::vector<fpr> tmp(12 * n);
+        int16_t *s2p[LAZY_BATCH];
+        const int8_t *sample2p[LAZY_BATCH];
+        const fpr *ytp[LAZY_BATCH];
+        const uint16_t *hmp[LAZY_BATCH];
+        for (unsigned l = 0; l < LAZY_BATCH; ++l) {
+            falcon_inner_sign_lazy_offline(&rng, expkey.data(), sample1[l].data(), sample2[l].data(), yt[l].data(),
+                                           logn);
+            for (uint64_t i = 0; i < n; ++i) {
+                hm[l][i] = rand() % F_Q;
+            }
+            s2p[l] = s2[l].data();
+            sample2p[l] = sample2[l].data();
+            ytp[l] = yt[l].data();
+            hmp[l] = hm[l].data();
+        }
+        falcon_inner_sign_lazy_online_batch(s2p, expkey.data(), sample2p, ytp, hmp, logn, tmp.data());
+        for (unsigned l = 0; l < LAZY_BATCH; ++l) {
+            falcon_inner_sign_lazy_online(s2_ref.data(), expkey.data(), sample1[l].data(), sample2[l].data(),
+                                          yt[l].data(), hm[l].data(), logn, LAZY_NORM_SKIP, tmp.data());
+            ASSERT_EQ(s2[l], s2_ref) << "logn=" << logn << " lane=" << l;
+        }
+    }
+}
+
 EXPORT void sample_gaussian(int8_t *res,
                      sampler_context* spc,
                      fpr isigma,
@@ -152,21 +314,17 @@ TEST(falcon, sample_gaussian) {
     }
 }
 
-EXPORT void sample_gaussian_poly_bern(int8_t *sample1, int8_t *sample2, size_t n);
+EXPORT void sample_gaussian_poly_bern(prng *p, int8_t *sample1, int8_t *sample2, size_t n);
 
 TEST(falcon, sample_gaussian_poly_bern) {
     for (const uint64_t n: {512,1024}) {
-        //const uint64_t n = 1 << logn;
-        //inner_shake256_context rng;
-        //inner_shake256_init(&rng);
-        //double sigma = 2.; // between 1 and 2
-        //fpr isigma = FPR(1./sigma);
-        //sampler_context sc;
-        //Zf(prng_init)(&sc.p, &rng);
-        //sc.sigma_min = fpr_sigma_min[logn];
+        inner_shake256_context rng;
+        shake256_init_prng_from_seed(&rng, "bern", 4);
+        prng p;
+        Zf(prng_init)(&p, &rng);
         std::vector<int8_t> res1(n);
         std::vector<int8_t> res2(n);
-        sample_gaussian_poly_bern(res1.data(), res2.data(), n);
+        sample_gaussian_poly_bern(&p, res1.data(), res2.data(), n);
         std::vector<double> st(n);
         for (uint64_t i=0; i<n; ++i) st[i]=res1[i];
         double norm = print_statistics(st);
@@ -174,33 +332,161 @@ TEST(falcon, sample_gaussian_poly_bern) {
     }
 }
 
+EXPORT uint64_t exp_scaled(uint64_t x);
+
+TEST(falcon, sample_bern_block) {
+    // 128-bit CDT thresholds (top, bottom) of the Bernoulli/CDT sampler
+    static const uint64_t cdt[10][2] = {
+        {11881272476311950404ULL, 2232598800125794762ULL},
+        {17729174351313943813ULL, 17046599807202850264ULL},
+        {18426461144592799266ULL, 9031501729263515114ULL},
+        {18446602887327906610ULL, 11817852927693963396ULL},
+        {18446743834670245612ULL, 7306021935394802834ULL},
+        {18446744073611412414ULL, 17880792342251759005ULL},
+        {18446744073709541852ULL, 14689009182029885173ULL},
+        {18446744073709551615ULL, 14106032229701791861ULL},
+        {18446744073709551615ULL, 18446718728838181855ULL},
+        {18446744073709551615ULL, 18446744073673701140ULL},
+    };
+    std::mt19937_64 gen(42);
+    std::vector<uint8_t> rnd(BERN_BLOCK_BYTES);
+    for (int iter = 0; iter < 20000; ++iter) {
+        for (auto &b: rnd) b = gen();
+        // push some candidates into the distribution tail and onto the edge cases
+        if (iter % 4 == 1) {
+            for (int u = 0; u < BERN_BLOCK; ++u) {
+                const uint64_t *c = cdt[(iter / 4 + u) % 10];
+                uint64_t top = c[0], bot = c[1] + (uint64_t) (gen() % 3) - 1;
+                memcpy(rnd.data() + 8 * u, &top, 8);
+                memcpy(rnd.data() + 8 * (BERN_BLOCK + u), &bot, 8);
+            }
+        } else if (iter % 4 == 2) {
+            for (int u = 0; u < BERN_BLOCK; ++u) {
+                rnd[24 * BERN_BLOCK + u] = 0;
+                if (u & 1) memset(rnd.data() + 8 * (2 * BERN_BLOCK + u), 0, 8);
+            }
+        }
+        std::vector<int8_t> ref;
+        for (int u = 0; u < BERN_BLOCK; ++u) {
+            uint64_t utop, ubot, w;
+            memcpy(&utop, rnd.data() + 8 * u, 8);
+            memcpy(&ubot, rnd.data() + 8 * (BERN_BLOCK + u), 8);
+            memcpy(&w, rnd.data() + 8 * (2 * BERN_BLOCK + u), 8);
+            w >>= 1;
+            uint32_t y = rnd[24 * BERN_BLOCK + u];
+            uint32_t c = rnd[25 * BERN_BLOCK + u];
+            unsigned __int128 uu = ((unsigned __int128) utop << 64) | ubot;
+            uint32_t x = 0;
+            for (int i = 0; i < 10; ++i)
+                x += uu > (((unsigned __int128) cdt[i][0] << 64) | cdt[i][1]);
+            x <<= 8;
+            int32_t z = x + y;
+            uint32_t e = y * (y + 2 * x) << 8;
+            uint32_t k = e / 16404853;
+            uint64_t v = exp_scaled(e - 16404853 * k) << (22 - k);
+            if (w > v || ((c & 1) && z == 0)) continue;
+            ref.push_back((c & 2) ? z : -z);
+        }
+        std::vector<int8_t> out(BERN_BLOCK);
+        size_t num = Zf(sample_bern_block)(out.data(), rnd.data());
+        out.resize(num);
+        ASSERT_EQ(out, ref) << "iter=" << iter;
+    }
+}
+
+// from falcon.h (FALCON_BACKEND_AUTO = 0, REF = 1, AVX2 = 2, AVX512 = 3)
+EXPORT int falcon_get_backend(void);
+EXPORT int falcon_set_backend(int backend);
+
+TEST(falcon, backends) {
+    // the PRNG stream and the integer samplers must not depend on the
+    // backend, also when it changes in the middle of a stream (the
+    // AVX-512 refill keeps a reserve of blocks); without runtime
+    // dispatch, only the compile-time backend is accepted
+    const int sel = falcon_get_backend();
+    ASSERT_GE(sel, 1);
+    ASSERT_LE(sel, 3);
+    ASSERT_EQ(falcon_set_backend(4), -5 /* FALCON_ERR_BADARG */);
+    std::vector<int> avail;
+    for (int b = 1; b <= 3; ++b) {
+        if (falcon_set_backend(b) == 0) avail.push_back(b);
+    }
+    ASSERT_FALSE(avail.empty());
+    ASSERT_EQ(falcon_set_backend(avail[0]), 0);
+    std::vector<uint8_t> ref_bytes(3000);
+    std::vector<int> ref_z(2000);
+    std::vector<int8_t> ref_bern(BERN_BLOCK);
+    std::vector<uint8_t> rnd(BERN_BLOCK_BYTES);
+    for (size_t i = 0; i < rnd.size(); ++i) rnd[i] = uint8_t(rand());
+    {
+        inner_shake256_context rng;
+        shake256_init_prng_from_seed(&rng, "backend", 7);
+        prng p;
+        Zf(prng_init)(&p, &rng);
+        Zf(prng_get_bytes)(&p, ref_bytes.data(), ref_bytes.size());
+        for (int &z: ref_z) z = Zf(gaussian0_sampler)(&p);
+        ref_bern.resize(Zf(sample_bern_block)(ref_bern.data(), rnd.data()));
+    }
+    for (size_t k = 0; k < avail.size(); ++k) {
+        const int b = avail[k];
+        ASSERT_EQ(falcon_set_backend(b), 0);
+        ASSERT_EQ(falcon_get_backend(), b);
+        inner_shake256_context rng;
+        shake256_init_prng_from_seed(&rng, "backend", 7);
+        prng p;
+        Zf(prng_init)(&p, &rng);
+        std::vector<uint8_t> bytes(ref_bytes.size());
+        Zf(prng_get_bytes)(&p, bytes.data(), 300);
+        ASSERT_EQ(falcon_set_backend(avail[(k + 1) % avail.size()]), 0);
+        Zf(prng_get_bytes)(&p, bytes.data() + 300, bytes.size() - 300);
+        ASSERT_EQ(falcon_set_backend(b), 0);
+        ASSERT_EQ(bytes, ref_bytes) << "backend=" << b;
+        std::vector<int> z(ref_z.size());
+        for (int &v: z) v = Zf(gaussian0_sampler)(&p);
+        ASSERT_EQ(z, ref_z) << "backend=" << b;
+        std::vector<int8_t> bern(BERN_BLOCK);
+        bern.resize(Zf(sample_bern_block)(bern.data(), rnd.data()));
+        ASSERT_EQ(bern, ref_bern) << "backend=" << b;
+    }
+    ASSERT_EQ(falcon_set_backend(sel), 0);
+}
+
 /** x0 - h.x1 */
-EXPORT void compute_target(uint16_t *h, int8_t *x0, int8_t *x1, uint16_t *res, unsigned logn);
+EXPORT void compute_target(const uint16_t *h, const int8_t *x0, const int8_t *x1, uint16_t *res, unsigned logn);
 
 TEST(falcon, mul_by_h) {
-    for (const uint64_t logn: {9,10}) {
-        const uint64_t n = 1 << logn;
-        std::vector<uint16_t> actual(n);
-        std::vector<uint16_t> h(n);
-        std::vector<uint16_t> x0(n);
-        for (uint16_t i=0; i<n; ++i) {
-            h[i] = posmod(random_u64(), F_Q);
-            x0[i] = posmod(random_u64(), F_Q);
+    // the NTT kernels must give the same results with every backend
+    const int sel = falcon_get_backend();
+    for (int b = 1; b <= 3; ++b) {
+        if (falcon_set_backend(b) != 0) continue;
+        for (const uint64_t logn: {1,2,3,4,5,6,7,8,9,10}) {
+            const uint64_t n = 1 << logn;
+            std::vector<uint16_t> actual(n);
+            std::vector<uint16_t> h(n);
+            std::vector<uint16_t> x0(n);
+            for (uint16_t i=0; i<n; ++i) {
+                h[i] = posmod(random_u64(), F_Q);
+                x0[i] = posmod(random_u64(), F_Q);
+            }
+            vec_modQ hq = to_vec_modQ(h);
+            vec_modQ x0q = to_vec_modQ(x0);
+            vec_modQ expect = starproduct(x0q , hq);
+            // we need to pass h_monty
+            std::vector<uint16_t> h_monty = h;
+            falcon_inner_to_ntt_monty(h_monty.data(), logn);
+            //
+            std::vector<uint16_t> res = x0;
+            falcon_inner_mq_NTT(res.data(), logn);
+            falcon_inner_mq_poly_montymul_ntt(res.data(), h_monty.data(), logn);
+            falcon_inner_mq_iNTT(res.data(), logn);
+
+            for (uint64_t i=0; i<n; ++i) {
+                ASSERT_LT(res[i], F_Q) << "backend=" << b;
+            }
+            ASSERT_EQ(to_vec_modQ(res), expect) << "backend=" << b;
         }
-        vec_modQ hq = to_vec_modQ(h);
-        vec_modQ x0q = to_vec_modQ(x0);
-        vec_modQ expect = starproduct(x0q , hq);
-        // we need to pass h_monty
-        std::vector<uint16_t> h_monty = h;
-        falcon_inner_to_ntt_monty(h_monty.data(), logn);
-        //
-        std::vector<uint16_t> res = x0;
-        mq_NTT(res.data(), logn);
-        mq_poly_montymul_ntt(res.data(), h_monty.data(), logn);
-        mq_iNTT(res.data(), logn);
-
-        ASSERT_EQ(to_vec_modQ(res), expect);
     }
+    ASSERT_EQ(falcon_set_backend(sel), 0);
 }
 
 
@@ -233,10 +519,9 @@ TEST(falcon, compute_target) {
  *  short (res0,res1) s.t.  res0 - h.res1 = target mod q
  */
 EXPORT void short_preimage(const uint16_t *target, //
-                           const fpr *f_fft, const fpr *g_fft, // key
-                           const fpr *F_fft, const fpr *G_fft, // key
+                           const fpr *B_fft, // key, interleaved
                            int32_t *res1, int32_t *res2,
-                           unsigned logn);
+                           unsigned logn, fpr *tmp);
 
 TEST(falcon, short_preimage) {
     for (const uint64_t logn: {9,10}) {
@@ -247,6 +532,7 @@ TEST(falcon, short_preimage) {
         std::vector<uint16_t> target(n);
         std::vector<int32_t> res1(n);
         std::vector<int32_t> res2(n);
+        std::vector<fpr> tmp(4 * n);
         for (uint16_t i=0; i<n; ++i) {
             target[i] = posmod(random_u64(), F_Q);
         }
@@ -264,12 +550,16 @@ TEST(falcon, short_preimage) {
         Zf(FFT)(g_FFT.data(), logn);
         Zf(FFT)(F_FFT.data(), logn);
         Zf(FFT)(G_FFT.data(), logn);
+        std::vector<fpr> B_FFT(4 * n);
+        Zf(poly_basis_set)(B_FFT.data(), f_FFT.data(), BASIS_F, logn);
+        Zf(poly_basis_set)(B_FFT.data(), g_FFT.data(), BASIS_G, logn);
+        Zf(poly_basis_set)(B_FFT.data(), F_FFT.data(), BASIS_BF, logn);
+        Zf(poly_basis_set)(B_FFT.data(), G_FFT.data(), BASIS_BG, logn);
         //
         short_preimage(target.data(), //
-                       f_FFT.data(), g_FFT.data(), //
-                       F_FFT.data(), G_FFT.data(), //
+                       B_FFT.data(), //
                        res1.data(), res2.data(), //
-                       logn);
+                       logn, tmp.data());
         // verify: the norm of res1, res2
         print_statistics(res1);
         print_statistics(res2);
@@ -284,6 +574,152 @@ TEST(falcon, short_preimage) {
     }
 }
 
+// The integer-only online phase computes the same preimage and the same
+// signature as the floating-point one (including for the extreme targets
+// 0 and q-1).
+TEST(falcon, short_preimage_int) {
+    for (uint64_t logn = 1; logn <= 10; ++logn) {
+        const uint64_t n = 1 << logn;
+        inner_shake256_context rng;
+        inner_shake256_init(&rng);
+        falcon_key_t key = keygen(logn, &rng);
+        std::vector<uint32_t> Bi(LAZY_IBASIS_SIZE(logn) / sizeof(uint32_t));
+        sign_dyn_lazy_basis_int(Bi.data(), key.f.data(), key.g.data(), key.F.data(), key.G.data(), logn);
+        std::vector<int8_t> sample1(n);
+        std::vector<int8_t> sample2(n);
+        std::vector<uint16_t> target(n);
+        std::vector<fpr> B_FFT(4 * n);
+        std::vector<fpr> ftmp(n);
+        std::vector<fpr> tmp(4 * n);
+        std::vector<uint32_t> itmp(6 * n);
+        std::vector<int32_t> res1(n), res2(n), ires1(n), ires2(n);
+        std::vector<uint16_t> hm(n);
+        std::vector<int16_t> s2(n), is2(n);
+        for (uint64_t trial = 0; trial < 20; ++trial) {
+            sign_dyn_lazy_offline(&rng, key.f.data(), key.g.data(), key.F.data(), key.G.data(), key.h.data(),
+                                  logn, sample1.data(), sample2.data(), target.data(), B_FFT.data(), ftmp.data());
+            if (trial < 2) {
+                for (uint64_t i = 0; i < n; ++i) {
+                    target[i] = trial == 0 ? 0 : F_Q - 1;
+                }
+            }
+            short_preimage(target.data(), B_FFT.data(), res1.data(), res2.data(), logn, tmp.data());
+            short_preimage_int(target.data(), Bi.data(), ires1.data(), ires2.data(), logn, itmp.data());
+            ASSERT_EQ(res1, ires1) << "logn=" << logn;
+            ASSERT_EQ(res2, ires2) << "logn=" << logn;
+
+            for (uint64_t i = 0; i < n; ++i) {
+                hm[i] = rand() % F_Q;
+            }
+            std::vector<uint16_t> itarget = target;
+            int r = sign_dyn_lazy_online(sample1.data(), sample2.data(), target.data(), s2.data(),
+                                         B_FFT.data(), hm.data(), logn, tmp.data());
+            int ir = sign_dyn_lazy_online_int(sample1.data(), sample2.data(), itarget.data(), is2.data(),
+                                              Bi.data(), hm.data(), logn, itmp.data());
+            ASSERT_EQ(s2, is2) << "logn=" << logn;
+            ASSERT_EQ(r, ir) << "logn=" << logn;
+        }
+    }
+}
+
+/** fused products with the interleaved basis: same results as the
+ *  separate poly_mul_fft / poly_add / poly_neg / poly_mulconst calls */
+TEST(falcon, poly_basis_mul) {
+    for (uint64_t logn = 1; logn <= 10; ++logn) {
+        const uint64_t n = 1 << logn;
+        std::vector<std::vector<fpr>> key(4, std::vector<fpr>(n));
+        std::vector<fpr> B(4 * n);
+        for (int k = 0; k < 4; ++k) {
+            for (uint64_t i = 0; i < n; ++i) {
+                key[k][i] = fpr_of(centermod(random_u64(), 4096));
+            }
+            Zf(FFT)(key[k].data(), logn);
+            Zf(poly_basis_set)(B.data(), key[k].data(), k, logn);
+        }
+        const std::vector<fpr>& f = key[BASIS_F];
+        const std::vector<fpr>& g = key[BASIS_G];
+        const std::vector<fpr>& F = key[BASIS_BF];
+        const std::vector<fpr>& G = key[BASIS_BG];
+        std::vector<fpr> y1(n), y2(n);
+        for (uint64_t i = 0; i < n; ++i) {
+            y1[i] = fpr_of(centermod(random_u64(), 1 << 20));
+            y2[i] = fpr_of(centermod(random_u64(), 1 << 20));
+        }
+
+        // first Babai step
+        std::vector<fpr> e1 = y1, e2 = y1;
+        Zf(poly_neg)(e1.data(), logn);
+        Zf(poly_mul_fft)(e1.data(), F.data(), logn);
+        Zf(poly_mul_fft)(e2.data(), f.data(), logn);
+        Zf(poly_mulconst)(e1.data(), fpr_inverse_of_q, logn);
+        Zf(poly_mulconst)(e2.data(), fpr_inverse_of_q, logn);
+        std::vector<fpr> a1 = y1, a2(n);
+        Zf(poly_basis_solve_fft)(a1.data(), a2.data(), B.data(), logn);
+        ASSERT_EQ(0, memcmp(a1.data(), e1.data(), n * sizeof(fpr)));
+        ASSERT_EQ(0, memcmp(a2.data(), e2.data(), n * sizeof(fpr)));
+
+        // (y1, y2) * B, both rows then the second one only
+        std::vector<fpr> t1 = y1, t2 = y2;
+        e1 = y1;
+        e2 = y2;
+        Zf(poly_mul_fft)(e1.data(), g.data(), logn);
+        Zf(poly_mul_fft)(t2.data(), G.data(), logn);
+        Zf(poly_add)(e1.data(), t2.data(), logn);
+        Zf(poly_mul_fft)(t1.data(), f.data(), logn);
+        Zf(poly_mul_fft)(e2.data(), F.data(), logn);
+        Zf(poly_add)(e2.data(), t1.data(), logn);
+        a1 = y1;
+        a2 = y2;
+        Zf(poly_basis_mul_fft)(a1.data(), a2.data(), B.data(), logn);
+        ASSERT_EQ(0, memcmp(a1.data(), e1.data(), n * sizeof(fpr)));
+        ASSERT_EQ(0, memcmp(a2.data(), e2.data(), n * sizeof(fpr)));
+        a2 = y2;
+        Zf(poly_basis_mul2_fft)(y1.data(), a2.data(), B.data(), logn);
+        ASSERT_EQ(0, memcmp(a2.data(), e2.data(), n * sizeof(fpr)));
+
+        // four interleaved pairs
+        std::vector<fpr> x1(4 * n), x2(4 * n);
+        for (uint64_t i = 0; i < 4 * n; ++i) {
+            x1[i] = fpr_of(centermod(random_u64(), 1 << 20));
+            x2[i] = fpr_of(centermod(random_u64(), 1 << 20));
+        }
+        std::vector<fpr> u1 = x1, u2 = x2;
+        Zf(poly_mul_fft_x4)(u1.data(), f.data(), logn);
+        Zf(poly_mul_fft_x4)(u2.data(), F.data(), logn);
+        Zf(poly_add)(u2.data(), u1.data(), logn + 2);
+        Zf(poly_basis_mul2_fft_x4)(x1.data(), x2.data(), B.data(), logn);
+        ASSERT_EQ(0, memcmp(x2.data(), u2.data(), 4 * n * sizeof(fpr)));
+    }
+}
+
+TEST(falcon, fft_specialized) {
+    // FFT and iFFT are specialized for logn = 9 and 10, with merged
+    // (radix-4) layers; they must return exactly what the generic
+    // radix-2 transforms return (0 ULP), so that rounding done on the
+    // outputs (e.g. fpr_rint() in short_preimage) cannot be affected
+    for (uint64_t logn = 1; logn <= 10; ++logn) {
+        const uint64_t n = 1 << logn;
+        for (int rep = 0; rep < 8; ++rep) {
+            std::vector<fpr> f(n);
+            for (uint64_t i = 0; i < n; ++i) {
+                f[i] = fpr_mul(fpr_of(centermod(random_u64(), 1 << 20)),
+                               fpr_inverse_of_q);
+            }
+            std::vector<fpr> a = f, e = f;
+            Zf(FFT)(a.data(), logn);
+            Zf(FFT_generic)(e.data(), logn);
+            ASSERT_EQ(0, memcmp(a.data(), e.data(), n * sizeof(fpr)))
+                << "logn=" << logn;
+            a = f;
+            e = f;
+            Zf(iFFT)(a.data(), logn);
+            Zf(iFFT_generic)(e.data(), logn);
+            ASSERT_EQ(0, memcmp(a.data(), e.data(), n * sizeof(fpr)))
+                << "logn=" << logn;
+        }
+    }
+}
+
 EXPORT void
 shake256_extract(inner_shake256_context *sc, void *out, size_t len);
 
@@ -324,22 +760,19 @@ TEST(falcon, lazy_sig_norm) {
         std::vector<int8_t> sample1(n);
         std::vector<int8_t> sample2(n);
         std::vector<uint16_t> sample_target(n);
-        std::vector<fpr> f_FFT(n);
-        std::vector<fpr> g_FFT(n);
-        std::vector<fpr> F_FFT(n);
-        std::vector<fpr> G_FFT(n);
+        std::vector<fpr> B_FFT(4 * n);
+        std::vector<fpr> ftmp(n);
 
         sign_dyn_lazy_offline(&rng, key.f.data(), key.g.data(), key.F.data(), key.G.data(), key.h.data(), logn,
-                                sample1.data(), sample2.data(), sample_target.data(), f_FFT.data(), g_FFT.data(),
-                                F_FFT.data(), G_FFT.data());
+                                sample1.data(), sample2.data(), sample_target.data(), B_FFT.data(), ftmp.data());
 
         //uint64_t t1_off = std::chrono::steady_clock::now().time_since_epoch().count();
         std::vector<uint16_t> orig_sample_target = sample_target;
         //uint64_t t0 = std::chrono::steady_clock::now().time_since_epoch().count();
 
         sign_dyn_lazy_online(sample1.data(), sample2.data(), sample_target.data(), sig.data(),
-                                f_FFT.data(), g_FFT.data(), F_FFT.data(), G_FFT.data(), hm.data(), logn,
-                                nullptr);
+                                B_FFT.data(), hm.data(), logn,
+                                (fpr *) tmp);
 
         free(tmp);
         // compute the full uncompressed signature
@@ -405,10 +838,8 @@ TEST(falcon, lazy_sig_norm_multikeys) {
     std::vector<int8_t> sample1(n);
     std::vector<int8_t> sample2(n);
     std::vector<uint16_t> sample_target(n);
-    std::vector<fpr> f_FFT(n);
-    std::vector<fpr> g_FFT(n);
-    std::vector<fpr> F_FFT(n);
-    std::vector<fpr> G_FFT(n);
+    std::vector<fpr> B_FFT(4 * n);
+    std::vector<fpr> ftmp(n);
 
     // write the header of the csv file
     std::ofstream ofs(signature_coords_filename);
@@ -428,8 +859,7 @@ TEST(falcon, lazy_sig_norm_multikeys) {
         vec_modQ hq = to_vec_modQ(key.h);
         // sign offline
         sign_dyn_lazy_offline(&rng, key.f.data(), key.g.data(), key.F.data(), key.G.data(), key.h.data(), logn,
-                              sample1.data(), sample2.data(), sample_target.data(), f_FFT.data(), g_FFT.data(),
-                              F_FFT.data(), G_FFT.data());
+                              sample1.data(), sample2.data(), sample_target.data(), B_FFT.data(), ftmp.data());
         // zero the gaussian sample
         // memset(sample1.data(), 0, n*sizeof(int8_t));
         // memset(sample2.data(), 0, n*sizeof(int8_t));
@@ -442,8 +872,8 @@ TEST(falcon, lazy_sig_norm_multikeys) {
             // we keep this one since the online phase modifies sample_target
             memset(sample_target.data(), 0, n*sizeof(uint16_t));
             sign_dyn_lazy_online(sample1.data(), sample2.data(), sample_target.data(), sig.data(),
-                                    f_FFT.data(), g_FFT.data(), F_FFT.data(), G_FFT.data(), hm.data(), logn,
-                                    nullptr);
+                                    B_FFT.data(), hm.data(), logn,
+                                    (fpr *) tmp);
 
             // compute the full uncompressed signature
             vec_modQ sigq = to_vec_modQ(sig);